@@ -0,0 +1,55 @@
+#ifndef ENETPP_CHANNEL_STATISTICS_H_
+#define ENETPP_CHANNEL_STATISTICS_H_
+
+#include <atomic>
+#include <stdint.h>
+#include "enet/enet.h"
+
+namespace enetpp {
+
+	//per channel traffic as seen by the worker thread. sent counts packets handed to enet, so coalesced / dropped
+	//packets aren't included.
+	class channel_statistics {
+	public:
+		//channels at or above this aren't tracked individually, they are added to the last entry.
+		static constexpr size_t tracked_channel_count = 8;
+
+	public:
+		std::atomic<uint64_t> _packets_sent;
+		std::atomic<uint64_t> _bytes_sent;
+		std::atomic<uint64_t> _packets_received;
+		std::atomic<uint64_t> _bytes_received;
+
+	public:
+		channel_statistics()
+			: _packets_sent(0)
+			, _bytes_sent(0)
+			, _packets_received(0)
+			, _bytes_received(0) {
+		}
+
+		static size_t get_index(enet_uint8 channel_id) {
+			return (channel_id < tracked_channel_count) ? channel_id : (tracked_channel_count - 1);
+		}
+
+		void reset() {
+			_packets_sent = 0;
+			_bytes_sent = 0;
+			_packets_received = 0;
+			_bytes_received = 0;
+		}
+
+		void record_sent(size_t byte_count) {
+			_packets_sent.fetch_add(1, std::memory_order_relaxed);
+			_bytes_sent.fetch_add(byte_count, std::memory_order_relaxed);
+		}
+
+		void record_received(size_t byte_count) {
+			_packets_received.fetch_add(1, std::memory_order_relaxed);
+			_bytes_received.fetch_add(byte_count, std::memory_order_relaxed);
+		}
+	};
+
+}
+
+#endif
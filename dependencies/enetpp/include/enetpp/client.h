@@ -1,15 +1,20 @@
 #ifndef ENETPP_CLIENT_H_
 #define ENETPP_CLIENT_H_
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <thread>
-#include <queue>
+#include <vector>
 #include <mutex>
 #include <assert.h>
 #include "global_state.h"
 #include "client_connect_params.h"
 #include "client_queued_packet.h"
 #include "client_statistics.h"
+#include "coalescing_packet_buffer.h"
+#include "spsc_ring.h"
+#include "wakeup_socket.h"
 #include "set_current_thread_name.h"
 #include "trace_handler.h"
 
@@ -21,26 +26,52 @@ namespace enetpp {
         CONNECT_CONNECTED,
     };
 
+	//called on the worker thread for every received packet. returning true takes ownership of the packet, which is
+	//then not queued for consume_events and has to be destroyed with enet_packet_destroy by the handler.
+	using receive_handler = std::function<bool(ENetPacket* packet)>;
+
 	class client {
+	public:
+		static constexpr size_t initial_event_queue_capacity = 256;
+
 	private:
 		trace_handler _trace_handler;
-
-		std::queue<client_queued_packet> _packet_queue;
-		std::mutex _packet_queue_mutex;
-
-		std::queue<ENetEvent> _event_queue;
-		std::queue<ENetEvent> _event_queue_copy; //member variable instead of stack variable to prevent mallocs?
+		receive_handler _receive_handler;
+
+		//written by the thread calling send_packet, drained by the worker thread.
+		spsc_ring<client_queued_packet> _packet_queue;
+		packet_queue_overflow _packet_queue_overflow;
+		std::chrono::milliseconds _packet_queue_overflow_timeout;
+		wakeup_socket _wakeup;
+
+		//worker thread only. state packets held back while the link is congested.
+		coalescing_packet_buffer _held_packets;
+
+		class queued_event {
+		public:
+			ENetEvent _event;
+			std::chrono::steady_clock::time_point _queued_time;
+		};
+
+		//double buffered. the worker thread appends to _event_queue, consume_events swaps it with the (empty)
+		//_event_queue_copy under the lock. both keep their capacity so steady state delivery never allocates.
+		std::vector<queued_event> _event_queue;
+		std::vector<queued_event> _event_queue_copy;
 		std::mutex _event_queue_mutex;
 
 		bool _should_exit_thread;
 
 		std::unique_ptr<std::thread> _thread;
-        connection_state _connection_state{ CONNECT_NONE };
+        std::atomic<connection_state> _connection_state{ CONNECT_NONE };
 		client_statistics _statistics;
 
 	public:
 		client()
-			: _should_exit_thread(false) {
+			: _packet_queue_overflow(PACKET_QUEUE_OVERFLOW_WAIT)
+			, _packet_queue_overflow_timeout(0)
+			, _should_exit_thread(false) {
+			_event_queue.reserve(initial_event_queue_capacity);
+			_event_queue_copy.reserve(initial_event_queue_capacity);
 		}
 
 		~client() {
@@ -57,6 +88,12 @@ namespace enetpp {
 			_trace_handler = handler;
 		}
 
+		//lets the caller decode packets on the worker thread instead of on the thread calling consume_events.
+		void set_receive_handler(receive_handler handler) {
+			assert(!is_connecting_or_connected()); //must be set before any threads started to be safe
+			_receive_handler = handler;
+		}
+
 		bool is_connecting_or_connected() const {
 			return _thread != nullptr;
 		}
@@ -71,11 +108,20 @@ namespace enetpp {
 			assert(params._channel_count > 0);
 			assert(params._server_port != 0);
 			assert(!params._server_host_name.empty());
+			assert(params._packet_queue_capacity > 0);
 
 			trace("connecting to '" + params._server_host_name + ":" + std::to_string(params._server_port) + "'");
 
             _connection_state = CONNECT_CONNECTING;
 
+			_packet_queue.reset(params._packet_queue_capacity);
+			_packet_queue_overflow = params._packet_queue_overflow;
+			_packet_queue_overflow_timeout = params._packet_queue_overflow_timeout;
+
+			if (!_wakeup.open()) {
+				trace("failed to open wakeup socket, sends will wait for the service timeout");
+			}
+
 			_should_exit_thread = false;
 			_thread = std::make_unique<std::thread>(&client::run_in_thread, this, params);
 		}
@@ -83,98 +129,178 @@ namespace enetpp {
 		void disconnect() {
 			if (_thread != nullptr) {
 				_should_exit_thread = true;
+				_wakeup.signal();
 				_thread->join();
 				_thread.release();
 			}
 
+			_wakeup.close();
 			destroy_all_queued_packets();
 			destroy_all_queued_events();
 		}
 
-		void send_packet(enet_uint8 channel_id, const enet_uint8* data, size_t data_size, enet_uint32 flags) {
+		//!IMPORTANT! the outbound queue is single producer. callers sending from more than one thread must serialize
+		//their calls themselves.
+		//
+		//coalesce_key marks state updates where only the newest matters, e.g. (message type, object id). while the
+		//link is congested only the newest packet per non zero key is kept and older ones are dropped unsent. held
+		//packets go out once the congestion clears, possibly after packets queued later without a key.
+		void send_packet(enet_uint8 channel_id, const enet_uint8* data, size_t data_size, enet_uint32 flags, uint64_t coalesce_key = 0) {
 			assert(is_connecting_or_connected());
 			if (_thread != nullptr) {
-				std::lock_guard<std::mutex> lock(_packet_queue_mutex);
 				auto packet = enet_packet_create(data, data_size, flags);
-				_packet_queue.emplace(channel_id, packet);
+				enqueue_packet(client_queued_packet(channel_id, packet, coalesce_key));
+				_wakeup.signal();
 			}
 		}
 
+		//takes ownership of an already created packet, e.g. one created with ENET_PACKET_FLAG_NO_ALLOCATE over a buffer
+		//the caller keeps alive until the packet's freeCallback runs. avoids the copy made by the overload above.
+		void send_packet(enet_uint8 channel_id, ENetPacket* packet, uint64_t coalesce_key = 0) {
+			assert(is_connecting_or_connected());
+			assert(packet != nullptr);
+			if (_thread != nullptr) {
+				enqueue_packet(client_queued_packet(channel_id, packet, coalesce_key));
+				_wakeup.signal();
+			}
+			else {
+				enet_packet_destroy(packet);
+			}
+		}
+
+		//callbacks are invoked directly, so lambdas get inlined and nothing is allocated per call.
+		template<typename OnConnected, typename OnDisconnected, typename OnDataReceived>
+		void consume_events(OnConnected&& on_connected, OnDisconnected&& on_disconnected, OnDataReceived&& on_data_received) {
+			dispatch_events(on_connected, on_disconnected, on_data_received);
+		}
+
+		//type erased overload kept for existing callers.
 		void consume_events(
 			std::function<void()> on_connected,
 			std::function<void()> on_disconnected,
 			std::function<void(const enet_uint8* data, size_t data_size)> on_data_received) {
+			dispatch_events(on_connected, on_disconnected, on_data_received);
+		}
 
-			if (!_event_queue.empty()) {
+		const client_statistics& get_statistics() const {
+			return _statistics;
+		}
 
-				//!IMPORTANT! neet to copy the events for consumption to prevent deadlocks!
-				//ex.
-				//- event = JoinGameFailed packet received
-				//- causes event_handler to call disconnect
-				//- disconnect deadlocks as the thread needs a critical section on events to exit
-				{
-					std::lock_guard<std::mutex> lock(_event_queue_mutex);
-					assert(_event_queue_copy.empty());
-					_event_queue_copy = _event_queue;
-					_event_queue = {};
+	private:
+		template<typename OnConnected, typename OnDisconnected, typename OnDataReceived>
+		void dispatch_events(OnConnected& on_connected, OnDisconnected& on_disconnected, OnDataReceived& on_data_received) {
+			//!IMPORTANT! neet to copy the events for consumption to prevent deadlocks!
+			//ex.
+			//- event = JoinGameFailed packet received
+			//- causes event_handler to call disconnect
+			//- disconnect deadlocks as the thread needs a critical section on events to exit
+			{
+				std::lock_guard<std::mutex> lock(_event_queue_mutex);
+				if (_event_queue.empty()) {
+					return;
 				}
 
-				bool is_disconnected = false;
+				assert(_event_queue_copy.empty());
+				_event_queue.swap(_event_queue_copy);
+			}
 
-				while (!_event_queue_copy.empty()) {
-					auto& e = _event_queue_copy.front();
-					switch (e.type) {
-						case ENET_EVENT_TYPE_CONNECT: {
-							on_connected();
-							break;
-						}
+			_statistics._event_queue_depth -= _event_queue_copy.size();
 
-						case ENET_EVENT_TYPE_DISCONNECT: {
-							on_disconnected();
-							is_disconnected = true;
-							break;
-						}
+			bool is_disconnected = false;
+			const auto now = std::chrono::steady_clock::now();
 
-						case ENET_EVENT_TYPE_RECEIVE: {
-							on_data_received(e.packet->data, e.packet->dataLength);
-							enet_packet_destroy(e.packet);
-							break;
-						}
+			for (auto& qe : _event_queue_copy) {
+				_statistics._event_queue_latency.record(now - qe._queued_time);
 
-						case ENET_EVENT_TYPE_NONE:
-						default:
-							assert(false);
-							break;
+				auto& e = qe._event;
+				switch (e.type) {
+					case ENET_EVENT_TYPE_CONNECT: {
+						on_connected();
+						break;
+					}
+
+					case ENET_EVENT_TYPE_DISCONNECT: {
+						on_disconnected();
+						is_disconnected = true;
+						break;
+					}
+
+					case ENET_EVENT_TYPE_RECEIVE: {
+						on_data_received(e.packet->data, e.packet->dataLength);
+						enet_packet_destroy(e.packet);
+						break;
 					}
-					_event_queue_copy.pop();
-				}
 
-				if (is_disconnected) {
-					//cleanup everything internally, make sure the thread is cleaned up.
-					disconnect();
+					case ENET_EVENT_TYPE_NONE:
+					default:
+						assert(false);
+						break;
 				}
 			}
+
+			_event_queue_copy.clear();
+
+			if (is_disconnected) {
+				//cleanup everything internally, make sure the thread is cleaned up.
+				disconnect();
+			}
 		}
 
-		const client_statistics& get_statistics() const {
-			return _statistics;
+		void enqueue_packet(client_queued_packet qp) {
+			//counted before the push so the worker thread never sees the packet before it is accounted for.
+			const size_t byte_count = qp._packet->dataLength;
+			qp._queued_time = std::chrono::steady_clock::now();
+			++_statistics._queued_packet_count;
+			_statistics._queued_byte_count += byte_count;
+
+			std::chrono::steady_clock::time_point wait_deadline;
+			bool is_waiting = false;
+			while (!_packet_queue.try_push(qp)) {
+				//the worker thread is gone (or going) so nothing will ever free a slot.
+				const bool is_thread_alive = (_connection_state == CONNECT_CONNECTING || _connection_state == CONNECT_CONNECTED);
+
+				//never wait for state packets, the caller will have a newer one before the slot frees up.
+				bool should_drop = (_packet_queue_overflow == PACKET_QUEUE_OVERFLOW_DROP || qp._coalesce_key != 0 || !is_thread_alive);
+				if (!should_drop) {
+					const auto now = std::chrono::steady_clock::now();
+					if (!is_waiting) {
+						wait_deadline = now + _packet_queue_overflow_timeout;
+						is_waiting = true;
+					}
+					should_drop = (now >= wait_deadline);
+				}
+
+				if (should_drop) {
+					enet_packet_destroy(qp._packet);
+					++_statistics._dropped_packet_count;
+					--_statistics._queued_packet_count;
+					_statistics._queued_byte_count -= byte_count;
+					return;
+				}
+
+				_wakeup.signal();
+				std::this_thread::yield();
+			}
 		}
 
-	private:
+		//only safe once the worker thread has been joined, the caller becomes the consumer.
 		void destroy_all_queued_packets() {
-			std::lock_guard<std::mutex> lock(_packet_queue_mutex);
-			while (!_packet_queue.empty()) {
-				enet_packet_destroy(_packet_queue.front()._packet);
-				_packet_queue.pop();
+			client_queued_packet qp;
+			while (_packet_queue.try_pop(qp)) {
+				enet_packet_destroy(qp._packet);
 			}
+
+			_statistics._queued_packet_count = 0;
+			_statistics._queued_byte_count = 0;
 		}
 
 		void destroy_all_queued_events() {
 			std::lock_guard<std::mutex> lock(_event_queue_mutex);
-			while (!_event_queue.empty()) {
-				destroy_unhandled_event_data(_event_queue.front());
-				_event_queue.pop();
+			for (auto& qe : _event_queue) {
+				destroy_unhandled_event_data(qe._event);
 			}
+			_event_queue.clear();
+			_statistics._event_queue_depth = 0;
 		}
 
 		void destroy_unhandled_event_data(ENetEvent& e) {
@@ -208,10 +334,10 @@ namespace enetpp {
 
 			bool is_disconnecting = false;
 			enet_uint32 disconnect_start_time = 0;
+			enet_uint32 service_timeout = static_cast<enet_uint32>(params._service_timeout.count());
 
 			while (peer != nullptr) {
-				_statistics._round_trip_time_in_ms = peer->roundTripTime;
-				_statistics._round_trip_time_variance_in_ms = peer->roundTripTimeVariance;
+				publish_peer_statistics_in_thread(peer);
 
 				if (_should_exit_thread) {
 					if (!is_disconnecting) {
@@ -229,6 +355,9 @@ namespace enetpp {
 					}
 				}
 
+				//reset before draining so a send racing with the drain still wakes the next wait.
+				_wakeup.reset();
+
 				if (!is_disconnecting) {
 					send_queued_packets_in_thread(peer);
 				}
@@ -239,8 +368,17 @@ namespace enetpp {
 				{
 					ENetEvent e;
 					while (enet_host_check_events(host, &e) > 0) {
+						if (e.type == ENET_EVENT_TYPE_RECEIVE) {
+							_statistics.get_channel(e.channelID).record_received(e.packet->dataLength);
+
+							if (_receive_handler != nullptr && _receive_handler(e.packet)) {
+								continue;
+							}
+						}
+
 						std::lock_guard<std::mutex> lock(_event_queue_mutex);
-						_event_queue.push(e);
+						_event_queue.push_back({ e, std::chrono::steady_clock::now() });
+						++_statistics._event_queue_depth;
 
                         if (e.type == ENET_EVENT_TYPE_CONNECT) {
                             _connection_state = CONNECT_CONNECTED;
@@ -254,30 +392,83 @@ namespace enetpp {
 					}
 				}
 
-				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				//block until there is something to do instead of polling. while disconnecting keep the loop ticking so
+				//the disconnect timeout above is noticed.
+				if (peer != nullptr) {
+					_wakeup.wait(host, is_disconnecting ? 1 : service_timeout);
+				}
 			}
 
             trace("leaving thread");
             _connection_state = CONNECT_FAILED;
 
+			_statistics._queued_packet_count -= _held_packets.size();
+			_statistics._queued_byte_count -= _held_packets.get_byte_count();
+			_held_packets.clear();
+
 			enet_host_destroy(host);
 		}
 
 		void send_queued_packets_in_thread(ENetPeer* peer) {
-			if (!_packet_queue.empty()) {
-				std::lock_guard<std::mutex> lock(_packet_queue_mutex);
-				while (!_packet_queue.empty()) {
-					auto qp = _packet_queue.front();
-					_packet_queue.pop();
-
-					if (enet_peer_send(peer, qp._channel_id, qp._packet) != 0) {
-						trace("enet_peer_send failed");
-					}
+			//reliableDataInTransit and packetThrottle only change inside enet_host_service so this holds for the whole drain.
+			const bool is_congested = is_peer_congested(peer);
+
+			if (!_held_packets.empty() && (!is_congested || _held_packets.is_overdue(std::chrono::steady_clock::now()))) {
+				_statistics._queued_packet_count -= _held_packets.size();
+				_statistics._queued_byte_count -= _held_packets.get_byte_count();
+				auto on_sent = [this](enet_uint8 channel_id, size_t byte_count) {
+					_statistics.get_channel(channel_id).record_sent(byte_count);
+				};
+				if (_held_packets.flush(peer, on_sent) > 0) {
+					trace("enet_peer_send failed");
+				}
+			}
 
-					if (qp._packet->referenceCount == 0) {
-						enet_packet_destroy(qp._packet);
-					}
+			client_queued_packet qp;
+			while (_packet_queue.try_pop(qp)) {
+				if (is_congested && qp._coalesce_key != 0) {
+					hold_packet_in_thread(qp);
+					continue;
+				}
+
+				_statistics._packet_queue_latency.record(std::chrono::steady_clock::now() - qp._queued_time);
+
+				if (enet_peer_send(peer, qp._channel_id, qp._packet) != 0) {
+					trace("enet_peer_send failed");
+				}
+				else {
+					_statistics.get_channel(qp._channel_id).record_sent(qp._packet->dataLength);
 				}
+
+				--_statistics._queued_packet_count;
+				_statistics._queued_byte_count -= qp._packet->dataLength;
+
+				if (qp._packet->referenceCount == 0) {
+					enet_packet_destroy(qp._packet);
+				}
+			}
+		}
+
+		void publish_peer_statistics_in_thread(const ENetPeer* peer) {
+			_statistics._round_trip_time_in_ms = peer->roundTripTime;
+			_statistics._round_trip_time_variance_in_ms = peer->roundTripTimeVariance;
+			_statistics._packet_loss = peer->packetLoss;
+			_statistics._packet_loss_variance = peer->packetLossVariance;
+			_statistics._packet_throttle = peer->packetThrottle;
+			_statistics._packets_sent = peer->packetsSent;
+			_statistics._packets_lost = peer->packetsLost;
+			_statistics._reliable_data_in_transit = peer->reliableDataInTransit;
+			_statistics._mtu = peer->mtu;
+		}
+
+		void hold_packet_in_thread(const client_queued_packet& qp) {
+			const size_t byte_count = _held_packets.get_byte_count() + qp._packet->dataLength;
+
+			//the buffer takes a reference of its own, the packet lives until it is flushed, replaced or cleared.
+			if (_held_packets.hold(qp._channel_id, qp._packet, qp._coalesce_key)) {
+				++_statistics._coalesced_packet_count;
+				--_statistics._queued_packet_count;
+				_statistics._queued_byte_count -= byte_count - _held_packets.get_byte_count();
 			}
 		}
 
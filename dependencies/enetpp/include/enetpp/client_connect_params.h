@@ -6,6 +6,13 @@
 
 namespace enetpp {
 
+	//what client::send_packet does when the outbound packet queue is full. state packets (non zero coalesce_key) are
+	//always dropped straight away whatever the policy, a newer update for the same key replaces them anyway.
+	enum packet_queue_overflow {
+		PACKET_QUEUE_OVERFLOW_WAIT, //yield until the worker thread frees a slot, for at most the overflow timeout.
+		PACKET_QUEUE_OVERFLOW_DROP, //destroy the new packet and count it in client_statistics.
+	};
+
 	class client_connect_params {
 	public:
 		size_t _channel_count;
@@ -14,6 +21,10 @@ namespace enetpp {
 		std::string _server_host_name;
 		enet_uint16 _server_port;
 		std::chrono::milliseconds _timeout;
+		std::chrono::milliseconds _service_timeout;
+		size_t _packet_queue_capacity;
+		packet_queue_overflow _packet_queue_overflow;
+		std::chrono::milliseconds _packet_queue_overflow_timeout;
 
 	public:
 		client_connect_params() 
@@ -22,7 +33,11 @@ namespace enetpp {
 			, _outgoing_bandwidth(0)
 			, _server_host_name()
 			, _server_port(0)
-			, _timeout(0) {
+			, _timeout(0)
+			, _service_timeout(10)
+			, _packet_queue_capacity(1024)
+			, _packet_queue_overflow(PACKET_QUEUE_OVERFLOW_WAIT)
+			, _packet_queue_overflow_timeout(5) {
 		}
 
 		client_connect_params& set_channel_count(size_t channel_count) {
@@ -51,6 +66,31 @@ namespace enetpp {
 			return *this;
 		}
 
+		//longest the worker thread sleeps when there is no traffic. sends and incoming datagrams wake it immediately,
+		//this only bounds how late enet's own resend / ping timers can run.
+		client_connect_params& set_service_timeout(std::chrono::milliseconds timeout) {
+			_service_timeout = timeout;
+			return *this;
+		}
+
+		client_connect_params& set_packet_queue_capacity(size_t capacity) {
+			_packet_queue_capacity = capacity;
+			return *this;
+		}
+
+		client_connect_params& set_packet_queue_overflow(packet_queue_overflow overflow) {
+			_packet_queue_overflow = overflow;
+			return *this;
+		}
+
+		//longest send_packet waits for a free slot with PACKET_QUEUE_OVERFLOW_WAIT before dropping the packet. callers
+		//usually send while holding their own locks, so this also bounds how long those are held when the worker
+		//thread stalls. the default is half the service timeout.
+		client_connect_params& set_packet_queue_overflow_timeout(std::chrono::milliseconds timeout) {
+			_packet_queue_overflow_timeout = timeout;
+			return *this;
+		}
+
 		ENetAddress make_server_address() const {
 			ENetAddress address;
 			enet_address_set_host(&address, _server_host_name.c_str());
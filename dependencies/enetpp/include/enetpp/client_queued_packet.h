@@ -1,6 +1,8 @@
 #ifndef ENETPP_CLIENT_QUEUED_PACKET_H_
 #define ENETPP_CLIENT_QUEUED_PACKET_H_
 
+#include <chrono>
+#include <stdint.h>
 #include "enet/enet.h"
 
 namespace enetpp {
@@ -9,16 +11,20 @@ namespace enetpp {
 	public:
 		enet_uint8 _channel_id;
 		ENetPacket* _packet;
+		uint64_t _coalesce_key; //0 for packets that must all be delivered, see client::send_packet
+		std::chrono::steady_clock::time_point _queued_time;
 
 	public:
 		client_queued_packet()
 			: _channel_id(0)
-			, _packet(nullptr) {
+			, _packet(nullptr)
+			, _coalesce_key(0) {
 		}
 
-		client_queued_packet(enet_uint8 channel_id, ENetPacket* packet)
+		client_queued_packet(enet_uint8 channel_id, ENetPacket* packet, uint64_t coalesce_key)
 			: _channel_id(channel_id)
-			, _packet(packet) {
+			, _packet(packet)
+			, _coalesce_key(coalesce_key) {
 		}
 	};
 
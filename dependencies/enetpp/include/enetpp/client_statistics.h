@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include "channel_statistics.h"
+#include "latency_histogram.h"
 
 namespace enetpp {
 
@@ -8,11 +10,49 @@ namespace enetpp {
 	public:
 		std::atomic<int> _round_trip_time_in_ms;
 		std::atomic<int> _round_trip_time_variance_in_ms;
+		std::atomic<unsigned int> _dropped_packet_count; //packets refused by a full queue, see packet_queue_overflow
+		std::atomic<unsigned int> _coalesced_packet_count; //state packets replaced by a newer one before they were sent
+		std::atomic<size_t> _queued_packet_count; //sent but not handed to enet yet, includes held state packets
+		std::atomic<size_t> _queued_byte_count;
+		std::atomic<size_t> _event_queue_depth; //received by the worker thread but not consumed yet
+
+		//copied from the peer by the worker thread every service loop.
+		std::atomic<unsigned int> _packet_loss; //enet's smoothed reliable packet loss, ENET_PEER_PACKET_LOSS_SCALE is 100%
+		std::atomic<unsigned int> _packet_loss_variance;
+		std::atomic<unsigned int> _packet_throttle; //ENET_PEER_PACKET_THROTTLE_SCALE is unthrottled
+		std::atomic<unsigned int> _packets_sent; //reliable packets sent by enet, resends included
+		std::atomic<unsigned int> _packets_lost; //reliable packets enet had to resend
+		std::atomic<unsigned int> _reliable_data_in_transit;
+		std::atomic<unsigned int> _mtu; //negotiated with the server while connecting, 0 until then
+
+		channel_statistics _channels[channel_statistics::tracked_channel_count];
+		latency_histogram _packet_queue_latency; //send_packet until handed to enet
+		latency_histogram _event_queue_latency; //received by the worker thread until consumed
 
 	public:
 		client_statistics()
 			: _round_trip_time_in_ms(0)
-			, _round_trip_time_variance_in_ms(0) {
+			, _round_trip_time_variance_in_ms(0)
+			, _dropped_packet_count(0)
+			, _coalesced_packet_count(0)
+			, _queued_packet_count(0)
+			, _queued_byte_count(0)
+			, _event_queue_depth(0)
+			, _packet_loss(0)
+			, _packet_loss_variance(0)
+			, _packet_throttle(0)
+			, _packets_sent(0)
+			, _packets_lost(0)
+			, _reliable_data_in_transit(0)
+			, _mtu(0) {
+		}
+
+		channel_statistics& get_channel(enet_uint8 channel_id) {
+			return _channels[channel_statistics::get_index(channel_id)];
+		}
+
+		const channel_statistics& get_channel(enet_uint8 channel_id) const {
+			return _channels[channel_statistics::get_index(channel_id)];
 		}
 	};
 
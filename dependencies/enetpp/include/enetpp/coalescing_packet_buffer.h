@@ -0,0 +1,145 @@
+#ifndef ENETPP_COALESCING_PACKET_BUFFER_H_
+#define ENETPP_COALESCING_PACKET_BUFFER_H_
+
+#include <chrono>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include <assert.h>
+#include "enet/enet.h"
+
+namespace enetpp {
+
+	//below this enet drops more than half of the unreliable packets handed to it, see enet_protocol_check_outgoing_commands.
+	constexpr enet_uint32 congested_packet_throttle = ENET_PEER_PACKET_THROTTLE_SCALE / 2;
+
+	//true when the peer already has a full (throttled) window of reliable data in flight, i.e. anything handed to
+	//enet_peer_send now would just sit in enet's outgoing queue, or when enet has throttled the peer far enough that
+	//most unreliable sends would be dropped at random. state packets usually go out unreliable, and those never count
+	//towards reliableDataInTransit.
+	inline bool is_peer_congested(const ENetPeer* peer) {
+		const enet_uint32 window_size = (peer->windowSize * peer->packetThrottle) / ENET_PEER_PACKET_THROTTLE_SCALE;
+		return peer->reliableDataInTransit >= window_size || peer->packetThrottle < congested_packet_throttle;
+	}
+
+	//per peer holding area for state packets (coalesce key != 0) that arrive while the peer is congested. only the
+	//newest packet per key is kept, older ones are destroyed unsent. worker thread only.
+	//
+	//a throttled peer can stay congested for a long time, so held packets also go out once the oldest has waited
+	//max_hold_time. state then still reaches the peer, just at most once per key per max_hold_time.
+	//
+	//held packets carry a reference of their own so a packet shared by several peers outlives whichever of them
+	//sends or replaces it first.
+	class coalescing_packet_buffer {
+	private:
+		class held_packet {
+		public:
+			enet_uint8 _channel_id;
+			ENetPacket* _packet;
+			uint64_t _coalesce_key;
+		};
+
+		std::vector<held_packet> _packets;
+		std::unordered_map<uint64_t, size_t> _packet_indices;
+		size_t _byte_count;
+		std::chrono::steady_clock::time_point _first_hold_time; //when the oldest held packet was held
+
+	public:
+		static constexpr std::chrono::milliseconds max_hold_time{ 100 };
+
+		coalescing_packet_buffer()
+			: _byte_count(0) {
+		}
+
+		~coalescing_packet_buffer() {
+			assert(_packets.empty());
+		}
+
+		bool empty() const {
+			return _packets.empty();
+		}
+
+		size_t size() const {
+			return _packets.size();
+		}
+
+		size_t get_byte_count() const {
+			return _byte_count;
+		}
+
+		//true once something has been held for max_hold_time, flush even if the peer is still congested.
+		bool is_overdue(std::chrono::steady_clock::time_point now) const {
+			return !_packets.empty() && (now - _first_hold_time) >= max_hold_time;
+		}
+
+		//returns true if an older packet with the same key was replaced.
+		bool hold(enet_uint8 channel_id, ENetPacket* packet, uint64_t coalesce_key) {
+			assert(coalesce_key != 0);
+			++packet->referenceCount;
+			_byte_count += packet->dataLength;
+
+			if (_packets.empty()) {
+				_first_hold_time = std::chrono::steady_clock::now();
+			}
+
+			auto iter = _packet_indices.find(coalesce_key);
+			if (iter == _packet_indices.end()) {
+				_packet_indices.emplace(coalesce_key, _packets.size());
+				_packets.push_back({ channel_id, packet, coalesce_key });
+				return false;
+			}
+
+			//keep the old position so held packets with different keys go out in the order they first arrived.
+			auto& hp = _packets[iter->second];
+			_byte_count -= hp._packet->dataLength;
+			release(hp._packet);
+
+			hp._channel_id = channel_id;
+			hp._packet = packet;
+			return true;
+		}
+
+		//hands every held packet to enet, on_sent(channel_id, data_length) is called for each one enet accepted. returns
+		//the number of sends that failed.
+		template<typename OnSent>
+		size_t flush(ENetPeer* peer, OnSent&& on_sent) {
+			size_t failed_count = 0;
+			for (auto& hp : _packets) {
+				if (enet_peer_send(peer, hp._channel_id, hp._packet) != 0) {
+					++failed_count;
+				}
+				else {
+					on_sent(hp._channel_id, hp._packet->dataLength);
+				}
+				release(hp._packet);
+			}
+
+			_packets.clear();
+			_packet_indices.clear();
+			_byte_count = 0;
+			return failed_count;
+		}
+
+		//destroys every held packet unsent, e.g. the peer disconnected.
+		void clear() {
+			for (auto& hp : _packets) {
+				release(hp._packet);
+			}
+
+			_packets.clear();
+			_packet_indices.clear();
+			_byte_count = 0;
+		}
+
+	private:
+		static void release(ENetPacket* packet) {
+			assert(packet->referenceCount > 0);
+			if (--packet->referenceCount == 0) {
+				enet_packet_destroy(packet);
+			}
+		}
+	};
+
+}
+
+#endif
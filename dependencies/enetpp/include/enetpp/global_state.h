@@ -3,6 +3,7 @@
 
 #include <assert.h>
 #include "enet/enet.h"
+#include "pool_allocator.h"
 
 namespace enetpp {
 
@@ -22,12 +23,20 @@ namespace enetpp {
 			return _is_initialized;
 		}
 
+		//every enet allocation goes through pool_allocator from here on. the callbacks have to be installed before
+		//enet allocates anything, pool blocks can't be handed to the crt's free.
 		void initialize() {
 			assert(!_is_initialized);
-			enet_initialize();
+			ENetCallbacks callbacks = pool_allocator::make_enet_callbacks();
+			enet_initialize_with_callbacks(ENET_VERSION, &callbacks);
 			_is_initialized = true;
 		}
 
+		//hit / miss counters per size class, for diagnostics.
+		const pool_allocator& get_allocator() const {
+			return pool_allocator::get();
+		}
+
 		void deinitialize() {
 			enet_deinitialize();
 			_is_initialized = false;
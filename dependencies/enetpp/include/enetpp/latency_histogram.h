@@ -0,0 +1,67 @@
+#ifndef ENETPP_LATENCY_HISTOGRAM_H_
+#define ENETPP_LATENCY_HISTOGRAM_H_
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <assert.h>
+
+namespace enetpp {
+
+	//log2 buckets of microseconds. bucket 0 is everything under 2us, bucket i covers [2^i, 2^(i+1)) us and the last
+	//bucket takes everything from ~0.5s up. written by one thread, read by any.
+	class latency_histogram {
+	public:
+		static constexpr size_t bucket_count = 20;
+
+	private:
+		std::atomic<uint32_t> _buckets[bucket_count];
+		std::atomic<uint64_t> _sample_count;
+		std::atomic<uint64_t> _total_in_us;
+
+	public:
+		latency_histogram()
+			: _sample_count(0)
+			, _total_in_us(0) {
+			for (auto& b : _buckets) {
+				b = 0;
+			}
+		}
+
+		void record(std::chrono::steady_clock::duration latency) {
+			const auto us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+			const uint64_t value = (us > 0) ? static_cast<uint64_t>(us) : 0;
+
+			size_t bucket = 0;
+			while (bucket + 1 < bucket_count && (value >> (bucket + 1)) != 0) {
+				++bucket;
+			}
+
+			_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+			_sample_count.fetch_add(1, std::memory_order_relaxed);
+			_total_in_us.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		uint32_t get_bucket(size_t bucket) const {
+			assert(bucket < bucket_count);
+			return _buckets[bucket].load(std::memory_order_relaxed);
+		}
+
+		//lower bound of the bucket in microseconds.
+		static uint64_t get_bucket_floor_in_us(size_t bucket) {
+			return (bucket == 0) ? 0 : (uint64_t(1) << bucket);
+		}
+
+		uint64_t get_sample_count() const {
+			return _sample_count.load(std::memory_order_relaxed);
+		}
+
+		uint64_t get_mean_in_us() const {
+			const auto count = get_sample_count();
+			return (count > 0) ? (_total_in_us.load(std::memory_order_relaxed) / count) : 0;
+		}
+	};
+
+}
+
+#endif
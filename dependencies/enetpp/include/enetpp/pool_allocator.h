@@ -0,0 +1,173 @@
+#ifndef ENETPP_POOL_ALLOCATOR_H_
+#define ENETPP_POOL_ALLOCATOR_H_
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "enet/enet.h"
+
+namespace enetpp {
+
+	//size class allocator installed as enet's malloc / free. packets, outgoing / incoming commands and acknowledgements
+	//are created and destroyed hundreds of times a second per peer, and nearly all of them fit a handful of small
+	//sizes. freed blocks go onto a per class free list instead of back to the crt heap. anything bigger than the
+	//largest class (peer arrays, channel arrays, huge packets) goes straight to malloc.
+	//
+	//blocks are touched from the worker threads and from whoever creates / destroys packets, so each class has its
+	//own lock. the hot path is a pointer pop under an uncontended lock.
+	class pool_allocator {
+	public:
+		static constexpr size_t size_class_count = 8;
+		static constexpr size_t smallest_block_size = 32; //classes are 32, 64, ... 4096 bytes
+		static constexpr size_t max_free_blocks_per_class = 4096; //anything freed beyond this goes back to the crt heap
+
+		class size_class_statistics {
+		public:
+			size_t _block_size;
+			std::atomic<uint64_t> _hit_count; //served from the free list
+			std::atomic<uint64_t> _miss_count; //had to malloc
+			std::atomic<uint64_t> _free_block_count; //currently parked on the free list
+
+		public:
+			size_class_statistics()
+				: _block_size(0)
+				, _hit_count(0)
+				, _miss_count(0)
+				, _free_block_count(0) {
+			}
+		};
+
+	private:
+		//keeps the returned pointer 16 byte aligned like malloc's.
+		static constexpr size_t header_size = 16;
+		static constexpr size_t large_block_class = size_class_count;
+
+		struct free_block {
+			free_block* _next;
+		};
+
+		struct size_class {
+			std::mutex _mutex;
+			free_block* _free_list = nullptr;
+			size_class_statistics _statistics;
+		};
+
+		size_class _size_classes[size_class_count];
+		std::atomic<uint64_t> _large_allocation_count;
+
+	public:
+		static pool_allocator& get() {
+			//intentionally leaked. enet can free blocks during static destruction and the pool has to still be there.
+			static pool_allocator* g = new pool_allocator();
+			return *g;
+		}
+
+		static ENetCallbacks make_enet_callbacks() {
+			ENetCallbacks callbacks;
+			callbacks.malloc = &pool_allocator::enet_malloc;
+			callbacks.free = &pool_allocator::enet_free;
+			callbacks.no_memory = &pool_allocator::enet_no_memory;
+			return callbacks;
+		}
+
+		void* allocate(size_t size) {
+			const size_t class_index = find_size_class(size);
+
+			if (class_index == large_block_class) {
+				++_large_allocation_count;
+				return make_block(malloc(header_size + size), large_block_class);
+			}
+
+			auto& sc = _size_classes[class_index];
+			{
+				std::lock_guard<std::mutex> lock(sc._mutex);
+				if (sc._free_list != nullptr) {
+					auto block = sc._free_list;
+					sc._free_list = block->_next;
+					--sc._statistics._free_block_count;
+					++sc._statistics._hit_count;
+					return make_block(block, class_index);
+				}
+			}
+
+			++sc._statistics._miss_count;
+			return make_block(malloc(header_size + sc._statistics._block_size), class_index);
+		}
+
+		void deallocate(void* memory) {
+			if (memory == nullptr) {
+				return;
+			}
+
+			auto block = static_cast<uint8_t*>(memory) - header_size;
+			const size_t class_index = *reinterpret_cast<size_t*>(block);
+			assert(class_index <= large_block_class);
+
+			if (class_index != large_block_class) {
+				auto& sc = _size_classes[class_index];
+				std::lock_guard<std::mutex> lock(sc._mutex);
+				if (sc._statistics._free_block_count < max_free_blocks_per_class) {
+					auto fb = reinterpret_cast<free_block*>(block);
+					fb->_next = sc._free_list;
+					sc._free_list = fb;
+					++sc._statistics._free_block_count;
+					return;
+				}
+			}
+
+			free(block);
+		}
+
+		const size_class_statistics& get_size_class_statistics(size_t class_index) const {
+			assert(class_index < size_class_count);
+			return _size_classes[class_index]._statistics;
+		}
+
+		uint64_t get_large_allocation_count() const {
+			return _large_allocation_count;
+		}
+
+	private:
+		pool_allocator()
+			: _large_allocation_count(0) {
+			for (size_t i = 0; i < size_class_count; ++i) {
+				_size_classes[i]._statistics._block_size = smallest_block_size << i;
+			}
+		}
+
+		size_t find_size_class(size_t size) const {
+			for (size_t i = 0; i < size_class_count; ++i) {
+				if (size <= _size_classes[i]._statistics._block_size) {
+					return i;
+				}
+			}
+			return large_block_class;
+		}
+
+		static void* make_block(void* block, size_t class_index) {
+			if (block == nullptr) {
+				return nullptr;
+			}
+
+			*static_cast<size_t*>(block) = class_index;
+			return static_cast<uint8_t*>(block) + header_size;
+		}
+
+		static void* ENET_CALLBACK enet_malloc(size_t size) {
+			return get().allocate(size);
+		}
+
+		static void ENET_CALLBACK enet_free(void* memory) {
+			get().deallocate(memory);
+		}
+
+		static void ENET_CALLBACK enet_no_memory() {
+			abort();
+		}
+	};
+
+}
+
+#endif
@@ -6,14 +6,19 @@
 #include <thread>
 #include <unordered_map>
 #include <queue>
+#include <vector>
 #include <mutex>
 #include <assert.h>
+#include "server_client_slot_map.h"
 #include "server_listen_params.h"
 #include "server_queued_packet.h"
+#include "server_statistics.h"
+#include "coalescing_packet_buffer.h"
 #include "server_event.h"
 #include "global_state.h"
 #include "set_current_thread_name.h"
 #include "trace_handler.h"
+#include "wakeup_socket.h"
 
 namespace enetpp {
 
@@ -22,29 +27,55 @@ namespace enetpp {
 	public:
 		using event_type = server_event<ClientT>;
 		using listen_params_type = server_listen_params<ClientT>;
-		using client_ptr_vector = std::vector<ClientT*>;
+		using client_slot_map = server_client_slot_map<ClientT>;
+		using client_slot = typename client_slot_map::slot;
+
+		static constexpr size_t initial_event_queue_capacity = 256;
+
+		//clients that disconnected on the worker thread keep their slot until the disconnect event is consumed, so
+		//there are more slots than peers to let new connections in meanwhile.
+		static constexpr size_t client_slots_per_peer = 2;
 
 	private:
 		trace_handler _trace_handler;
 
 		bool _should_exit_thread;
 		std::unique_ptr<std::thread> _thread;
+		wakeup_socket _wakeup;
+
+		//owns every client. see server_client_slot_map for which thread touches what.
+		client_slot_map _client_slots;
+
+		//consumer thread only. client id to slot index for the id based send / lookup functions.
+		std::unordered_map<unsigned int, unsigned int> _client_slot_indices;
 
-		//mapping of uid to peer so that sending packets to specific peers is safe.
-		std::unordered_map<unsigned int, ENetPeer*> _thread_peer_map;
+		//worker thread only, indexed by slot. queued packets carry a handle so sending is an array index plus a
+		//generation check instead of a map lookup.
+		class thread_slot {
+		public:
+			ENetPeer* _peer = nullptr;
+			unsigned int _generation = 0;
+			coalescing_packet_buffer _held_packets; //state packets held back while the peer is congested
+		};
+		std::vector<thread_slot> _thread_slots;
 
-		client_ptr_vector _connected_clients;
+		server_statistics _statistics;
+		std::unique_ptr<server_peer_statistics[]> _peer_statistics; //indexed by slot
 
 		std::queue<server_queued_packet> _packet_queue;
 		std::mutex _packet_queue_mutex;
 
-		std::queue<event_type> _event_queue;
-		std::queue<event_type> _event_queue_copy; //member variable instead of stack variable to prevent mallocs?
+		//double buffered. the worker thread appends to _event_queue, consume_events swaps it with the (empty)
+		//_event_queue_copy under the lock. both keep their capacity so steady state delivery never allocates.
+		std::vector<event_type> _event_queue;
+		std::vector<event_type> _event_queue_copy;
 		std::mutex _event_queue_mutex;
 
 	public:
 		server() 
 			: _should_exit_thread(false) {
+			_event_queue.reserve(initial_event_queue_capacity);
+			_event_queue_copy.reserve(initial_event_queue_capacity);
 		}
 
 		~server() {
@@ -54,7 +85,7 @@ namespace enetpp {
 			assert(_packet_queue.empty());
 			assert(_event_queue.empty());
 			assert(_event_queue_copy.empty());
-			assert(_connected_clients.empty());
+			assert(_client_slots.get_connected_count() == 0);
 		}
 
 		void set_trace_handler(trace_handler handler) {
@@ -76,6 +107,14 @@ namespace enetpp {
 
 			trace("listening on port " + std::to_string(params._listen_port));
 
+			_client_slots.reset(params._max_client_count * client_slots_per_peer);
+			_thread_slots.assign(_client_slots.capacity(), thread_slot());
+			_peer_statistics = std::make_unique<server_peer_statistics[]>(_client_slots.capacity());
+
+			if (!_wakeup.open()) {
+				trace("failed to open wakeup socket, sends will wait for the service timeout");
+			}
+
 			_should_exit_thread = false;
 			_thread = std::make_unique<std::thread>(&server::run_in_thread, this, params);
 		}
@@ -83,91 +122,197 @@ namespace enetpp {
 		void stop_listening() {
 			if (_thread != nullptr) {
 				_should_exit_thread = true;
+				_wakeup.signal();
 				_thread->join();
 				_thread.release();
 			}
 
+			_wakeup.close();
 			destroy_all_queued_packets();
 			destroy_all_queued_events();
-			delete_all_connected_clients();
+			_client_slots.clear();
+			_client_slot_indices.clear();
 		}
 
-		void send_packet_to(unsigned int client_id, enet_uint8 channel_id, const enet_uint8* data, size_t data_size, enet_uint32 flags) {
+		//coalesce_key marks state updates where only the newest matters, e.g. (message type, object id). while a
+		//peer is congested only the newest packet per non zero key is kept for it and older ones are dropped unsent.
+		//held packets go out once the congestion clears, possibly after packets queued later without a key.
+		void send_packet_to(unsigned int client_id, enet_uint8 channel_id, const enet_uint8* data, size_t data_size, enet_uint32 flags, uint64_t coalesce_key = 0) {
 			assert(is_listening());
 			if (_thread != nullptr) {
-				std::lock_guard<std::mutex> lock(_packet_queue_mutex);
+				auto slot = find_client_slot(client_id);
+				if (slot == nullptr) {
+					return;
+				}
+
 				auto packet = enet_packet_create(data, data_size, flags);
-				_packet_queue.emplace(channel_id, packet, client_id);
+				enqueue_packet(server_queued_packet(channel_id, packet, _client_slots.get_handle(*slot), coalesce_key));
+			}
+			_wakeup.signal();
+		}
+
+		//takes ownership of an already created packet, e.g. one created with ENET_PACKET_FLAG_NO_ALLOCATE over a buffer
+		//the caller keeps alive until the packet's freeCallback runs. avoids the copy made by the overload above.
+		void send_packet_to(unsigned int client_id, enet_uint8 channel_id, ENetPacket* packet, uint64_t coalesce_key = 0) {
+			assert(is_listening());
+			assert(packet != nullptr);
+			auto slot = find_client_slot(client_id);
+			if (_thread != nullptr && slot != nullptr) {
+				enqueue_packet(server_queued_packet(channel_id, packet, _client_slots.get_handle(*slot), coalesce_key));
+			}
+			else {
+				enet_packet_destroy(packet);
 			}
+			_wakeup.signal();
 		}
 
-		void send_packet_to_all_if(enet_uint8 channel_id, const enet_uint8* data, size_t data_size, enet_uint32 flags, std::function<bool(const ClientT& client)> predicate) {
+		//the predicate is evaluated on the calling thread and the matching clients are queued as a single entry sharing
+		//one packet. the entry always names its clients, even when every client matched: a broadcast would also reach
+		//peers the worker has connected but whose connect event hasn't been consumed, which the predicate never saw.
+		void send_packet_to_all_if(enet_uint8 channel_id, const enet_uint8* data, size_t data_size, enet_uint32 flags, std::function<bool(const ClientT& client)> predicate, uint64_t coalesce_key = 0) {
 			assert(is_listening());
 			if (_thread != nullptr) {
-				std::lock_guard<std::mutex> lock(_packet_queue_mutex);
-				auto packet = enet_packet_create(data, data_size, flags);
-				for (auto c : _connected_clients) {
-					if (predicate(*c)) {
-						_packet_queue.emplace(channel_id, packet, c->get_id());
+				std::vector<server_client_handle> clients;
+				clients.reserve(_client_slots.get_connected_count());
+				_client_slots.for_each_connected([&](client_slot& s) {
+					if (predicate(*s._client)) {
+						clients.push_back(_client_slots.get_handle(s));
 					}
+				});
+
+				if (clients.empty()) {
+					return;
 				}
+
+				auto packet = enet_packet_create(data, data_size, flags);
+				enqueue_packet(server_queued_packet(channel_id, packet, std::move(clients), coalesce_key));
+			}
+			_wakeup.signal();
+		}
+
+		//sent to every peer connected on the worker thread at the time the queue is drained.
+		void send_packet_to_all(enet_uint8 channel_id, const enet_uint8* data, size_t data_size, enet_uint32 flags, uint64_t coalesce_key = 0) {
+			assert(is_listening());
+			if (_thread != nullptr) {
+				auto packet = enet_packet_create(data, data_size, flags);
+				enqueue_packet(server_queued_packet(channel_id, packet, SERVER_QUEUED_PACKET_TARGET_ALL, coalesce_key));
 			}
+			_wakeup.signal();
 		}
 
+		//takes ownership of an already created packet, see send_packet_to.
+		void send_packet_to_all(enet_uint8 channel_id, ENetPacket* packet, uint64_t coalesce_key = 0) {
+			assert(is_listening());
+			assert(packet != nullptr);
+			if (_thread != nullptr) {
+				enqueue_packet(server_queued_packet(channel_id, packet, SERVER_QUEUED_PACKET_TARGET_ALL, coalesce_key));
+			}
+			else {
+				enet_packet_destroy(packet);
+			}
+			_wakeup.signal();
+		}
+
+		//callbacks are invoked directly, so lambdas get inlined and nothing is allocated per call.
+		template<typename OnClientConnected, typename OnClientDisconnected, typename OnClientDataReceived>
+		void consume_events(
+			OnClientConnected&& on_client_connected,
+			OnClientDisconnected&& on_client_disconnected,
+			OnClientDataReceived&& on_client_data_received) {
+			dispatch_events(on_client_connected, on_client_disconnected, on_client_data_received);
+		}
+
+		//type erased overload kept for existing callers.
 		void consume_events(
 			std::function<void(ClientT& client)> on_client_connected,
 			std::function<void(unsigned int client_id)> on_client_disconnected,
 			std::function<void(ClientT& client, const enet_uint8* data, size_t data_size)> on_client_data_received) {
+			dispatch_events(on_client_connected, on_client_disconnected, on_client_data_received);
+		}
+
+		size_t get_connected_client_count() const {
+			return _client_slots.get_connected_count();
+		}
+
+		//visits connected clients in a stable order, a client keeps its position for as long as it stays connected.
+		template<typename F>
+		void for_each_connected_client(F&& f) {
+			_client_slots.for_each_connected([&](client_slot& s) {
+				f(*s._client);
+			});
+		}
+
+		const server_statistics& get_statistics() const {
+			return _statistics;
+		}
+
+		//nullptr if the client isn't connected.
+		const server_peer_statistics* get_client_statistics(unsigned int client_id) {
+			auto slot = find_client_slot(client_id);
+			return (slot != nullptr) ? &_peer_statistics[slot->_index] : nullptr;
+		}
 
-			if (!_event_queue.empty()) {
+		ClientT* find_client(unsigned int client_id) {
+			auto slot = find_client_slot(client_id);
+			return (slot != nullptr) ? &*slot->_client : nullptr;
+		}
 
-				{
-					std::lock_guard<std::mutex> lock(_event_queue_mutex);
-					assert(_event_queue_copy.empty());
-					_event_queue_copy = _event_queue;
-					_event_queue = {};
+	private:
+		template<typename OnClientConnected, typename OnClientDisconnected, typename OnClientDataReceived>
+		void dispatch_events(
+			OnClientConnected& on_client_connected,
+			OnClientDisconnected& on_client_disconnected,
+			OnClientDataReceived& on_client_data_received) {
+			{
+				std::lock_guard<std::mutex> lock(_event_queue_mutex);
+				if (_event_queue.empty()) {
+					return;
 				}
 
-				while (!_event_queue_copy.empty()) {
-					auto& e = _event_queue_copy.front();
-					switch (e._event_type) {
-						case ENET_EVENT_TYPE_CONNECT: {
-							_connected_clients.push_back(e._client);
-							on_client_connected(*e._client);
-							break;
-						}
+				assert(_event_queue_copy.empty());
+				_event_queue.swap(_event_queue_copy);
+			}
 
-						case ENET_EVENT_TYPE_DISCONNECT: {
-							auto iter = std::find(_connected_clients.begin(), _connected_clients.end(), e._client);
-							assert(iter != _connected_clients.end());
-							_connected_clients.erase(iter);
-							unsigned int client_id = e._client->get_id();
-							delete e._client;
-							on_client_disconnected(client_id);
-							break;
-						}
+			_statistics._event_queue_depth -= _event_queue_copy.size();
+			const auto now = std::chrono::steady_clock::now();
 
-						case ENET_EVENT_TYPE_RECEIVE: {
-							on_client_data_received(*e._client, e._packet->data, e._packet->dataLength);
-							enet_packet_destroy(e._packet);
-							break;
-						}
+			for (auto& e : _event_queue_copy) {
+				_statistics._event_queue_latency.record(now - e._queued_time);
 
-						case ENET_EVENT_TYPE_NONE:
-						default:
-							assert(false);
-							break;
+				switch (e._event_type) {
+					case ENET_EVENT_TYPE_CONNECT: {
+						auto& slot = _client_slots.get_slot(e._slot_index);
+						_client_slots.set_connected(slot);
+						_client_slot_indices[e._client->get_id()] = e._slot_index;
+						on_client_connected(*e._client);
+						break;
+					}
+
+					case ENET_EVENT_TYPE_DISCONNECT: {
+						auto& slot = _client_slots.get_slot(e._slot_index);
+						unsigned int client_id = e._client->get_id();
+						_client_slot_indices.erase(client_id);
+						_client_slots.release(slot);
+						on_client_disconnected(client_id);
+						break;
+					}
+
+					case ENET_EVENT_TYPE_RECEIVE: {
+						on_client_data_received(*e._client, e._packet->data, e._packet->dataLength);
+						enet_packet_destroy(e._packet);
+						break;
 					}
-					_event_queue_copy.pop();
+
+					case ENET_EVENT_TYPE_NONE:
+					default:
+						assert(false);
+						break;
 				}
 			}
-		}
 
-		const client_ptr_vector& get_connected_clients() const {
-			return _connected_clients;
+			_event_queue_copy.clear();
 		}
 
-	private:
 		void run_in_thread(const listen_params_type& params) {
 			set_current_thread_name("enetpp::server");
 
@@ -182,6 +327,8 @@ namespace enetpp {
 				trace("enet_host_create failed");
 			}
 
+			enet_uint32 service_timeout = static_cast<enet_uint32>(params._service_timeout.count());
+
 			while (host != nullptr) {
 
 				if (_should_exit_thread) {
@@ -191,44 +338,169 @@ namespace enetpp {
 				}
 
 				if (host != nullptr) {
-					send_queued_packets_in_thread();
+					//reset before draining so a send racing with the drain still wakes the next wait.
+					_wakeup.reset();
+					send_queued_packets_in_thread(host);
 					capture_events_in_thread(params, host);
+					publish_peer_statistics_in_thread();
+
+					//block until there is something to do instead of polling.
+					_wakeup.wait(host, service_timeout);
 				}
+			}
+		}
 
-				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		client_slot* find_client_slot(unsigned int client_id) {
+			auto iter = _client_slot_indices.find(client_id);
+			if (iter == _client_slot_indices.end()) {
+				return nullptr;
 			}
+			return &_client_slots.get_slot(iter->second);
 		}
 
 		void disconnect_all_peers_in_thread() {
-			for (auto iter : _thread_peer_map) {
-				enet_peer_disconnect_now(iter.second, 0);
-				iter.second->data = nullptr;
+			for (auto& ts : _thread_slots) {
+				ts._held_packets.clear();
+				if (ts._peer != nullptr) {
+					enet_peer_disconnect_now(ts._peer, 0);
+					ts._peer->data = nullptr;
+					ts._peer = nullptr;
+				}
 			}
-			_thread_peer_map.clear();
 		}
 
-		void send_queued_packets_in_thread() {
+		void enqueue_packet(server_queued_packet&& qp) {
+			std::lock_guard<std::mutex> lock(_packet_queue_mutex);
+			qp._queued_time = std::chrono::steady_clock::now();
+			++_statistics._queued_packet_count;
+			_statistics._queued_byte_count += qp._packet->dataLength;
+			_packet_queue.push(std::move(qp));
+		}
+
+		void send_queued_packets_in_thread(ENetHost* host) {
+			//peers whose congestion cleared, or whose held packets waited too long, get them before anything newer.
+			const auto now = std::chrono::steady_clock::now();
+			for (auto& ts : _thread_slots) {
+				if (ts._peer != nullptr && !ts._held_packets.empty() && (!is_peer_congested(ts._peer) || ts._held_packets.is_overdue(now))) {
+					auto& ps = get_peer_statistics_in_thread(ts);
+					auto on_sent = [&ps](enet_uint8 channel_id, size_t byte_count) {
+						ps.get_channel(channel_id).record_sent(byte_count);
+					};
+					if (ts._held_packets.flush(ts._peer, on_sent) > 0) {
+						trace("enet_peer_send failed");
+					}
+				}
+			}
+
 			if (!_packet_queue.empty()) {
 				std::lock_guard<std::mutex> lock(_packet_queue_mutex);
 				while (!_packet_queue.empty()) {
-					auto qp = _packet_queue.front();
+					auto qp = std::move(_packet_queue.front());
 					_packet_queue.pop();
 
-					auto pi = _thread_peer_map.find(qp._client_id);
-					if (pi != _thread_peer_map.end()) {
+					--_statistics._queued_packet_count;
+					_statistics._queued_byte_count -= qp._packet->dataLength;
+					_statistics._packet_queue_latency.record(std::chrono::steady_clock::now() - qp._queued_time);
 
-						//enet_peer_send fails if state not connected. was getting random asserts on peers disconnecting and going into ENET_PEER_STATE_ZOMBIE.
-						if (pi->second->state == ENET_PEER_STATE_CONNECTED) {
+					switch (qp._target) {
+						case SERVER_QUEUED_PACKET_TARGET_CLIENT: {
+							send_packet_to_client_in_thread(qp._client, qp._channel_id, qp._packet, qp._coalesce_key);
+							break;
+						}
+
+						case SERVER_QUEUED_PACKET_TARGET_CLIENTS: {
+							for (auto& client : qp._clients) {
+								send_packet_to_client_in_thread(client, qp._channel_id, qp._packet, qp._coalesce_key);
+							}
+							break;
+						}
 
-							if (enet_peer_send(pi->second, qp._channel_id, qp._packet) != 0) {
-								trace("enet_peer_send failed");
+						case SERVER_QUEUED_PACKET_TARGET_ALL: {
+							if (qp._coalesce_key == 0) {
+								//counted up front, the broadcast may destroy the packet.
+								for (auto& ts : _thread_slots) {
+									if (ts._peer != nullptr && ts._peer->state == ENET_PEER_STATE_CONNECTED) {
+										get_peer_statistics_in_thread(ts).get_channel(qp._channel_id).record_sent(qp._packet->dataLength);
+									}
+								}
+
+								//only sends to connected peers and destroys the packet itself if none took it.
+								enet_host_broadcast(host, qp._channel_id, qp._packet);
+								continue;
 							}
 
-							if (qp._packet->referenceCount == 0) {
-								enet_packet_destroy(qp._packet);
+							//state packets may have to be held for some peers, so no broadcast.
+							for (auto& ts : _thread_slots) {
+								if (ts._peer != nullptr) {
+									send_packet_to_peer_in_thread(ts, qp._channel_id, qp._packet, qp._coalesce_key);
+								}
 							}
+							break;
 						}
 					}
+
+					//every send that succeeded holds a reference, so this only destroys packets nobody took. checked once
+					//after all recipients so a shared packet isn't freed after the first send.
+					if (qp._packet->referenceCount == 0) {
+						enet_packet_destroy(qp._packet);
+					}
+				}
+			}
+		}
+
+		void send_packet_to_client_in_thread(const server_client_handle& client, enet_uint8 channel_id, ENetPacket* packet, uint64_t coalesce_key) {
+			auto& ts = _thread_slots[client._index];
+
+			//a stale generation means the client disconnected and the slot was reused since the packet was queued.
+			if (ts._peer != nullptr && ts._generation == client._generation) {
+				send_packet_to_peer_in_thread(ts, channel_id, packet, coalesce_key);
+			}
+		}
+
+		void send_packet_to_peer_in_thread(thread_slot& ts, enet_uint8 channel_id, ENetPacket* packet, uint64_t coalesce_key) {
+			//enet_peer_send fails if state not connected. was getting random asserts on peers disconnecting and going into ENET_PEER_STATE_ZOMBIE.
+			if (ts._peer->state != ENET_PEER_STATE_CONNECTED) {
+				return;
+			}
+
+			if (coalesce_key != 0 && is_peer_congested(ts._peer)) {
+				if (ts._held_packets.hold(channel_id, packet, coalesce_key)) {
+					++_statistics._coalesced_packet_count;
+				}
+				return;
+			}
+
+			if (enet_peer_send(ts._peer, channel_id, packet) != 0) {
+				trace("enet_peer_send failed");
+			}
+			else {
+				get_peer_statistics_in_thread(ts).get_channel(channel_id).record_sent(packet->dataLength);
+			}
+		}
+
+		server_peer_statistics& get_peer_statistics_in_thread(const thread_slot& ts) {
+			return _peer_statistics[&ts - _thread_slots.data()];
+		}
+
+		void publish_peer_statistics_in_thread() {
+			for (size_t i = 0; i < _thread_slots.size(); ++i) {
+				auto& ts = _thread_slots[i];
+				auto& ps = _peer_statistics[i];
+				ps._held_packet_count = ts._held_packets.size();
+				ps._held_byte_count = ts._held_packets.get_byte_count();
+
+				if (ts._peer != nullptr) {
+					ps._reliable_data_in_transit = ts._peer->reliableDataInTransit;
+					ps._round_trip_time_in_ms = ts._peer->roundTripTime;
+					ps._round_trip_time_variance_in_ms = ts._peer->roundTripTimeVariance;
+					ps._packet_loss = ts._peer->packetLoss;
+					ps._packet_loss_variance = ts._peer->packetLossVariance;
+					ps._packet_throttle = ts._peer->packetThrottle;
+					ps._packets_sent = ts._peer->packetsSent;
+					ps._packets_lost = ts._peer->packetsLost;
+				}
+				else {
+					ps._reliable_data_in_transit = 0;
 				}
 			}
 		}
@@ -274,39 +546,58 @@ namespace enetpp {
 			//there is a chance the first few packets are received on the worker thread when the peer is not 
 			//initialized with data causing them to be discarded.
 
-			auto client = new ClientT();
+			auto slot = _client_slots.allocate();
+			if (slot == nullptr) {
+				trace("no free client slot, dropping connection");
+				enet_peer_disconnect_now(e.peer, 0);
+				return;
+			}
+
+			auto client = &*slot->_client;
 			params._initialize_client_function(*client, peer_ip);
 
 			assert(e.peer->data == nullptr);
-			e.peer->data = client;
+			e.peer->data = slot;
+
+			auto& ts = _thread_slots[slot->_index];
+			assert(ts._peer == nullptr);
+			ts._peer = e.peer;
+			ts._generation = slot->_generation;
 
-			_thread_peer_map[client->get_id()] = e.peer;
+			for (auto& cs : _peer_statistics[slot->_index]._channels) {
+				cs.reset();
+			}
 
 			{
 				std::lock_guard<std::mutex> lock(_event_queue_mutex);
-				_event_queue.emplace(ENET_EVENT_TYPE_CONNECT, 0, nullptr, client);
+				_event_queue.emplace_back(ENET_EVENT_TYPE_CONNECT, 0, nullptr, client, slot->_index);
+				++_statistics._event_queue_depth;
 			}
 		}
 
 		void handle_disconnect_event_in_thread(const ENetEvent& e) {
-			auto client = reinterpret_cast<ClientT*>(e.peer->data);
-			if (client != nullptr) {
-				auto iter = _thread_peer_map.find(client->get_id());
-				assert(iter != _thread_peer_map.end());
-				assert(iter->second == e.peer);
+			auto slot = reinterpret_cast<client_slot*>(e.peer->data);
+			if (slot != nullptr) {
+				auto& ts = _thread_slots[slot->_index];
+				assert(ts._peer == e.peer);
+				ts._held_packets.clear();
+				ts._peer = nullptr;
 				e.peer->data = nullptr;
-				_thread_peer_map.erase(iter);
 
 				std::lock_guard<std::mutex> lock(_event_queue_mutex);
-				_event_queue.emplace(ENET_EVENT_TYPE_DISCONNECT, 0, nullptr, client);
+				_event_queue.emplace_back(ENET_EVENT_TYPE_DISCONNECT, 0, nullptr, &*slot->_client, slot->_index);
+				++_statistics._event_queue_depth;
 			}
 		}
 
 		void handle_receive_event_in_thread(const ENetEvent& e) {
-			auto client = reinterpret_cast<ClientT*>(e.peer->data);
-			if (client != nullptr) {
+			auto slot = reinterpret_cast<client_slot*>(e.peer->data);
+			if (slot != nullptr) {
+				_peer_statistics[slot->_index].get_channel(e.channelID).record_received(e.packet->dataLength);
+
 				std::lock_guard<std::mutex> lock(_event_queue_mutex);
-				_event_queue.emplace(ENET_EVENT_TYPE_RECEIVE, e.channelID, e.packet, client);
+				_event_queue.emplace_back(ENET_EVENT_TYPE_RECEIVE, e.channelID, e.packet, &*slot->_client, slot->_index);
+				++_statistics._event_queue_depth;
 			}
 		}
 
@@ -316,28 +607,23 @@ namespace enetpp {
 				enet_packet_destroy(_packet_queue.front()._packet);
 				_packet_queue.pop();
 			}
+
+			_statistics._queued_packet_count = 0;
+			_statistics._queued_byte_count = 0;
 		}
 
 		void destroy_all_queued_events() {
 			std::lock_guard<std::mutex> lock(_event_queue_mutex);
-			while (!_event_queue.empty()) {
-				destroy_unhandled_event_data(_event_queue.front());
-				_event_queue.pop();
+			for (auto& e : _event_queue) {
+				destroy_unhandled_event_data(e);
 			}
-		}
-
-		void delete_all_connected_clients() {
-			for (auto c : _connected_clients) {
-				delete c;
-			}
-			_connected_clients.clear();
+			_event_queue.clear();
+			_statistics._event_queue_depth = 0;
 		}
 
 		void destroy_unhandled_event_data(event_type& e) {
-			if (e._event_type == ENET_EVENT_TYPE_CONNECT) {
-				delete e._client;
-			}
-			else if (e._event_type == ENET_EVENT_TYPE_RECEIVE) {
+			//clients are owned by _client_slots and destroyed when it is cleared.
+			if (e._event_type == ENET_EVENT_TYPE_RECEIVE) {
 				enet_packet_destroy(e._packet);
 			}
 		}
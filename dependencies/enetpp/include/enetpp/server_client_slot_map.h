@@ -0,0 +1,160 @@
+#ifndef ENETPP_SERVER_CLIENT_SLOT_MAP_H_
+#define ENETPP_SERVER_CLIENT_SLOT_MAP_H_
+
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <assert.h>
+
+namespace enetpp {
+
+	//identifies a client slot for the lifetime of one connection. the generation changes every time the slot is
+	//released, so a handle held past a disconnect never resolves to whoever reuses the slot.
+	class server_client_handle {
+	public:
+		unsigned int _index;
+		unsigned int _generation;
+
+	public:
+		server_client_handle()
+			: _index(0)
+			, _generation(0) {
+		}
+
+		server_client_handle(unsigned int index, unsigned int generation)
+			: _index(index)
+			, _generation(generation) {
+		}
+	};
+
+	//fixed capacity storage for server clients. clients live inline in one contiguous array and never move once
+	//constructed, so pointers handed out in events stay valid until the slot is released.
+	//
+	//slots are constructed by the worker thread when a peer connects and released by the thread consuming events once
+	//it has handled the disconnect, so a client is never destroyed while the other side can still see it. only the
+	//free list is shared and it is touched once per connect / disconnect.
+	template<typename ClientT>
+	class server_client_slot_map {
+	public:
+		class slot {
+		public:
+			std::optional<ClientT> _client;
+			unsigned int _index = 0;
+			unsigned int _generation = 0;
+			bool _is_connected = false; //consumer side view, set once the connect event has been handled
+		};
+
+	private:
+		std::vector<slot> _slots;
+		std::vector<unsigned int> _free_indices;
+		std::mutex _free_indices_mutex;
+		size_t _connected_count;
+
+	public:
+		server_client_slot_map()
+			: _connected_count(0) {
+		}
+
+		server_client_slot_map(const server_client_slot_map&) = delete;
+		server_client_slot_map& operator=(const server_client_slot_map&) = delete;
+
+		//must only be called while no worker thread is running.
+		void reset(size_t capacity) {
+			clear();
+
+			_slots.clear();
+			_slots.resize(capacity);
+			_free_indices.clear();
+			_free_indices.reserve(capacity);
+
+			//a fresh map hands out the lowest indices first so iteration order starts out following connect order.
+			for (size_t i = 0; i < capacity; ++i) {
+				_slots[i]._index = static_cast<unsigned int>(i);
+				_free_indices.push_back(static_cast<unsigned int>(capacity - 1 - i));
+			}
+		}
+
+		//must only be called while no worker thread is running. destroys every client still held.
+		void clear() {
+			for (auto& s : _slots) {
+				if (s._client.has_value()) {
+					s._client.reset();
+					++s._generation;
+				}
+				s._is_connected = false;
+			}
+
+			_connected_count = 0;
+		}
+
+		size_t capacity() const {
+			return _slots.size();
+		}
+
+		//worker thread. returns nullptr when every slot is taken.
+		slot* allocate() {
+			std::lock_guard<std::mutex> lock(_free_indices_mutex);
+			if (_free_indices.empty()) {
+				return nullptr;
+			}
+
+			auto& s = _slots[_free_indices.back()];
+			_free_indices.pop_back();
+
+			assert(!s._client.has_value());
+			s._client.emplace();
+			return &s;
+		}
+
+		//consumer thread.
+		void set_connected(slot& s) {
+			assert(s._client.has_value());
+			assert(!s._is_connected);
+			s._is_connected = true;
+			++_connected_count;
+		}
+
+		//consumer thread. destroys the client and makes the slot available to the worker thread again.
+		void release(slot& s) {
+			assert(s._client.has_value());
+
+			if (s._is_connected) {
+				s._is_connected = false;
+				--_connected_count;
+			}
+
+			s._client.reset();
+			++s._generation;
+
+			std::lock_guard<std::mutex> lock(_free_indices_mutex);
+			_free_indices.push_back(s._index);
+		}
+
+		slot& get_slot(unsigned int index) {
+			assert(index < _slots.size());
+			return _slots[index];
+		}
+
+		server_client_handle get_handle(const slot& s) const {
+			return server_client_handle(s._index, s._generation);
+		}
+
+		//consumer thread.
+		size_t get_connected_count() const {
+			return _connected_count;
+		}
+
+		//consumer thread. visits connected clients in slot order, which doesn't change while a client stays connected.
+		template<typename F>
+		void for_each_connected(F&& f) {
+			for (auto& s : _slots) {
+				if (s._is_connected) {
+					f(s);
+				}
+			}
+		}
+	};
+
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef ENETPP_SERVER_EVENT_H_
 #define ENETPP_SERVER_EVENT_H_
 
+#include <chrono>
 #include "enet/enet.h"
 
 namespace enetpp {
@@ -13,20 +14,26 @@ namespace enetpp {
 		enet_uint8 _channel_id;
 		ENetPacket* _packet;
 		ClientT* _client;
+		unsigned int _slot_index;
+		std::chrono::steady_clock::time_point _queued_time;
 	
 	public:
 		server_event()
 			: _event_type(ENET_EVENT_TYPE_NONE)
 			, _channel_id(0)
 			, _packet(nullptr)
-			, _client(nullptr) {
+			, _client(nullptr)
+			, _slot_index(0)
+			, _queued_time() {
 		}
 
-		server_event(ENetEventType event_type, enet_uint8 channel_id, ENetPacket* packet, ClientT* client)
+		server_event(ENetEventType event_type, enet_uint8 channel_id, ENetPacket* packet, ClientT* client, unsigned int slot_index)
 			: _event_type(event_type)
 			, _channel_id(channel_id)
 			, _packet(packet)
-			, _client(client) {
+			, _client(client)
+			, _slot_index(slot_index)
+			, _queued_time(std::chrono::steady_clock::now()) {
 		}
 	};
 
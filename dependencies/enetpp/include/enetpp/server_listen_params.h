@@ -19,6 +19,7 @@ namespace enetpp {
 		enet_uint32 _outgoing_bandwidth;
 		enet_uint16 _listen_port;
 		std::chrono::milliseconds _peer_timeout;
+		std::chrono::milliseconds _service_timeout;
 		initialize_client_function _initialize_client_function;
 
 	public:
@@ -27,7 +28,8 @@ namespace enetpp {
 			, _channel_count(0)
 			, _incoming_bandwidth(0)
 			, _outgoing_bandwidth(0) 
-			, _peer_timeout(0) {
+			, _peer_timeout(0)
+			, _service_timeout(10) {
 		}
 
 		server_listen_params& set_listen_port(enet_uint16 port) {
@@ -60,6 +62,13 @@ namespace enetpp {
 			return *this;
 		}
 
+		//longest the worker thread sleeps when there is no traffic. sends and incoming datagrams wake it immediately,
+		//this only bounds how late enet's own resend / ping timers can run.
+		server_listen_params& set_service_timeout(std::chrono::milliseconds timeout) {
+			_service_timeout = timeout;
+			return *this;
+		}
+
 		server_listen_params& set_initialize_client_function(initialize_client_function f) {
 			_initialize_client_function = f;
 			return *this;
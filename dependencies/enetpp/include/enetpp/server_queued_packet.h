@@ -1,30 +1,64 @@
 #ifndef ENETPP_SERVER_QUEUED_PACKET_H_
 #define ENETPP_SERVER_QUEUED_PACKET_H_
 
+#include <chrono>
+#include <stdint.h>
+#include <vector>
 #include "enet/enet.h"
+#include "server_client_slot_map.h"
 
 namespace enetpp {
 
+	enum server_queued_packet_target {
+		SERVER_QUEUED_PACKET_TARGET_CLIENT, //_client
+		SERVER_QUEUED_PACKET_TARGET_CLIENTS, //_clients
+		SERVER_QUEUED_PACKET_TARGET_ALL, //every connected peer, sent with enet_host_broadcast
+	};
+
+	//one entry per packet regardless of how many clients receive it. the packet is shared by all recipients and is
+	//only destroyed by the worker thread once every send has taken its reference.
 	class server_queued_packet {
 	public:
 		enet_uint8 _channel_id;
 		ENetPacket* _packet;
-		unsigned int _client_id;
+		server_queued_packet_target _target;
+		server_client_handle _client;
+		std::vector<server_client_handle> _clients;
+		uint64_t _coalesce_key; //0 for packets that must all be delivered, see server::send_packet_to
+		std::chrono::steady_clock::time_point _queued_time;
 
 	public:
 		server_queued_packet()
 			: _channel_id(0)
 			, _packet(nullptr) 
-			, _client_id(0) {
+			, _target(SERVER_QUEUED_PACKET_TARGET_CLIENT)
+			, _coalesce_key(0) {
 		}
 
-		server_queued_packet(enet_uint8 channel_id, ENetPacket* packet, unsigned int client_id)
+		server_queued_packet(enet_uint8 channel_id, ENetPacket* packet, server_client_handle client, uint64_t coalesce_key)
 			: _channel_id(channel_id)
 			, _packet(packet) 
-			, _client_id(client_id) {
+			, _target(SERVER_QUEUED_PACKET_TARGET_CLIENT)
+			, _client(client)
+			, _coalesce_key(coalesce_key) {
+		}
+
+		server_queued_packet(enet_uint8 channel_id, ENetPacket* packet, std::vector<server_client_handle>&& clients, uint64_t coalesce_key)
+			: _channel_id(channel_id)
+			, _packet(packet)
+			, _target(SERVER_QUEUED_PACKET_TARGET_CLIENTS)
+			, _clients(std::move(clients))
+			, _coalesce_key(coalesce_key) {
+		}
+
+		server_queued_packet(enet_uint8 channel_id, ENetPacket* packet, server_queued_packet_target target, uint64_t coalesce_key)
+			: _channel_id(channel_id)
+			, _packet(packet)
+			, _target(target)
+			, _coalesce_key(coalesce_key) {
 		}
 	};
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,71 @@
+#ifndef ENETPP_SERVER_STATISTICS_H_
+#define ENETPP_SERVER_STATISTICS_H_
+
+#include <atomic>
+#include "channel_statistics.h"
+#include "latency_histogram.h"
+
+namespace enetpp {
+
+	class server_statistics {
+	public:
+		std::atomic<size_t> _queued_packet_count; //sent but not picked up by the worker thread yet
+		std::atomic<size_t> _queued_byte_count;
+		std::atomic<unsigned int> _coalesced_packet_count; //per peer state packets replaced by a newer one before they were sent
+		std::atomic<size_t> _event_queue_depth; //received by the worker thread but not consumed yet
+
+		latency_histogram _packet_queue_latency; //send_packet_to* until the worker thread picks the packet up
+		latency_histogram _event_queue_latency; //received by the worker thread until consumed
+
+	public:
+		server_statistics()
+			: _queued_packet_count(0)
+			, _queued_byte_count(0)
+			, _coalesced_packet_count(0)
+			, _event_queue_depth(0) {
+		}
+	};
+
+	//published by the worker thread once per service loop.
+	class server_peer_statistics {
+	public:
+		std::atomic<size_t> _held_packet_count; //state packets held back while the peer is congested
+		std::atomic<size_t> _held_byte_count;
+		std::atomic<unsigned int> _reliable_data_in_transit; //bytes enet has sent but not had acknowledged
+		std::atomic<unsigned int> _round_trip_time_in_ms;
+		std::atomic<unsigned int> _round_trip_time_variance_in_ms;
+		std::atomic<unsigned int> _packet_loss; //enet's smoothed reliable packet loss, ENET_PEER_PACKET_LOSS_SCALE is 100%
+		std::atomic<unsigned int> _packet_loss_variance;
+		std::atomic<unsigned int> _packet_throttle; //ENET_PEER_PACKET_THROTTLE_SCALE is unthrottled
+		std::atomic<unsigned int> _packets_sent; //reliable packets sent by enet, resends included
+		std::atomic<unsigned int> _packets_lost; //reliable packets enet had to resend
+
+		//counted by the worker thread as packets are handed to / received from enet. reset when the slot is reused.
+		channel_statistics _channels[channel_statistics::tracked_channel_count];
+
+	public:
+		server_peer_statistics()
+			: _held_packet_count(0)
+			, _held_byte_count(0)
+			, _reliable_data_in_transit(0)
+			, _round_trip_time_in_ms(0)
+			, _round_trip_time_variance_in_ms(0)
+			, _packet_loss(0)
+			, _packet_loss_variance(0)
+			, _packet_throttle(0)
+			, _packets_sent(0)
+			, _packets_lost(0) {
+		}
+
+		channel_statistics& get_channel(enet_uint8 channel_id) {
+			return _channels[channel_statistics::get_index(channel_id)];
+		}
+
+		const channel_statistics& get_channel(enet_uint8 channel_id) const {
+			return _channels[channel_statistics::get_index(channel_id)];
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef ENETPP_SPSC_RING_H_
+#define ENETPP_SPSC_RING_H_
+
+#include <atomic>
+#include <vector>
+#include <assert.h>
+
+namespace enetpp {
+
+	//bounded single producer / single consumer ring buffer. the producer and consumer indices are kept on separate
+	//cache lines so the thread pushing and the thread popping never write to the same line. each side also keeps a
+	//cached copy of the other side's index so the shared line is only touched when the ring looks full / empty.
+	//
+	//!IMPORTANT! exactly one thread may push and exactly one thread may pop at any given time. if several threads
+	//produce, the caller must serialize them.
+	template<typename T>
+	class spsc_ring {
+	public:
+		static constexpr size_t cache_line_size = 64;
+
+	private:
+		//producer side
+		alignas(cache_line_size) std::atomic<size_t> _head;
+		size_t _cached_tail;
+
+		//consumer side
+		alignas(cache_line_size) std::atomic<size_t> _tail;
+		size_t _cached_head;
+
+		//read only after reset()
+		alignas(cache_line_size) std::vector<T> _slots;
+		size_t _mask;
+
+	public:
+		spsc_ring()
+			: _head(0)
+			, _cached_tail(0)
+			, _tail(0)
+			, _cached_head(0)
+			, _mask(0) {
+		}
+
+		spsc_ring(const spsc_ring&) = delete;
+		spsc_ring& operator=(const spsc_ring&) = delete;
+
+		//must only be called while no thread is pushing or popping. capacity is rounded up to a power of two.
+		void reset(size_t capacity) {
+			assert(capacity > 0);
+			assert(empty());
+
+			size_t rounded = 1;
+			while (rounded < capacity) {
+				rounded <<= 1;
+			}
+
+			_slots.assign(rounded, T());
+			_mask = rounded - 1;
+			_head.store(0, std::memory_order_relaxed);
+			_tail.store(0, std::memory_order_relaxed);
+			_cached_tail = 0;
+			_cached_head = 0;
+		}
+
+		size_t capacity() const {
+			return _slots.size();
+		}
+
+		//producer only. returns false if the ring is full.
+		bool try_push(const T& value) {
+			const size_t head = _head.load(std::memory_order_relaxed);
+			if (head - _cached_tail == _slots.size()) {
+				_cached_tail = _tail.load(std::memory_order_acquire);
+				if (head - _cached_tail == _slots.size()) {
+					return false;
+				}
+			}
+
+			_slots[head & _mask] = value;
+			_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		//consumer only. returns false if the ring is empty.
+		bool try_pop(T& value) {
+			const size_t tail = _tail.load(std::memory_order_relaxed);
+			if (tail == _cached_head) {
+				_cached_head = _head.load(std::memory_order_acquire);
+				if (tail == _cached_head) {
+					return false;
+				}
+			}
+
+			value = _slots[tail & _mask];
+			_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		//safe from either side, but only a snapshot.
+		bool empty() const {
+			return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+		}
+
+		size_t size() const {
+			const size_t tail = _tail.load(std::memory_order_acquire);
+			const size_t head = _head.load(std::memory_order_acquire);
+			return head - tail;
+		}
+	};
+
+}
+
+#endif
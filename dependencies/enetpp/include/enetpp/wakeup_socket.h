@@ -0,0 +1,121 @@
+#ifndef ENETPP_WAKEUP_SOCKET_H_
+#define ENETPP_WAKEUP_SOCKET_H_
+
+#include <atomic>
+#include "enet/enet.h"
+
+namespace enetpp {
+
+	//loopback datagram socket used to wake a worker thread that is blocked waiting on its host socket. works the same
+	//on every platform enet supports, unlike eventfd / pipes which winsock can't select on.
+	class wakeup_socket {
+	private:
+		ENetSocket _socket;
+		ENetAddress _address;
+		std::atomic<bool> _is_signaled;
+
+	public:
+		wakeup_socket()
+			: _socket(ENET_SOCKET_NULL)
+			, _address()
+			, _is_signaled(false) {
+		}
+
+		~wakeup_socket() {
+			close();
+		}
+
+		wakeup_socket(const wakeup_socket&) = delete;
+		wakeup_socket& operator=(const wakeup_socket&) = delete;
+
+		//must be called before the worker thread starts. if this fails wait() still honours its timeout, the thread
+		//just can't be woken early.
+		bool open() {
+			close();
+
+			_socket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+			if (_socket == ENET_SOCKET_NULL) {
+				return false;
+			}
+
+			ENetAddress bind_address;
+			enet_address_set_host_ip(&bind_address, "127.0.0.1");
+			bind_address.port = 0;
+
+			if (enet_socket_bind(_socket, &bind_address) != 0 ||
+				enet_socket_get_address(_socket, &_address) != 0 ||
+				enet_socket_set_option(_socket, ENET_SOCKOPT_NONBLOCK, 1) != 0) {
+				close();
+				return false;
+			}
+
+			//getsockname reports the wildcard host on some stacks, always talk to loopback.
+			enet_address_set_host_ip(&_address, "127.0.0.1");
+			_is_signaled = false;
+			return true;
+		}
+
+		//must be called after the worker thread has been joined.
+		void close() {
+			if (_socket != ENET_SOCKET_NULL) {
+				enet_socket_destroy(_socket);
+				_socket = ENET_SOCKET_NULL;
+			}
+		}
+
+		//any thread. repeated signals before the worker thread wakes cost a single atomic exchange.
+		void signal() {
+			if (_socket == ENET_SOCKET_NULL || _is_signaled.exchange(true)) {
+				return;
+			}
+
+			enet_uint8 byte = 0;
+			ENetBuffer buffer;
+			buffer.data = &byte;
+			buffer.dataLength = sizeof(byte);
+			enet_socket_send(_socket, &_address, &buffer, 1);
+		}
+
+		//worker thread only. call before draining whatever the signal was for so a signal raised while draining is
+		//never lost.
+		//
+		//the socket is drained before the flag is cleared. the other way round, a signal() landing in between sets the
+		//flag and sends a byte that the drain then swallows. the flag stays set with nothing left to read, so every
+		//later signal() returns early and the worker sleeps out its whole timeout. a signal() that still sees the
+		//flag set here sends nothing, which is fine because the caller drains its queue after reset() returns.
+		void reset() {
+			if (_socket == ENET_SOCKET_NULL) {
+				return;
+			}
+
+			enet_uint8 bytes[16];
+			ENetBuffer buffer;
+			buffer.data = bytes;
+			buffer.dataLength = sizeof(bytes);
+			while (enet_socket_receive(_socket, nullptr, &buffer, 1) > 0) {
+			}
+
+			_is_signaled = false;
+		}
+
+		//worker thread only. blocks until the host socket is readable, signal() is called or timeout_in_ms passes.
+		void wait(ENetHost* host, enet_uint32 timeout_in_ms) {
+			ENetSocketSet read_set;
+			ENET_SOCKETSET_EMPTY(read_set);
+			ENET_SOCKETSET_ADD(read_set, host->socket);
+
+			ENetSocket max_socket = host->socket;
+			if (_socket != ENET_SOCKET_NULL) {
+				ENET_SOCKETSET_ADD(read_set, _socket);
+				if (_socket > max_socket) {
+					max_socket = _socket;
+				}
+			}
+
+			enet_socketset_select(max_socket, &read_set, nullptr, timeout_in_ms);
+		}
+	};
+
+}
+
+#endif
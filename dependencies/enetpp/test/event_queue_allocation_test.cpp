@@ -0,0 +1,204 @@
+//checks that delivering events through enetpp::client and enetpp::server allocates nothing once warmed up. the worker
+//threads append to preallocated, double buffered event vectors and consume_events swaps them, so after the first few
+//rounds neither side should ever touch the heap through operator new. 64 clients keep the server's queues busier than
+//their initial capacity, so the warmup also covers them growing once and then staying put.
+//
+//enet's own allocations go through pool_allocator and malloc, not operator new, so they aren't counted here.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+#include "enetpp/client.h"
+#include "enetpp/server.h"
+#include "test.h"
+
+static std::atomic<uint64_t> s_allocation_count{ 0 };
+
+//set around calls whose own allocations aren't under test, e.g. server::send_packet_to pushing onto its std::queue.
+static thread_local bool t_ignore_allocations = false;
+
+void* operator new(size_t size) {
+	if (!t_ignore_allocations) {
+		++s_allocation_count;
+	}
+
+	if (void* p = malloc(size != 0 ? size : 1)) {
+		return p;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	free(p);
+}
+
+static const enet_uint16 PORT = 47123;
+static const int CLIENT_COUNT = 64;
+static const int WARMUP_ROUNDS = 16;
+static const int MEASURED_ROUNDS = 64;
+static const int PACKETS_PER_ROUND = 8; //per client. the server sees 512 events a round, twice initial_event_queue_capacity
+
+class test_client {
+public:
+	unsigned int _id = 0;
+
+public:
+	unsigned int get_id() const {
+		return _id;
+	}
+};
+
+class ignore_allocations {
+public:
+	ignore_allocations() {
+		t_ignore_allocations = true;
+	}
+
+	~ignore_allocations() {
+		t_ignore_allocations = false;
+	}
+};
+
+ENETPP_TEST(event_queue_allocation) {
+	enetpp::global_state::get().initialize();
+
+	unsigned int next_client_id = 1;
+	enetpp::server<test_client> server;
+	server.start_listening(enetpp::server_listen_params<test_client>()
+		.set_max_client_count(CLIENT_COUNT)
+		.set_channel_count(1)
+		.set_listen_port(PORT)
+		.set_initialize_client_function([&](test_client& client, const char* ip) { client._id = next_client_id++; }));
+
+	class test_connection {
+	public:
+		enetpp::client _client;
+		bool _is_connected = false;
+		int _received = 0;
+	};
+
+	std::vector<std::unique_ptr<test_connection>> connections;
+	for (int i = 0; i < CLIENT_COUNT; ++i) {
+		connections.push_back(std::make_unique<test_connection>());
+		connections.back()->_client.connect(enetpp::client_connect_params()
+			.set_channel_count(1)
+			.set_server_host_name_and_port("127.0.0.1", PORT));
+	}
+
+	std::vector<unsigned int> server_client_ids;
+	int server_received = 0;
+
+	auto on_client_connected = [&](test_client& c) { server_client_ids.push_back(c.get_id()); };
+	auto on_client_disconnected = [&](unsigned int client_id) { std::erase(server_client_ids, client_id); };
+	auto on_client_data_received = [&](test_client& c, const enet_uint8* data, size_t data_size) { ++server_received; };
+
+	auto pump = [&]() {
+		for (auto& connection : connections) {
+			auto& c = *connection;
+			c._client.consume_events(
+				[&]() { c._is_connected = true; },
+				[&]() { c._is_connected = false; },
+				[&](const enet_uint8* data, size_t data_size) { ++c._received; });
+		}
+		server.consume_events(on_client_connected, on_client_disconnected, on_client_data_received);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	};
+
+	auto count_connected_clients = [&]() {
+		int count = 0;
+		for (auto& connection : connections) {
+			count += connection->_is_connected ? 1 : 0;
+		}
+		return count;
+	};
+
+	auto count_received_by_clients = [&]() {
+		int count = 0;
+		for (auto& connection : connections) {
+			count += connection->_received;
+		}
+		return count;
+	};
+
+	auto shutdown = [&](std::chrono::steady_clock::time_point deadline) {
+		for (auto& connection : connections) {
+			connection->_client.disconnect();
+		}
+		while (!server_client_ids.empty() && std::chrono::steady_clock::now() < deadline) {
+			server.consume_events(on_client_connected, on_client_disconnected, on_client_data_received);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		server.stop_listening();
+		enetpp::global_state::get().deinitialize();
+	};
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+	auto timed_out = [&]() {
+		return std::chrono::steady_clock::now() > deadline;
+	};
+
+	while ((count_connected_clients() < CLIENT_COUNT || server_client_ids.size() < CLIENT_COUNT) && !timed_out()) {
+		pump();
+	}
+
+	if (count_connected_clients() < CLIENT_COUNT || server_client_ids.size() < CLIENT_COUNT) {
+		printf("FAIL: %d / %d clients connected, server saw %zu\n", count_connected_clients(), CLIENT_COUNT, server_client_ids.size());
+		shutdown(deadline);
+		return false;
+	}
+
+	const enet_uint8 payload[32] = {};
+	uint64_t allocations_before = 0;
+
+	for (int round = 0; round < WARMUP_ROUNDS + MEASURED_ROUNDS && !timed_out(); ++round) {
+		if (round == WARMUP_ROUNDS) {
+			allocations_before = s_allocation_count;
+		}
+
+		for (int i = 0; i < PACKETS_PER_ROUND; ++i) {
+			for (auto& connection : connections) {
+				connection->_client.send_packet(0, payload, sizeof(payload), ENET_PACKET_FLAG_RELIABLE);
+			}
+
+			ignore_allocations ignore;
+			for (auto id : server_client_ids) {
+				server.send_packet_to(id, 0, payload, sizeof(payload), ENET_PACKET_FLAG_RELIABLE);
+			}
+		}
+
+		const int expected = (round + 1) * PACKETS_PER_ROUND * CLIENT_COUNT;
+		while ((count_received_by_clients() < expected || server_received < expected) && !timed_out()) {
+			pump();
+		}
+	}
+
+	const uint64_t allocations = s_allocation_count - allocations_before;
+	const int expected = (WARMUP_ROUNDS + MEASURED_ROUNDS) * PACKETS_PER_ROUND * CLIENT_COUNT;
+	const int delivered_events = 2 * MEASURED_ROUNDS * PACKETS_PER_ROUND * CLIENT_COUNT;
+	bool result = true;
+
+	if (count_received_by_clients() != expected || server_received != expected) {
+		printf("FAIL: received %d / %d packets on the clients, %d / %d on the server\n", count_received_by_clients(), expected, server_received, expected);
+		result = false;
+	}
+	else if (allocations != 0) {
+		printf("FAIL: %llu allocations while delivering %d events to %d clients\n", (unsigned long long)allocations, delivered_events, CLIENT_COUNT);
+		result = false;
+	}
+	else {
+		printf("ok: no allocations while delivering %d events to %d clients\n", delivered_events, CLIENT_COUNT);
+	}
+
+	shutdown(deadline + std::chrono::seconds(10));
+	return result;
+}
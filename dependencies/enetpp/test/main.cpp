@@ -0,0 +1,32 @@
+//runs every registered test, plus the benchmarks when started with --benchmark. see test.h.
+
+#include <cstdio>
+#include <cstring>
+#include "test.h"
+
+int main(int argc, char** argv) {
+	bool run_benchmarks = false;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--benchmark") == 0) {
+			run_benchmarks = true;
+		}
+	}
+
+	int run_count = 0;
+	int failure_count = 0;
+	for (auto& tc : enetpp_test::get_test_cases()) {
+		if (tc._is_benchmark && !run_benchmarks) {
+			continue;
+		}
+
+		printf("%s\n", tc._name);
+		fflush(stdout);
+		++run_count;
+		if (!tc._function()) {
+			++failure_count;
+		}
+	}
+
+	printf("%d run, %d failed\n", run_count, failure_count);
+	return (failure_count == 0) ? 0 : 1;
+}
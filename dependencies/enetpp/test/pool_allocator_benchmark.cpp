@@ -0,0 +1,236 @@
+//time spent in enet's allocator while a server relays state packets between 64 clients, before and after
+//pool_allocator. every client sends a small unreliable packet a round and the server forwards it to the 63 others,
+//the traffic pattern of the relay server.
+//
+//before: enet's callbacks are plain malloc / free.
+//after: pool_allocator, as installed by global_state::initialize. its hit / miss counters are reported for the run.
+//
+//both runs wrap the callbacks with the same timer, so the numbers only differ by the allocator underneath.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "enetpp/client.h"
+#include "enetpp/server.h"
+#include "test.h"
+
+static const enet_uint16 RELAY_PORT = 47124;
+static const int RELAY_CLIENT_COUNT = 64;
+static const int RELAY_ROUNDS = 20;
+static const size_t RELAY_PACKET_SIZE = 64;
+
+static std::atomic<uint64_t> s_allocator_call_count{ 0 };
+static std::atomic<uint64_t> s_allocator_time_in_ns{ 0 };
+
+class allocator_timer {
+private:
+	std::chrono::steady_clock::time_point _start;
+
+public:
+	allocator_timer()
+		: _start(std::chrono::steady_clock::now()) {
+	}
+
+	~allocator_timer() {
+		const auto elapsed = std::chrono::steady_clock::now() - _start;
+		s_allocator_time_in_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+		s_allocator_call_count.fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+static void* ENET_CALLBACK timed_malloc(size_t size) {
+	allocator_timer timer;
+	return malloc(size);
+}
+
+static void ENET_CALLBACK timed_free(void* memory) {
+	allocator_timer timer;
+	free(memory);
+}
+
+static void* ENET_CALLBACK timed_pool_allocate(size_t size) {
+	allocator_timer timer;
+	return enetpp::pool_allocator::get().allocate(size);
+}
+
+static void ENET_CALLBACK timed_pool_deallocate(void* memory) {
+	allocator_timer timer;
+	enetpp::pool_allocator::get().deallocate(memory);
+}
+
+static void ENET_CALLBACK abort_on_no_memory() {
+	abort();
+}
+
+class relay_client {
+public:
+	unsigned int _id = 0;
+
+public:
+	unsigned int get_id() const {
+		return _id;
+	}
+};
+
+static void get_pool_counters(uint64_t& hit_count, uint64_t& miss_count) {
+	hit_count = 0;
+	miss_count = 0;
+	for (size_t i = 0; i < enetpp::pool_allocator::size_class_count; ++i) {
+		const auto& stats = enetpp::pool_allocator::get().get_size_class_statistics(i);
+		hit_count += stats._hit_count;
+		miss_count += stats._miss_count;
+	}
+}
+
+static void run_relay_benchmark(const char* name, ENetCallbacks callbacks) {
+	//global_state installs pool_allocator, the timed callbacks replace it before any host exists.
+	enetpp::global_state::get().initialize();
+	enet_initialize_with_callbacks(ENET_VERSION, &callbacks);
+
+	unsigned int next_client_id = 1;
+	enetpp::server<relay_client> server;
+	server.start_listening(enetpp::server_listen_params<relay_client>()
+		.set_max_client_count(RELAY_CLIENT_COUNT)
+		.set_channel_count(1)
+		.set_listen_port(RELAY_PORT)
+		.set_initialize_client_function([&](relay_client& client, const char* ip) { client._id = next_client_id++; }));
+
+	class relay_connection {
+	public:
+		enetpp::client _client;
+		bool _is_connected = false;
+		int _received = 0;
+	};
+
+	std::vector<std::unique_ptr<relay_connection>> connections;
+	for (int i = 0; i < RELAY_CLIENT_COUNT; ++i) {
+		connections.push_back(std::make_unique<relay_connection>());
+		connections.back()->_client.connect(enetpp::client_connect_params()
+			.set_channel_count(1)
+			.set_server_host_name_and_port("127.0.0.1", RELAY_PORT));
+	}
+
+	int server_connected_count = 0;
+	auto on_client_connected = [&](relay_client& c) { ++server_connected_count; };
+	auto on_client_disconnected = [&](unsigned int client_id) { --server_connected_count; };
+	auto on_client_data_received = [&](relay_client& c, const enet_uint8* data, size_t data_size) {
+		const unsigned int sender_id = c.get_id();
+		server.send_packet_to_all_if(0, data, data_size, 0, [sender_id](const relay_client& other) { return other.get_id() != sender_id; });
+	};
+
+	auto pump = [&]() {
+		for (auto& connection : connections) {
+			auto& c = *connection;
+			c._client.consume_events(
+				[&]() { c._is_connected = true; },
+				[&]() { c._is_connected = false; },
+				[&](const enet_uint8* data, size_t data_size) { ++c._received; });
+		}
+		server.consume_events(on_client_connected, on_client_disconnected, on_client_data_received);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	};
+
+	auto count_received_by_clients = [&]() {
+		int count = 0;
+		for (auto& connection : connections) {
+			count += connection->_received;
+		}
+		return count;
+	};
+
+	auto count_connected_clients = [&]() {
+		int count = 0;
+		for (auto& connection : connections) {
+			count += connection->_is_connected ? 1 : 0;
+		}
+		return count;
+	};
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+	auto timed_out = [&]() {
+		return std::chrono::steady_clock::now() > deadline;
+	};
+
+	while ((count_connected_clients() < RELAY_CLIENT_COUNT || server_connected_count < RELAY_CLIENT_COUNT) && !timed_out()) {
+		pump();
+	}
+
+	uint64_t hits_before = 0;
+	uint64_t misses_before = 0;
+	get_pool_counters(hits_before, misses_before);
+
+	s_allocator_call_count = 0;
+	s_allocator_time_in_ns = 0;
+	const auto start = std::chrono::steady_clock::now();
+
+	const enet_uint8 payload[RELAY_PACKET_SIZE] = {};
+	for (int round = 0; round < RELAY_ROUNDS && !timed_out(); ++round) {
+		for (auto& connection : connections) {
+			connection->_client.send_packet(0, payload, sizeof(payload), 0);
+		}
+
+		const int expected = (round + 1) * RELAY_CLIENT_COUNT * (RELAY_CLIENT_COUNT - 1);
+		while (count_received_by_clients() < expected && !timed_out()) {
+			pump();
+		}
+	}
+
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	const uint64_t call_count = s_allocator_call_count;
+	const uint64_t time_in_ns = s_allocator_time_in_ns;
+
+	uint64_t hits_after = 0;
+	uint64_t misses_after = 0;
+	get_pool_counters(hits_after, misses_after);
+
+	printf("  %-8s %8llu allocator calls  %7.2f ms in the allocator  %5.1f ns / call  relay took %7.1f ms  (%d / %d delivered)",
+		name,
+		(unsigned long long)call_count,
+		time_in_ns / 1e6,
+		call_count > 0 ? double(time_in_ns) / call_count : 0.0,
+		std::chrono::duration<double, std::milli>(elapsed).count(),
+		count_received_by_clients(),
+		RELAY_ROUNDS * RELAY_CLIENT_COUNT * (RELAY_CLIENT_COUNT - 1));
+	if (callbacks.malloc == &timed_pool_allocate) {
+		printf("  pool hits %llu misses %llu", (unsigned long long)(hits_after - hits_before), (unsigned long long)(misses_after - misses_before));
+	}
+	printf("\n");
+
+	for (auto& connection : connections) {
+		connection->_client.disconnect();
+	}
+	while (server_connected_count > 0 && !timed_out()) {
+		server.consume_events(on_client_connected, on_client_disconnected, on_client_data_received);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	server.stop_listening();
+
+	enetpp::global_state::get().deinitialize();
+}
+
+ENETPP_BENCHMARK(pool_allocator_benchmark) {
+	//the timer's own cost is included in every call, measure it so the per call numbers can be read net of it.
+	s_allocator_call_count = 0;
+	s_allocator_time_in_ns = 0;
+	for (int i = 0; i < 1000000; ++i) {
+		allocator_timer timer;
+	}
+	printf("  timer    %5.1f ns / call of overhead\n", double(s_allocator_time_in_ns) / s_allocator_call_count);
+
+	ENetCallbacks malloc_callbacks;
+	malloc_callbacks.malloc = &timed_malloc;
+	malloc_callbacks.free = &timed_free;
+	malloc_callbacks.no_memory = &abort_on_no_memory;
+	run_relay_benchmark("malloc", malloc_callbacks);
+
+	ENetCallbacks pool_callbacks;
+	pool_callbacks.malloc = &timed_pool_allocate;
+	pool_callbacks.free = &timed_pool_deallocate;
+	pool_callbacks.no_memory = &abort_on_no_memory;
+	run_relay_benchmark("pool", pool_callbacks);
+	return true;
+}
@@ -0,0 +1,119 @@
+//client::send_packet's outbound queue, before and after spsc_ring. one thread enqueues client_queued_packets as fast
+//as it can while the worker thread drains them, the way client::run_in_thread does.
+//
+//before: std::queue under a std::mutex, the consumer locks and drains everything it finds.
+//after: spsc_ring at the default client_connect_params capacity, the producer yields while it is full.
+//
+//enqueue latency is the time spent inside the push call, throughput is packets through the queue per second.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "enetpp/client_connect_params.h"
+#include "enetpp/client_queued_packet.h"
+#include "enetpp/spsc_ring.h"
+#include "test.h"
+
+static const size_t PACKET_COUNT = 1000000;
+
+class mutex_queue {
+private:
+	std::queue<enetpp::client_queued_packet> _queue;
+	std::mutex _mutex;
+
+public:
+	void push(const enetpp::client_queued_packet& qp) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queue.push(qp);
+	}
+
+	template<typename F>
+	void drain(F&& f) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		while (!_queue.empty()) {
+			f(_queue.front());
+			_queue.pop();
+		}
+	}
+};
+
+class ring_queue {
+private:
+	enetpp::spsc_ring<enetpp::client_queued_packet> _ring;
+
+public:
+	ring_queue() {
+		_ring.reset(enetpp::client_connect_params()._packet_queue_capacity);
+	}
+
+	void push(const enetpp::client_queued_packet& qp) {
+		while (!_ring.try_push(qp)) {
+			std::this_thread::yield();
+		}
+	}
+
+	template<typename F>
+	void drain(F&& f) {
+		enetpp::client_queued_packet qp;
+		while (_ring.try_pop(qp)) {
+			f(qp);
+		}
+	}
+};
+
+template<typename Queue>
+static void run_queue_benchmark(const char* name) {
+	Queue queue;
+	enetpp_test::latency_samples enqueue_latency;
+	enqueue_latency.reserve(PACKET_COUNT);
+
+	std::atomic<bool> is_done{ false };
+	size_t consumed = 0;
+	uint64_t checksum = 0;
+
+	std::thread consumer([&]() {
+		auto on_packet = [&](const enetpp::client_queued_packet& qp) {
+			++consumed;
+			checksum += qp._coalesce_key;
+		};
+
+		//the real worker sleeps in select when there is nothing to send, yielding stands in for that.
+		while (!is_done.load(std::memory_order_acquire)) {
+			const size_t consumed_before = consumed;
+			queue.drain(on_packet);
+			if (consumed == consumed_before) {
+				std::this_thread::yield();
+			}
+		}
+		queue.drain(on_packet);
+	});
+
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < PACKET_COUNT; ++i) {
+		const auto before = std::chrono::steady_clock::now();
+		queue.push(enetpp::client_queued_packet(0, nullptr, i));
+		enqueue_latency.record(std::chrono::steady_clock::now() - before);
+	}
+	is_done.store(true, std::memory_order_release);
+	consumer.join();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	const double seconds = std::chrono::duration<double>(elapsed).count();
+	printf("  %-12s enqueue p50 %5llu ns  p99 %6llu ns  p99.9 %7llu ns  throughput %6.2f M packets/s  (%zu consumed, checksum %llu)\n",
+		name,
+		(unsigned long long)enqueue_latency.get_percentile_in_ns(50.0),
+		(unsigned long long)enqueue_latency.get_percentile_in_ns(99.0),
+		(unsigned long long)enqueue_latency.get_percentile_in_ns(99.9),
+		PACKET_COUNT / seconds / 1e6,
+		consumed,
+		(unsigned long long)checksum);
+}
+
+ENETPP_BENCHMARK(client_packet_queue_benchmark) {
+	run_queue_benchmark<mutex_queue>("std::queue");
+	run_queue_benchmark<ring_queue>("spsc_ring");
+	return true;
+}
@@ -0,0 +1,88 @@
+#ifndef ENETPP_TEST_H_
+#define ENETPP_TEST_H_
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <stdint.h>
+
+namespace enetpp_test {
+
+	//tests return false after printing why they failed. benchmarks only print their numbers and always return true,
+	//they run when enetpp-tests is started with --benchmark.
+	using test_function = std::function<bool()>;
+
+	class test_case {
+	public:
+		const char* _name;
+		test_function _function;
+		bool _is_benchmark;
+	};
+
+	inline std::vector<test_case>& get_test_cases() {
+		static std::vector<test_case> cases;
+		return cases;
+	}
+
+	class test_registrar {
+	public:
+		test_registrar(const char* name, test_function function, bool is_benchmark) {
+			get_test_cases().push_back({ name, std::move(function), is_benchmark });
+		}
+	};
+
+	//raw samples, so percentiles are exact instead of latency_histogram's log2 buckets.
+	class latency_samples {
+	private:
+		std::vector<uint64_t> _samples_in_ns;
+		bool _is_sorted;
+
+	public:
+		latency_samples()
+			: _is_sorted(true) {
+		}
+
+		void reserve(size_t count) {
+			_samples_in_ns.reserve(count);
+		}
+
+		void record(std::chrono::steady_clock::duration latency) {
+			const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+			_samples_in_ns.push_back(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+			_is_sorted = false;
+		}
+
+		size_t size() const {
+			return _samples_in_ns.size();
+		}
+
+		//percentile in [0, 100].
+		uint64_t get_percentile_in_ns(double percentile) {
+			if (_samples_in_ns.empty()) {
+				return 0;
+			}
+
+			if (!_is_sorted) {
+				std::sort(_samples_in_ns.begin(), _samples_in_ns.end());
+				_is_sorted = true;
+			}
+
+			const size_t index = static_cast<size_t>(percentile / 100.0 * (_samples_in_ns.size() - 1) + 0.5);
+			return _samples_in_ns[std::min(index, _samples_in_ns.size() - 1)];
+		}
+	};
+
+}
+
+#define ENETPP_TEST(name) \
+	static bool name(); \
+	static enetpp_test::test_registrar name##_registrar(#name, name, false); \
+	static bool name()
+
+#define ENETPP_BENCHMARK(name) \
+	static bool name(); \
+	static enetpp_test::test_registrar name##_registrar(#name, name, true); \
+	static bool name()
+
+#endif
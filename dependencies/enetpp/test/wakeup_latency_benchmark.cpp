@@ -0,0 +1,141 @@
+//enqueue to wire latency of the worker loop, before and after wakeup_socket. a producer thread pushes a packet every
+//few hundred microseconds at a random phase to the worker, the worker pops it and sends it as a datagram from its
+//host socket, and a receiver thread timestamps the datagram when it arrives.
+//
+//before: the worker sleeps 1 ms between loops, like client::run_in_thread used to.
+//after: the worker blocks in wakeup_socket::wait on its host socket and the producer signals after every push.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include "enetpp/global_state.h"
+#include "enetpp/spsc_ring.h"
+#include "enetpp/wakeup_socket.h"
+#include "test.h"
+
+static const int PACKET_COUNT = 2000;
+static const int MIN_SEND_INTERVAL_IN_US = 200;
+static const int MAX_SEND_INTERVAL_IN_US = 1000;
+
+using time_stamp = std::chrono::steady_clock::rep;
+
+static time_stamp get_time_stamp() {
+	return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+template<typename WorkerLoop>
+static void run_wakeup_benchmark(const char* name, WorkerLoop&& worker_loop) {
+	ENetHost* host = enet_host_create(nullptr, 1, 1, 0, 0);
+
+	ENetSocket receiver = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+	ENetAddress receiver_address;
+	enet_address_set_host_ip(&receiver_address, "127.0.0.1");
+	receiver_address.port = 0;
+	if (host == nullptr || receiver == ENET_SOCKET_NULL ||
+		enet_socket_bind(receiver, &receiver_address) != 0 ||
+		enet_socket_get_address(receiver, &receiver_address) != 0) {
+		printf("  %-12s could not create sockets\n", name);
+		if (receiver != ENET_SOCKET_NULL) {
+			enet_socket_destroy(receiver);
+		}
+		if (host != nullptr) {
+			enet_host_destroy(host);
+		}
+		return;
+	}
+	enet_address_set_host_ip(&receiver_address, "127.0.0.1");
+
+	enetpp::spsc_ring<time_stamp> queue;
+	queue.reset(1024);
+	enetpp::wakeup_socket wakeup;
+	wakeup.open();
+
+	std::atomic<bool> should_exit{ false };
+	enetpp_test::latency_samples latency;
+	latency.reserve(PACKET_COUNT);
+
+	std::thread receiver_thread([&]() {
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (latency.size() < PACKET_COUNT && std::chrono::steady_clock::now() < deadline) {
+			ENetSocketSet read_set;
+			ENET_SOCKETSET_EMPTY(read_set);
+			ENET_SOCKETSET_ADD(read_set, receiver);
+			if (enet_socketset_select(receiver, &read_set, nullptr, 100) <= 0) {
+				continue;
+			}
+
+			time_stamp sent_time = 0;
+			ENetBuffer buffer;
+			buffer.data = &sent_time;
+			buffer.dataLength = sizeof(sent_time);
+			if (enet_socket_receive(receiver, nullptr, &buffer, 1) == sizeof(sent_time)) {
+				latency.record(std::chrono::steady_clock::duration(get_time_stamp() - sent_time));
+			}
+		}
+	});
+
+	auto send_queued = [&]() {
+		time_stamp sent_time;
+		while (queue.try_pop(sent_time)) {
+			ENetBuffer buffer;
+			buffer.data = &sent_time;
+			buffer.dataLength = sizeof(sent_time);
+			enet_socket_send(host->socket, &receiver_address, &buffer, 1);
+		}
+	};
+
+	std::thread worker_thread([&]() {
+		worker_loop(host, wakeup, should_exit, send_queued);
+	});
+
+	std::mt19937 random(1234);
+	std::uniform_int_distribution<int> interval(MIN_SEND_INTERVAL_IN_US, MAX_SEND_INTERVAL_IN_US);
+	for (int i = 0; i < PACKET_COUNT; ++i) {
+		std::this_thread::sleep_for(std::chrono::microseconds(interval(random)));
+		while (!queue.try_push(get_time_stamp())) {
+			std::this_thread::yield();
+		}
+		wakeup.signal();
+	}
+
+	receiver_thread.join();
+	should_exit = true;
+	wakeup.signal();
+	worker_thread.join();
+
+	printf("  %-12s enqueue to wire p50 %7.1f us  p99 %7.1f us  max %7.1f us  (%zu / %d packets)\n",
+		name,
+		latency.get_percentile_in_ns(50.0) / 1000.0,
+		latency.get_percentile_in_ns(99.0) / 1000.0,
+		latency.get_percentile_in_ns(100.0) / 1000.0,
+		latency.size(),
+		PACKET_COUNT);
+
+	wakeup.close();
+	enet_socket_destroy(receiver);
+	enet_host_destroy(host);
+}
+
+ENETPP_BENCHMARK(wakeup_latency_benchmark) {
+	enetpp::global_state::get().initialize();
+
+	run_wakeup_benchmark("1 ms sleep", [](ENetHost* host, enetpp::wakeup_socket& wakeup, std::atomic<bool>& should_exit, auto& send_queued) {
+		while (!should_exit) {
+			send_queued();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+
+	run_wakeup_benchmark("wakeup", [](ENetHost* host, enetpp::wakeup_socket& wakeup, std::atomic<bool>& should_exit, auto& send_queued) {
+		while (!should_exit) {
+			wakeup.reset();
+			send_queued();
+			wakeup.wait(host, 10);
+		}
+	});
+
+	enetpp::global_state::get().deinitialize();
+	return true;
+}
@@ -31,7 +31,7 @@ type MockClient struct {
 }
 
 func (mock *MockClient) sendPing(peer enet.Peer) {
-	peer.SendBytes(core.MakeEmptyPacketBytes(nier.PacketTypeID_PING), 0, enet.PacketFlagReliable)
+	core.SendPacketBytes(peer, nier.PacketTypeID_PING, core.MakeEmptyPacketBytes(nier.PacketTypeID_PING))
 }
 
 func (mock *MockClient) sendHello(peer enet.Peer, name string, password string) {
@@ -50,7 +50,7 @@ func (mock *MockClient) sendHello(peer enet.Peer, name string, password string)
 	})
 
 	pkt := core.MakePacketBytes(nier.PacketTypeID_HELLO, helloBytes)
-	peer.SendBytes(pkt, 0, enet.PacketFlagReliable)
+	core.SendPacketBytes(peer, nier.PacketTypeID_HELLO, pkt)
 }
 
 func (mock *MockClient) getNextPacket(ev enet.Event) *nier.Packet {
@@ -159,14 +159,14 @@ func (mock *MockClient) Run() {
 	enet.Initialize()
 
 	// Create a client host
-	client, err := enet.NewHost(nil, 1, 1, 0, 0)
+	client, err := enet.NewHost(nil, 1, core.ChannelCount, 0, 0)
 	if err != nil {
 		log.Error("Couldn't create host: %s", err.Error())
 		return
 	}
 
 	// Connect the client host to the server
-	peer, err := client.Connect(enet.NewAddress("127.0.0.1", 6969), 1, 0)
+	peer, err := client.Connect(enet.NewAddress("127.0.0.1", 6969), core.ChannelCount, 0)
 	if err != nil {
 		log.Error("Couldn't connect: %s", err.Error())
 		return
@@ -196,7 +196,7 @@ func (mock *MockClient) Run() {
 				})
 
 				animationData := core.MakePacketBytes(nier.PacketTypeID_ANIMATION_START, animationStartBytes)
-				peer.SendBytes(animationData, 0, enet.PacketFlagReliable)
+				core.SendPacketBytes(peer, nier.PacketTypeID_ANIMATION_START, animationData)
 
 				once_test = false
 			}
@@ -217,7 +217,7 @@ func (mock *MockClient) Run() {
 				})
 
 				packetData := core.MakePacketBytes(nier.PacketTypeID_PLAYER_DATA, playerDataBytes)
-				peer.SendBytes(packetData, 0, enet.PacketFlagReliable)
+				core.SendPacketBytes(peer, nier.PacketTypeID_PLAYER_DATA, packetData)
 				sendUpdateTime = now
 				continue
 			}
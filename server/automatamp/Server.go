@@ -54,6 +54,7 @@ func handleDisconnect(connection *structs.Connection, peer enet.Peer) {
 
 	if connection.Client != nil {
 		handlers.HandleDestroyPlayer(currentServer, connection)
+		core.FreePlayerSlot(currentServer, connection.Client)
 		delete(currentServer.Clients, connection)
 	}
 
@@ -64,6 +65,7 @@ func handleDisconnect(connection *structs.Connection, peer enet.Peer) {
 	if len(currentServer.Clients) == 0 {
 		currentServer.Entities = make(structs.EntityList)
 		currentServer.HighestEntityGuid = 0
+		currentServer.Strings = structs.StringTable{Ids: make(map[string]uint32)} // nobody is left holding a copy
 	}
 
 	delete(currentServer.Connections, peer)
@@ -127,6 +129,12 @@ func service() {
 
 		ev = currentServer.Host.Service(0)
 	}
+
+	// Everything sent to V2 clients during this pass goes out batched.
+	for _, connection := range currentServer.Connections {
+		core.QueuePlayerDataAck(connection)
+		core.FlushPackets(connection)
+	}
 }
 
 func cleanup() {
@@ -227,7 +235,7 @@ func Run() {
 	}
 
 	// Create a host listening on 0.0.0.0:6969
-	host, err := enet.NewHost(enet.NewListenAddress(uint16(port)), 32, 1, 0, 0)
+	host, err := enet.NewHost(enet.NewListenAddress(uint16(port)), structs.MaxPlayerSlots, core.ChannelCount, 0, 0)
 	if err != nil {
 		log.Error("Couldn't create host: %s", err.Error())
 		panic(err)
@@ -258,18 +266,27 @@ func CreateServer() {
 
 	currentServer.Connections = make(map[enet.Peer]*structs.Connection)
 	currentServer.Clients = make(map[*structs.Connection]*structs.Client)
+	currentServer.PlayerSlots = [structs.MaxPlayerSlots]*structs.Client{}
 	currentServer.Entities = make(structs.EntityList)
 	currentServer.Config = make(map[string]interface{})
 	currentServer.ConnectionCount = 0
 	currentServer.HighestEntityGuid = 0
+	currentServer.Strings = structs.StringTable{Ids: make(map[string]uint32)}
 	currentServer.Config["password"] = ""
 	currentServer.Config["masterServer"] = "http://localhost"
 	currentServer.Config["masterServerNotify"] = true
 	currentServer.Config["name"] = "AutomataMP Server"
 	currentServer.Config["port"] = "6969"
+	currentServer.Config["positionPrecision"] = core.DefaultPositionPrecision // meters, 0 sends positions as floats
 
 	json.Unmarshal(serverJson, &currentServer.Config)
 	log.Info("Server password: %s", currentServer.Config["password"].(string))
 
+	if precision := core.GetPositionPrecision(currentServer); precision > 0 {
+		log.Info("Position precision: %f", precision)
+	} else {
+		log.Info("Position quantization disabled")
+	}
+
 	Run()
 }
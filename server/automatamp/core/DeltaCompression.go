@@ -0,0 +1,264 @@
+package core
+
+import (
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+// Quantized player data sent as the XOR against an update the receiver acked, see nier.PlayerDataMessage.Delta.
+// The relay decodes what each client sends and encodes it again against what every recipient acked.
+// Must match src/mods/multiplayer/DeltaCompression.hpp.
+const (
+	zeroRunFlag = 0x80
+	maxRun      = 0x80
+
+	// Offsets of the structs a state is made of, in wire layout.
+	playerStateOrientation     = 24
+	playerStateAngularVelocity = playerStateOrientation + 4
+)
+
+// True if sequence a came after b, sequences wrap around.
+func isNewerSequence(a, b uint16) bool {
+	return int16(a-b) > 0
+}
+
+func MakePlayerState(quantized *nier.QuantizedPlayerData, orientation *nier.CompressedQuaternion, angularVelocity *nier.QuantizedAngularVelocity) structs.PlayerState {
+	var state structs.PlayerState
+
+	// Structs are read in place, so their bytes are the wire format. A missing one stays zero.
+	if quantized != nil {
+		copyStructBytes(state[:playerStateOrientation], quantized.Table())
+	}
+
+	if orientation != nil {
+		copyStructBytes(state[playerStateOrientation:playerStateAngularVelocity], orientation.Table())
+	}
+
+	if angularVelocity != nil {
+		copyStructBytes(state[playerStateAngularVelocity:], angularVelocity.Table())
+	}
+
+	return state
+}
+
+// The structs of a decoded state, viewing the state's own bytes.
+func ReadPlayerState(state *structs.PlayerState) (quantized *nier.QuantizedPlayerData, orientation *nier.CompressedQuaternion, angularVelocity *nier.QuantizedAngularVelocity) {
+	quantized = &nier.QuantizedPlayerData{}
+	quantized.Init(state[:], 0)
+
+	orientation = &nier.CompressedQuaternion{}
+	orientation.Init(state[:], playerStateOrientation)
+
+	angularVelocity = &nier.QuantizedAngularVelocity{}
+	angularVelocity.Init(state[:], playerStateAngularVelocity)
+	return
+}
+
+func copyStructBytes(out []uint8, table flatbuffers.Table) {
+	copy(out, table.Bytes[table.Pos:int(table.Pos)+len(out)])
+}
+
+// Appends state XOR baseline to out. A control byte below 0x80 is followed by that many plus one
+// literal bytes, one above it stands for (control & 0x7F) + 1 zero bytes.
+func encodeDelta(state, baseline *structs.PlayerState, out []uint8) []uint8 {
+	var xored structs.PlayerState
+
+	for i := range xored {
+		xored[i] = state[i] ^ baseline[i]
+	}
+
+	for i := 0; i < len(xored); {
+		zero := xored[i] == 0
+		end := i + 1
+
+		for end < len(xored) && end-i < maxRun && (xored[end] == 0) == zero {
+			end++
+		}
+
+		if zero {
+			out = append(out, zeroRunFlag|uint8(end-i-1))
+		} else {
+			out = append(out, uint8(end-i-1))
+			out = append(out, xored[i:end]...)
+		}
+
+		i = end
+	}
+
+	return out
+}
+
+// False if delta is malformed or doesn't cover exactly one state.
+func decodeDelta(delta []uint8, baseline, state *structs.PlayerState) bool {
+	written := 0
+
+	for i := 0; i < len(delta); {
+		control := delta[i]
+		length := int(control&^zeroRunFlag) + 1
+		i++
+
+		if written+length > len(state) {
+			return false
+		}
+
+		if control&zeroRunFlag != 0 {
+			copy(state[written:written+length], baseline[written:written+length])
+		} else {
+			if i+length > len(delta) {
+				return false
+			}
+
+			for j := 0; j < length; j++ {
+				state[written+j] = baseline[written+j] ^ delta[i+j]
+			}
+
+			i += length
+		}
+
+		written += length
+	}
+
+	return written == len(state)
+}
+
+func findBaseline(stream *structs.PlayerDataStream, sequence uint16) *structs.PlayerState {
+	entry := &stream.Baselines[sequence%structs.PlayerDataBaselineCount]
+
+	if !entry.Valid || entry.Sequence != sequence {
+		return nil
+	}
+
+	return &entry.State
+}
+
+func storeBaseline(stream *structs.PlayerDataStream, sequence uint16, state *structs.PlayerState) {
+	stream.Baselines[sequence%structs.PlayerDataBaselineCount] = structs.PlayerDataBaseline{Sequence: sequence, State: *state, Valid: true}
+}
+
+// Encodes state against the newest acked state, or against zeros while there is none.
+// baseline == sequence tells the receiver which one it was.
+func EncodePlayerState(stream *structs.PlayerDataStream, state *structs.PlayerState) (delta []uint8, sequence, baseline uint16) {
+	var zeros structs.PlayerState
+
+	stream.Sequence++
+	sequence = stream.Sequence
+	baseline = sequence
+	baselineState := &zeros
+
+	// An ack that fell out of the ring would point the receiver at a state it has overwritten too.
+	if stream.HasAck && sequence-stream.Acked < structs.PlayerDataBaselineCount {
+		if acked := findBaseline(stream, stream.Acked); acked != nil {
+			baseline = stream.Acked
+			baselineState = acked
+		}
+	}
+
+	delta = encodeDelta(state, baselineState, make([]uint8, 0, structs.PlayerStateSize+4))
+	storeBaseline(stream, sequence, state)
+	return
+}
+
+func OnPlayerDataAck(stream *structs.PlayerDataStream, sequence uint16) {
+	// Acks for updates that were never sent come from a confused or stale client.
+	if isNewerSequence(sequence, stream.Sequence) || (stream.HasAck && !isNewerSequence(sequence, stream.Acked)) {
+		return
+	}
+
+	stream.Acked = sequence
+	stream.HasAck = true
+}
+
+// False if the update is older than one already decoded or its baseline is gone, it is dropped then.
+func DecodePlayerState(stream *structs.PlayerDataStream, sequence, baseline uint16, delta []uint8) (state structs.PlayerState, ok bool) {
+	var zeros structs.PlayerState
+
+	if stream.HasSequence && !isNewerSequence(sequence, stream.Sequence) {
+		return state, false
+	}
+
+	baselineState := &zeros
+
+	if baseline != sequence {
+		baselineState = findBaseline(stream, baseline)
+	}
+
+	if baselineState == nil || !decodeDelta(delta, baselineState, &state) {
+		return state, false
+	}
+
+	storeBaseline(stream, sequence, &state)
+	stream.Sequence = sequence
+	stream.HasSequence = true
+	stream.AckPending = true
+	return state, true
+}
+
+// Acks the newest update decoded from the client since the last call, under the client's own guid.
+func QueuePlayerDataAck(connection *structs.Connection) {
+	stream := &connection.PlayerDataIn
+
+	if !stream.AckPending || connection.Client == nil {
+		return
+	}
+
+	stream.AckPending = false
+	queuePacketBytes(connection, nier.PacketTypeID_PLAYER_DATA_ACK,
+		makePlayerDataAckBytes([]uint64{connection.Client.Guid}, []uint16{stream.Sequence}))
+}
+
+func makePlayerDataAckBytes(guids []uint64, sequences []uint16) []uint8 {
+	builder := flatbuffers.NewBuilder(0)
+
+	nier.PlayerDataAckStartSequencesVector(builder, len(sequences))
+	for i := len(sequences) - 1; i >= 0; i-- {
+		builder.PrependUint16(sequences[i])
+	}
+	sequencesOffs := builder.EndVector(len(sequences))
+
+	nier.PlayerDataAckStartGuidsVector(builder, len(guids))
+	for i := len(guids) - 1; i >= 0; i-- {
+		builder.PrependUint64(guids[i])
+	}
+	guidsOffs := builder.EndVector(len(guids))
+
+	nier.PlayerDataAckStart(builder)
+	nier.PlayerDataAckAddGuids(builder, guidsOffs)
+	nier.PlayerDataAckAddSequences(builder, sequencesOffs)
+	ack := nier.PlayerDataAckEnd(builder)
+
+	nier.PacketV2Start(builder)
+	nier.PacketV2AddId(builder, nier.PacketTypeID_PLAYER_DATA_ACK)
+	nier.PacketV2AddMessageType(builder, nier.MessagePlayerDataAck)
+	nier.PacketV2AddMessage(builder, ack)
+	builder.FinishWithFileIdentifier(nier.PacketV2End(builder), []byte(PacketV2Identifier))
+	return builder.FinishedBytes()
+}
+
+// Returns the acks of a V2 ack packet, nil if it is malformed.
+func GetPlayerDataAck(data []uint8) (out *nier.PlayerDataAck) {
+	defer handlepanic()
+
+	packet := nier.GetRootAsPacketV2(data, 0)
+	messageTable := flatbuffers.Table{}
+
+	if packet.MessageType() != nier.MessagePlayerDataAck || !packet.Message(&messageTable) {
+		return nil
+	}
+
+	ack := &nier.PlayerDataAck{}
+	ack.Init(messageTable.Bytes, messageTable.Pos)
+
+	if ack.GuidsLength() != ack.SequencesLength() {
+		return nil
+	}
+
+	// Reads the last of each once, so a vector past the end of the buffer panics here.
+	if n := ack.GuidsLength(); n > 0 {
+		ack.Guids(n - 1)
+		ack.Sequences(n - 1)
+	}
+
+	return ack
+}
@@ -0,0 +1,299 @@
+package core
+
+import (
+	"bytes"
+	"encoding/binary"
+	"math"
+	"testing"
+
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+)
+
+// Must match delta_compression_shared_vector in test/multiplayer/DeltaCompressionTest.cpp.
+var sharedDelta = []uint8{
+	0x00, 0x10,
+	0x84,
+	0x01, 0x42, 0x14,
+	0x93,
+	0x03, 0xBD, 0xAF, 0xDD, 0xCB,
+	0x80,
+	0x00, 0x21,
+}
+
+func makeSharedBaseline() structs.PlayerState {
+	var baseline structs.PlayerState
+
+	for i := range baseline {
+		baseline[i] = uint8(i)
+	}
+
+	return baseline
+}
+
+func makeSharedState() structs.PlayerState {
+	state := makeSharedBaseline()
+	state[0] = 0x10
+	state[6] = 0x44
+	state[7] = 0x13
+	state[28] = 0xA1
+	state[29] = 0xB2
+	state[30] = 0xC3
+	state[31] = 0xD4
+	state[33] = 0x00
+	return state
+}
+
+// A state in wire layout, see nier.QuantizedPlayerData, nier.CompressedQuaternion and nier.QuantizedAngularVelocity.
+func makeTraceState(x, y, z int16, facing uint16, speed float32, buttons uint32, orientation uint32, yawRate int16) structs.PlayerState {
+	var state structs.PlayerState
+
+	binary.LittleEndian.PutUint16(state[0:], uint16(x))
+	binary.LittleEndian.PutUint16(state[2:], uint16(y))
+	binary.LittleEndian.PutUint16(state[4:], uint16(z))
+	binary.LittleEndian.PutUint16(state[6:], facing)
+	binary.LittleEndian.PutUint16(state[8:], facing)
+	state[10] = 2 // sector
+	state[12] = 1 // weapon
+	binary.LittleEndian.PutUint32(state[16:], math.Float32bits(speed))
+	binary.LittleEndian.PutUint32(state[20:], buttons)
+	binary.LittleEndian.PutUint32(state[playerStateOrientation:], orientation)
+	binary.LittleEndian.PutUint16(state[playerStateAngularVelocity+2:], uint16(yawRate))
+	return state
+}
+
+// Synthetic, not recorded from a session: a player standing, then running and turning, then standing again,
+// at 60 ticks a second. Standing still is where deltas save the most, so the idle share drives the result.
+func makeSyntheticTrace(ticks int) []structs.PlayerState {
+	trace := make([]structs.PlayerState, ticks)
+	x, z := 0.0, 0.0
+	yaw := 0.0
+
+	for tick := range trace {
+		phase := tick % 600
+		speed, yawRate := 0.0, 0.0
+
+		// 4 seconds running out of every 10, turning for half of it.
+		if phase >= 120 && phase < 360 {
+			speed = 6.0
+
+			if phase >= 240 {
+				yawRate = 1.5
+			}
+		}
+
+		yaw += yawRate / 60
+		x += math.Sin(yaw) * speed / 60
+		z += math.Cos(yaw) * speed / 60
+
+		// Attack held now and then while running.
+		buttons := uint32(0)
+		if speed > 0 && tick%90 < 20 {
+			buttons = 0x10
+		}
+
+		// Quantized like the client does, centimeters and 1/65536 turns.
+		facing := uint16(int64(yaw / (2 * math.Pi) * 65536))
+		trace[tick] = makeTraceState(int16(int64(x*100)), 120, int16(int64(z*100)), facing, float32(speed), buttons,
+			0x40000000|uint32(facing)<<8, int16(yawRate*100))
+	}
+
+	return trace
+}
+
+func TestPlayerStateDeltaSharedVector(t *testing.T) {
+	baseline, state := makeSharedBaseline(), makeSharedState()
+
+	if out := encodeDelta(&state, &baseline, nil); !bytes.Equal(out, sharedDelta) {
+		t.Fatalf("got % X, want % X", out, sharedDelta)
+	}
+
+	var decoded structs.PlayerState
+
+	if !decodeDelta(sharedDelta, &baseline, &decoded) || decoded != state {
+		t.Fatalf("got % X, want % X", decoded, state)
+	}
+}
+
+func TestPlayerStateDeltaMalformed(t *testing.T) {
+	baseline := makeSharedBaseline()
+	malformed := [][]uint8{
+		{},
+		{0x80 | 32},                         // covers less than a state
+		{0x80 | 33, 0x80},                   // covers more than a state
+		{0xFF},                              // one run longer than a state
+		{0x80 | 31, 0x01, 0xAA},             // literal run past the end of the delta
+		{0x80 | 31, 0x02, 0xAA, 0xBB, 0xCC}, // literal run past the end of the state
+	}
+
+	// No prefix of a valid delta decodes either.
+	for size := 0; size < len(sharedDelta); size++ {
+		malformed = append(malformed, sharedDelta[:size])
+	}
+
+	for _, delta := range malformed {
+		var state structs.PlayerState
+
+		if decodeDelta(delta, &baseline, &state) {
+			t.Fatalf("decoded malformed delta % X", delta)
+		}
+	}
+}
+
+func TestPlayerDataAckIgnoresUnsentAndStale(t *testing.T) {
+	var stream structs.PlayerDataStream
+	state := makeSharedState()
+
+	// Nothing sent yet.
+	OnPlayerDataAck(&stream, 1)
+
+	if _, sequence, baseline := EncodePlayerState(&stream, &state); sequence != 1 || baseline != sequence {
+		t.Fatalf("got sequence %d baseline %d, want both 1", sequence, baseline)
+	}
+
+	EncodePlayerState(&stream, &state)
+	OnPlayerDataAck(&stream, 2)
+	OnPlayerDataAck(&stream, 1)
+
+	if _, sequence, baseline := EncodePlayerState(&stream, &state); sequence != 3 || baseline != 2 {
+		t.Fatalf("got sequence %d baseline %d, want 3 against 2", sequence, baseline)
+	}
+
+	// Back to zeros once the ack fell out of the ring.
+	for i := 0; i < structs.PlayerDataBaselineCount-2; i++ {
+		EncodePlayerState(&stream, &state)
+	}
+
+	if _, sequence, baseline := EncodePlayerState(&stream, &state); baseline != sequence {
+		t.Fatalf("sequence %d still encoded against %d", sequence, baseline)
+	}
+}
+
+func TestPlayerDataAckRoundTrip(t *testing.T) {
+	guids := []uint64{1, 0xFFFFFFFFFFFFFFFF}
+	sequences := []uint16{7, 65535}
+	ack := GetPlayerDataAck(makePlayerDataAckBytes(guids, sequences))
+
+	if ack == nil || ack.GuidsLength() != len(guids) {
+		t.Fatalf("ack didn't decode")
+	}
+
+	for i := range guids {
+		if ack.Guids(i) != guids[i] || ack.Sequences(i) != sequences[i] {
+			t.Fatalf("ack %d is %d for %d, want %d for %d", i, ack.Sequences(i), ack.Guids(i), sequences[i], guids[i])
+		}
+	}
+}
+
+// Updates and acks are lost and reordered across the sequence wrap, every decoded state must still be the one that was sent.
+func TestPlayerStateLostUpdatesNeverCorrupt(t *testing.T) {
+	type update struct {
+		sequence, baseline uint16
+		delta              []uint8
+		state              structs.PlayerState
+	}
+
+	var sender, receiver structs.PlayerDataStream
+	var inFlight []update
+	var acksInFlight []uint16
+
+	trace := makeSyntheticTrace(70000)
+	random := uint32(7)
+	chance := func(percent uint32) bool {
+		random = random*1664525 + 1013904223
+		return (random>>8)%100 < percent
+	}
+
+	decoded := 0
+
+	for tick := range trace {
+		delta, sequence, baseline := EncodePlayerState(&sender, &trace[tick])
+		sent := update{sequence, baseline, delta, trace[tick]}
+
+		// 10% loss, the rest may swap with the update before it.
+		if !chance(10) {
+			if len(inFlight) > 0 && chance(20) {
+				inFlight = append(inFlight[:len(inFlight)-1], sent, inFlight[len(inFlight)-1])
+			} else {
+				inFlight = append(inFlight, sent)
+			}
+		}
+
+		// A couple of ticks of latency.
+		for ; len(inFlight) > 2; inFlight = inFlight[1:] {
+			received := inFlight[0]
+			newest, hadNewest := receiver.Sequence, receiver.HasSequence
+
+			state, ok := DecodePlayerState(&receiver, received.sequence, received.baseline, received.delta)
+
+			if !ok {
+				continue
+			}
+
+			if state != received.state {
+				t.Fatalf("sequence %d decoded to % X, want % X", received.sequence, state, received.state)
+			}
+
+			if hadNewest && !isNewerSequence(received.sequence, newest) {
+				t.Fatalf("sequence %d decoded after %d", received.sequence, newest)
+			}
+
+			decoded++
+		}
+
+		if receiver.AckPending {
+			receiver.AckPending = false
+
+			if !chance(10) {
+				acksInFlight = append(acksInFlight, receiver.Sequence)
+			}
+		}
+
+		for ; len(acksInFlight) > 2; acksInFlight = acksInFlight[1:] {
+			OnPlayerDataAck(&sender, acksInFlight[0])
+		}
+	}
+
+	if decoded < len(trace)*7/10 {
+		t.Fatalf("only %d of %d updates decoded", decoded, len(trace))
+	}
+}
+
+// Replays the synthetic trace with a 100 ms round trip and 2% loss, and reports what the deltas cost
+// against sending every state raw. Run with: go test -run '^$' -bench PlayerStateDelta ./automatamp/core/
+func BenchmarkPlayerStateDeltaSyntheticTrace(b *testing.B) {
+	const roundTripTicks = 6
+
+	trace := makeSyntheticTrace(60 * 60)
+	deltaBytes, updates := 0, 0
+
+	for i := 0; i < b.N; i++ {
+		var sender, receiver structs.PlayerDataStream
+		acks := make([]uint16, 0, roundTripTicks+1)
+		random := uint32(1)
+
+		for tick := range trace {
+			delta, sequence, baseline := EncodePlayerState(&sender, &trace[tick])
+			deltaBytes += len(delta)
+			updates++
+
+			random = random*1664525 + 1013904223
+			if (random>>8)%100 >= 2 {
+				DecodePlayerState(&receiver, sequence, baseline, delta)
+			}
+
+			if receiver.AckPending {
+				receiver.AckPending = false
+				acks = append(acks, receiver.Sequence)
+			}
+
+			if len(acks) > roundTripTicks {
+				OnPlayerDataAck(&sender, acks[0])
+				acks = acks[1:]
+			}
+		}
+	}
+
+	b.ReportMetric(float64(deltaBytes)/float64(updates), "delta-B/update")
+	b.ReportMetric(structs.PlayerStateSize, "raw-B/update")
+	b.ReportMetric(float64(deltaBytes)/float64(updates*structs.PlayerStateSize)*100, "%-of-raw")
+}
@@ -0,0 +1,317 @@
+package core
+
+import (
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+
+	"github.com/codecat/go-enet"
+	"github.com/codecat/go-libs/log"
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+// One entity of a snapshot with floats for its position and facings, whichever encoding the snapshot used.
+type entitySnapshotEntry struct {
+	guid            uint32
+	x, y, z         float32
+	facing, facing2 float32
+	health          uint32
+	orientation     uint32   // compressed, only set if hasOrientations
+	velocity        [3]int16 // quantized, only set if hasVelocities
+}
+
+// Returns the snapshot carried by a V2 packet, or nil if it is malformed.
+func GetEntitySnapshot(data []uint8) (out *nier.EntitySnapshot) {
+	defer handlepanic()
+
+	packet := nier.GetRootAsPacketV2(data, 0)
+	messageTable := flatbuffers.Table{}
+
+	if packet.MessageType() != nier.MessageEntitySnapshot || !packet.Message(&messageTable) {
+		return nil
+	}
+
+	snapshot := &nier.EntitySnapshot{}
+	snapshot.Init(messageTable.Bytes, messageTable.Pos)
+
+	count := snapshot.GuidsLength()
+
+	if (snapshot.HealthsLength() != count && !hasDirty(snapshot)) || (snapshot.OrientationsLength() != 0 && snapshot.OrientationsLength() != count) ||
+		(snapshot.VelocitiesLength() != 0 && snapshot.VelocitiesLength() != count) {
+		return nil
+	}
+
+	if isQuantizedEntitySnapshot(snapshot) {
+		if snapshot.QuantizedPositionsLength() != count || snapshot.QuantizedFacingsLength() != count ||
+			snapshot.QuantizedFacings2Length() != count {
+			return nil
+		}
+	} else if snapshot.PositionsLength() != count || snapshot.FacingsLength() != count || snapshot.Facings2Length() != count {
+		return nil
+	}
+
+	return snapshot
+}
+
+// Quantized snapshots always carry the sector their positions are relative to.
+func isQuantizedEntitySnapshot(snapshot *nier.EntitySnapshot) bool {
+	return snapshot.Sector(nil) != nil
+}
+
+// Masters that replicate properties send a dirty mask per entity instead of healths.
+func hasDirty(snapshot *nier.EntitySnapshot) bool {
+	return snapshot.HealthsLength() == 0 && snapshot.DirtyLength() == snapshot.GuidsLength() && snapshot.DirtyLength() != 0
+}
+
+// Orientations are optional, masters that predate them leave them out.
+func hasOrientations(snapshot *nier.EntitySnapshot) bool {
+	return snapshot.OrientationsLength() != 0
+}
+
+// Velocities are optional too, receivers without them show every snapshot as it arrives.
+func hasVelocities(snapshot *nier.EntitySnapshot) bool {
+	return snapshot.VelocitiesLength() != 0
+}
+
+// precision is the one negotiated with the sender. Returns nil if the snapshot is malformed.
+// Healths that aren't dirty come from the last snapshot that had them, the dirty ones are kept in entities for the next.
+func decodeEntitySnapshot(snapshot *nier.EntitySnapshot, precision float32, entities structs.EntityList) (out []entitySnapshotEntry) {
+	defer handlepanic()
+
+	entries := make([]entitySnapshotEntry, snapshot.GuidsLength())
+
+	if isQuantizedEntitySnapshot(snapshot) {
+		sector := snapshot.Sector(nil)
+		position := &nier.QuantizedVector3{}
+
+		for i := range entries {
+			snapshot.QuantizedPositions(position, i)
+			entry := &entries[i]
+			entry.x, entry.y, entry.z = DequantizePosition(position, sector.X(), sector.Y(), sector.Z(), precision)
+			entry.facing = DequantizeYaw(snapshot.QuantizedFacings(i))
+			entry.facing2 = DequantizeYaw(snapshot.QuantizedFacings2(i))
+		}
+	} else {
+		position := &nier.Vector3f{}
+
+		for i := range entries {
+			snapshot.Positions(position, i)
+			entry := &entries[i]
+			entry.x, entry.y, entry.z = position.X(), position.Y(), position.Z()
+			entry.facing = snapshot.Facings(i)
+			entry.facing2 = snapshot.Facings2(i)
+		}
+	}
+
+	properties := snapshot.PropertiesBytes()
+	offset := 0
+
+	for i := range entries {
+		entry := &entries[i]
+		entry.guid = snapshot.Guids(i)
+		entity := entities[entry.guid]
+
+		if !hasDirty(snapshot) {
+			entry.health = snapshot.Healths(i)
+		} else {
+			if entity != nil {
+				entry.health = entity.Health
+			}
+
+			if !readEntityProperties(properties, snapshot.Dirty(i), &offset, &entry.health) {
+				return nil
+			}
+		}
+
+		if entity != nil {
+			entity.Health = entry.health
+		}
+	}
+
+	if hasDirty(snapshot) && offset != len(properties) {
+		return nil
+	}
+
+	if hasOrientations(snapshot) {
+		orientation := &nier.CompressedQuaternion{}
+
+		for i := range entries {
+			snapshot.Orientations(orientation, i)
+			entries[i].orientation = orientation.Value()
+		}
+	}
+
+	if hasVelocities(snapshot) {
+		velocity := &nier.QuantizedVelocity{}
+
+		for i := range entries {
+			snapshot.Velocities(velocity, i)
+			entries[i].velocity = [3]int16{velocity.X(), velocity.Y(), velocity.Z()}
+		}
+	}
+
+	return entries
+}
+
+// V1 clients get a snapshot as the entity data packets it replaces, entity data has no velocity so they snap to each one.
+func entitySnapshotToV1Packets(entries []entitySnapshotEntry) [][]uint8 {
+	packets := make([][]uint8, 0, len(entries))
+
+	for _, entry := range entries {
+		entityData := BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+			return nier.CreateEntityData(builder, entry.facing, entry.facing2, entry.health, entry.x, entry.y, entry.z)
+		})
+
+		packets = append(packets, MakeEntityPacketBytes(entry.guid, nier.PacketTypeID_ENTITY_DATA, entityData))
+	}
+
+	return packets
+}
+
+// V2 clients that read floats or healths get the snapshot re-encoded with both.
+func makeEntitySnapshotBytes(entries []entitySnapshotEntry, withOrientations bool, withVelocities bool) []uint8 {
+	builder := flatbuffers.NewBuilder(0)
+	count := len(entries)
+
+	var orientations flatbuffers.UOffsetT
+	var velocities flatbuffers.UOffsetT
+
+	if withVelocities {
+		nier.EntitySnapshotStartVelocitiesVector(builder, count)
+		for i := count - 1; i >= 0; i-- {
+			velocity := entries[i].velocity
+			nier.CreateQuantizedVelocity(builder, velocity[0], velocity[1], velocity[2])
+		}
+		velocities = builder.EndVector(count)
+	}
+
+	if withOrientations {
+		nier.EntitySnapshotStartOrientationsVector(builder, count)
+		for i := count - 1; i >= 0; i-- {
+			nier.CreateCompressedQuaternion(builder, entries[i].orientation)
+		}
+		orientations = builder.EndVector(count)
+	}
+
+	nier.EntitySnapshotStartGuidsVector(builder, count)
+	for i := count - 1; i >= 0; i-- {
+		builder.PrependUint32(entries[i].guid)
+	}
+	guids := builder.EndVector(count)
+
+	nier.EntitySnapshotStartPositionsVector(builder, count)
+	for i := count - 1; i >= 0; i-- {
+		nier.CreateVector3f(builder, entries[i].x, entries[i].y, entries[i].z)
+	}
+	positions := builder.EndVector(count)
+
+	nier.EntitySnapshotStartFacingsVector(builder, count)
+	for i := count - 1; i >= 0; i-- {
+		builder.PrependFloat32(entries[i].facing)
+	}
+	facings := builder.EndVector(count)
+
+	nier.EntitySnapshotStartFacings2Vector(builder, count)
+	for i := count - 1; i >= 0; i-- {
+		builder.PrependFloat32(entries[i].facing2)
+	}
+	facings2 := builder.EndVector(count)
+
+	nier.EntitySnapshotStartHealthsVector(builder, count)
+	for i := count - 1; i >= 0; i-- {
+		builder.PrependUint32(entries[i].health)
+	}
+	healths := builder.EndVector(count)
+
+	nier.EntitySnapshotStart(builder)
+	nier.EntitySnapshotAddGuids(builder, guids)
+	nier.EntitySnapshotAddPositions(builder, positions)
+	nier.EntitySnapshotAddFacings(builder, facings)
+	nier.EntitySnapshotAddFacings2(builder, facings2)
+	nier.EntitySnapshotAddHealths(builder, healths)
+
+	if withOrientations {
+		nier.EntitySnapshotAddOrientations(builder, orientations)
+	}
+
+	if withVelocities {
+		nier.EntitySnapshotAddVelocities(builder, velocities)
+	}
+
+	snapshot := nier.EntitySnapshotEnd(builder)
+
+	nier.PacketV2Start(builder)
+	nier.PacketV2AddId(builder, nier.PacketTypeID_ENTITY_SNAPSHOT)
+	nier.PacketV2AddMessageType(builder, nier.MessageEntitySnapshot)
+	nier.PacketV2AddMessage(builder, snapshot)
+	builder.FinishWithFileIdentifier(nier.PacketV2End(builder), []byte(PacketV2Identifier))
+	return builder.FinishedBytes()
+}
+
+// data is the V2 packet as it was received.
+// Clients that read it as it is get it untouched, the others get it decoded once and re-encoded.
+// Snapshots with dirty masks are always decoded, the relay fills in healths for clients that didn't negotiate them.
+func BroadcastEntitySnapshotToAllExceptSender(server *structs.Server, sender enet.Peer, connection *structs.Connection, data []uint8) {
+	snapshot := GetEntitySnapshot(data)
+
+	if snapshot == nil {
+		log.Error("Invalid entity snapshot from %s", sender.GetAddress())
+		return
+	}
+
+	quantized := isQuantizedEntitySnapshot(snapshot)
+
+	if quantized && connection.PositionPrecision == 0 {
+		log.Error("Quantized entity snapshot from %s, which didn't negotiate a position precision", sender.GetAddress())
+		return
+	}
+
+	var entries []entitySnapshotEntry
+	var v1Packets [][]uint8
+	var v2Bytes []uint8
+
+	decode := func() bool {
+		if entries == nil {
+			entries = decodeEntitySnapshot(snapshot, connection.PositionPrecision, server.Entities)
+		}
+
+		return entries != nil
+	}
+
+	dirty := hasDirty(snapshot)
+
+	if dirty && !decode() {
+		log.Error("Invalid entity properties from %s", sender.GetAddress())
+		return
+	}
+
+	for conn := range server.Clients {
+		if conn.Peer == sender {
+			continue
+		}
+
+		if conn.Protocol >= nier.ProtocolVersionV2 {
+			if (!quantized || conn.PositionPrecision > 0) && (!dirty || conn.ReplicatedProperties) {
+				queuePacketBytes(conn, nier.PacketTypeID_ENTITY_SNAPSHOT, data)
+				continue
+			}
+
+			if v2Bytes == nil && decode() {
+				v2Bytes = makeEntitySnapshotBytes(entries, hasOrientations(snapshot), hasVelocities(snapshot))
+			}
+
+			if v2Bytes != nil {
+				queuePacketBytes(conn, nier.PacketTypeID_ENTITY_SNAPSHOT, v2Bytes)
+			}
+
+			continue
+		}
+
+		if v1Packets == nil && decode() {
+			v1Packets = entitySnapshotToV1Packets(entries)
+		}
+
+		for _, packet := range v1Packets {
+			SendPacketBytes(conn.Peer, nier.PacketTypeID_ENTITY_DATA, packet)
+		}
+	}
+}
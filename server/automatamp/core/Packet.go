@@ -86,8 +86,8 @@ func MakePlayerPacketBytes(guid uint64, id nier.PacketType, data []uint8) []uint
 	return MakePacketBytes(id, playerPacketData)
 }
 
-func MakeEntityPacketBytes(guid uint32, id nier.PacketType, data []uint8) []uint8 {
-	entityPacketData := BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+func MakeEntityPacketData(guid uint32, data []uint8) []uint8 {
+	return BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
 		dataoffs := makeVectorData(builder, data)
 
 		nier.EntityPacketStart(builder)
@@ -95,6 +95,8 @@ func MakeEntityPacketBytes(guid uint32, id nier.PacketType, data []uint8) []uint
 		nier.EntityPacketAddData(builder, dataoffs)
 		return nier.EntityPacketEnd(builder)
 	})
+}
 
-	return MakePacketBytes(id, entityPacketData)
+func MakeEntityPacketBytes(guid uint32, id nier.PacketType, data []uint8) []uint8 {
+	return MakePacketBytes(id, MakeEntityPacketData(guid, data))
 }
@@ -0,0 +1,135 @@
+package core
+
+import (
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+
+	"github.com/codecat/go-enet"
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+// Batches are packed up to the MTU so they go out as one datagram.
+// Must match the budget in src/mods/multiplayer/PacketBatcher.hpp.
+const (
+	// ENET_HOST_DEFAULT_MTU, neither side changes it.
+	packetBatchMTU = 1392
+	// ENet's protocol header, the send command and a few acknowledgements sharing the datagram.
+	packetBatchENetOverhead = 48
+	// The PacketV2 and PacketBatch tables around the entries, and each entry's table and vector header, rounded up.
+	packetBatchEnvelopeSize = 48
+	packetBatchEntrySize    = 16
+
+	MaxPacketBatchSize = packetBatchMTU - packetBatchENetOverhead
+)
+
+func IsPacketBatch(data []uint8) bool {
+	return IsPacketV2(data) && GetPacketV2Id(data) == nier.PacketTypeID_PACKET_BATCH
+}
+
+// Returns the V2 packets carried by a batch, or nil if the batch is malformed.
+func SplitPacketBatch(data []uint8) (out [][]uint8) {
+	defer handlepanic()
+
+	packet := nier.GetRootAsPacketV2(data, 0)
+	messageTable := flatbuffers.Table{}
+
+	if packet.MessageType() != nier.MessagePacketBatch || !packet.Message(&messageTable) {
+		return nil
+	}
+
+	batch := &nier.PacketBatch{}
+	batch.Init(messageTable.Bytes, messageTable.Pos)
+
+	entry := &nier.PacketBatchEntry{}
+	packets := make([][]uint8, 0, batch.PacketsLength())
+
+	for i := 0; i < batch.PacketsLength(); i++ {
+		batch.Packets(entry, i)
+		entryBytes := entry.PacketBytes()
+
+		if !IsPacketV2(entryBytes) {
+			return nil
+		}
+
+		packets = append(packets, entryBytes)
+	}
+
+	return packets
+}
+
+func MakePacketBatchBytes(packets [][]uint8) []uint8 {
+	builder := flatbuffers.NewBuilder(MaxPacketBatchSize)
+	entries := make([]flatbuffers.UOffsetT, len(packets))
+
+	for i, data := range packets {
+		packet := builder.CreateByteVector(data)
+		nier.PacketBatchEntryStart(builder)
+		nier.PacketBatchEntryAddPacket(builder, packet)
+		entries[i] = nier.PacketBatchEntryEnd(builder)
+	}
+
+	nier.PacketBatchStartPacketsVector(builder, len(entries))
+	for i := len(entries) - 1; i >= 0; i-- {
+		builder.PrependUOffsetT(entries[i])
+	}
+	entriesOffs := builder.EndVector(len(entries))
+
+	nier.PacketBatchStart(builder)
+	nier.PacketBatchAddPackets(builder, entriesOffs)
+	batch := nier.PacketBatchEnd(builder)
+
+	nier.PacketV2Start(builder)
+	nier.PacketV2AddId(builder, nier.PacketTypeID_PACKET_BATCH)
+	nier.PacketV2AddMessageType(builder, nier.MessagePacketBatch)
+	nier.PacketV2AddMessage(builder, batch)
+	builder.FinishWithFileIdentifier(nier.PacketV2End(builder), []byte(PacketV2Identifier))
+	return builder.FinishedBytes()
+}
+
+// Sends everything queued for a V2 client since the last flush, one batch per channel
+// unless a channel's packets don't fit in one datagram.
+func FlushPackets(connection *structs.Connection) {
+	if len(connection.Queued) == 0 {
+		return
+	}
+
+	for channel := uint8(0); channel < ChannelCount; channel++ {
+		var batch [][]uint8
+		var flags enet.PacketFlags
+		batchSize := packetBatchEnvelopeSize
+
+		for _, queued := range connection.Queued {
+			if queued.Channel != channel {
+				continue
+			}
+
+			size := len(queued.Data) + packetBatchEntrySize
+
+			if len(batch) > 0 && batchSize+size > MaxPacketBatchSize {
+				sendPacketBatch(connection.Peer, channel, flags, batch)
+				batch = batch[:0]
+				batchSize = packetBatchEnvelopeSize
+			}
+
+			batch = append(batch, queued.Data)
+			flags = queued.Flags
+			batchSize += size
+		}
+
+		sendPacketBatch(connection.Peer, channel, flags, batch)
+	}
+
+	connection.Queued = connection.Queued[:0]
+}
+
+func sendPacketBatch(peer enet.Peer, channel uint8, flags enet.PacketFlags, batch [][]uint8) {
+	switch len(batch) {
+	case 0:
+		return
+	case 1:
+		// Not worth an envelope.
+		peer.SendBytes(batch[0], channel, flags)
+	default:
+		peer.SendBytes(MakePacketBatchBytes(batch), channel, flags)
+	}
+}
@@ -0,0 +1,42 @@
+package core
+
+import (
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+
+	"github.com/codecat/go-enet"
+)
+
+// Must match src/mods/multiplayer/PacketPolicy.hpp on the client.
+const (
+	// Reliable, ordered. Spawns, destroys, handshakes, anything that must not be lost.
+	ChannelLifecycle uint8 = 0
+	// Unreliable, sequenced. Continuous state where only the newest update matters.
+	ChannelState uint8 = 1
+	// Reliable, ordered, but separate from lifecycle so a resend doesn't stall spawns.
+	ChannelEvents uint8 = 2
+
+	ChannelCount = 3
+)
+
+type PacketPolicy struct {
+	Channel uint8
+	Flags   enet.PacketFlags
+}
+
+func GetPacketPolicy(id nier.PacketType) PacketPolicy {
+	switch id {
+	case nier.PacketTypeID_PLAYER_DATA, nier.PacketTypeID_PLAYER_DATA_ACK, nier.PacketTypeID_ENTITY_DATA, nier.PacketTypeID_ENTITY_SNAPSHOT:
+		// No flags is unreliable sequenced in ENet, stale updates are dropped by the receiver.
+		return PacketPolicy{ChannelState, 0}
+	case nier.PacketTypeID_ANIMATION_START, nier.PacketTypeID_ENTITY_ANIMATION_START, nier.PacketTypeID_BUTTONS:
+		return PacketPolicy{ChannelEvents, enet.PacketFlagReliable}
+	default:
+		return PacketPolicy{ChannelLifecycle, enet.PacketFlagReliable}
+	}
+}
+
+// Sends already built packet bytes on the channel and with the flags the policy table gives for id.
+func SendPacketBytes(peer enet.Peer, id nier.PacketType, data []uint8) {
+	policy := GetPacketPolicy(id)
+	peer.SendBytes(data, policy.Channel, policy.Flags)
+}
@@ -0,0 +1,397 @@
+package core
+
+import (
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+// The handlers work on the V1 layout (nier.Packet with nested payloads).
+// V2 clients (one nier.PacketV2 envelope with a union) are converted to V1 when their packets arrive,
+// and every outgoing packet is encoded in whichever layout its recipient negotiated in the hello.
+
+// Must match the file_identifier in schema/Packets.fbs.
+const PacketV2Identifier = "NMP2"
+
+func IsPacketV2(data []uint8) bool {
+	return len(data) >= flatbuffers.SizeUOffsetT+len(PacketV2Identifier) &&
+		string(data[flatbuffers.SizeUOffsetT:flatbuffers.SizeUOffsetT+len(PacketV2Identifier)]) == PacketV2Identifier
+}
+
+// Returns 0 (ID_MASTER_CLIENT_START, never sent) if the packet is malformed.
+func GetPacketV2Id(data []uint8) (id nier.PacketType) {
+	defer handlepanic()
+
+	return nier.GetRootAsPacketV2(data, 0).Id()
+}
+
+// Picks the layout used for a client from the highest one its hello advertised.
+// Clients that predate V2 don't send the field, which reads as V1.
+func NegotiateProtocol(hello *nier.Hello) nier.ProtocolVersion {
+	if hello.Protocol() >= nier.ProtocolVersionV2 {
+		return nier.ProtocolVersionV2
+	}
+
+	return nier.ProtocolVersionV1
+}
+
+// One message on its way to clients that may use different layouts.
+// Each layout is encoded the first time a recipient needs it, so a broadcast encodes at most three times.
+type OutgoingPacket struct {
+	Id         nier.PacketType
+	guid       uint64  // player guid of a bounced player packet
+	payload    []uint8 // what a V1 packet carries in Packet.data, before the player packet wrapper
+	player     bool
+	v1         []uint8
+	v2         []uint8
+	v2Interned []uint8 // V2 with names sent as ids, for clients that negotiated the string table
+}
+
+func NewPacket(id nier.PacketType, payload []uint8) *OutgoingPacket {
+	return &OutgoingPacket{Id: id, payload: payload}
+}
+
+// Player packets are bounced from the sender to everyone else, V1 wraps them in a nier.PlayerPacket.
+func NewPlayerPacket(guid uint64, id nier.PacketType, payload []uint8) *OutgoingPacket {
+	return &OutgoingPacket{Id: id, guid: guid, payload: payload, player: true}
+}
+
+// Ids only ever get added to the table, so the interned encoding stays valid for every later recipient.
+func (packet *OutgoingPacket) Bytes(connection *structs.Connection) []uint8 {
+	if connection.Protocol >= nier.ProtocolVersionV2 && connection.Strings != nil {
+		if packet.v2Interned == nil {
+			packet.v2Interned = MakePacketV2Bytes(packet.Id, packet.guid, packet.payload, connection.Strings)
+		}
+
+		return packet.v2Interned
+	}
+
+	if connection.Protocol >= nier.ProtocolVersionV2 {
+		if packet.v2 == nil {
+			packet.v2 = MakePacketV2Bytes(packet.Id, packet.guid, packet.payload, nil)
+		}
+
+		return packet.v2
+	}
+
+	if packet.v1 == nil {
+		if packet.player {
+			packet.v1 = MakePlayerPacketBytes(packet.guid, packet.Id, packet.payload)
+		} else {
+			packet.v1 = MakePacketBytes(packet.Id, packet.payload)
+		}
+	}
+
+	return packet.v1
+}
+
+// V2 clients get the packet in the next batch flushed for them, V1 clients right away.
+func SendPacket(connection *structs.Connection, packet *OutgoingPacket) {
+	if connection.Protocol >= nier.ProtocolVersionV2 {
+		queuePacketBytes(connection, packet.Id, packet.Bytes(connection))
+		return
+	}
+
+	SendPacketBytes(connection.Peer, packet.Id, packet.Bytes(connection))
+}
+
+// Queues an encoded V2 packet for the next FlushPackets.
+func queuePacketBytes(connection *structs.Connection, id nier.PacketType, data []uint8) {
+	policy := GetPacketPolicy(id)
+	connection.Queued = append(connection.Queued, structs.QueuedPacket{
+		Channel: policy.Channel,
+		Flags:   policy.Flags,
+		Data:    data,
+	})
+}
+
+// Encodes a V1 payload as a V2 packet. guid is only used for player packets,
+// entity packets and destroy player carry their own. Names strings has are sent as ids, strings may be nil.
+func MakePacketV2Bytes(id nier.PacketType, guid uint64, payload []uint8, strings *structs.StringTable) []uint8 {
+	builder := flatbuffers.NewBuilder(0)
+	messageType := nier.MessageNONE
+	message := flatbuffers.UOffsetT(0)
+
+	switch id {
+	case nier.PacketTypeID_WELCOME:
+		messageType, message = nier.MessageWelcome, copyWelcome(builder, nier.GetRootAsWelcome(payload, 0))
+	case nier.PacketTypeID_CREATE_PLAYER:
+		messageType, message = nier.MessageCreatePlayer, copyCreatePlayer(builder, nier.GetRootAsCreatePlayer(payload, 0), strings)
+	case nier.PacketTypeID_DESTROY_PLAYER:
+		destroyPlayer := &nier.DestroyPlayer{}
+		flatbuffers.GetRootAs(payload, 0, destroyPlayer)
+		guid = destroyPlayer.Guid()
+	case nier.PacketTypeID_PLAYER_DATA:
+		messageType, message = nier.MessagePlayerDataMessage, makePlayerDataMessage(builder, payload)
+	case nier.PacketTypeID_ANIMATION_START:
+		messageType, message = nier.MessageAnimationStartMessage, makeAnimationStartMessage(builder, payload)
+	case nier.PacketTypeID_BUTTONS:
+		messageType, message = nier.MessageButtons, copyButtons(builder, nier.GetRootAsButtons(payload, 0))
+	case nier.PacketTypeID_SPAWN_ENTITY, nier.PacketTypeID_DESTROY_ENTITY,
+		nier.PacketTypeID_ENTITY_DATA, nier.PacketTypeID_ENTITY_ANIMATION_START:
+		entityPkt := nier.GetRootAsEntityPacket(payload, 0)
+		guid = uint64(entityPkt.Guid())
+
+		switch id {
+		case nier.PacketTypeID_SPAWN_ENTITY:
+			messageType, message = nier.MessageEntitySpawnParams, CopyEntitySpawnParams(builder, nier.GetRootAsEntitySpawnParams(entityPkt.DataBytes(), 0), strings)
+		case nier.PacketTypeID_ENTITY_DATA:
+			messageType, message = nier.MessageEntityDataMessage, makeEntityDataMessage(builder, entityPkt.DataBytes())
+		case nier.PacketTypeID_ENTITY_ANIMATION_START:
+			messageType, message = nier.MessageAnimationStartMessage, makeAnimationStartMessage(builder, entityPkt.DataBytes())
+		}
+	}
+
+	nier.PacketV2Start(builder)
+	nier.PacketV2AddId(builder, id)
+	nier.PacketV2AddGuid(builder, guid)
+
+	if message != 0 {
+		nier.PacketV2AddMessageType(builder, messageType)
+		nier.PacketV2AddMessage(builder, message)
+	}
+
+	builder.FinishWithFileIdentifier(nier.PacketV2End(builder), []byte(PacketV2Identifier))
+	return builder.FinishedBytes()
+}
+
+// Converts a packet from a V2 client into the V1 packet a V1 client would have sent, with names sent as ids
+// looked up in strings (the sender's connection.Strings). Returns nil if the packet is malformed.
+func PacketV2ToV1Bytes(data []uint8, strings *structs.StringTable) (out []uint8) {
+	defer handlepanic()
+
+	packet := nier.GetRootAsPacketV2(data, 0)
+	id := packet.Id()
+
+	// A missing message or one of the wrong type panics, which drops the packet like any other malformed one.
+	initMessage := func(messageType nier.Message, message flatbuffers.FlatBuffer) {
+		messageTable := flatbuffers.Table{}
+
+		if !packet.Message(&messageTable) || packet.MessageType() != messageType {
+			panic("unexpected message " + packet.MessageType().String() + " for " + id.String())
+		}
+
+		message.Init(messageTable.Bytes, messageTable.Pos)
+	}
+
+	var payload []uint8
+
+	switch id {
+	case nier.PacketTypeID_PING:
+	case nier.PacketTypeID_HELLO:
+		hello := &nier.Hello{}
+		initMessage(nier.MessageHello, hello)
+		payload = BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+			return copyHello(builder, hello)
+		})
+	case nier.PacketTypeID_PLAYER_DATA:
+		message := &nier.PlayerDataMessage{}
+		initMessage(nier.MessagePlayerDataMessage, message)
+		payload = BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+			return createPlayerData(builder, message.Data(nil))
+		})
+	case nier.PacketTypeID_ANIMATION_START:
+		message := &nier.AnimationStartMessage{}
+		initMessage(nier.MessageAnimationStartMessage, message)
+		payload = BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+			return createAnimationStart(builder, message.Data(nil))
+		})
+	case nier.PacketTypeID_BUTTONS:
+		buttons := &nier.Buttons{}
+		initMessage(nier.MessageButtons, buttons)
+		payload = BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+			return copyButtons(builder, buttons)
+		})
+	case nier.PacketTypeID_SPAWN_ENTITY:
+		spawn := &nier.EntitySpawnParams{}
+		initMessage(nier.MessageEntitySpawnParams, spawn)
+
+		// V1 clients get the name itself, a client can only send ids the relay gave out.
+		name, ok := getNameBytes(strings, spawn.Name(), spawn.NameId())
+
+		if !ok {
+			return nil
+		}
+
+		payload = MakeEntityPacketData(uint32(packet.Guid()), BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+			return createEntitySpawnParams(builder, spawn, name, 0)
+		}))
+	case nier.PacketTypeID_DESTROY_ENTITY:
+		payload = MakeEntityPacketData(uint32(packet.Guid()), nil)
+	case nier.PacketTypeID_ENTITY_DATA:
+		message := &nier.EntityDataMessage{}
+		initMessage(nier.MessageEntityDataMessage, message)
+		payload = MakeEntityPacketData(uint32(packet.Guid()), BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+			return createEntityData(builder, message.Data(nil))
+		}))
+	case nier.PacketTypeID_ENTITY_ANIMATION_START:
+		message := &nier.AnimationStartMessage{}
+		initMessage(nier.MessageAnimationStartMessage, message)
+		payload = MakeEntityPacketData(uint32(packet.Guid()), BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+			return createAnimationStart(builder, message.Data(nil))
+		}))
+	default:
+		panic("packet " + id.String() + " can't be sent by a client")
+	}
+
+	return MakePacketBytes(id, payload)
+}
+
+func makePlayerDataMessage(builder *flatbuffers.Builder, payload []uint8) flatbuffers.UOffsetT {
+	playerData := &nier.PlayerData{}
+	flatbuffers.GetRootAs(payload, 0, playerData)
+
+	nier.PlayerDataMessageStart(builder)
+	nier.PlayerDataMessageAddData(builder, createPlayerData(builder, playerData))
+	return nier.PlayerDataMessageEnd(builder)
+}
+
+func makeAnimationStartMessage(builder *flatbuffers.Builder, payload []uint8) flatbuffers.UOffsetT {
+	animationData := &nier.AnimationStart{}
+	flatbuffers.GetRootAs(payload, 0, animationData)
+
+	nier.AnimationStartMessageStart(builder)
+	nier.AnimationStartMessageAddData(builder, createAnimationStart(builder, animationData))
+	return nier.AnimationStartMessageEnd(builder)
+}
+
+func makeEntityDataMessage(builder *flatbuffers.Builder, payload []uint8) flatbuffers.UOffsetT {
+	entityData := &nier.EntityData{}
+	flatbuffers.GetRootAs(payload, 0, entityData)
+
+	nier.EntityDataMessageStart(builder)
+	nier.EntityDataMessageAddData(builder, createEntityData(builder, entityData))
+	return nier.EntityDataMessageEnd(builder)
+}
+
+// Structs must be created right before they are added to their table, the Data() accessors
+// return nil when the struct is missing so these panic on it like any other malformed field.
+func createPlayerData(builder *flatbuffers.Builder, data *nier.PlayerData) flatbuffers.UOffsetT {
+	position := data.Position(nil)
+	return nier.CreatePlayerData(builder, data.Flashlight(), data.Speed(), data.Facing(), data.Facing2(),
+		data.WeaponIndex(), data.PodIndex(), data.HeldButtonFlags(), position.X(), position.Y(), position.Z())
+}
+
+func createAnimationStart(builder *flatbuffers.Builder, data *nier.AnimationStart) flatbuffers.UOffsetT {
+	return nier.CreateAnimationStart(builder, data.Anim(), data.Variant(), data.A3(), data.A4())
+}
+
+func createEntityData(builder *flatbuffers.Builder, data *nier.EntityData) flatbuffers.UOffsetT {
+	position := data.Position(nil)
+	return nier.CreateEntityData(builder, data.Facing(), data.Facing2(), data.Health(), position.X(), position.Y(), position.Z())
+}
+
+func copyHello(builder *flatbuffers.Builder, hello *nier.Hello) flatbuffers.UOffsetT {
+	name := builder.CreateByteString(hello.Name())
+	password := builder.CreateByteString(hello.Password())
+
+	nier.HelloStart(builder)
+	nier.HelloAddMajor(builder, hello.Major())
+	nier.HelloAddMinor(builder, hello.Minor())
+	nier.HelloAddPatch(builder, hello.Patch())
+	nier.HelloAddName(builder, name)
+	nier.HelloAddPassword(builder, password)
+	nier.HelloAddModel(builder, hello.Model())
+	nier.HelloAddProtocol(builder, hello.Protocol())
+	nier.HelloAddQuantizedPositions(builder, hello.QuantizedPositions())
+	nier.HelloAddDeltaPlayerData(builder, hello.DeltaPlayerData())
+	nier.HelloAddReplicatedProperties(builder, hello.ReplicatedProperties())
+	nier.HelloAddStringTable(builder, hello.StringTable())
+	return nier.HelloEnd(builder)
+}
+
+func copyWelcome(builder *flatbuffers.Builder, welcome *nier.Welcome) flatbuffers.UOffsetT {
+	nier.WelcomeStart(builder)
+	nier.WelcomeAddGuid(builder, welcome.Guid())
+	nier.WelcomeAddIsMasterClient(builder, welcome.IsMasterClient())
+	nier.WelcomeAddHighestEntityGuid(builder, welcome.HighestEntityGuid())
+	nier.WelcomeAddProtocol(builder, welcome.Protocol())
+	nier.WelcomeAddPositionPrecision(builder, welcome.PositionPrecision())
+	nier.WelcomeAddDeltaPlayerData(builder, welcome.DeltaPlayerData())
+	nier.WelcomeAddReplicatedProperties(builder, welcome.ReplicatedProperties())
+	nier.WelcomeAddStringTable(builder, welcome.StringTable())
+	return nier.WelcomeEnd(builder)
+}
+
+// The name goes out as its id if strings has it, strings may be nil.
+func copyCreatePlayer(builder *flatbuffers.Builder, createPlayer *nier.CreatePlayer, strings *structs.StringTable) flatbuffers.UOffsetT {
+	nameId := getStringId(strings, createPlayer.Name())
+	name := flatbuffers.UOffsetT(0)
+
+	if nameId == 0 {
+		name = builder.CreateByteString(createPlayer.Name())
+	}
+
+	nier.CreatePlayerStart(builder)
+	nier.CreatePlayerAddGuid(builder, createPlayer.Guid())
+
+	if nameId != 0 {
+		nier.CreatePlayerAddNameId(builder, nameId)
+	} else {
+		nier.CreatePlayerAddName(builder, name)
+	}
+
+	nier.CreatePlayerAddModel(builder, createPlayer.Model())
+	nier.CreatePlayerAddSlot(builder, createPlayer.Slot())
+	return nier.CreatePlayerEnd(builder)
+}
+
+func copyButtons(builder *flatbuffers.Builder, buttons *nier.Buttons) flatbuffers.UOffsetT {
+	count := buttons.ButtonsLength()
+
+	nier.ButtonsStartButtonsVector(builder, count)
+	for i := count - 1; i >= 0; i-- {
+		builder.PrependUint32(buttons.Buttons(i))
+	}
+	buttonsOffs := builder.EndVector(count)
+
+	nier.ButtonsStart(builder)
+	nier.ButtonsAddButtons(builder, buttonsOffs)
+	return nier.ButtonsEnd(builder)
+}
+
+// The name goes out as its id if strings has it, strings may be nil.
+func CopyEntitySpawnParams(builder *flatbuffers.Builder, spawnInfo *nier.EntitySpawnParams, strings *structs.StringTable) flatbuffers.UOffsetT {
+	return createEntitySpawnParams(builder, spawnInfo, spawnInfo.Name(), getStringId(strings, spawnInfo.Name()))
+}
+
+// Writes nameId instead of name unless it is 0.
+func createEntitySpawnParams(builder *flatbuffers.Builder, spawnInfo *nier.EntitySpawnParams, name []uint8, nameId uint32) flatbuffers.UOffsetT {
+	nameOffs := flatbuffers.UOffsetT(0)
+
+	if nameId == 0 {
+		nameOffs = builder.CreateByteString(name)
+	}
+
+	posdata := spawnInfo.Positional(nil)
+
+	nier.EntitySpawnParamsStart(builder)
+
+	if nameId != 0 {
+		nier.EntitySpawnParamsAddNameId(builder, nameId)
+	} else {
+		nier.EntitySpawnParamsAddName(builder, nameOffs)
+	}
+
+	nier.EntitySpawnParamsAddModel(builder, spawnInfo.Model())
+	nier.EntitySpawnParamsAddModel2(builder, spawnInfo.Model2())
+
+	if posdata != nil {
+		packetPosData := nier.CreateEntitySpawnPositionalData(
+			builder,
+			posdata.Forward(nil).X(), posdata.Forward(nil).Y(), posdata.Forward(nil).Z(), posdata.Forward(nil).W(),
+			posdata.Up(nil).X(), posdata.Up(nil).Y(), posdata.Up(nil).Z(), posdata.Up(nil).W(),
+			posdata.Right(nil).X(), posdata.Right(nil).Y(), posdata.Right(nil).Z(), posdata.Right(nil).W(),
+			posdata.W(nil).X(), posdata.W(nil).Y(), posdata.W(nil).Z(), posdata.W(nil).W(),
+			posdata.Position(nil).X(), posdata.Position(nil).Y(), posdata.Position(nil).Z(), posdata.Position(nil).W(),
+			posdata.Unknown(nil).X(), posdata.Unknown(nil).Y(), posdata.Unknown(nil).Z(), posdata.Unknown(nil).W(),
+			posdata.Unknown2(nil).X(), posdata.Unknown2(nil).Y(), posdata.Unknown2(nil).Z(), posdata.Unknown2(nil).W(),
+			posdata.Unk(), posdata.Unk2(), posdata.Unk3(), posdata.Unk4(),
+			posdata.Unk5(), posdata.Unk6(), posdata.Unk7(), posdata.Unk8(),
+		)
+		nier.EntitySpawnParamsAddPositional(builder, packetPosData)
+	}
+
+	return nier.EntitySpawnParamsEnd(builder)
+}
@@ -0,0 +1,95 @@
+package core
+
+import (
+	"testing"
+
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+// The most frequent packet, a player's state every tick.
+func makePlayerDataPayload() []uint8 {
+	return BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+		return nier.CreatePlayerData(builder, true, 1.5, 0.25, -0.5, 3, 1, 0x14, 120.5, -3.25, 2048.75)
+	})
+}
+
+// V1 nests the payload twice: Packet.data holds a PlayerPacket whose data holds the PlayerData.
+func decodePlayerDataV1(data []uint8) *nier.PlayerData {
+	packet := nier.GetRootAsPacket(data, 0)
+	playerPacket := nier.GetRootAsPlayerPacket(packet.DataBytes(), 0)
+	playerData := &nier.PlayerData{}
+	flatbuffers.GetRootAs(playerPacket.DataBytes(), 0, playerData)
+	return playerData
+}
+
+func decodePlayerDataV2(data []uint8) *nier.PlayerData {
+	packet := nier.GetRootAsPacketV2(data, 0)
+	messageTable := flatbuffers.Table{}
+
+	if !packet.Message(&messageTable) || packet.MessageType() != nier.MessagePlayerDataMessage {
+		return nil
+	}
+
+	message := &nier.PlayerDataMessage{}
+	message.Init(messageTable.Bytes, messageTable.Pos)
+	return message.Data(nil)
+}
+
+func TestPlayerDataDecodesTheSameInBothLayouts(t *testing.T) {
+	payload := makePlayerDataPayload()
+	v1 := decodePlayerDataV1(MakePlayerPacketBytes(42, nier.PacketTypeID_PLAYER_DATA, payload))
+	v2 := decodePlayerDataV2(MakePacketV2Bytes(nier.PacketTypeID_PLAYER_DATA, 42, payload, nil))
+
+	if v2 == nil {
+		t.Fatalf("V2 packet has no player data message")
+	}
+
+	p1, p2 := v1.Position(nil), v2.Position(nil)
+
+	if v1.Flashlight() != v2.Flashlight() || v1.Speed() != v2.Speed() || v1.Facing() != v2.Facing() ||
+		v1.Facing2() != v2.Facing2() || v1.WeaponIndex() != v2.WeaponIndex() || v1.PodIndex() != v2.PodIndex() ||
+		v1.HeldButtonFlags() != v2.HeldButtonFlags() || p1.X() != p2.X() || p1.Y() != p2.Y() || p1.Z() != p2.Z() {
+		t.Fatalf("V1 and V2 decode to different player data")
+	}
+}
+
+// ns/op is the time per message. Run with: go test -run '^$' -bench PlayerData ./automatamp/core/
+func BenchmarkPlayerDataEncodeV1(b *testing.B) {
+	payload := makePlayerDataPayload()
+	b.ReportAllocs()
+
+	for i := 0; i < b.N; i++ {
+		MakePlayerPacketBytes(42, nier.PacketTypeID_PLAYER_DATA, payload)
+	}
+}
+
+func BenchmarkPlayerDataEncodeV2(b *testing.B) {
+	payload := makePlayerDataPayload()
+	b.ReportAllocs()
+
+	for i := 0; i < b.N; i++ {
+		MakePacketV2Bytes(nier.PacketTypeID_PLAYER_DATA, 42, payload, nil)
+	}
+}
+
+func BenchmarkPlayerDataDecodeV1(b *testing.B) {
+	data := MakePlayerPacketBytes(42, nier.PacketTypeID_PLAYER_DATA, makePlayerDataPayload())
+	b.SetBytes(int64(len(data)))
+	b.ReportAllocs()
+
+	for i := 0; i < b.N; i++ {
+		decodePlayerDataV1(data).Position(nil)
+	}
+}
+
+func BenchmarkPlayerDataDecodeV2(b *testing.B) {
+	data := MakePacketV2Bytes(nier.PacketTypeID_PLAYER_DATA, 42, makePlayerDataPayload(), nil)
+	b.SetBytes(int64(len(data)))
+	b.ReportAllocs()
+
+	for i := 0; i < b.N; i++ {
+		decodePlayerDataV2(data).Position(nil)
+	}
+}
@@ -0,0 +1,313 @@
+package core
+
+import (
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+
+	"github.com/codecat/go-enet"
+	"github.com/codecat/go-libs/log"
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+// Returns the message of a V2 player data packet, nil if it carries neither PlayerData,
+// QuantizedPlayerData nor a delta or is malformed.
+func GetPlayerDataMessage(data []uint8) (out *nier.PlayerDataMessage) {
+	defer handlepanic()
+
+	packet := nier.GetRootAsPacketV2(data, 0)
+	messageTable := flatbuffers.Table{}
+
+	if packet.MessageType() != nier.MessagePlayerDataMessage || !packet.Message(&messageTable) {
+		return nil
+	}
+
+	message := &nier.PlayerDataMessage{}
+	message.Init(messageTable.Bytes, messageTable.Pos)
+
+	if message.Data(nil) == nil && message.Quantized(nil) == nil && message.DeltaLength() == 0 {
+		return nil
+	}
+
+	// Reads every optional struct once, so one past the end of the buffer panics here instead of while broadcasting.
+	if orientation := message.Orientation(nil); orientation != nil {
+		orientation.Value()
+	}
+
+	if angularVelocity := message.AngularVelocity(nil); angularVelocity != nil {
+		angularVelocity.Z()
+	}
+
+	if sector := message.Sector(nil); sector != nil {
+		sector.Z()
+	}
+
+	message.DeltaBytes()
+	message.PropertiesBytes()
+	return message
+}
+
+// V2 clients that can read the message get it with orientation included, as a delta against what they acked
+// if they negotiated deltas. V1 clients, and clients without a position precision when it is quantized, get
+// the float PlayerData, once the sector it is relative to has arrived if it is quantized.
+// Clients that negotiated replicated properties get them as properties, everyone else as plain fields.
+func BroadcastPlayerDataMessageToAllExceptSender(server *structs.Server, sender enet.Peer, connection *structs.Connection, message *nier.PlayerDataMessage) {
+	quantized := message.Quantized(nil)
+	sector := message.Sector(nil)
+	orientation := message.Orientation(nil)
+	angularVelocity := message.AngularVelocity(nil)
+
+	if delta := message.DeltaBytes(); delta != nil {
+		state, ok := DecodePlayerState(&connection.PlayerDataIn, message.Sequence(), message.Baseline(), delta)
+
+		// Its baseline is gone or a newer update got here first, the next ack keeps the following one decodable.
+		if !ok {
+			return
+		}
+
+		quantized, orientation, angularVelocity = ReadPlayerState(&state)
+
+		// All zeros while not turning, the same as leaving it out.
+		if angularVelocity.X() == 0 && angularVelocity.Y() == 0 && angularVelocity.Z() == 0 {
+			angularVelocity = nil
+		}
+	}
+
+	client := connection.Client
+	properties := message.PropertiesBytes()
+
+	if connection.ReplicatedProperties {
+		if properties != nil && !ReadPlayerProperties(properties, &client.Properties) {
+			log.Error("Invalid player properties from %s", sender.GetAddress())
+			return
+		}
+	} else {
+		client.Properties = getPlayerProperties(message.Data(nil), quantized)
+		properties = makePlayerPropertiesBytes(&client.Properties)
+	}
+
+	playerSector := &connection.PlayerSector
+
+	if quantized != nil && sector != nil {
+		*playerSector = structs.PlayerSector{Id: quantized.SectorId(), X: sector.X(), Y: sector.Y(), Z: sector.Z(), Valid: true}
+	}
+
+	guid := client.Guid
+	filled := &client.Properties
+	replicated := &structs.PlayerProperties{} // left zero, the properties go along instead
+	var messageBytes, replicatedMessageBytes []uint8
+	var floatPacket *OutgoingPacket
+
+	if quantized == nil || (playerSector.Valid && playerSector.Id == quantized.SectorId()) {
+		payload := BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+			if quantized == nil {
+				return createPlayerDataWithProperties(builder, message.Data(nil), filled)
+			}
+
+			return createDequantizedPlayerData(builder, quantized, filled, playerSector, connection.PositionPrecision)
+		})
+
+		playerData := &nier.PlayerData{}
+		flatbuffers.GetRootAs(payload, 0, playerData)
+		connection.Client.LastPlayerData = playerData
+
+		floatPacket = NewPlayerPacket(guid, nier.PacketTypeID_PLAYER_DATA, payload)
+	}
+
+	// Deltas always carry an orientation, a quantized update without one goes out whole.
+	canDelta := quantized != nil && orientation != nil
+	state := MakePlayerState(quantized, orientation, angularVelocity)
+	filledState := withPlayerProperties(state, filled)
+	replicatedState := withPlayerProperties(state, replicated)
+
+	for conn := range server.Clients {
+		if conn.Peer == sender {
+			continue
+		}
+
+		if conn.DeltaPlayerData && canDelta {
+			if conn.ReplicatedProperties {
+				queuePacketBytes(conn, nier.PacketTypeID_PLAYER_DATA, makePlayerDataDeltaBytes(conn, guid, sector, &replicatedState, properties))
+			} else {
+				queuePacketBytes(conn, nier.PacketTypeID_PLAYER_DATA, makePlayerDataDeltaBytes(conn, guid, sector, &filledState, nil))
+			}
+		} else if conn.Protocol >= nier.ProtocolVersionV2 && (quantized == nil || conn.PositionPrecision > 0) {
+			if conn.ReplicatedProperties {
+				if replicatedMessageBytes == nil {
+					replicatedMessageBytes = makePlayerDataMessageBytes(guid, message.Data(nil), quantized, sector, orientation, angularVelocity,
+						replicated, properties)
+				}
+
+				queuePacketBytes(conn, nier.PacketTypeID_PLAYER_DATA, replicatedMessageBytes)
+			} else {
+				if messageBytes == nil {
+					messageBytes = makePlayerDataMessageBytes(guid, message.Data(nil), quantized, sector, orientation, angularVelocity,
+						filled, nil)
+				}
+
+				queuePacketBytes(conn, nier.PacketTypeID_PLAYER_DATA, messageBytes)
+			}
+		} else if floatPacket != nil {
+			SendPacket(conn, floatPacket)
+		}
+	}
+}
+
+// A copy of state with the properties in its quantized player data replaced.
+func withPlayerProperties(state structs.PlayerState, properties *structs.PlayerProperties) structs.PlayerState {
+	quantized, _, _ := ReadPlayerState(&state)
+	quantized.MutateFlashlight(properties.Flashlight)
+	quantized.MutateWeaponIndex(uint8(properties.WeaponIndex))
+	quantized.MutatePodIndex(uint8(properties.PodIndex))
+	quantized.MutateHeldButtonFlags(properties.HeldButtonFlags)
+	return state
+}
+
+// V1 player data goes out as it is, clients that negotiated replicated properties get a message with them.
+func BroadcastPlayerDataToAllExceptSender(server *structs.Server, sender enet.Peer, connection *structs.Connection, playerData *nier.PlayerData, data []uint8) {
+	client := connection.Client
+
+	if !readPlayerDataProperties(playerData, &client.Properties) {
+		log.Error("Invalid player data from %s", sender.GetAddress())
+		return
+	}
+
+	broadcastPacket := NewPlayerPacket(client.Guid, nier.PacketTypeID_PLAYER_DATA, data)
+	var replicatedMessageBytes []uint8
+
+	for conn := range server.Clients {
+		if conn.Peer == sender {
+			continue
+		}
+
+		if !conn.ReplicatedProperties {
+			SendPacket(conn, broadcastPacket)
+			continue
+		}
+
+		if replicatedMessageBytes == nil {
+			replicatedMessageBytes = makePlayerDataMessageBytes(client.Guid, playerData, nil, nil, nil, nil,
+				&structs.PlayerProperties{}, makePlayerPropertiesBytes(&client.Properties))
+		}
+
+		queuePacketBytes(conn, nier.PacketTypeID_PLAYER_DATA, replicatedMessageBytes)
+	}
+}
+
+// False if the player data is shorter than the struct.
+func readPlayerDataProperties(playerData *nier.PlayerData, properties *structs.PlayerProperties) (ok bool) {
+	defer handlepanic()
+
+	playerData.Position(nil).Z()
+	*properties = getPlayerProperties(playerData, nil)
+	return true
+}
+
+// Encodes state against what the recipient acked of the player with this guid, properties is left out if it is nil.
+func makePlayerDataDeltaBytes(recipient *structs.Connection, guid uint64, sector *nier.Sector, state *structs.PlayerState, properties []uint8) []uint8 {
+	if recipient.PlayerDataOut == nil {
+		recipient.PlayerDataOut = make(map[uint64]*structs.PlayerDataStream)
+	}
+
+	stream := recipient.PlayerDataOut[guid]
+
+	if stream == nil {
+		stream = &structs.PlayerDataStream{}
+		recipient.PlayerDataOut[guid] = stream
+	}
+
+	delta, sequence, baseline := EncodePlayerState(stream, state)
+	builder := flatbuffers.NewBuilder(0)
+	propertiesOffs := createPropertiesVector(builder, properties)
+	deltaOffs := builder.CreateByteVector(delta)
+
+	nier.PlayerDataMessageStart(builder)
+
+	if properties != nil {
+		nier.PlayerDataMessageAddProperties(builder, propertiesOffs)
+	}
+
+	nier.PlayerDataMessageAddDelta(builder, deltaOffs)
+
+	if sector != nil {
+		nier.PlayerDataMessageAddSector(builder, nier.CreateSector(builder, sector.X(), sector.Y(), sector.Z()))
+	}
+
+	nier.PlayerDataMessageAddBaseline(builder, baseline)
+	nier.PlayerDataMessageAddSequence(builder, sequence)
+	return finishPlayerDataMessage(builder, guid, nier.PlayerDataMessageEnd(builder))
+}
+
+// Re-encodes the message under the sender's guid, whatever guid the client put in the packet.
+// The fields replicated as properties are written from properties, propertiesBytes is left out if it is nil.
+func makePlayerDataMessageBytes(guid uint64, data *nier.PlayerData, quantized *nier.QuantizedPlayerData, sector *nier.Sector,
+	orientation *nier.CompressedQuaternion, angularVelocity *nier.QuantizedAngularVelocity,
+	properties *structs.PlayerProperties, propertiesBytes []uint8) []uint8 {
+	builder := flatbuffers.NewBuilder(0)
+	propertiesOffs := createPropertiesVector(builder, propertiesBytes)
+
+	nier.PlayerDataMessageStart(builder)
+
+	if propertiesBytes != nil {
+		nier.PlayerDataMessageAddProperties(builder, propertiesOffs)
+	}
+
+	if angularVelocity != nil {
+		nier.PlayerDataMessageAddAngularVelocity(builder, nier.CreateQuantizedAngularVelocity(builder,
+			angularVelocity.X(), angularVelocity.Y(), angularVelocity.Z()))
+	}
+
+	if orientation != nil {
+		nier.PlayerDataMessageAddOrientation(builder, nier.CreateCompressedQuaternion(builder, orientation.Value()))
+	}
+
+	if sector != nil {
+		nier.PlayerDataMessageAddSector(builder, nier.CreateSector(builder, sector.X(), sector.Y(), sector.Z()))
+	}
+
+	if quantized != nil {
+		position := quantized.Position(nil)
+		nier.PlayerDataMessageAddQuantized(builder, nier.CreateQuantizedPlayerData(builder,
+			position.X(), position.Y(), position.Z(), quantized.Facing(), quantized.Facing2(), quantized.SectorId(),
+			properties.Flashlight, uint8(properties.WeaponIndex), uint8(properties.PodIndex), quantized.Speed(), properties.HeldButtonFlags))
+	}
+
+	if data != nil {
+		nier.PlayerDataMessageAddData(builder, createPlayerDataWithProperties(builder, data, properties))
+	}
+
+	return finishPlayerDataMessage(builder, guid, nier.PlayerDataMessageEnd(builder))
+}
+
+func finishPlayerDataMessage(builder *flatbuffers.Builder, guid uint64, messageOffset flatbuffers.UOffsetT) []uint8 {
+	nier.PacketV2Start(builder)
+	nier.PacketV2AddId(builder, nier.PacketTypeID_PLAYER_DATA)
+	nier.PacketV2AddGuid(builder, guid)
+	nier.PacketV2AddMessageType(builder, nier.MessagePlayerDataMessage)
+	nier.PacketV2AddMessage(builder, messageOffset)
+	builder.FinishWithFileIdentifier(nier.PacketV2End(builder), []byte(PacketV2Identifier))
+	return builder.FinishedBytes()
+}
+
+// Vectors must be created before the table they go in is started, returns 0 for nil.
+func createPropertiesVector(builder *flatbuffers.Builder, properties []uint8) flatbuffers.UOffsetT {
+	if properties == nil {
+		return 0
+	}
+
+	return builder.CreateByteVector(properties)
+}
+
+func createPlayerDataWithProperties(builder *flatbuffers.Builder, data *nier.PlayerData, properties *structs.PlayerProperties) flatbuffers.UOffsetT {
+	position := data.Position(nil)
+	return nier.CreatePlayerData(builder, properties.Flashlight, data.Speed(), data.Facing(), data.Facing2(),
+		properties.WeaponIndex, properties.PodIndex, properties.HeldButtonFlags, position.X(), position.Y(), position.Z())
+}
+
+func createDequantizedPlayerData(builder *flatbuffers.Builder, quantized *nier.QuantizedPlayerData, properties *structs.PlayerProperties,
+	sector *structs.PlayerSector, precision float32) flatbuffers.UOffsetT {
+	x, y, z := DequantizePosition(quantized.Position(nil), sector.X, sector.Y, sector.Z, precision)
+
+	return nier.CreatePlayerData(builder, properties.Flashlight, quantized.Speed(),
+		DequantizeYaw(quantized.Facing()), DequantizeYaw(quantized.Facing2()),
+		properties.WeaponIndex, properties.PodIndex, properties.HeldButtonFlags, x, y, z)
+}
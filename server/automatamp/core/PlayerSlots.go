@@ -0,0 +1,31 @@
+package core
+
+import (
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+)
+
+// Every player gets a small slot for as long as it is connected, see nier.CreatePlayer.slot.
+// Clients keep their players in an array indexed by it instead of a map keyed by guid.
+
+// Gives client the lowest free slot, false if every slot is taken.
+func AssignPlayerSlot(server *structs.Server, client *structs.Client) bool {
+	for i, occupant := range server.PlayerSlots {
+		if occupant == nil {
+			server.PlayerSlots[i] = client
+			client.Slot = uint8(i + 1)
+			return true
+		}
+	}
+
+	return false
+}
+
+// Frees client's slot for the next player that connects.
+func FreePlayerSlot(server *structs.Server, client *structs.Client) {
+	if client.Slot == 0 || server.PlayerSlots[client.Slot-1] != client {
+		return
+	}
+
+	server.PlayerSlots[client.Slot-1] = nil
+	client.Slot = 0
+}
@@ -0,0 +1,70 @@
+package core
+
+import (
+	"math"
+
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+)
+
+// Fixed point positions and facings, used instead of floats by clients that negotiated a position precision.
+// Must match src/mods/multiplayer/Quantization.hpp, the relay decodes them for clients that read floats.
+const (
+	SectorSteps = 49152.0
+	YawSteps    = 65536.0
+
+	// A decoded position is off by at most half a step (1mm) and a sector spans 98m.
+	DefaultPositionPrecision = 0.002
+	// Anything coarser than this would make a sector larger than a level.
+	MaxPositionPrecision = 0.1
+)
+
+// Returns 0 (floats) for a precision the encoding can't use.
+func ValidatePositionPrecision(precision float64) float32 {
+	if math.IsNaN(precision) || precision <= 0 || precision > MaxPositionPrecision {
+		return 0
+	}
+
+	return float32(precision)
+}
+
+// The precision from server.json, 0 if it is missing or unusable.
+func GetPositionPrecision(server *structs.Server) float32 {
+	precision, ok := server.Config["positionPrecision"].(float64)
+
+	if !ok {
+		return 0
+	}
+
+	return ValidatePositionPrecision(precision)
+}
+
+// Every client that can read quantized positions gets the server's precision,
+// so their packets can be forwarded to each other without decoding them.
+func NegotiatePositionPrecision(server *structs.Server, hello *nier.Hello, protocol nier.ProtocolVersion) float32 {
+	if protocol < nier.ProtocolVersionV2 || !hello.QuantizedPositions() {
+		return 0
+	}
+
+	return GetPositionPrecision(server)
+}
+
+func DequantizePosition(position *nier.QuantizedVector3, sectorX, sectorY, sectorZ int16, precision float32) (x, y, z float32) {
+	sectorSize := precision * SectorSteps
+
+	x = float32(sectorX)*sectorSize + float32(position.X())*precision
+	y = float32(sectorY)*sectorSize + float32(position.Y())*precision
+	z = float32(sectorZ)*sectorSize + float32(position.Z())*precision
+	return
+}
+
+// Returns a facing in [-pi, pi), the range the game keeps them in.
+func DequantizeYaw(yaw uint16) float32 {
+	radians := float32(yaw) * (2 * math.Pi / YawSteps)
+
+	if radians >= math.Pi {
+		radians -= 2 * math.Pi
+	}
+
+	return radians
+}
@@ -0,0 +1,148 @@
+package core
+
+import (
+	"encoding/binary"
+	"math"
+	"testing"
+
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+)
+
+// What src/mods/multiplayer/Quantization.hpp sends, so the relay's decoding is checked against the client's encoding.
+func quantizeForTest(value float32, precision float32) (sector int16, offset int16) {
+	toShort := func(v float64) int16 {
+		return int16(math.Max(-32768, math.Min(32767, math.Round(v))))
+	}
+
+	sector = toShort(float64(value / (precision * SectorSteps)))
+	center := float32(sector) * (precision * SectorSteps)
+	offset = toShort(float64((value - center) / precision))
+	return
+}
+
+func quantizeYawForTest(radians float32) uint16 {
+	turns := float64(radians / (2 * math.Pi))
+	turns -= math.Floor(turns)
+
+	return uint16(uint32(math.Round(turns*YawSteps)) & 0xFFFF)
+}
+
+func makeQuantizedVector3(x, y, z int16) *nier.QuantizedVector3 {
+	buf := make([]byte, 6)
+	binary.LittleEndian.PutUint16(buf[0:], uint16(x))
+	binary.LittleEndian.PutUint16(buf[2:], uint16(y))
+	binary.LittleEndian.PutUint16(buf[4:], uint16(z))
+
+	position := &nier.QuantizedVector3{}
+	position.Init(buf, 0)
+	return position
+}
+
+const float32Epsilon = 1.1920929e-7
+
+// A decoded value can't be closer than the floats around it allow.
+func getTolerance(bound float32, value float32) float64 {
+	return float64(bound) + 4*float32Epsilon*math.Max(1, math.Abs(float64(value)))
+}
+
+func TestDequantizePositionWithin1mm(t *testing.T) {
+	const precision = DefaultPositionPrecision
+	seed := uint32(1)
+	next := func(scale float32) float32 {
+		seed = seed*1664525 + 1013904223
+		return (float32(seed>>8)/float32(1<<24)*2 - 1) * scale
+	}
+
+	for i := 0; i < 100000; i++ {
+		position := [3]float32{next(5000), next(500), next(5000)}
+		var sector, offset [3]int16
+
+		for axis := range position {
+			sector[axis], offset[axis] = quantizeForTest(position[axis], precision)
+		}
+
+		x, y, z := DequantizePosition(makeQuantizedVector3(offset[0], offset[1], offset[2]), sector[0], sector[1], sector[2], precision)
+
+		for axis, decoded := range [3]float32{x, y, z} {
+			if err := math.Abs(float64(decoded - position[axis])); err > getTolerance(0.001, position[axis]) {
+				t.Fatalf("%v decoded to %v, %v off", position, [3]float32{x, y, z}, err)
+			}
+		}
+	}
+}
+
+// The last offsets a short holds on either side of a sector's center decode past the sector's half-way point,
+// so a player can wander into the next sector before their own has to change.
+func TestDequantizePositionSectorEdge(t *testing.T) {
+	const precision = DefaultPositionPrecision
+	sectorSize := float32(precision * SectorSteps)
+
+	for _, test := range []struct {
+		offset int16
+		want   float32
+	}{
+		{0, sectorSize},
+		{32767, sectorSize + 32767*precision},
+		{-32768, sectorSize - 32768*precision},
+	} {
+		x, _, _ := DequantizePosition(makeQuantizedVector3(test.offset, 0, 0), 1, 0, 0, precision)
+
+		if math.Abs(float64(x-test.want)) > getTolerance(0, test.want) {
+			t.Fatalf("offset %d: got %v, want %v", test.offset, x, test.want)
+		}
+
+		if test.offset != 0 && math.Abs(float64(x-sectorSize)) <= float64(sectorSize/2) {
+			t.Fatalf("offset %d should reach past the sector's half-way point", test.offset)
+		}
+	}
+}
+
+func TestDequantizeYawWrap(t *testing.T) {
+	const step = 2 * math.Pi / YawSteps
+
+	for _, test := range []struct {
+		yaw  uint16
+		want float32
+	}{
+		{0, 0},
+		{16384, math.Pi / 2},
+		{32767, math.Pi - step},
+		{32768, -math.Pi},
+		{65535, -step},
+	} {
+		if got := DequantizeYaw(test.yaw); math.Abs(float64(got-test.want)) > 1e-6 {
+			t.Fatalf("yaw %d: got %v, want %v", test.yaw, got, test.want)
+		}
+	}
+
+	// Just below a full turn rounds up to 65536, which has to wrap to 0.
+	for _, radians := range []float32{2 * math.Pi, math.Nextafter32(2*math.Pi, 0), -2 * math.Pi, -0.00001} {
+		if yaw := quantizeYawForTest(radians); yaw != 0 {
+			t.Fatalf("%v: got yaw %d, want 0", radians, yaw)
+		}
+	}
+
+	for radians := float32(-6 * math.Pi); radians <= 6*math.Pi; radians += 0.001 {
+		decoded := DequantizeYaw(quantizeYawForTest(radians))
+
+		if decoded < -math.Pi || decoded >= math.Pi {
+			t.Fatalf("%v decoded to %v, outside [-pi, pi)", radians, decoded)
+		}
+
+		if err := math.Abs(math.Remainder(float64(decoded-radians), 2*math.Pi)); err > getTolerance(step/2, radians) {
+			t.Fatalf("%v decoded to %v, %v off", radians, decoded, err)
+		}
+	}
+}
+
+func TestValidatePositionPrecision(t *testing.T) {
+	for _, precision := range []float64{0, -0.002, MaxPositionPrecision * 2, math.NaN(), math.Inf(1)} {
+		if got := ValidatePositionPrecision(precision); got != 0 {
+			t.Fatalf("%v: got %v, want 0", precision, got)
+		}
+	}
+
+	if got := ValidatePositionPrecision(DefaultPositionPrecision); got != DefaultPositionPrecision {
+		t.Fatalf("got %v, want %v", got, DefaultPositionPrecision)
+	}
+}
@@ -0,0 +1,118 @@
+package core
+
+import (
+	"encoding/binary"
+	"math"
+	"testing"
+
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+)
+
+// The relay forwards orientations without decoding them, these pin the wire layout it forwards.
+// Must match test/multiplayer/QuaternionTest.cpp and compress_quaternion in src/mods/multiplayer/Quantization.hpp.
+const (
+	quaternionComponentRange = 0.70710678118654752440
+	quaternionComponentSteps = 1023.0
+
+	// Half a step for the three components that are sent, the rebuilt one takes on their error.
+	sentComponentBound    = 0.0007
+	rebuiltComponentBound = 0.0021
+)
+
+// x y z w, one per largest component, the last two with it negative.
+var goldenQuaternions = []struct {
+	rotation [4]float64
+	largest  uint32
+	value    uint32
+}{
+	{[4]float64{0.9, -0.3, 0.2, 0.1}, 0, 0x121A524A},
+	{[4]float64{-0.3, 0.9, 0.1, 0.2}, 1, 0x52192A94},
+	{[4]float64{0.2, 0.3, -0.9, -0.1}, 2, 0x96B4864A},
+	{[4]float64{0.1, -0.2, 0.3, -0.9}, 3, 0xDB5A5121},
+}
+
+// Same steps as decompress_quaternion, in x y z w order.
+func decompressQuaternionForTest(value uint32) (components [4]float64, largest uint32) {
+	largest = value >> 30
+	shift := uint32(30)
+	sum := 0.0
+
+	for i := uint32(0); i < 4; i++ {
+		if i == largest {
+			continue
+		}
+
+		shift -= 10
+		bits := (value >> shift) & 0x3FF
+		components[i] = (float64(bits)/quaternionComponentSteps*2 - 1) * quaternionComponentRange
+		sum += components[i] * components[i]
+	}
+
+	components[largest] = math.Sqrt(math.Max(0, 1-sum))
+	return
+}
+
+func TestQuaternionGoldenValues(t *testing.T) {
+	for _, golden := range goldenQuaternions {
+		decoded, largest := decompressQuaternionForTest(golden.value)
+
+		if largest != golden.largest {
+			t.Fatalf("0x%08X: largest %d, want %d", golden.value, largest, golden.largest)
+		}
+
+		length := 0.0
+
+		for _, component := range golden.rotation {
+			length += component * component
+		}
+
+		length = math.Sqrt(length)
+
+		// The left out component is always sent as positive, a negative one comes back as -q.
+		sign := 1.0
+
+		if golden.rotation[largest] < 0 {
+			sign = -1
+		}
+
+		for i := range decoded {
+			bound := sentComponentBound
+
+			if uint32(i) == largest {
+				bound = rebuiltComponentBound
+			}
+
+			if err := math.Abs(golden.rotation[i]/length*sign - decoded[i]); err > bound {
+				t.Fatalf("0x%08X component %d: got %v, want %v", golden.value, i, decoded[i], golden.rotation[i]/length*sign)
+			}
+		}
+	}
+}
+
+// Orientations go through the relay's delta coding, every bit has to survive it for each largest index.
+func TestQuaternionSurvivesDeltaCoding(t *testing.T) {
+	var baseline structs.PlayerState
+
+	for _, golden := range goldenQuaternions {
+		buf := make([]byte, 4)
+		binary.LittleEndian.PutUint32(buf, golden.value)
+
+		orientation := &nier.CompressedQuaternion{}
+		orientation.Init(buf, 0)
+
+		state := MakePlayerState(nil, orientation, nil)
+
+		var decoded structs.PlayerState
+
+		if !decodeDelta(encodeDelta(&state, &baseline, nil), &baseline, &decoded) {
+			t.Fatalf("0x%08X: delta didn't decode", golden.value)
+		}
+
+		if _, out, _ := ReadPlayerState(&decoded); out.Value() != golden.value {
+			t.Fatalf("got 0x%08X, want 0x%08X", out.Value(), golden.value)
+		}
+
+		baseline = state
+	}
+}
@@ -0,0 +1,107 @@
+package core
+
+import (
+	"encoding/binary"
+
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+)
+
+// Rarely changing fields sent as a mask byte followed by only the values in it, see nier.PlayerDataMessage.Properties.
+// Values are little endian in the order of the mask bits, bools take one byte.
+// Must match src/mods/multiplayer/ReplicatedProperty.hpp, the relay fills them in for clients that didn't negotiate them.
+const (
+	playerPropertyFlashlight = 1 << iota
+	playerPropertyWeaponIndex
+	playerPropertyPodIndex
+	playerPropertyHeldButtonFlags
+
+	playerPropertiesAll = 1<<iota - 1
+)
+
+const (
+	entityPropertyHealth = 1 << iota
+
+	entityPropertiesAll = 1<<iota - 1
+)
+
+// Reads four bytes at offset into value and moves offset past them. False if data is too short.
+func readPropertyUint32(data []uint8, offset *int, value *uint32) bool {
+	if *offset+4 > len(data) {
+		return false
+	}
+
+	*value = binary.LittleEndian.Uint32(data[*offset:])
+	*offset += 4
+	return true
+}
+
+// Overwrites the properties in the message's mask. False if it is malformed, properties is left as is then.
+func ReadPlayerProperties(data []uint8, properties *structs.PlayerProperties) bool {
+	if len(data) == 0 || data[0]&^playerPropertiesAll != 0 {
+		return false
+	}
+
+	mask := data[0]
+	offset := 1
+	read := *properties
+
+	if mask&playerPropertyFlashlight != 0 {
+		if offset >= len(data) {
+			return false
+		}
+
+		read.Flashlight = data[offset] != 0
+		offset++
+	}
+
+	if (mask&playerPropertyWeaponIndex != 0 && !readPropertyUint32(data, &offset, &read.WeaponIndex)) ||
+		(mask&playerPropertyPodIndex != 0 && !readPropertyUint32(data, &offset, &read.PodIndex)) ||
+		(mask&playerPropertyHeldButtonFlags != 0 && !readPropertyUint32(data, &offset, &read.HeldButtonFlags)) {
+		return false
+	}
+
+	if offset != len(data) {
+		return false
+	}
+
+	*properties = read
+	return true
+}
+
+// Every property, for clients that negotiated them when the sender sends them as plain fields.
+func makePlayerPropertiesBytes(properties *structs.PlayerProperties) []uint8 {
+	out := make([]uint8, 0, 14)
+	out = append(out, playerPropertiesAll)
+
+	if properties.Flashlight {
+		out = append(out, 1)
+	} else {
+		out = append(out, 0)
+	}
+
+	out = binary.LittleEndian.AppendUint32(out, properties.WeaponIndex)
+	out = binary.LittleEndian.AppendUint32(out, properties.PodIndex)
+	return binary.LittleEndian.AppendUint32(out, properties.HeldButtonFlags)
+}
+
+// The properties of an update from a client that sends them as plain fields, one of data and quantized is set.
+func getPlayerProperties(data *nier.PlayerData, quantized *nier.QuantizedPlayerData) structs.PlayerProperties {
+	if data != nil {
+		return structs.PlayerProperties{Flashlight: data.Flashlight(), WeaponIndex: data.WeaponIndex(),
+			PodIndex: data.PodIndex(), HeldButtonFlags: data.HeldButtonFlags()}
+	}
+
+	return structs.PlayerProperties{Flashlight: quantized.Flashlight(), WeaponIndex: uint32(quantized.WeaponIndex()),
+		PodIndex: uint32(quantized.PodIndex()), HeldButtonFlags: quantized.HeldButtonFlags()}
+}
+
+// Overwrites health if it is dirty, reading it from properties at offset and moving offset past it.
+// False if the mask or properties are malformed.
+func readEntityProperties(properties []uint8, mask uint8, offset *int, health *uint32) bool {
+	if mask&^entityPropertiesAll != 0 {
+		return false
+	}
+
+	return mask&entityPropertyHealth == 0 || readPropertyUint32(properties, offset, health)
+}
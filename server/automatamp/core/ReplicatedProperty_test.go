@@ -0,0 +1,122 @@
+package core
+
+import (
+	"bytes"
+	"testing"
+
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+)
+
+// Must match test/multiplayer/ReplicatedPropertyTest.cpp, the bytes replication::PlayerProperties writes.
+var (
+	playerPropertiesValues  = structs.PlayerProperties{Flashlight: true, WeaponIndex: 7, PodIndex: 0x01020304, HeldButtonFlags: 0xAABBCCDD}
+	playerPropertiesMessage = []uint8{
+		0x0F,
+		0x01,
+		0x07, 0x00, 0x00, 0x00,
+		0x04, 0x03, 0x02, 0x01,
+		0xDD, 0xCC, 0xBB, 0xAA,
+	}
+
+	oldPlayerProperties = structs.PlayerProperties{Flashlight: false, WeaponIndex: 1, PodIndex: 2, HeldButtonFlags: 3}
+)
+
+func TestPlayerPropertiesWireFormat(t *testing.T) {
+	if out := makePlayerPropertiesBytes(&playerPropertiesValues); !bytes.Equal(out, playerPropertiesMessage) {
+		t.Fatalf("got % X, want % X", out, playerPropertiesMessage)
+	}
+
+	properties := oldPlayerProperties
+
+	if !ReadPlayerProperties(playerPropertiesMessage, &properties) || properties != playerPropertiesValues {
+		t.Fatalf("got %+v, want %+v", properties, playerPropertiesValues)
+	}
+
+	// Only what's in the mask, in mask bit order.
+	properties = oldPlayerProperties
+	want := structs.PlayerProperties{Flashlight: false, WeaponIndex: 7, PodIndex: 2, HeldButtonFlags: 0xAABBCCDD}
+
+	if !ReadPlayerProperties([]uint8{0x0A, 0x07, 0x00, 0x00, 0x00, 0xDD, 0xCC, 0xBB, 0xAA}, &properties) || properties != want {
+		t.Fatalf("got %+v, want %+v", properties, want)
+	}
+}
+
+func TestPlayerPropertiesMaskOnly(t *testing.T) {
+	properties := oldPlayerProperties
+
+	// Nothing changed, nothing is overwritten.
+	if !ReadPlayerProperties([]uint8{0x00}, &properties) || properties != oldPlayerProperties {
+		t.Fatalf("got %+v, want %+v", properties, oldPlayerProperties)
+	}
+
+	// A mask that says there are values but none of them, and no mask at all.
+	for _, data := range [][]uint8{{0x01}, {}} {
+		if ReadPlayerProperties(data, &properties) || properties != oldPlayerProperties {
+			t.Fatalf("% X: expected a failure leaving %+v, got %+v", data, oldPlayerProperties, properties)
+		}
+	}
+}
+
+func TestPlayerPropertiesShortBuffer(t *testing.T) {
+	for size := 1; size < len(playerPropertiesMessage); size++ {
+		properties := oldPlayerProperties
+
+		// A value cut in half doesn't leave the ones before it half applied either.
+		if ReadPlayerProperties(playerPropertiesMessage[:size], &properties) || properties != oldPlayerProperties {
+			t.Fatalf("%d bytes: expected a failure leaving %+v, got %+v", size, oldPlayerProperties, properties)
+		}
+	}
+}
+
+func TestPlayerPropertiesTrailingBytes(t *testing.T) {
+	for _, data := range [][]uint8{append(append([]uint8{}, playerPropertiesMessage...), 0x00), {0x00, 0x00}} {
+		properties := oldPlayerProperties
+
+		if ReadPlayerProperties(data, &properties) || properties != oldPlayerProperties {
+			t.Fatalf("% X: expected a failure leaving %+v, got %+v", data, oldPlayerProperties, properties)
+		}
+	}
+}
+
+func TestPropertiesOutOfRangeMask(t *testing.T) {
+	for _, mask := range []uint8{0x10, 0x20, 0x80, 0xFF} {
+		data := append([]uint8{}, playerPropertiesMessage...)
+		data[0] = mask
+		properties := oldPlayerProperties
+
+		if ReadPlayerProperties(data, &properties) || properties != oldPlayerProperties {
+			t.Fatalf("mask %02X: expected a failure leaving %+v, got %+v", mask, oldPlayerProperties, properties)
+		}
+	}
+
+	// Entities only have health.
+	offset := 0
+	health := uint32(9)
+
+	if readEntityProperties([]uint8{0x05, 0x00, 0x00, 0x00}, 0x02, &offset, &health) || health != 9 || offset != 0 {
+		t.Fatalf("expected a failure leaving health 9 at offset 0, got %d at %d", health, offset)
+	}
+}
+
+// The mask comes from elsewhere and the values are read from the middle of a buffer, like entity snapshots are.
+func TestEntityPropertiesReadAtOffset(t *testing.T) {
+	data := []uint8{0xEE, 0xEE, 0x05, 0x01, 0x00, 0x00, 0x06, 0x01, 0x00, 0x00}
+	offset := 2
+	health := uint32(9)
+
+	for _, test := range []struct {
+		mask   uint8
+		ok     bool
+		health uint32
+		offset int
+	}{
+		{0x01, true, 0x105, 6},
+		{0x00, true, 0x105, 6}, // not dirty, nothing is read
+		{0x01, true, 0x106, len(data)},
+		{0x01, false, 0x106, len(data)},
+	} {
+		if ok := readEntityProperties(data, test.mask, &offset, &health); ok != test.ok || health != test.health || offset != test.offset {
+			t.Fatalf("mask %02X: got %t, health %X at %d, want %t, health %X at %d", test.mask, ok, health, offset, test.ok, test.health, test.offset)
+		}
+	}
+}
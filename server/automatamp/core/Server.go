@@ -32,39 +32,39 @@ func GetFilteredPlayerName(server *structs.Server, input []uint8) string {
 }
 
 func BroadcastPacketToAll(server *structs.Server, id nier.PacketType, data []uint8) {
-	broadcastData := MakePacketBytes(id, data)
+	broadcastPacket := NewPacket(id, data)
 	for conn := range server.Clients {
-		conn.Peer.SendBytes(broadcastData, 0, enet.PacketFlagReliable)
+		SendPacket(conn, broadcastPacket)
 	}
 }
 
 func BroadcastPacketToAllExceptSender(server *structs.Server, sender enet.Peer, id nier.PacketType, data []uint8) {
-	broadcastData := MakePacketBytes(id, data)
+	broadcastPacket := NewPacket(id, data)
 	for conn := range server.Clients {
 		if conn.Peer == sender {
 			continue
 		}
 
-		conn.Peer.SendBytes(broadcastData, 0, enet.PacketFlagReliable)
+		SendPacket(conn, broadcastPacket)
 	}
 }
 
 func BroadcastPlayerPacketToAll(server *structs.Server, connection *structs.Connection, id nier.PacketType, data []uint8) {
-	broadcastData := MakePlayerPacketBytes(connection.Client.Guid, id, data)
+	broadcastPacket := NewPlayerPacket(connection.Client.Guid, id, data)
 
 	for conn := range server.Clients {
-		conn.Peer.SendBytes(broadcastData, 0, enet.PacketFlagReliable)
+		SendPacket(conn, broadcastPacket)
 	}
 }
 
 func BroadcastPlayerPacketToAllExceptSender(server *structs.Server, sender enet.Peer, connection *structs.Connection, id nier.PacketType, data []uint8) {
-	broadcastData := MakePlayerPacketBytes(connection.Client.Guid, id, data)
+	broadcastPacket := NewPlayerPacket(connection.Client.Guid, id, data)
 
 	for conn := range server.Clients {
 		if conn.Peer == sender {
 			continue
 		}
 
-		conn.Peer.SendBytes(broadcastData, 0, enet.PacketFlagReliable)
+		SendPacket(conn, broadcastPacket)
 	}
 }
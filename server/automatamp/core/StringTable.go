@@ -0,0 +1,120 @@
+package core
+
+import (
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+// Entity and player names repeat all session long, so clients that negotiated the table send
+// and receive the id the relay gave a name instead of the name itself, see nier.StringTable.
+// A joiner gets the whole table after its welcome and every new entry is sent to everyone
+// on the lifecycle channel before the first packet that uses it, so ids always arrive first.
+
+// Past this names are sent as they are, a master spawning endless unique names can't grow the table forever.
+const MaxInternedStrings = 4096
+
+// Returns the id of name, giving it one and sending it to every client that negotiated the table if it is new.
+// 0 if name is empty or the table is full.
+func InternString(server *structs.Server, name string) uint32 {
+	strings := &server.Strings
+
+	if id, ok := strings.Ids[name]; ok {
+		return id
+	}
+
+	if name == "" || len(strings.Strings) >= MaxInternedStrings {
+		return 0
+	}
+
+	strings.Strings = append(strings.Strings, name)
+	id := uint32(len(strings.Strings))
+	strings.Ids[name] = id
+
+	entryBytes := makeStringTableBytes(strings.Strings[id-1:], id)
+
+	for conn := range server.Clients {
+		if conn.Strings != nil {
+			queuePacketBytes(conn, nier.PacketTypeID_STRING_TABLE, entryBytes)
+		}
+	}
+
+	return id
+}
+
+// Returns the name with id, false if the table doesn't have it. strings may be nil.
+func LookupString(strings *structs.StringTable, id uint32) (string, bool) {
+	if strings == nil || id == 0 || id > uint32(len(strings.Strings)) {
+		return "", false
+	}
+
+	return strings.Strings[id-1], true
+}
+
+// Sends everything interned so far, for a client that negotiated the table in its hello.
+func SendStringTable(connection *structs.Connection) {
+	if connection.Strings == nil || len(connection.Strings.Strings) == 0 {
+		return
+	}
+
+	queuePacketBytes(connection, nier.PacketTypeID_STRING_TABLE, makeStringTableBytes(connection.Strings.Strings, 1))
+}
+
+// The id of name if it is worth sending one, 0 to send the name. strings may be nil.
+func getStringId(strings *structs.StringTable, name []uint8) uint32 {
+	if strings == nil {
+		return 0
+	}
+
+	return strings.Ids[string(name)]
+}
+
+// Resolves a name that may have been sent as an id, false if the table doesn't have the id.
+func getNameBytes(strings *structs.StringTable, name []uint8, id uint32) ([]uint8, bool) {
+	if id == 0 {
+		return name, true
+	}
+
+	resolved, ok := LookupString(strings, id)
+
+	if !ok {
+		return nil, false
+	}
+
+	return []uint8(resolved), true
+}
+
+// A V2 packet with names consecutive ids starting at firstId.
+func makeStringTableBytes(names []string, firstId uint32) []uint8 {
+	builder := flatbuffers.NewBuilder(0)
+
+	nameOffsets := make([]flatbuffers.UOffsetT, len(names))
+	for i, name := range names {
+		nameOffsets[i] = builder.CreateString(name)
+	}
+
+	nier.StringTableStartStringsVector(builder, len(names))
+	for i := len(names) - 1; i >= 0; i-- {
+		builder.PrependUOffsetT(nameOffsets[i])
+	}
+	stringsOffs := builder.EndVector(len(names))
+
+	nier.StringTableStartIdsVector(builder, len(names))
+	for i := len(names) - 1; i >= 0; i-- {
+		builder.PrependUint32(firstId + uint32(i))
+	}
+	idsOffs := builder.EndVector(len(names))
+
+	nier.StringTableStart(builder)
+	nier.StringTableAddIds(builder, idsOffs)
+	nier.StringTableAddStrings(builder, stringsOffs)
+	table := nier.StringTableEnd(builder)
+
+	nier.PacketV2Start(builder)
+	nier.PacketV2AddId(builder, nier.PacketTypeID_STRING_TABLE)
+	nier.PacketV2AddMessageType(builder, nier.MessageStringTable)
+	nier.PacketV2AddMessage(builder, table)
+	builder.FinishWithFileIdentifier(nier.PacketV2End(builder), []byte(PacketV2Identifier))
+	return builder.FinishedBytes()
+}
@@ -0,0 +1,203 @@
+package core
+
+import (
+	"fmt"
+	"testing"
+
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+func newStringTableServer() *structs.Server {
+	return &structs.Server{
+		Clients: make(map[*structs.Connection]*structs.Client),
+		Strings: structs.StringTable{Ids: make(map[string]uint32)},
+	}
+}
+
+func makeSpawnPacketPayload(guid uint32, name string) []uint8 {
+	return MakeEntityPacketData(guid, BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+		nameOffs := builder.CreateString(name)
+		nier.EntitySpawnParamsStart(builder)
+		nier.EntitySpawnParamsAddName(builder, nameOffs)
+		nier.EntitySpawnParamsAddModel(builder, 0x10000)
+		return nier.EntitySpawnParamsEnd(builder)
+	}))
+}
+
+func getV2SpawnParams(t *testing.T, data []uint8) *nier.EntitySpawnParams {
+	packet := nier.GetRootAsPacketV2(data, 0)
+	messageTable := flatbuffers.Table{}
+
+	if !packet.Message(&messageTable) || packet.MessageType() != nier.MessageEntitySpawnParams {
+		t.Fatalf("expected an EntitySpawnParams message, got %s", packet.MessageType())
+	}
+
+	spawn := &nier.EntitySpawnParams{}
+	spawn.Init(messageTable.Bytes, messageTable.Pos)
+	return spawn
+}
+
+func TestInternStringIds(t *testing.T) {
+	server := newStringTableServer()
+
+	if id := InternString(server, "em1000"); id != 1 {
+		t.Fatalf("first id: got %d, want 1", id)
+	}
+
+	if id := InternString(server, "em2000"); id != 2 {
+		t.Fatalf("second id: got %d, want 2", id)
+	}
+
+	if id := InternString(server, "em1000"); id != 1 {
+		t.Fatalf("interning a name again: got %d, want 1", id)
+	}
+
+	if id := InternString(server, ""); id != 0 {
+		t.Fatalf("empty name: got %d, want 0", id)
+	}
+
+	if name, ok := LookupString(&server.Strings, 2); !ok || name != "em2000" {
+		t.Fatalf("lookup of 2: got %q, %t", name, ok)
+	}
+
+	for _, id := range []uint32{0, 3} {
+		if _, ok := LookupString(&server.Strings, id); ok {
+			t.Fatalf("lookup of %d should fail", id)
+		}
+	}
+
+	if _, ok := LookupString(nil, 1); ok {
+		t.Fatalf("lookup without a table should fail")
+	}
+}
+
+func TestInternStringFull(t *testing.T) {
+	server := newStringTableServer()
+
+	for i := 0; i < MaxInternedStrings; i++ {
+		if id := InternString(server, fmt.Sprintf("name%d", i)); id != uint32(i+1) {
+			t.Fatalf("name %d: got id %d", i, id)
+		}
+	}
+
+	if id := InternString(server, "one too many"); id != 0 {
+		t.Fatalf("full table: got %d, want 0", id)
+	}
+
+	if id := InternString(server, "name0"); id != 1 {
+		t.Fatalf("names already in a full table keep their id: got %d, want 1", id)
+	}
+}
+
+func TestGetNameBytes(t *testing.T) {
+	server := newStringTableServer()
+	InternString(server, "em1000")
+
+	if name, ok := getNameBytes(&server.Strings, []uint8("sent"), 0); !ok || string(name) != "sent" {
+		t.Fatalf("id 0 keeps the sent name: got %q, %t", name, ok)
+	}
+
+	if name, ok := getNameBytes(&server.Strings, nil, 1); !ok || string(name) != "em1000" {
+		t.Fatalf("id 1: got %q, %t", name, ok)
+	}
+
+	if _, ok := getNameBytes(&server.Strings, nil, 2); ok {
+		t.Fatalf("unknown id should fail")
+	}
+
+	if _, ok := getNameBytes(nil, nil, 1); ok {
+		t.Fatalf("an id without a table should fail")
+	}
+}
+
+// A name the table has goes to a V2 client as its id and comes back from it as the name.
+func TestSpawnNameIdRoundTrip(t *testing.T) {
+	server := newStringTableServer()
+	id := InternString(server, "em1000")
+
+	v2 := MakePacketV2Bytes(nier.PacketTypeID_SPAWN_ENTITY, 0, makeSpawnPacketPayload(7, "em1000"), &server.Strings)
+	spawn := getV2SpawnParams(t, v2)
+
+	if spawn.NameId() != id || len(spawn.Name()) != 0 {
+		t.Fatalf("expected name_id %d and no name, got name_id %d and name %q", id, spawn.NameId(), spawn.Name())
+	}
+
+	v1 := PacketV2ToV1Bytes(v2, &server.Strings)
+
+	if v1 == nil {
+		t.Fatalf("conversion to V1 failed")
+	}
+
+	packet := nier.GetRootAsPacket(v1, 0)
+	entityPacket := nier.GetRootAsEntityPacket(packet.DataBytes(), 0)
+	v1Spawn := nier.GetRootAsEntitySpawnParams(entityPacket.DataBytes(), 0)
+
+	if packet.Id() != nier.PacketTypeID_SPAWN_ENTITY || entityPacket.Guid() != 7 {
+		t.Fatalf("got packet %s for entity %d", packet.Id(), entityPacket.Guid())
+	}
+
+	if string(v1Spawn.Name()) != "em1000" || v1Spawn.NameId() != 0 || v1Spawn.Model() != 0x10000 {
+		t.Fatalf("got name %q, name_id %d, model %x", v1Spawn.Name(), v1Spawn.NameId(), v1Spawn.Model())
+	}
+}
+
+// Names the table doesn't have, and clients without a table, get the name itself.
+func TestSpawnNameSentAsIs(t *testing.T) {
+	server := newStringTableServer()
+	InternString(server, "em1000")
+
+	for _, strings := range []*structs.StringTable{&server.Strings, nil} {
+		spawn := getV2SpawnParams(t, MakePacketV2Bytes(nier.PacketTypeID_SPAWN_ENTITY, 0, makeSpawnPacketPayload(7, "em2000"), strings))
+
+		if spawn.NameId() != 0 || string(spawn.Name()) != "em2000" {
+			t.Fatalf("got name_id %d and name %q", spawn.NameId(), spawn.Name())
+		}
+	}
+}
+
+// An id the relay never gave out drops the packet instead of spawning something nameless.
+func TestSpawnUnknownNameIdDropped(t *testing.T) {
+	server := newStringTableServer()
+	InternString(server, "em1000")
+
+	v2 := MakePacketV2Bytes(nier.PacketTypeID_SPAWN_ENTITY, 0, makeSpawnPacketPayload(7, "em1000"), &server.Strings)
+
+	if v1 := PacketV2ToV1Bytes(v2, &structs.StringTable{Ids: make(map[string]uint32)}); v1 != nil {
+		t.Fatalf("expected the packet to be dropped")
+	}
+
+	if v1 := PacketV2ToV1Bytes(v2, nil); v1 != nil {
+		t.Fatalf("expected the packet to be dropped without a table")
+	}
+}
+
+func TestCreatePlayerNameId(t *testing.T) {
+	server := newStringTableServer()
+	id := InternString(server, "2B")
+
+	payload := BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+		name := builder.CreateString("2B")
+		nier.CreatePlayerStart(builder)
+		nier.CreatePlayerAddGuid(builder, 3)
+		nier.CreatePlayerAddName(builder, name)
+		nier.CreatePlayerAddSlot(builder, 2)
+		return nier.CreatePlayerEnd(builder)
+	})
+
+	packet := nier.GetRootAsPacketV2(MakePacketV2Bytes(nier.PacketTypeID_CREATE_PLAYER, 0, payload, &server.Strings), 0)
+	messageTable := flatbuffers.Table{}
+
+	if !packet.Message(&messageTable) || packet.MessageType() != nier.MessageCreatePlayer {
+		t.Fatalf("expected a CreatePlayer message, got %s", packet.MessageType())
+	}
+
+	createPlayer := &nier.CreatePlayer{}
+	createPlayer.Init(messageTable.Bytes, messageTable.Pos)
+
+	if createPlayer.Guid() != 3 || createPlayer.NameId() != id || len(createPlayer.Name()) != 0 || createPlayer.Slot() != 2 {
+		t.Fatalf("got guid %d, name_id %d, name %q, slot %d", createPlayer.Guid(), createPlayer.NameId(), createPlayer.Name(), createPlayer.Slot())
+	}
+}
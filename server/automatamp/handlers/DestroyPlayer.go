@@ -15,4 +15,8 @@ func HandleDestroyPlayer(server *structs.Server, connection *structs.Connection)
 	})
 
 	core.BroadcastPacketToAllExceptSender(server, connection.Peer, nier.PacketTypeID_DESTROY_PLAYER, destroyPlayerBytes)
+
+	for conn := range server.Clients {
+		delete(conn.PlayerDataOut, connection.Client.Guid)
+	}
 }
@@ -0,0 +1,18 @@
+package handlers
+
+import (
+	"github.com/codecat/go-enet"
+	"github.com/codecat/go-libs/log"
+	core "github.com/praydog/AutomataMP/server/automatamp/core"
+	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
+)
+
+// data is the whole V2 packet, snapshots aren't converted to V1 on the way in.
+func HandleEntitySnapshot(server *structs.Server, sender enet.Peer, connection *structs.Connection, data []byte) {
+	if !connection.Client.IsMasterClient {
+		log.Info(" Not a master client, ignoring")
+		return
+	}
+
+	core.BroadcastEntitySnapshotToAllExceptSender(server, sender, connection, data)
+}
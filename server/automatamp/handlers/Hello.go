@@ -73,11 +73,40 @@ func HandleHello(server *structs.Server, sender enet.Peer, connection *structs.C
 		IsMasterClient: len(server.Clients) == 0,
 	}
 
+	if !core.AssignPlayerSlot(server, client) {
+		log.Error("No free player slots, disconnecting")
+		sender.DisconnectNow(0)
+		return
+	}
+
 	log.Info("Client name: %s", clientName)
 	log.Info("Client GUID: %d", client.Guid)
+	log.Info("Client slot: %d", client.Slot)
 	log.Info("Client is master client: %t", client.IsMasterClient)
 	log.Info("Client model: %s", nier.EnumNamesModelType[nier.ModelType(helloData.Model())])
 
+	// Everything from the welcome on goes out in the layout the client asked for.
+	connection.Protocol = core.NegotiateProtocol(helloData)
+	log.Info("Client protocol: %s", connection.Protocol)
+
+	connection.PositionPrecision = core.NegotiatePositionPrecision(server, helloData, connection.Protocol)
+	log.Info("Client position precision: %f", connection.PositionPrecision)
+
+	// Deltas only cover quantized player data.
+	connection.DeltaPlayerData = helloData.DeltaPlayerData() && connection.PositionPrecision > 0
+	log.Info("Client delta player data: %t", connection.DeltaPlayerData)
+
+	// Properties ride on V2 messages only.
+	connection.ReplicatedProperties = helloData.ReplicatedProperties() && connection.Protocol >= nier.ProtocolVersionV2
+	log.Info("Client replicated properties: %t", connection.ReplicatedProperties)
+
+	// The table rides on V2 messages only.
+	if helloData.StringTable() && connection.Protocol >= nier.ProtocolVersionV2 {
+		connection.Strings = &server.Strings
+	}
+
+	log.Info("Client string table: %t", connection.Strings != nil)
+
 	// Add the client to the map
 	connection.Client = client
 	server.Clients[connection] = client
@@ -88,11 +117,21 @@ func HandleHello(server *structs.Server, sender enet.Peer, connection *structs.C
 		nier.WelcomeAddGuid(builder, client.Guid)
 		nier.WelcomeAddIsMasterClient(builder, client.IsMasterClient)
 		nier.WelcomeAddHighestEntityGuid(builder, server.HighestEntityGuid)
+		nier.WelcomeAddProtocol(builder, connection.Protocol)
+		nier.WelcomeAddPositionPrecision(builder, connection.PositionPrecision)
+		nier.WelcomeAddDeltaPlayerData(builder, connection.DeltaPlayerData)
+		nier.WelcomeAddReplicatedProperties(builder, connection.ReplicatedProperties)
+		nier.WelcomeAddStringTable(builder, connection.Strings != nil)
 		return nier.WelcomeEnd(builder)
 	})
 
 	log.Info("Sending welcome packet")
-	sender.SendBytes(core.MakePacketBytes(nier.PacketTypeID_WELCOME, welcomeBytes), 0, enet.PacketFlagReliable)
+	core.SendPacket(connection, core.NewPacket(nier.PacketTypeID_WELCOME, welcomeBytes))
+
+	// Everything interned so far goes out before the players and entities that use it,
+	// the new client's own name is sent to everyone when it is interned below.
+	core.SendStringTable(connection)
+	core.InternString(server, client.Name)
 
 	// Send the player creation packet
 	createPlayerBytes := core.BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
@@ -101,6 +140,7 @@ func HandleHello(server *structs.Server, sender enet.Peer, connection *structs.C
 		nier.CreatePlayerAddGuid(builder, client.Guid)
 		nier.CreatePlayerAddName(builder, playerName)
 		nier.CreatePlayerAddModel(builder, client.Model)
+		nier.CreatePlayerAddSlot(builder, client.Slot)
 		return nier.CreatePlayerEnd(builder)
 	})
 
@@ -119,11 +159,12 @@ func HandleHello(server *structs.Server, sender enet.Peer, connection *structs.C
 			nier.CreatePlayerAddGuid(builder, prevClient.Guid)
 			nier.CreatePlayerAddName(builder, playerName)
 			nier.CreatePlayerAddModel(builder, prevClient.Model)
+			nier.CreatePlayerAddSlot(builder, prevClient.Slot)
 			return nier.CreatePlayerEnd(builder)
 		})
 
 		log.Info("Sending create player packet for previous client %d to client %d", prevClient.Guid, client.Guid)
-		sender.SendBytes(core.MakePacketBytes(nier.PacketTypeID_CREATE_PLAYER, createPlayerBytes), 0, enet.PacketFlagReliable)
+		core.SendPacket(connection, core.NewPacket(nier.PacketTypeID_CREATE_PLAYER, createPlayerBytes))
 	}
 
 	// Broadcast previously spawned entities to the new client
@@ -133,31 +174,12 @@ func HandleHello(server *structs.Server, sender enet.Peer, connection *structs.C
 		}
 
 		spawnData := core.BuilderSurround(func(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
-			name := builder.CreateString(string(entity.SpawnInfo.Name()))
-			posdata := entity.SpawnInfo.Positional(nil)
-			nier.EntitySpawnParamsStart(builder)
-			nier.EntitySpawnParamsAddName(builder, name)
-			nier.EntitySpawnParamsAddModel(builder, entity.SpawnInfo.Model())
-			nier.EntitySpawnParamsAddModel2(builder, entity.SpawnInfo.Model2())
-			packetPosData := nier.CreateEntitySpawnPositionalData(
-				builder,
-				posdata.Forward(nil).X(), posdata.Forward(nil).Y(), posdata.Forward(nil).Z(), posdata.Forward(nil).W(),
-				posdata.Up(nil).X(), posdata.Up(nil).Y(), posdata.Up(nil).Z(), posdata.Up(nil).W(),
-				posdata.Right(nil).X(), posdata.Right(nil).Y(), posdata.Right(nil).Z(), posdata.Right(nil).W(),
-				posdata.W(nil).X(), posdata.W(nil).Y(), posdata.W(nil).Z(), posdata.W(nil).W(),
-				posdata.Position(nil).X(), posdata.Position(nil).Y(), posdata.Position(nil).Z(), posdata.Position(nil).W(),
-				posdata.Unknown(nil).X(), posdata.Unknown(nil).Y(), posdata.Unknown(nil).Z(), posdata.Unknown(nil).W(),
-				posdata.Unknown2(nil).X(), posdata.Unknown2(nil).Y(), posdata.Unknown2(nil).Z(), posdata.Unknown2(nil).W(),
-				posdata.Unk(), posdata.Unk2(), posdata.Unk3(), posdata.Unk4(),
-				posdata.Unk5(), posdata.Unk6(), posdata.Unk7(), posdata.Unk8(),
-			)
-			nier.EntitySpawnParamsAddPositional(builder, packetPosData)
-			return nier.EntitySpawnParamsEnd(builder)
+			return core.CopyEntitySpawnParams(builder, entity.SpawnInfo, nil)
 		})
 
-		spawnPacket := core.MakeEntityPacketBytes(entity.Guid, nier.PacketTypeID_SPAWN_ENTITY, spawnData)
+		spawnPacket := core.NewPacket(nier.PacketTypeID_SPAWN_ENTITY, core.MakeEntityPacketData(entity.Guid, spawnData))
 
 		log.Info("Sending spawn entity packet for entity %d to client %d", entity.Guid, client.Guid)
-		sender.SendBytes(spawnPacket, 0, enet.PacketFlagReliable)
+		core.SendPacket(connection, spawnPacket)
 	}
 }
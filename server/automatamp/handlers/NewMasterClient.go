@@ -1,7 +1,6 @@
 package handlers
 
 import (
-	"github.com/codecat/go-enet"
 	"github.com/codecat/go-libs/log"
 	core "github.com/praydog/AutomataMP/server/automatamp/core"
 	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
@@ -14,7 +13,7 @@ func HandleNewMasterClient(server *structs.Server) {
 		log.Info("Setting new master client: %s @ %s", client.Name, conn.Peer.GetAddress())
 
 		client.IsMasterClient = true
-		conn.Peer.SendBytes(core.MakeEmptyPacketBytes(nier.PacketTypeID_SET_MASTER_CLIENT), 0, enet.PacketFlagReliable)
+		core.SendPacket(conn, core.NewPacket(nier.PacketTypeID_SET_MASTER_CLIENT, nil))
 		break
 	}
 }
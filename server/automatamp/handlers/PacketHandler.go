@@ -3,11 +3,60 @@ package handlers
 import (
 	"github.com/codecat/go-enet"
 	"github.com/codecat/go-libs/log"
+	core "github.com/praydog/AutomataMP/server/automatamp/core"
 	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
 	structs "github.com/praydog/AutomataMP/server/automatamp/structs"
 )
 
 func PacketHandler(server *structs.Server, connection *structs.Connection, sender enet.Peer, data []byte) {
+	if !core.IsPacketBatch(data) {
+		handlePacket(server, connection, sender, data)
+		return
+	}
+
+	packets := core.SplitPacketBatch(data)
+
+	if packets == nil {
+		log.Error("Invalid packet batch from %s", sender.GetAddress())
+		return
+	}
+
+	// Whatever the handlers send back is queued per recipient and re-batched when the service pass ends.
+	for _, packet := range packets {
+		handlePacket(server, connection, sender, packet)
+	}
+}
+
+func handlePacket(server *structs.Server, connection *structs.Connection, sender enet.Peer, data []byte) {
+	// Snapshots have no V1 counterpart, V2 clients get them as they are.
+	if core.IsPacketV2(data) && core.GetPacketV2Id(data) == nier.PacketTypeID_ENTITY_SNAPSHOT {
+		HandleEntitySnapshot(server, sender, connection, data)
+		return
+	}
+
+	// Acks only mean something to the relay, they are never forwarded.
+	if core.IsPacketV2(data) && core.GetPacketV2Id(data) == nier.PacketTypeID_PLAYER_DATA_ACK {
+		HandlePlayerDataAck(sender, connection, data)
+		return
+	}
+
+	if core.IsPacketV2(data) && core.GetPacketV2Id(data) == nier.PacketTypeID_PLAYER_DATA {
+		if message := core.GetPlayerDataMessage(data); message != nil {
+			HandlePlayerDataMessage(server, sender, connection, message)
+			return
+		}
+	}
+
+	// The handlers below read the V1 layout.
+	if core.IsPacketV2(data) {
+		data = core.PacketV2ToV1Bytes(data, connection.Strings)
+
+		if data == nil {
+			log.Error("Invalid V2 packet from %s", sender.GetAddress())
+			return
+		}
+	}
+
 	packetData := nier.GetRootAsPacket(data, 0)
 
 	switch packetData.Id() {
@@ -10,5 +10,5 @@ import (
 
 func HandlePing(sender enet.Peer, connection *structs.Connection) {
 	log.Info("Ping received from %s", connection.Client.Name)
-	sender.SendBytes(core.MakeEmptyPacketBytes(nier.PacketTypeID_PONG), 0, enet.PacketFlagReliable)
+	core.SendPacket(connection, core.NewPacket(nier.PacketTypeID_PONG, nil))
 }
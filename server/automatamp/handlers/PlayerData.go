@@ -2,6 +2,7 @@ package handlers
 
 import (
 	"github.com/codecat/go-enet"
+	"github.com/codecat/go-libs/log"
 	flatbuffers "github.com/google/flatbuffers/go"
 	core "github.com/praydog/AutomataMP/server/automatamp/core"
 	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
@@ -15,5 +16,37 @@ func HandlePlayerData(server *structs.Server, sender enet.Peer, connection *stru
 	connection.Client.LastPlayerData = playerData
 
 	// Broadcast the packet back to all valid clients (except the sender)
-	core.BroadcastPlayerPacketToAllExceptSender(server, sender, connection, nier.PacketTypeID_PLAYER_DATA, data.DataBytes())
+	core.BroadcastPlayerDataToAllExceptSender(server, sender, connection, playerData, data.DataBytes())
+}
+
+// V2 player data is forwarded without converting it on the way in, V1 has nowhere to keep
+// quantized positions or the orientation.
+func HandlePlayerDataMessage(server *structs.Server, sender enet.Peer, connection *structs.Connection, message *nier.PlayerDataMessage) {
+	if message.Quantized(nil) != nil && connection.PositionPrecision == 0 {
+		log.Error("Quantized player data from %s, which didn't negotiate a position precision", sender.GetAddress())
+		return
+	}
+
+	if message.DeltaLength() > 0 && !connection.DeltaPlayerData {
+		log.Error("Player data delta from %s, which didn't negotiate deltas", sender.GetAddress())
+		return
+	}
+
+	core.BroadcastPlayerDataMessageToAllExceptSender(server, sender, connection, message)
+}
+
+// Acks from a client for the deltas it was sent, by the guid of the player each one was about.
+func HandlePlayerDataAck(sender enet.Peer, connection *structs.Connection, data []byte) {
+	ack := core.GetPlayerDataAck(data)
+
+	if ack == nil {
+		log.Error("Invalid player data ack from %s", sender.GetAddress())
+		return
+	}
+
+	for i := 0; i < ack.GuidsLength(); i++ {
+		if stream := connection.PlayerDataOut[ack.Guids(i)]; stream != nil {
+			core.OnPlayerDataAck(stream, ack.Sequences(i))
+		}
+	}
 }
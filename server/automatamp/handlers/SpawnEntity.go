@@ -31,5 +31,8 @@ func HandleSpawnEntity(server *structs.Server, sender enet.Peer, connection *str
 	server.Entities[entityPkt.Guid()].Guid = entityPkt.Guid()
 	server.Entities[entityPkt.Guid()].SpawnInfo = spawnInfo
 
+	// Goes out to clients with the table ahead of the spawn, so they can read it as an id.
+	core.InternString(server, string(spawnInfo.Name()))
+
 	core.BroadcastPacketToAllExceptSender(server, sender, nier.PacketTypeID_SPAWN_ENTITY, data.DataBytes())
 }
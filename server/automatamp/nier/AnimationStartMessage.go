@@ -0,0 +1,57 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type AnimationStartMessage struct {
+	_tab flatbuffers.Table
+}
+
+func GetRootAsAnimationStartMessage(buf []byte, offset flatbuffers.UOffsetT) *AnimationStartMessage {
+	n := flatbuffers.GetUOffsetT(buf[offset:])
+	x := &AnimationStartMessage{}
+	x.Init(buf, n+offset)
+	return x
+}
+
+func GetSizePrefixedRootAsAnimationStartMessage(buf []byte, offset flatbuffers.UOffsetT) *AnimationStartMessage {
+	n := flatbuffers.GetUOffsetT(buf[offset+flatbuffers.SizeUint32:])
+	x := &AnimationStartMessage{}
+	x.Init(buf, n+offset+flatbuffers.SizeUint32)
+	return x
+}
+
+func (rcv *AnimationStartMessage) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *AnimationStartMessage) Table() flatbuffers.Table {
+	return rcv._tab
+}
+
+func (rcv *AnimationStartMessage) Data(obj *AnimationStart) *AnimationStart {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(4))
+	if o != 0 {
+		x := o + rcv._tab.Pos
+		if obj == nil {
+			obj = new(AnimationStart)
+		}
+		obj.Init(rcv._tab.Bytes, x)
+		return obj
+	}
+	return nil
+}
+
+func AnimationStartMessageStart(builder *flatbuffers.Builder) {
+	builder.StartObject(1)
+}
+func AnimationStartMessageAddData(builder *flatbuffers.Builder, data flatbuffers.UOffsetT) {
+	builder.PrependStructSlot(0, flatbuffers.UOffsetT(data), 0)
+}
+func AnimationStartMessageEnd(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+	return builder.EndObject()
+}
@@ -0,0 +1,33 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type CompressedQuaternion struct {
+	_tab flatbuffers.Struct
+}
+
+func (rcv *CompressedQuaternion) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *CompressedQuaternion) Table() flatbuffers.Table {
+	return rcv._tab.Table
+}
+
+func (rcv *CompressedQuaternion) Value() uint32 {
+	return rcv._tab.GetUint32(rcv._tab.Pos + flatbuffers.UOffsetT(0))
+}
+func (rcv *CompressedQuaternion) MutateValue(n uint32) bool {
+	return rcv._tab.MutateUint32(rcv._tab.Pos+flatbuffers.UOffsetT(0), n)
+}
+
+func CreateCompressedQuaternion(builder *flatbuffers.Builder, value uint32) flatbuffers.UOffsetT {
+	builder.Prep(4, 4)
+	builder.PrependUint32(value)
+	return builder.Offset()
+}
@@ -65,8 +65,32 @@ func (rcv *CreatePlayer) MutateModel(n uint32) bool {
 	return rcv._tab.MutateUint32Slot(8, n)
 }
 
+func (rcv *CreatePlayer) NameId() uint32 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(10))
+	if o != 0 {
+		return rcv._tab.GetUint32(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *CreatePlayer) MutateNameId(n uint32) bool {
+	return rcv._tab.MutateUint32Slot(10, n)
+}
+
+func (rcv *CreatePlayer) Slot() byte {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(12))
+	if o != 0 {
+		return rcv._tab.GetByte(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *CreatePlayer) MutateSlot(n byte) bool {
+	return rcv._tab.MutateByteSlot(12, n)
+}
+
 func CreatePlayerStart(builder *flatbuffers.Builder) {
-	builder.StartObject(3)
+	builder.StartObject(5)
 }
 func CreatePlayerAddGuid(builder *flatbuffers.Builder, guid uint64) {
 	builder.PrependUint64Slot(0, guid, 0)
@@ -77,6 +101,12 @@ func CreatePlayerAddName(builder *flatbuffers.Builder, name flatbuffers.UOffsetT
 func CreatePlayerAddModel(builder *flatbuffers.Builder, model uint32) {
 	builder.PrependUint32Slot(2, model, 0)
 }
+func CreatePlayerAddNameId(builder *flatbuffers.Builder, nameId uint32) {
+	builder.PrependUint32Slot(3, nameId, 0)
+}
+func CreatePlayerAddSlot(builder *flatbuffers.Builder, slot byte) {
+	builder.PrependByteSlot(4, slot, 0)
+}
 func CreatePlayerEnd(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
 	return builder.EndObject()
 }
@@ -0,0 +1,57 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type EntityDataMessage struct {
+	_tab flatbuffers.Table
+}
+
+func GetRootAsEntityDataMessage(buf []byte, offset flatbuffers.UOffsetT) *EntityDataMessage {
+	n := flatbuffers.GetUOffsetT(buf[offset:])
+	x := &EntityDataMessage{}
+	x.Init(buf, n+offset)
+	return x
+}
+
+func GetSizePrefixedRootAsEntityDataMessage(buf []byte, offset flatbuffers.UOffsetT) *EntityDataMessage {
+	n := flatbuffers.GetUOffsetT(buf[offset+flatbuffers.SizeUint32:])
+	x := &EntityDataMessage{}
+	x.Init(buf, n+offset+flatbuffers.SizeUint32)
+	return x
+}
+
+func (rcv *EntityDataMessage) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *EntityDataMessage) Table() flatbuffers.Table {
+	return rcv._tab
+}
+
+func (rcv *EntityDataMessage) Data(obj *EntityData) *EntityData {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(4))
+	if o != 0 {
+		x := o + rcv._tab.Pos
+		if obj == nil {
+			obj = new(EntityData)
+		}
+		obj.Init(rcv._tab.Bytes, x)
+		return obj
+	}
+	return nil
+}
+
+func EntityDataMessageStart(builder *flatbuffers.Builder) {
+	builder.StartObject(1)
+}
+func EntityDataMessageAddData(builder *flatbuffers.Builder, data flatbuffers.UOffsetT) {
+	builder.PrependStructSlot(0, flatbuffers.UOffsetT(data), 0)
+}
+func EntityDataMessageEnd(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+	return builder.EndObject()
+}
@@ -78,8 +78,20 @@ func (rcv *EntitySpawnParams) Positional(obj *EntitySpawnPositionalData) *Entity
 	return nil
 }
 
+func (rcv *EntitySpawnParams) NameId() uint32 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(12))
+	if o != 0 {
+		return rcv._tab.GetUint32(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *EntitySpawnParams) MutateNameId(n uint32) bool {
+	return rcv._tab.MutateUint32Slot(12, n)
+}
+
 func EntitySpawnParamsStart(builder *flatbuffers.Builder) {
-	builder.StartObject(4)
+	builder.StartObject(5)
 }
 func EntitySpawnParamsAddName(builder *flatbuffers.Builder, name flatbuffers.UOffsetT) {
 	builder.PrependUOffsetTSlot(0, flatbuffers.UOffsetT(name), 0)
@@ -93,6 +105,9 @@ func EntitySpawnParamsAddModel2(builder *flatbuffers.Builder, model2 uint32) {
 func EntitySpawnParamsAddPositional(builder *flatbuffers.Builder, positional flatbuffers.UOffsetT) {
 	builder.PrependStructSlot(3, flatbuffers.UOffsetT(positional), 0)
 }
+func EntitySpawnParamsAddNameId(builder *flatbuffers.Builder, nameId uint32) {
+	builder.PrependUint32Slot(4, nameId, 0)
+}
 func EntitySpawnParamsEnd(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
 	return builder.EndObject()
 }
@@ -97,8 +97,68 @@ func (rcv *Hello) MutateModel(n uint32) bool {
 	return rcv._tab.MutateUint32Slot(14, n)
 }
 
+func (rcv *Hello) Protocol() ProtocolVersion {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(16))
+	if o != 0 {
+		return ProtocolVersion(rcv._tab.GetUint32(o + rcv._tab.Pos))
+	}
+	return 1
+}
+
+func (rcv *Hello) MutateProtocol(n ProtocolVersion) bool {
+	return rcv._tab.MutateUint32Slot(16, uint32(n))
+}
+
+func (rcv *Hello) QuantizedPositions() bool {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(18))
+	if o != 0 {
+		return rcv._tab.GetBool(o + rcv._tab.Pos)
+	}
+	return false
+}
+
+func (rcv *Hello) MutateQuantizedPositions(n bool) bool {
+	return rcv._tab.MutateBoolSlot(18, n)
+}
+
+func (rcv *Hello) DeltaPlayerData() bool {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(20))
+	if o != 0 {
+		return rcv._tab.GetBool(o + rcv._tab.Pos)
+	}
+	return false
+}
+
+func (rcv *Hello) MutateDeltaPlayerData(n bool) bool {
+	return rcv._tab.MutateBoolSlot(20, n)
+}
+
+func (rcv *Hello) ReplicatedProperties() bool {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(22))
+	if o != 0 {
+		return rcv._tab.GetBool(o + rcv._tab.Pos)
+	}
+	return false
+}
+
+func (rcv *Hello) MutateReplicatedProperties(n bool) bool {
+	return rcv._tab.MutateBoolSlot(22, n)
+}
+
+func (rcv *Hello) StringTable() bool {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(24))
+	if o != 0 {
+		return rcv._tab.GetBool(o + rcv._tab.Pos)
+	}
+	return false
+}
+
+func (rcv *Hello) MutateStringTable(n bool) bool {
+	return rcv._tab.MutateBoolSlot(24, n)
+}
+
 func HelloStart(builder *flatbuffers.Builder) {
-	builder.StartObject(6)
+	builder.StartObject(11)
 }
 func HelloAddMajor(builder *flatbuffers.Builder, major uint32) {
 	builder.PrependUint32Slot(0, major, 0)
@@ -118,6 +178,21 @@ func HelloAddPassword(builder *flatbuffers.Builder, password flatbuffers.UOffset
 func HelloAddModel(builder *flatbuffers.Builder, model uint32) {
 	builder.PrependUint32Slot(5, model, 0)
 }
+func HelloAddProtocol(builder *flatbuffers.Builder, protocol ProtocolVersion) {
+	builder.PrependUint32Slot(6, uint32(protocol), 1)
+}
+func HelloAddQuantizedPositions(builder *flatbuffers.Builder, quantizedPositions bool) {
+	builder.PrependBoolSlot(7, quantizedPositions, false)
+}
+func HelloAddDeltaPlayerData(builder *flatbuffers.Builder, deltaPlayerData bool) {
+	builder.PrependBoolSlot(8, deltaPlayerData, false)
+}
+func HelloAddReplicatedProperties(builder *flatbuffers.Builder, replicatedProperties bool) {
+	builder.PrependBoolSlot(9, replicatedProperties, false)
+}
+func HelloAddStringTable(builder *flatbuffers.Builder, stringTable bool) {
+	builder.PrependBoolSlot(10, stringTable, false)
+}
 func HelloEnd(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
 	return builder.EndObject()
 }
@@ -0,0 +1,62 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import "strconv"
+
+type Message byte
+
+const (
+	MessageNONE                  Message = 0
+	MessageHello                 Message = 1
+	MessageWelcome               Message = 2
+	MessageCreatePlayer          Message = 3
+	MessageEntitySpawnParams     Message = 4
+	MessageEntityDataMessage     Message = 5
+	MessageAnimationStartMessage Message = 6
+	MessagePlayerDataMessage     Message = 7
+	MessageButtons               Message = 8
+	MessagePacketBatch           Message = 9
+	MessageEntitySnapshot        Message = 10
+	MessagePlayerDataAck         Message = 11
+	MessageStringTable           Message = 12
+)
+
+var EnumNamesMessage = map[Message]string{
+	MessageNONE:                  "NONE",
+	MessageHello:                 "Hello",
+	MessageWelcome:               "Welcome",
+	MessageCreatePlayer:          "CreatePlayer",
+	MessageEntitySpawnParams:     "EntitySpawnParams",
+	MessageEntityDataMessage:     "EntityDataMessage",
+	MessageAnimationStartMessage: "AnimationStartMessage",
+	MessagePlayerDataMessage:     "PlayerDataMessage",
+	MessageButtons:               "Buttons",
+	MessagePacketBatch:           "PacketBatch",
+	MessageEntitySnapshot:        "EntitySnapshot",
+	MessagePlayerDataAck:         "PlayerDataAck",
+	MessageStringTable:           "StringTable",
+}
+
+var EnumValuesMessage = map[string]Message{
+	"NONE":                  MessageNONE,
+	"Hello":                 MessageHello,
+	"Welcome":               MessageWelcome,
+	"CreatePlayer":          MessageCreatePlayer,
+	"EntitySpawnParams":     MessageEntitySpawnParams,
+	"EntityDataMessage":     MessageEntityDataMessage,
+	"AnimationStartMessage": MessageAnimationStartMessage,
+	"PlayerDataMessage":     MessagePlayerDataMessage,
+	"Buttons":               MessageButtons,
+	"PacketBatch":           MessagePacketBatch,
+	"EntitySnapshot":        MessageEntitySnapshot,
+	"PlayerDataAck":         MessagePlayerDataAck,
+	"StringTable":           MessageStringTable,
+}
+
+func (v Message) String() string {
+	if s, ok := EnumNamesMessage[v]; ok {
+		return s
+	}
+	return "Message(" + strconv.FormatInt(int64(v), 10) + ")"
+}
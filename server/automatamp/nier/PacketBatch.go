@@ -0,0 +1,67 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type PacketBatch struct {
+	_tab flatbuffers.Table
+}
+
+func GetRootAsPacketBatch(buf []byte, offset flatbuffers.UOffsetT) *PacketBatch {
+	n := flatbuffers.GetUOffsetT(buf[offset:])
+	x := &PacketBatch{}
+	x.Init(buf, n+offset)
+	return x
+}
+
+func GetSizePrefixedRootAsPacketBatch(buf []byte, offset flatbuffers.UOffsetT) *PacketBatch {
+	n := flatbuffers.GetUOffsetT(buf[offset+flatbuffers.SizeUint32:])
+	x := &PacketBatch{}
+	x.Init(buf, n+offset+flatbuffers.SizeUint32)
+	return x
+}
+
+func (rcv *PacketBatch) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *PacketBatch) Table() flatbuffers.Table {
+	return rcv._tab
+}
+
+func (rcv *PacketBatch) Packets(obj *PacketBatchEntry, j int) bool {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(4))
+	if o != 0 {
+		x := rcv._tab.Vector(o)
+		x += flatbuffers.UOffsetT(j) * 4
+		x = rcv._tab.Indirect(x)
+		obj.Init(rcv._tab.Bytes, x)
+		return true
+	}
+	return false
+}
+
+func (rcv *PacketBatch) PacketsLength() int {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(4))
+	if o != 0 {
+		return rcv._tab.VectorLen(o)
+	}
+	return 0
+}
+
+func PacketBatchStart(builder *flatbuffers.Builder) {
+	builder.StartObject(1)
+}
+func PacketBatchAddPackets(builder *flatbuffers.Builder, packets flatbuffers.UOffsetT) {
+	builder.PrependUOffsetTSlot(0, flatbuffers.UOffsetT(packets), 0)
+}
+func PacketBatchStartPacketsVector(builder *flatbuffers.Builder, numElems int) flatbuffers.UOffsetT {
+	return builder.StartVector(4, numElems, 4)
+}
+func PacketBatchEnd(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+	return builder.EndObject()
+}
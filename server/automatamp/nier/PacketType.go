@@ -12,7 +12,8 @@ const (
 	PacketTypeID_DESTROY_ENTITY         PacketType = 2
 	PacketTypeID_ENTITY_DATA            PacketType = 3
 	PacketTypeID_ENTITY_ANIMATION_START PacketType = 4
-	PacketTypeID_MASTER_CLIENT_END      PacketType = 5
+	PacketTypeID_ENTITY_SNAPSHOT        PacketType = 5
+	PacketTypeID_MASTER_CLIENT_END      PacketType = 6
 	PacketTypeID_SERVER_START           PacketType = 2048
 	PacketTypeID_CREATE_PLAYER          PacketType = 2049
 	PacketTypeID_DESTROY_PLAYER         PacketType = 2050
@@ -28,6 +29,9 @@ const (
 	PacketTypeID_PONG                   PacketType = 32769
 	PacketTypeID_HELLO                  PacketType = 32770
 	PacketTypeID_WELCOME                PacketType = 32771
+	PacketTypeID_PACKET_BATCH           PacketType = 32772
+	PacketTypeID_PLAYER_DATA_ACK        PacketType = 32773
+	PacketTypeID_STRING_TABLE           PacketType = 32774
 )
 
 var EnumNamesPacketType = map[PacketType]string{
@@ -36,6 +40,7 @@ var EnumNamesPacketType = map[PacketType]string{
 	PacketTypeID_DESTROY_ENTITY:         "ID_DESTROY_ENTITY",
 	PacketTypeID_ENTITY_DATA:            "ID_ENTITY_DATA",
 	PacketTypeID_ENTITY_ANIMATION_START: "ID_ENTITY_ANIMATION_START",
+	PacketTypeID_ENTITY_SNAPSHOT:        "ID_ENTITY_SNAPSHOT",
 	PacketTypeID_MASTER_CLIENT_END:      "ID_MASTER_CLIENT_END",
 	PacketTypeID_SERVER_START:           "ID_SERVER_START",
 	PacketTypeID_CREATE_PLAYER:          "ID_CREATE_PLAYER",
@@ -52,6 +57,9 @@ var EnumNamesPacketType = map[PacketType]string{
 	PacketTypeID_PONG:                   "ID_PONG",
 	PacketTypeID_HELLO:                  "ID_HELLO",
 	PacketTypeID_WELCOME:                "ID_WELCOME",
+	PacketTypeID_PACKET_BATCH:           "ID_PACKET_BATCH",
+	PacketTypeID_PLAYER_DATA_ACK:        "ID_PLAYER_DATA_ACK",
+	PacketTypeID_STRING_TABLE:           "ID_STRING_TABLE",
 }
 
 var EnumValuesPacketType = map[string]PacketType{
@@ -60,6 +68,7 @@ var EnumValuesPacketType = map[string]PacketType{
 	"ID_DESTROY_ENTITY":         PacketTypeID_DESTROY_ENTITY,
 	"ID_ENTITY_DATA":            PacketTypeID_ENTITY_DATA,
 	"ID_ENTITY_ANIMATION_START": PacketTypeID_ENTITY_ANIMATION_START,
+	"ID_ENTITY_SNAPSHOT":        PacketTypeID_ENTITY_SNAPSHOT,
 	"ID_MASTER_CLIENT_END":      PacketTypeID_MASTER_CLIENT_END,
 	"ID_SERVER_START":           PacketTypeID_SERVER_START,
 	"ID_CREATE_PLAYER":          PacketTypeID_CREATE_PLAYER,
@@ -76,6 +85,9 @@ var EnumValuesPacketType = map[string]PacketType{
 	"ID_PONG":                   PacketTypeID_PONG,
 	"ID_HELLO":                  PacketTypeID_HELLO,
 	"ID_WELCOME":                PacketTypeID_WELCOME,
+	"ID_PACKET_BATCH":           PacketTypeID_PACKET_BATCH,
+	"ID_PLAYER_DATA_ACK":        PacketTypeID_PLAYER_DATA_ACK,
+	"ID_STRING_TABLE":           PacketTypeID_STRING_TABLE,
 }
 
 func (v PacketType) String() string {
@@ -0,0 +1,98 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type PacketV2 struct {
+	_tab flatbuffers.Table
+}
+
+func GetRootAsPacketV2(buf []byte, offset flatbuffers.UOffsetT) *PacketV2 {
+	n := flatbuffers.GetUOffsetT(buf[offset:])
+	x := &PacketV2{}
+	x.Init(buf, n+offset)
+	return x
+}
+
+func GetSizePrefixedRootAsPacketV2(buf []byte, offset flatbuffers.UOffsetT) *PacketV2 {
+	n := flatbuffers.GetUOffsetT(buf[offset+flatbuffers.SizeUint32:])
+	x := &PacketV2{}
+	x.Init(buf, n+offset+flatbuffers.SizeUint32)
+	return x
+}
+
+func (rcv *PacketV2) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *PacketV2) Table() flatbuffers.Table {
+	return rcv._tab
+}
+
+func (rcv *PacketV2) Id() PacketType {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(4))
+	if o != 0 {
+		return PacketType(rcv._tab.GetUint32(o + rcv._tab.Pos))
+	}
+	return 0
+}
+
+func (rcv *PacketV2) MutateId(n PacketType) bool {
+	return rcv._tab.MutateUint32Slot(4, uint32(n))
+}
+
+func (rcv *PacketV2) Guid() uint64 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(6))
+	if o != 0 {
+		return rcv._tab.GetUint64(o + rcv._tab.Pos)
+	}
+	return 0
+}
+
+func (rcv *PacketV2) MutateGuid(n uint64) bool {
+	return rcv._tab.MutateUint64Slot(6, n)
+}
+
+func (rcv *PacketV2) MessageType() Message {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(8))
+	if o != 0 {
+		return Message(rcv._tab.GetByte(o + rcv._tab.Pos))
+	}
+	return 0
+}
+
+func (rcv *PacketV2) MutateMessageType(n Message) bool {
+	return rcv._tab.MutateByteSlot(8, byte(n))
+}
+
+func (rcv *PacketV2) Message(obj *flatbuffers.Table) bool {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(10))
+	if o != 0 {
+		rcv._tab.Union(obj, o)
+		return true
+	}
+	return false
+}
+
+func PacketV2Start(builder *flatbuffers.Builder) {
+	builder.StartObject(4)
+}
+func PacketV2AddId(builder *flatbuffers.Builder, id PacketType) {
+	builder.PrependUint32Slot(0, uint32(id), 0)
+}
+func PacketV2AddGuid(builder *flatbuffers.Builder, guid uint64) {
+	builder.PrependUint64Slot(1, guid, 0)
+}
+func PacketV2AddMessageType(builder *flatbuffers.Builder, messageType Message) {
+	builder.PrependByteSlot(2, byte(messageType), 0)
+}
+func PacketV2AddMessage(builder *flatbuffers.Builder, message flatbuffers.UOffsetT) {
+	builder.PrependUOffsetTSlot(3, flatbuffers.UOffsetT(message), 0)
+}
+func PacketV2End(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
+	return builder.EndObject()
+}
@@ -0,0 +1,29 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import "strconv"
+
+type ProtocolVersion uint32
+
+const (
+	ProtocolVersionV1 ProtocolVersion = 1
+	ProtocolVersionV2 ProtocolVersion = 2
+)
+
+var EnumNamesProtocolVersion = map[ProtocolVersion]string{
+	ProtocolVersionV1: "V1",
+	ProtocolVersionV2: "V2",
+}
+
+var EnumValuesProtocolVersion = map[string]ProtocolVersion{
+	"V1": ProtocolVersionV1,
+	"V2": ProtocolVersionV2,
+}
+
+func (v ProtocolVersion) String() string {
+	if s, ok := EnumNamesProtocolVersion[v]; ok {
+		return s
+	}
+	return "ProtocolVersion(" + strconv.FormatInt(int64(v), 10) + ")"
+}
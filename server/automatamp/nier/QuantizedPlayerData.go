@@ -0,0 +1,101 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type QuantizedPlayerData struct {
+	_tab flatbuffers.Struct
+}
+
+func (rcv *QuantizedPlayerData) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *QuantizedPlayerData) Table() flatbuffers.Table {
+	return rcv._tab.Table
+}
+
+func (rcv *QuantizedPlayerData) Position(obj *QuantizedVector3) *QuantizedVector3 {
+	if obj == nil {
+		obj = new(QuantizedVector3)
+	}
+	obj.Init(rcv._tab.Bytes, rcv._tab.Pos+0)
+	return obj
+}
+func (rcv *QuantizedPlayerData) Facing() uint16 {
+	return rcv._tab.GetUint16(rcv._tab.Pos + flatbuffers.UOffsetT(6))
+}
+func (rcv *QuantizedPlayerData) MutateFacing(n uint16) bool {
+	return rcv._tab.MutateUint16(rcv._tab.Pos+flatbuffers.UOffsetT(6), n)
+}
+
+func (rcv *QuantizedPlayerData) Facing2() uint16 {
+	return rcv._tab.GetUint16(rcv._tab.Pos + flatbuffers.UOffsetT(8))
+}
+func (rcv *QuantizedPlayerData) MutateFacing2(n uint16) bool {
+	return rcv._tab.MutateUint16(rcv._tab.Pos+flatbuffers.UOffsetT(8), n)
+}
+
+func (rcv *QuantizedPlayerData) SectorId() byte {
+	return rcv._tab.GetByte(rcv._tab.Pos + flatbuffers.UOffsetT(10))
+}
+func (rcv *QuantizedPlayerData) MutateSectorId(n byte) bool {
+	return rcv._tab.MutateByte(rcv._tab.Pos+flatbuffers.UOffsetT(10), n)
+}
+
+func (rcv *QuantizedPlayerData) Flashlight() bool {
+	return rcv._tab.GetBool(rcv._tab.Pos + flatbuffers.UOffsetT(11))
+}
+func (rcv *QuantizedPlayerData) MutateFlashlight(n bool) bool {
+	return rcv._tab.MutateBool(rcv._tab.Pos+flatbuffers.UOffsetT(11), n)
+}
+
+func (rcv *QuantizedPlayerData) WeaponIndex() byte {
+	return rcv._tab.GetByte(rcv._tab.Pos + flatbuffers.UOffsetT(12))
+}
+func (rcv *QuantizedPlayerData) MutateWeaponIndex(n byte) bool {
+	return rcv._tab.MutateByte(rcv._tab.Pos+flatbuffers.UOffsetT(12), n)
+}
+
+func (rcv *QuantizedPlayerData) PodIndex() byte {
+	return rcv._tab.GetByte(rcv._tab.Pos + flatbuffers.UOffsetT(13))
+}
+func (rcv *QuantizedPlayerData) MutatePodIndex(n byte) bool {
+	return rcv._tab.MutateByte(rcv._tab.Pos+flatbuffers.UOffsetT(13), n)
+}
+
+func (rcv *QuantizedPlayerData) Speed() float32 {
+	return rcv._tab.GetFloat32(rcv._tab.Pos + flatbuffers.UOffsetT(16))
+}
+func (rcv *QuantizedPlayerData) MutateSpeed(n float32) bool {
+	return rcv._tab.MutateFloat32(rcv._tab.Pos+flatbuffers.UOffsetT(16), n)
+}
+
+func (rcv *QuantizedPlayerData) HeldButtonFlags() uint32 {
+	return rcv._tab.GetUint32(rcv._tab.Pos + flatbuffers.UOffsetT(20))
+}
+func (rcv *QuantizedPlayerData) MutateHeldButtonFlags(n uint32) bool {
+	return rcv._tab.MutateUint32(rcv._tab.Pos+flatbuffers.UOffsetT(20), n)
+}
+
+func CreateQuantizedPlayerData(builder *flatbuffers.Builder, position_x int16, position_y int16, position_z int16, facing uint16, facing2 uint16, sectorId byte, flashlight bool, weaponIndex byte, podIndex byte, speed float32, heldButtonFlags uint32) flatbuffers.UOffsetT {
+	builder.Prep(4, 24)
+	builder.PrependUint32(heldButtonFlags)
+	builder.PrependFloat32(speed)
+	builder.Pad(2)
+	builder.PrependByte(podIndex)
+	builder.PrependByte(weaponIndex)
+	builder.PrependBool(flashlight)
+	builder.PrependByte(sectorId)
+	builder.PrependUint16(facing2)
+	builder.PrependUint16(facing)
+	builder.Prep(2, 6)
+	builder.PrependInt16(position_z)
+	builder.PrependInt16(position_y)
+	builder.PrependInt16(position_x)
+	return builder.Offset()
+}
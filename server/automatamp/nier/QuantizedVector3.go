@@ -0,0 +1,49 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type QuantizedVector3 struct {
+	_tab flatbuffers.Struct
+}
+
+func (rcv *QuantizedVector3) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *QuantizedVector3) Table() flatbuffers.Table {
+	return rcv._tab.Table
+}
+
+func (rcv *QuantizedVector3) X() int16 {
+	return rcv._tab.GetInt16(rcv._tab.Pos + flatbuffers.UOffsetT(0))
+}
+func (rcv *QuantizedVector3) MutateX(n int16) bool {
+	return rcv._tab.MutateInt16(rcv._tab.Pos+flatbuffers.UOffsetT(0), n)
+}
+
+func (rcv *QuantizedVector3) Y() int16 {
+	return rcv._tab.GetInt16(rcv._tab.Pos + flatbuffers.UOffsetT(2))
+}
+func (rcv *QuantizedVector3) MutateY(n int16) bool {
+	return rcv._tab.MutateInt16(rcv._tab.Pos+flatbuffers.UOffsetT(2), n)
+}
+
+func (rcv *QuantizedVector3) Z() int16 {
+	return rcv._tab.GetInt16(rcv._tab.Pos + flatbuffers.UOffsetT(4))
+}
+func (rcv *QuantizedVector3) MutateZ(n int16) bool {
+	return rcv._tab.MutateInt16(rcv._tab.Pos+flatbuffers.UOffsetT(4), n)
+}
+
+func CreateQuantizedVector3(builder *flatbuffers.Builder, x int16, y int16, z int16) flatbuffers.UOffsetT {
+	builder.Prep(2, 6)
+	builder.PrependInt16(z)
+	builder.PrependInt16(y)
+	builder.PrependInt16(x)
+	return builder.Offset()
+}
@@ -0,0 +1,49 @@
+// Code generated by the FlatBuffers compiler. DO NOT EDIT.
+
+package nier
+
+import (
+	flatbuffers "github.com/google/flatbuffers/go"
+)
+
+type Sector struct {
+	_tab flatbuffers.Struct
+}
+
+func (rcv *Sector) Init(buf []byte, i flatbuffers.UOffsetT) {
+	rcv._tab.Bytes = buf
+	rcv._tab.Pos = i
+}
+
+func (rcv *Sector) Table() flatbuffers.Table {
+	return rcv._tab.Table
+}
+
+func (rcv *Sector) X() int16 {
+	return rcv._tab.GetInt16(rcv._tab.Pos + flatbuffers.UOffsetT(0))
+}
+func (rcv *Sector) MutateX(n int16) bool {
+	return rcv._tab.MutateInt16(rcv._tab.Pos+flatbuffers.UOffsetT(0), n)
+}
+
+func (rcv *Sector) Y() int16 {
+	return rcv._tab.GetInt16(rcv._tab.Pos + flatbuffers.UOffsetT(2))
+}
+func (rcv *Sector) MutateY(n int16) bool {
+	return rcv._tab.MutateInt16(rcv._tab.Pos+flatbuffers.UOffsetT(2), n)
+}
+
+func (rcv *Sector) Z() int16 {
+	return rcv._tab.GetInt16(rcv._tab.Pos + flatbuffers.UOffsetT(4))
+}
+func (rcv *Sector) MutateZ(n int16) bool {
+	return rcv._tab.MutateInt16(rcv._tab.Pos+flatbuffers.UOffsetT(4), n)
+}
+
+func CreateSector(builder *flatbuffers.Builder, x int16, y int16, z int16) flatbuffers.UOffsetT {
+	builder.Prep(2, 6)
+	builder.PrependInt16(z)
+	builder.PrependInt16(y)
+	builder.PrependInt16(x)
+	return builder.Offset()
+}
@@ -69,8 +69,68 @@ func (rcv *Welcome) MutateHighestEntityGuid(n uint32) bool {
 	return rcv._tab.MutateUint32Slot(8, n)
 }
 
+func (rcv *Welcome) Protocol() ProtocolVersion {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(10))
+	if o != 0 {
+		return ProtocolVersion(rcv._tab.GetUint32(o + rcv._tab.Pos))
+	}
+	return 1
+}
+
+func (rcv *Welcome) MutateProtocol(n ProtocolVersion) bool {
+	return rcv._tab.MutateUint32Slot(10, uint32(n))
+}
+
+func (rcv *Welcome) PositionPrecision() float32 {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(12))
+	if o != 0 {
+		return rcv._tab.GetFloat32(o + rcv._tab.Pos)
+	}
+	return 0.0
+}
+
+func (rcv *Welcome) MutatePositionPrecision(n float32) bool {
+	return rcv._tab.MutateFloat32Slot(12, n)
+}
+
+func (rcv *Welcome) DeltaPlayerData() bool {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(14))
+	if o != 0 {
+		return rcv._tab.GetBool(o + rcv._tab.Pos)
+	}
+	return false
+}
+
+func (rcv *Welcome) MutateDeltaPlayerData(n bool) bool {
+	return rcv._tab.MutateBoolSlot(14, n)
+}
+
+func (rcv *Welcome) ReplicatedProperties() bool {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(16))
+	if o != 0 {
+		return rcv._tab.GetBool(o + rcv._tab.Pos)
+	}
+	return false
+}
+
+func (rcv *Welcome) MutateReplicatedProperties(n bool) bool {
+	return rcv._tab.MutateBoolSlot(16, n)
+}
+
+func (rcv *Welcome) StringTable() bool {
+	o := flatbuffers.UOffsetT(rcv._tab.Offset(18))
+	if o != 0 {
+		return rcv._tab.GetBool(o + rcv._tab.Pos)
+	}
+	return false
+}
+
+func (rcv *Welcome) MutateStringTable(n bool) bool {
+	return rcv._tab.MutateBoolSlot(18, n)
+}
+
 func WelcomeStart(builder *flatbuffers.Builder) {
-	builder.StartObject(3)
+	builder.StartObject(8)
 }
 func WelcomeAddGuid(builder *flatbuffers.Builder, guid uint64) {
 	builder.PrependUint64Slot(0, guid, 0)
@@ -81,6 +141,21 @@ func WelcomeAddIsMasterClient(builder *flatbuffers.Builder, isMasterClient bool)
 func WelcomeAddHighestEntityGuid(builder *flatbuffers.Builder, highestEntityGuid uint32) {
 	builder.PrependUint32Slot(2, highestEntityGuid, 0)
 }
+func WelcomeAddProtocol(builder *flatbuffers.Builder, protocol ProtocolVersion) {
+	builder.PrependUint32Slot(3, uint32(protocol), 1)
+}
+func WelcomeAddPositionPrecision(builder *flatbuffers.Builder, positionPrecision float32) {
+	builder.PrependFloat32Slot(4, positionPrecision, 0.0)
+}
+func WelcomeAddDeltaPlayerData(builder *flatbuffers.Builder, deltaPlayerData bool) {
+	builder.PrependBoolSlot(5, deltaPlayerData, false)
+}
+func WelcomeAddReplicatedProperties(builder *flatbuffers.Builder, replicatedProperties bool) {
+	builder.PrependBoolSlot(6, replicatedProperties, false)
+}
+func WelcomeAddStringTable(builder *flatbuffers.Builder, stringTable bool) {
+	builder.PrependBoolSlot(7, stringTable, false)
+}
 func WelcomeEnd(builder *flatbuffers.Builder) flatbuffers.UOffsetT {
 	return builder.EndObject()
 }
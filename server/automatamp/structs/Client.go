@@ -2,10 +2,20 @@ package structs
 
 import nier "github.com/praydog/AutomataMP/server/automatamp/nier"
 
+// The fields of a player that are replicated as properties, see core/ReplicatedProperty.go.
+type PlayerProperties struct {
+	Flashlight      bool
+	WeaponIndex     uint32
+	PodIndex        uint32
+	HeldButtonFlags uint32
+}
+
 type Client struct {
 	Guid           uint64
+	Slot           uint8 // 1 based, see core/PlayerSlots.go
 	Model          uint32
 	Name           string
 	IsMasterClient bool
 	LastPlayerData *nier.PlayerData
+	Properties     PlayerProperties // the newest received, whichever way the client sends them
 }
@@ -2,9 +2,57 @@ package structs
 
 import (
 	"github.com/codecat/go-enet"
+	nier "github.com/praydog/AutomataMP/server/automatamp/nier"
 )
 
+// An encoded V2 packet waiting to be batched with everything else sent to the same peer.
+type QueuedPacket struct {
+	Channel uint8
+	Flags   enet.PacketFlags
+	Data    []uint8
+}
+
+// The sector a client's quantized player data is relative to, see nier.PlayerDataMessage.
+type PlayerSector struct {
+	Id      uint8
+	X, Y, Z int16
+	Valid   bool
+}
+
+// Must match PLAYER_STATE_SIZE and BASELINE_COUNT in src/mods/multiplayer/DeltaCompression.hpp.
+const (
+	PlayerStateSize         = 34
+	PlayerDataBaselineCount = 32
+)
+
+type PlayerState [PlayerStateSize]byte
+
+type PlayerDataBaseline struct {
+	Sequence uint16
+	State    PlayerState
+	Valid    bool
+}
+
+// One direction of one player's delta encoded updates, see core/DeltaCompression.go.
+type PlayerDataStream struct {
+	Baselines   [PlayerDataBaselineCount]PlayerDataBaseline // sent or received states, indexed by sequence
+	Sequence    uint16                                      // the last sent, or the newest received
+	HasSequence bool
+	Acked       uint16 // the newest the receiving side acked
+	HasAck      bool
+	AckPending  bool // received updates the sending side hasn't been acked for yet
+}
+
 type Connection struct {
-	Peer   enet.Peer
-	Client *Client
+	Peer                 enet.Peer
+	Client               *Client
+	Protocol             nier.ProtocolVersion // packet layout negotiated in the hello, V1 until then
+	PositionPrecision    float32              // meters per quantized position step from the welcome, 0 for floats
+	PlayerSector         PlayerSector
+	DeltaPlayerData      bool                         // from the welcome, quantized player data goes both ways as deltas
+	PlayerDataIn         PlayerDataStream             // this client's own updates
+	PlayerDataOut        map[uint64]*PlayerDataStream // updates sent to this client, by the guid of the player they are about
+	ReplicatedProperties bool                         // from the welcome, rarely changing fields go both ways as properties, see core/ReplicatedProperty.go
+	Strings              *StringTable                 // from the welcome, names in it go both ways as ids, nil if not negotiated
+	Queued               []QueuedPacket               // V2 packets sent since the last core.FlushPackets
 }
@@ -5,6 +5,7 @@ import nier "github.com/praydog/AutomataMP/server/automatamp/nier"
 type ActiveEntity struct {
 	Guid      uint32
 	SpawnInfo *nier.EntitySpawnParams
+	Health    uint32 // the newest from a snapshot, masters that replicate properties only send it when it changes
 	//lastEntityData *nier.EntityData // to be seen if it needs to be used.
 }
 
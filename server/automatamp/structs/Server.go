@@ -6,13 +6,18 @@ import (
 	"github.com/codecat/go-enet"
 )
 
+// Matches the client's player table, see core/PlayerSlots.go.
+const MaxPlayerSlots = 32
+
 type Server struct {
 	Host              enet.Host
 	Connections       map[enet.Peer]*Connection
 	Clients           map[*Connection]*Client
+	PlayerSlots       [MaxPlayerSlots]*Client // Client.Slot - 1 to the client holding it
 	Entities          EntityList
 	ConnectionCount   uint64
 	HighestEntityGuid uint32
+	Strings           StringTable // kept across master changes, every client still has its copy
 	Config            map[string]interface{}
 	LastHeartbeat     time.Time
 }
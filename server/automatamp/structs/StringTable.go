@@ -0,0 +1,8 @@
+package structs
+
+// Names the relay has given ids for the rest of the session, see core/StringTable.go.
+// Ids start at 1, Strings[id-1] is the name. 0 is never used, it means the name is sent as is.
+type StringTable struct {
+	Ids     map[string]uint32
+	Strings []string
+}
@@ -29,6 +29,27 @@ public:
         return regenny()->facing;
     }
 
+    Matrix4x4f& world_matrix() {
+        return *(Matrix4x4f*)&regenny()->model_mat4_1;
+    }
+
+    // Orientation from the basis of the world matrix, ignoring its scale.
+    glm::quat rotation() {
+        const auto& m = world_matrix();
+
+        return glm::quat_cast(Matrix3x3f{glm::normalize(Vector3f{m[0]}), glm::normalize(Vector3f{m[1]}), glm::normalize(Vector3f{m[2]})});
+    }
+
+    // Replaces the basis of the world matrix, keeping the length of each axis.
+    void set_rotation(const glm::quat& rotation) {
+        auto& m = world_matrix();
+        const auto basis = glm::mat3_cast(glm::normalize(rotation));
+
+        for (auto i = 0; i < 3; ++i) {
+            m[i] = Vector4f{basis[i] * glm::length(Vector3f{m[i]}), m[i].w};
+        }
+    }
+
     auto& tick_count() {
         return regenny()->tick_count;
     }
@@ -64,6 +64,10 @@ public:
         return character_controller().speed;
     }
 
+    __forceinline uint32_t& held_flags() {
+        return character_controller().held_flags;
+    }
+
 public:
     OBJECT_SCRIPT_FUNCTION(Pl0000, addRedGirl, void) // base + 0x471bb0
     OBJECT_SCRIPT_FUNCTION(Pl0000, callDialogTutorial, void, int) // base + 0x474700
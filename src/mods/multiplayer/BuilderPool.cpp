@@ -0,0 +1,84 @@
+#include <spdlog/spdlog.h>
+
+#include "BuilderPool.hpp"
+
+BuilderPool::BuilderPool(size_t initial_builder_size)
+    : m_initial_builder_size{initial_builder_size}
+{
+}
+
+flatbuffers::FlatBufferBuilder* BuilderPool::acquire() {
+    std::scoped_lock _{m_mtx};
+
+    if (m_free.empty()) {
+        m_entries.emplace_back(std::make_unique<Entry>(this, m_initial_builder_size));
+        return m_entries.back().get();
+    }
+
+    auto entry = m_free.back();
+    m_free.pop_back();
+
+    return entry;
+}
+
+void BuilderPool::release(flatbuffers::FlatBufferBuilder* builder) {
+    auto entry = find_entry(builder);
+
+    if (entry == nullptr) {
+        spdlog::error("[BuilderPool] Released a builder that does not belong to this pool");
+        return;
+    }
+
+    // Keeps the underlying buffer, so the next message reuses the memory.
+    builder->Clear();
+
+    std::scoped_lock _{m_mtx};
+    m_free.push_back(entry);
+}
+
+ENetPacket* BuilderPool::create_packet(flatbuffers::FlatBufferBuilder* builder, enet_uint32 flags) {
+    auto entry = find_entry(builder);
+
+    if (entry == nullptr) {
+        spdlog::error("[BuilderPool] Tried to create a packet from a builder that does not belong to this pool");
+        return nullptr;
+    }
+
+    auto packet = enet_packet_create(builder->GetBufferPointer(), builder->GetSize(), flags | ENET_PACKET_FLAG_NO_ALLOCATE);
+
+    if (packet == nullptr) {
+        release(builder);
+        return nullptr;
+    }
+
+    packet->userData = entry;
+    packet->freeCallback = &BuilderPool::on_packet_freed;
+
+    return packet;
+}
+
+void ENET_CALLBACK BuilderPool::on_packet_freed(ENetPacket* packet) {
+    auto entry = (Entry*)packet->userData;
+
+    if (entry == nullptr) {
+        return;
+    }
+
+    packet->userData = nullptr;
+    entry->pool->release(entry);
+}
+
+BuilderPool::Entry* BuilderPool::find_entry(flatbuffers::FlatBufferBuilder* builder) {
+    if (builder == nullptr) {
+        return nullptr;
+    }
+
+    // Every builder we hand out is an Entry.
+    auto entry = static_cast<Entry*>(builder);
+
+    if (entry->pool != this) {
+        return nullptr;
+    }
+
+    return entry;
+}
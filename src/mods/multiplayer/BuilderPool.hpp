@@ -0,0 +1,95 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <enet/enet.h>
+#include <enetpp/pool_allocator.h>
+#include <flatbuffers/flatbuffers.h>
+
+// Recycles FlatBufferBuilders so a finished buffer can be handed to ENet as-is.
+// create_packet wraps the builder's buffer with ENET_PACKET_FLAG_NO_ALLOCATE and the builder
+// stays checked out until ENet destroys the packet, at which point the free callback returns it here.
+// The pool must outlive every packet it created.
+// Builders are only ever Clear()ed, so once every builder has grown to fit the largest message
+// sent through it, building and sending a message does not allocate.
+class BuilderPool {
+public:
+    // For builders used as scratch space for a nested payload, returns the builder on scope exit.
+    class Scoped {
+    public:
+        Scoped(BuilderPool& pool)
+            : m_pool{pool},
+            m_builder{pool.acquire()}
+        {
+        }
+
+        ~Scoped() { m_pool.release(m_builder); }
+
+        Scoped(const Scoped&) = delete;
+        Scoped& operator=(const Scoped&) = delete;
+
+        flatbuffers::FlatBufferBuilder* operator->() const { return m_builder; }
+        flatbuffers::FlatBufferBuilder& operator*() const { return *m_builder; }
+
+    private:
+        BuilderPool& m_pool;
+        flatbuffers::FlatBufferBuilder* m_builder;
+    };
+
+    BuilderPool(size_t initial_builder_size = 1024);
+
+    flatbuffers::FlatBufferBuilder* acquire();
+    void release(flatbuffers::FlatBufferBuilder* builder);
+
+    // builder must have been acquired from this pool and finished.
+    // Ownership of the builder passes to the returned packet.
+    ENetPacket* create_packet(flatbuffers::FlatBufferBuilder* builder, enet_uint32 flags);
+
+    size_t get_total_count() {
+        std::scoped_lock _{m_mtx};
+        return m_entries.size();
+    }
+
+    size_t get_free_count() {
+        std::scoped_lock _{m_mtx};
+        return m_free.size();
+    }
+
+private:
+    // Builder buffers come from the same size class pool ENet allocates from, the first growth
+    // steps of a fresh builder are served from its free lists instead of the CRT heap.
+    class Allocator : public flatbuffers::Allocator {
+    public:
+        uint8_t* allocate(size_t size) override {
+            return (uint8_t*)enetpp::pool_allocator::get().allocate(size);
+        }
+
+        void deallocate(uint8_t* p, size_t) override {
+            enetpp::pool_allocator::get().deallocate(p);
+        }
+    };
+
+    // Every builder handed out is one of these, so the owning pool can be found from the builder alone.
+    struct Entry : public flatbuffers::FlatBufferBuilder {
+        Entry(BuilderPool* owner, size_t initial_size)
+            : flatbuffers::FlatBufferBuilder{initial_size, &owner->m_allocator, false},
+            pool{owner}
+        {
+        }
+
+        BuilderPool* pool;
+    };
+
+    static void ENET_CALLBACK on_packet_freed(ENetPacket* packet);
+
+    Entry* find_entry(flatbuffers::FlatBufferBuilder* builder);
+
+    size_t m_initial_builder_size{};
+    Allocator m_allocator{}; // declared before the entries so it outlives their buffers
+
+    std::mutex m_mtx{}; // packets are freed on the enet thread
+    std::vector<std::unique_ptr<Entry>> m_entries{};
+    std::vector<Entry*> m_free{};
+};
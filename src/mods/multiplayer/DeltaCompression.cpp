@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cstring>
+
+#include "DeltaCompression.hpp"
+
+namespace delta_compression {
+static constexpr uint8_t ZERO_RUN_FLAG = 0x80;
+static constexpr size_t MAX_RUN = 0x80;
+
+PlayerState make_player_state(const nier::QuantizedPlayerData& quantized, const nier::CompressedQuaternion& orientation,
+    const nier::QuantizedAngularVelocity& angular_velocity)
+{
+    PlayerState state{};
+    auto out = state.data();
+
+    // The structs are stored little endian, so their bytes are the wire format.
+    memcpy(out, &quantized, sizeof(quantized));
+    memcpy(out += sizeof(quantized), &orientation, sizeof(orientation));
+    memcpy(out += sizeof(orientation), &angular_velocity, sizeof(angular_velocity));
+
+    return state;
+}
+
+void read_player_state(const PlayerState& state, nier::QuantizedPlayerData& quantized, nier::CompressedQuaternion& orientation,
+    nier::QuantizedAngularVelocity& angular_velocity)
+{
+    auto in = state.data();
+
+    memcpy(&quantized, in, sizeof(quantized));
+    memcpy(&orientation, in += sizeof(quantized), sizeof(orientation));
+    memcpy(&angular_velocity, in += sizeof(orientation), sizeof(angular_velocity));
+}
+
+void encode(const PlayerState& state, const PlayerState& baseline, std::vector<uint8_t>& out) {
+    PlayerState xored{};
+
+    for (size_t i = 0; i < xored.size(); ++i) {
+        xored[i] = state[i] ^ baseline[i];
+    }
+
+    for (size_t i = 0; i < xored.size();) {
+        const auto zero = xored[i] == 0;
+        auto end = i + 1;
+
+        while (end < xored.size() && end - i < MAX_RUN && (xored[end] == 0) == zero) {
+            ++end;
+        }
+
+        const auto length = end - i;
+
+        if (zero) {
+            out.push_back(ZERO_RUN_FLAG | (uint8_t)(length - 1));
+        } else {
+            out.push_back((uint8_t)(length - 1));
+            out.insert(out.end(), xored.begin() + i, xored.begin() + end);
+        }
+
+        i = end;
+    }
+}
+
+bool decode(const uint8_t* delta, size_t size, const PlayerState& baseline, PlayerState& state) {
+    size_t written = 0;
+
+    for (size_t i = 0; i < size;) {
+        const auto control = delta[i++];
+        const auto length = (size_t)(control & ~ZERO_RUN_FLAG) + 1;
+
+        if (written + length > state.size()) {
+            return false;
+        }
+
+        if (control & ZERO_RUN_FLAG) {
+            std::copy_n(baseline.begin() + written, length, state.begin() + written);
+        } else {
+            if (i + length > size) {
+                return false;
+            }
+
+            for (size_t j = 0; j < length; ++j) {
+                state[written + j] = baseline[written + j] ^ delta[i + j];
+            }
+
+            i += length;
+        }
+
+        written += length;
+    }
+
+    return written == state.size();
+}
+
+void BaselineRing::store(uint16_t sequence, const PlayerState& state) {
+    auto& entry = m_entries[sequence % BASELINE_COUNT];
+    entry.state = state;
+    entry.sequence = sequence;
+    entry.valid = true;
+}
+
+const PlayerState* BaselineRing::find(uint16_t sequence) const {
+    const auto& entry = m_entries[sequence % BASELINE_COUNT];
+
+    return entry.valid && entry.sequence == sequence ? &entry.state : nullptr;
+}
+
+void Sender::encode(const PlayerState& state, std::vector<uint8_t>& out, uint16_t& sequence, uint16_t& baseline) {
+    static const PlayerState zeros{};
+
+    sequence = ++m_sequence;
+    baseline = sequence;
+
+    const PlayerState* baseline_state = &zeros;
+
+    // An ack that fell out of the ring would point the receiver at a state it has overwritten too.
+    if (m_has_ack && (uint16_t)(sequence - m_acked) < BASELINE_COUNT) {
+        if (const auto acked = m_sent.find(m_acked); acked != nullptr) {
+            baseline = m_acked;
+            baseline_state = acked;
+        }
+    }
+
+    delta_compression::encode(state, *baseline_state, out);
+    m_sent.store(sequence, state);
+}
+
+void Sender::on_ack(uint16_t sequence) {
+    // Acks for updates that were never sent come from a confused or stale peer.
+    if (is_newer(sequence, m_sequence) || (m_has_ack && !is_newer(sequence, m_acked))) {
+        return;
+    }
+
+    m_acked = sequence;
+    m_has_ack = true;
+}
+
+void Sender::reset() {
+    m_sent.clear();
+    m_sequence = 0;
+    m_acked = 0;
+    m_has_ack = false;
+}
+
+bool Receiver::decode(uint16_t sequence, uint16_t baseline, const uint8_t* delta, size_t size, PlayerState& state) {
+    static const PlayerState zeros{};
+
+    if (m_has_newest && !is_newer(sequence, m_newest)) {
+        return false;
+    }
+
+    const auto baseline_state = baseline == sequence ? &zeros : m_received.find(baseline);
+
+    if (baseline_state == nullptr || !delta_compression::decode(delta, size, *baseline_state, state)) {
+        return false;
+    }
+
+    m_received.store(sequence, state);
+    m_newest = sequence;
+    m_has_newest = true;
+    m_ack_pending = true;
+
+    return true;
+}
+
+bool Receiver::take_ack(uint16_t& sequence) {
+    if (!m_ack_pending) {
+        return false;
+    }
+
+    sequence = m_newest;
+    m_ack_pending = false;
+
+    return true;
+}
+
+void Receiver::reset() {
+    m_received.clear();
+    m_newest = 0;
+    m_has_newest = false;
+    m_ack_pending = false;
+}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "schema/Packets_generated.h"
+
+// Quantized player data sent as the XOR against an update the receiver acked, see nier::PlayerDataMessage.delta.
+// Each hop keeps its own baselines: a client encodes for the relay, the relay decodes and encodes again for
+// every recipient, and acks travel back one hop at a time.
+// Must match server/automatamp/core/DeltaCompression.go.
+namespace delta_compression {
+// The bytes a delta covers, QuantizedPlayerData, CompressedQuaternion and QuantizedAngularVelocity as laid out on the wire.
+constexpr size_t PLAYER_STATE_SIZE =
+    sizeof(nier::QuantizedPlayerData) + sizeof(nier::CompressedQuaternion) + sizeof(nier::QuantizedAngularVelocity);
+using PlayerState = std::array<uint8_t, PLAYER_STATE_SIZE>;
+
+// How many sent or received states are kept, an ack older than this can't be used as a baseline anymore.
+constexpr uint16_t BASELINE_COUNT = 32;
+
+PlayerState make_player_state(const nier::QuantizedPlayerData& quantized, const nier::CompressedQuaternion& orientation,
+    const nier::QuantizedAngularVelocity& angular_velocity);
+void read_player_state(const PlayerState& state, nier::QuantizedPlayerData& quantized, nier::CompressedQuaternion& orientation,
+    nier::QuantizedAngularVelocity& angular_velocity);
+
+// Appends state XOR baseline to out. A control byte below 0x80 is followed by that many plus one
+// literal bytes, one above it stands for (control & 0x7F) + 1 zero bytes.
+void encode(const PlayerState& state, const PlayerState& baseline, std::vector<uint8_t>& out);
+// False if delta is malformed or doesn't cover exactly one state.
+bool decode(const uint8_t* delta, size_t size, const PlayerState& baseline, PlayerState& state);
+
+// True if sequence a came after b, sequences wrap around.
+inline bool is_newer(uint16_t a, uint16_t b) {
+    return (int16_t)(uint16_t)(a - b) > 0;
+}
+
+// The last BASELINE_COUNT states, indexed by sequence.
+class BaselineRing {
+public:
+    void store(uint16_t sequence, const PlayerState& state);
+    // nullptr if sequence was never stored or has been overwritten.
+    const PlayerState* find(uint16_t sequence) const;
+    void clear() { m_entries = {}; }
+
+private:
+    struct Entry {
+        PlayerState state{};
+        uint16_t sequence{};
+        bool valid{false};
+    };
+
+    std::array<Entry, BASELINE_COUNT> m_entries{};
+};
+
+// One player's updates on the sending side.
+class Sender {
+public:
+    // Encodes state against the newest acked state, or against zeros while there is none.
+    // baseline == sequence tells the receiver which one it was.
+    void encode(const PlayerState& state, std::vector<uint8_t>& out, uint16_t& sequence, uint16_t& baseline);
+    void on_ack(uint16_t sequence);
+    void reset();
+
+private:
+    BaselineRing m_sent{};
+    uint16_t m_sequence{};
+    uint16_t m_acked{};
+    bool m_has_ack{false};
+};
+
+// One player's updates on the receiving side.
+class Receiver {
+public:
+    // False if the update is older than one already decoded or its baseline is gone, it is dropped then.
+    bool decode(uint16_t sequence, uint16_t baseline, const uint8_t* delta, size_t size, PlayerState& state);
+    // True once per newly decoded update, sequence is the newest one.
+    bool take_ack(uint16_t& sequence);
+    void reset();
+
+private:
+    BaselineRing m_received{};
+    uint16_t m_newest{};
+    bool m_has_newest{false};
+    bool m_ack_pending{false};
+};
+}
@@ -1,14 +1,81 @@
+#include <algorithm>
+#include <cmath>
+
 #include <spdlog/spdlog.h>
 
 #include "schema/Packets_generated.h"
 
 #include "mods/AutomataMPMod.hpp"
 #include "EntitySync.hpp"
+#include "Quantization.hpp"
+#include "TickScheduler.hpp"
 
 using namespace std;
 
 EntitySync* g_entity_sync = nullptr;
 
+static Vector3f to_vector(const nier::Vector3f& v) {
+    return Vector3f{v.x(), v.y(), v.z()};
+}
+
+static float seconds_between(NetworkEntity::Clock::time_point from, NetworkEntity::Clock::time_point to) {
+    return std::chrono::duration<float>{to - from}.count();
+}
+
+// Facings wrap around, the shortest way between them.
+static float get_facing_difference(float a, float b) {
+    const auto difference = std::fmod(std::abs(a - b), quantization::TWO_PI);
+
+    return std::min(difference, quantization::TWO_PI - difference);
+}
+
+// Velocities are optional, masters that predate them leave them out and their entities don't move between updates.
+static bool read_entity_velocity(const nier::EntitySnapshot* snapshot, flatbuffers::uoffset_t i, Vector3f& velocity) {
+    const auto velocities = snapshot->velocities();
+
+    if (velocities == nullptr) {
+        velocity = {};
+        return true;
+    }
+
+    if (i >= velocities->size()) {
+        return false;
+    }
+
+    velocity = quantization::dequantize_velocity(*velocities->Get(i));
+    return true;
+}
+
+// Snapshots carry either healths or, from masters that replicate properties, a dirty mask per entity.
+static bool has_entity_properties(const nier::EntitySnapshot* snapshot, flatbuffers::uoffset_t count) {
+    if (const auto healths = snapshot->healths(); healths != nullptr) {
+        return healths->size() == count;
+    }
+
+    return snapshot->dirty() != nullptr && snapshot->dirty()->size() == count;
+}
+
+// Overwrites values with what the snapshot has for entity i, properties are read from offset on and it moves past them.
+// False if they are malformed, values is left as is for properties that aren't dirty.
+static bool read_entity_properties(const nier::EntitySnapshot* snapshot, flatbuffers::uoffset_t i, size_t& offset,
+    replication::EntityProperties::Values& values)
+{
+    if (const auto healths = snapshot->healths(); healths != nullptr) {
+        values = {healths->Get(i)};
+        return true;
+    }
+
+    const auto dirty = snapshot->dirty()->Get(i);
+    const auto properties = snapshot->properties();
+
+    if ((dirty & ~replication::EntityProperties::ALL) != 0) {
+        return false;
+    }
+
+    return dirty == 0 ||
+        (properties != nullptr && replication::EntityProperties::read(properties->data(), properties->size(), dirty, values, offset));
+}
+
 NetworkEntity::NetworkEntity(sdk::Entity* entity, uint32_t guid)
     : m_guid(guid)
     , m_entity_handle(entity->handle) {
@@ -23,6 +90,52 @@ NetworkEntity::NetworkEntity(sdk::Entity* entity, uint32_t guid)
     }
 }
 
+void NetworkEntity::set_motion(const nier::EntityData& data, const Vector3f& velocity, Clock::time_point now) {
+    m_entity_data = data;
+    m_velocity = velocity;
+    m_correction = {};
+    m_motion_time = now;
+}
+
+void NetworkEntity::receive_motion(const nier::EntityData& data, const Vector3f& velocity, Clock::time_point now) {
+    const auto shown = get_display_position(now);
+
+    set_motion(data, velocity, now);
+
+    const auto correction = shown - to_vector(data.position());
+
+    if (glm::length(correction) < TELEPORT_DISTANCE) {
+        m_correction = correction;
+    }
+}
+
+Vector3f NetworkEntity::predict_position(Clock::time_point now) const {
+    const auto elapsed = std::clamp(seconds_between(m_motion_time, now), 0.0f, MAX_EXTRAPOLATION);
+
+    return to_vector(m_entity_data.position()) + m_velocity * elapsed;
+}
+
+Vector3f NetworkEntity::get_display_position(Clock::time_point now) const {
+    const auto remaining = 1.0f - std::clamp(seconds_between(m_motion_time, now) / CORRECTION_TIME, 0.0f, 1.0f);
+
+    return predict_position(now) + m_correction * remaining;
+}
+
+Vector3f NetworkEntity::estimate_velocity(const Vector3f& position, Clock::time_point now) {
+    const auto elapsed = seconds_between(m_sample_time, now);
+    const auto moved = position - m_sample_position;
+
+    m_sample_position = position;
+    m_sample_time = now;
+
+    // Longer than a tick at the slowest send rate means this is the first sample in a while.
+    if (elapsed <= 0.0f || elapsed > 1.0f / TickScheduler::MIN_RATE || glm::length(moved) >= TELEPORT_DISTANCE) {
+        return {};
+    }
+
+    return moved / elapsed;
+}
+
 void NetworkEntity::start_animation_hook(sdk::Behavior* behavior, uint32_t anim, uint32_t variant, uint32_t a3, uint32_t a4) {
     scoped_lock _(g_entity_sync->m_map_mutex);
 
@@ -176,9 +289,15 @@ void EntitySync::remove_entity(uint32_t identifier) {
     }
 }
 
-void EntitySync::think() {
+void EntitySync::think(bool send_tick) {
     scoped_lock _(m_map_mutex);
 
+    const auto is_master_client = AutomataMPMod::get()->is_server();
+    const auto send_snapshot = is_master_client && send_tick;
+    const auto send_unchanged = send_snapshot && m_snapshot_tick++ % SNAPSHOT_REFRESH_INTERVAL == 0;
+    const auto send_velocities = send_snapshot && AutomataMPMod::get()->get_client()->sends_entity_velocities();
+    const auto now = NetworkEntity::Clock::now();
+
     for (auto& it : m_network_entities) {
         auto networked_entity = it.second;
         auto ent = networked_entity->get_entity();
@@ -194,28 +313,55 @@ void EntitySync::think() {
             continue;
         }
 
-        if (AutomataMPMod::get()->is_server()) {
-            /*packet.position = *npc->getPosition();
-            packet.facing = *npc->getFacing();
-            packet.facing2 = *npc->getFacing2();
-            packet.health = *npc->getHealth();*/
+        if (send_snapshot) {
+            const Vector3f position = npc->position();
+            const nier::EntityData data(npc->facing(),
+                0.0f, // entity is not a player.
+                npc->health(), *(nier::Vector3f*)&position);
+            const auto orientation = quantization::compress_quaternion(npc->rotation());
+            // Estimated every tick, sent or not, so it always spans one tick. Receivers of V1 entity data don't get one.
+            const auto velocity = quantization::quantize_velocity(networked_entity->estimate_velocity(position, now));
+            const auto sent_velocity = send_velocities ? velocity : nier::QuantizedVelocity{};
+            auto& properties = networked_entity->get_properties();
+
+            properties.update(*npc);
+
+            if (send_unchanged) {
+                properties.mark_all_dirty();
+            }
+
+            // Still dirty properties keep the entity in the snapshot until their resends are used up.
+            const auto dirty = properties.take_dirty();
 
-            AutomataMPMod::get()->get_client()->send_entity_data(it.first, npc);
+            // packet holds what was last sent for this entity, and is what receivers predict from.
+            if (send_unchanged || dirty != 0 || data.health() != packet.health() || has_diverged(*networked_entity, data, orientation, now)) {
+                networked_entity->set_motion(data, quantization::dequantize_velocity(sent_velocity), now);
+                networked_entity->set_orientation(orientation);
+                m_snapshot.push_back(it.first, data, orientation, sent_velocity, dirty, properties.get_values());
+            }
         }
-        else {
-            npc->position() = *(Vector3f*)&packet.position();
+        else if (!is_master_client) {
+            npc->position() = networked_entity->get_display_position(now);
             npc->facing() = packet.facing();
             //npc->getFacing2() = packet.facing2();
             npc->health() = packet.health();
+
+            if (const auto orientation = networked_entity->get_orientation(); orientation != nullptr) {
+                npc->set_rotation(quantization::decompress_quaternion(*orientation));
+            }
         }
 
         npc->setSuspend(false);
     }
 
+    // Every diverged entity goes out in one message instead of a packet each.
+    if (!m_snapshot.empty()) {
+        AutomataMPMod::get()->get_client()->send_entity_snapshot(m_snapshot);
+        m_snapshot.clear();
+    }
+
     // genius moment
     try {
-        const auto is_master_client = AutomataMPMod::get()->is_server();
-
         // Delete any entities that are not supposed to be networked.
         if (!is_master_client) {
             auto entity_list = sdk::EntityList::get();
@@ -254,25 +400,168 @@ void EntitySync::process_entity_data(uint32_t guid, const nier::EntityData* data
 
     scoped_lock _(m_map_mutex);
     if (auto it = m_network_entities.find(guid); it != m_network_entities.end()) {
-        auto ent = it->second;
+        // Entity data has no velocity, the entity stays put until the next one.
+        apply_entity_data(*it->second, *data, Vector3f{});
+    }
+}
 
-        const auto cont = ent->get_entity();
+bool EntitySync::process_entity_snapshot(const nier::EntitySnapshot* snapshot, float position_precision) {
+    if (snapshot->quantized_positions() != nullptr) {
+        return process_quantized_entity_snapshot(snapshot, position_precision);
+    }
 
-        if (cont == nullptr) {
-            return;
+    const auto guids = snapshot->guids();
+    const auto positions = snapshot->positions();
+    const auto facings = snapshot->facings();
+    const auto facings2 = snapshot->facings2();
+
+    if (guids == nullptr || positions == nullptr || facings == nullptr || facings2 == nullptr) {
+        return false;
+    }
+
+    const auto count = guids->size();
+
+    if (positions->size() != count || facings->size() != count || facings2->size() != count || !has_entity_properties(snapshot, count)) {
+        return false;
+    }
+
+    scoped_lock _(m_map_mutex);
+    size_t properties_offset = 0;
+
+    for (flatbuffers::uoffset_t i = 0; i < count; ++i) {
+        const auto it = m_network_entities.find(guids->Get(i));
+        const auto known = it != m_network_entities.end();
+
+        // Read for unknown entities too, their properties are in the way of the ones after them.
+        replication::EntityProperties::Values properties{known ? it->second->get_entity_data().health() : 0u};
+
+        if (!read_entity_properties(snapshot, i, properties_offset, properties)) {
+            return false;
         }
 
-        auto npc = cont->behavior->as<sdk::BehaviorAppBase>();
+        if (!known) {
+            continue;
+        }
 
-        if (npc == nullptr) {
-            return;
+        Vector3f velocity{};
+
+        if (!read_entity_velocity(snapshot, i, velocity)) {
+            return false;
         }
 
-        npc->position() = *(Vector3f*)&data->position();
-        npc->facing() = data->facing();
-        //*npc->getFacing2() = data->facing2();
-        npc->health() = data->health();
+        const auto& [health] = properties;
+        const nier::EntityData data(facings->Get(i), facings2->Get(i), health, *positions->Get(i));
+        apply_entity_data(*it->second, data, velocity);
+    }
+
+    apply_entity_orientations(guids, snapshot->orientations());
 
-        ent->set_entity_data(*data);
+    return true;
+}
+
+bool EntitySync::process_quantized_entity_snapshot(const nier::EntitySnapshot* snapshot, float position_precision) {
+    const auto guids = snapshot->guids();
+    const auto sector = snapshot->sector();
+    const auto positions = snapshot->quantized_positions();
+    const auto facings = snapshot->quantized_facings();
+    const auto facings2 = snapshot->quantized_facings2();
+
+    if (position_precision <= 0.0f || guids == nullptr || sector == nullptr || positions == nullptr ||
+        facings == nullptr || facings2 == nullptr)
+    {
+        return false;
+    }
+
+    const auto count = guids->size();
+
+    if (positions->size() != count || facings->size() != count || facings2->size() != count || !has_entity_properties(snapshot, count)) {
+        return false;
     }
+
+    scoped_lock _(m_map_mutex);
+    size_t properties_offset = 0;
+
+    for (flatbuffers::uoffset_t i = 0; i < count; ++i) {
+        const auto it = m_network_entities.find(guids->Get(i));
+        const auto known = it != m_network_entities.end();
+
+        // Read for unknown entities too, same as process_entity_snapshot.
+        replication::EntityProperties::Values properties{known ? it->second->get_entity_data().health() : 0u};
+
+        if (!read_entity_properties(snapshot, i, properties_offset, properties)) {
+            return false;
+        }
+
+        if (!known) {
+            continue;
+        }
+
+        Vector3f velocity{};
+
+        if (!read_entity_velocity(snapshot, i, velocity)) {
+            return false;
+        }
+
+        const auto& [health] = properties;
+        const nier::EntityData data(quantization::dequantize_yaw(facings->Get(i)), quantization::dequantize_yaw(facings2->Get(i)),
+            health, quantization::dequantize_position(*positions->Get(i), *sector, position_precision));
+        apply_entity_data(*it->second, data, velocity);
+    }
+
+    apply_entity_orientations(guids, snapshot->orientations());
+
+    return true;
+}
+
+void EntitySync::apply_entity_orientations(const flatbuffers::Vector<uint32_t>* guids,
+    const flatbuffers::Vector<const nier::CompressedQuaternion*>* orientations)
+{
+    if (orientations == nullptr || orientations->size() != guids->size()) {
+        return;
+    }
+
+    scoped_lock _(m_map_mutex);
+
+    for (flatbuffers::uoffset_t i = 0; i < guids->size(); ++i) {
+        const auto it = m_network_entities.find(guids->Get(i));
+
+        if (it == m_network_entities.end()) {
+            continue;
+        }
+
+        // Applied to the entity by think(), with the rest of its state.
+        it->second->set_orientation(*orientations->Get(i));
+    }
+}
+
+bool EntitySync::has_diverged(const NetworkEntity& network_entity, const nier::EntityData& data,
+    const nier::CompressedQuaternion& orientation, NetworkEntity::Clock::time_point now)
+{
+    const auto& sent = network_entity.m_entity_data;
+
+    if (glm::length(to_vector(data.position()) - network_entity.predict_position(now)) > POSITION_TOLERANCE ||
+        get_facing_difference(data.facing(), sent.facing()) > FACING_TOLERANCE)
+    {
+        return true;
+    }
+
+    const auto sent_orientation = network_entity.get_orientation();
+
+    if (sent_orientation == nullptr) {
+        return true;
+    }
+
+    // Compressed the same both times, so an unchanged orientation compares equal without decompressing.
+    if (sent_orientation->value() == orientation.value()) {
+        return false;
+    }
+
+    const auto dot = std::abs(glm::dot(quantization::decompress_quaternion(*sent_orientation), quantization::decompress_quaternion(orientation)));
+
+    return 2.0f * std::acos(std::min(dot, 1.0f)) > ORIENTATION_TOLERANCE;
+}
+
+// Shown by think() every frame, carried on from here at velocity until the next update.
+void EntitySync::apply_entity_data(NetworkEntity& network_entity, const nier::EntityData& data, const Vector3f& velocity) {
+    network_entity.receive_motion(data, velocity, NetworkEntity::Clock::now());
 }
@@ -1,18 +1,33 @@
 #pragma once
 
+#include <chrono>
 #include <unordered_map>
 #include <mutex>
+#include <vector>
 
 #include <utility/VtableHook.hpp>
 
 #include "schema/Packets_generated.h"
+#include "ReplicatedProperty.hpp"
 #include <sdk/Entity.hpp>
 #include <sdk/EntityList.hpp>
+#include <sdk/Math.hpp>
 
 class EntitySync;
 
+// Entities are dead reckoned: receivers carry one on at the velocity it was last sent with, and the master
+// predicts the same from what it sent so it only sends again once the real entity has moved away from that guess.
 class NetworkEntity {
 public:
+    using Clock = std::chrono::steady_clock;
+
+    // Past this an entity that wasn't updated stops where it is, so one whose updates stopped arriving doesn't drift off.
+    static constexpr float MAX_EXTRAPOLATION = 0.25f;
+    // How long the jump between a prediction and a new update is blended out over.
+    static constexpr float CORRECTION_TIME = 0.1f;
+    // Jumps further than this aren't blended, the entity was moved there.
+    static constexpr float TELEPORT_DISTANCE = 10.0f;
+
     NetworkEntity(sdk::Entity* entity, uint32_t guid);
 
     void set_entity(sdk::Entity* entity) { m_entity_handle = entity->handle; }
@@ -31,6 +46,29 @@ public:
 
     void set_entity_data(const nier::EntityData& data) { m_entity_data = data; }
 
+    // Takes state the master sent or, on the master, the state it sent, carried on from now at velocity.
+    void set_motion(const nier::EntityData& data, const Vector3f& velocity, Clock::time_point now);
+    // Like set_motion, but blends from where the entity is shown instead of jumping to the new state.
+    void receive_motion(const nier::EntityData& data, const Vector3f& velocity, Clock::time_point now);
+
+    // Where receivers expect the entity to be at now, going by the last state.
+    Vector3f predict_position(Clock::time_point now) const;
+    // The prediction plus what is left of the last correction, where receivers show the entity.
+    Vector3f get_display_position(Clock::time_point now) const;
+    // On the master, the velocity since the previous call. Zero for the first one or after a jump.
+    Vector3f estimate_velocity(const Vector3f& position, Clock::time_point now);
+
+    // Compressed, so the master compares what it last sent and everyone else keeps what it received.
+    const nier::CompressedQuaternion* get_orientation() const { return m_has_orientation ? &m_orientation : nullptr; }
+
+    void set_orientation(const nier::CompressedQuaternion& orientation) {
+        m_orientation = orientation;
+        m_has_orientation = true;
+    }
+
+    // What the master last saw of the entity's replicated properties.
+    auto& get_properties() { return m_properties; }
+
     auto get_guid() const { return m_guid; }
 
     void set_guid(uint32_t guid) { m_guid = guid; }
@@ -43,6 +81,57 @@ private:
     uint32_t m_guid{};
     uint32_t m_entity_handle{};
     nier::EntityData m_entity_data;
+    Vector3f m_velocity{};
+    Vector3f m_correction{};
+    Clock::time_point m_motion_time{};
+    Vector3f m_sample_position{};
+    Clock::time_point m_sample_time{};
+    nier::CompressedQuaternion m_orientation{};
+    bool m_has_orientation{false};
+    replication::EntityProperties m_properties{};
+};
+
+// The state of every entity that changed during a tick as parallel arrays, laid out like nier::EntitySnapshot.
+struct EntitySnapshotData {
+    std::vector<uint32_t> guids{};
+    std::vector<nier::Vector3f> positions{};
+    std::vector<float> facings{};
+    std::vector<float> facings2{};
+    std::vector<uint32_t> healths{};
+    std::vector<nier::CompressedQuaternion> orientations{};
+    std::vector<nier::QuantizedVelocity> velocities{};
+    std::vector<uint8_t> dirty{}; // the replicated properties to send, see nier::EntitySnapshot.dirty
+    std::vector<replication::EntityProperties::Values> properties{};
+
+    void push_back(uint32_t guid, const nier::EntityData& data, const nier::CompressedQuaternion& orientation,
+        const nier::QuantizedVelocity& velocity, uint8_t dirty_mask, const replication::EntityProperties::Values& values)
+    {
+        guids.push_back(guid);
+        positions.push_back(data.position());
+        facings.push_back(data.facing());
+        facings2.push_back(data.facing2());
+        healths.push_back(data.health());
+        orientations.push_back(orientation);
+        velocities.push_back(velocity);
+        dirty.push_back(dirty_mask);
+        properties.push_back(values);
+    }
+
+    // Keeps the capacity, so a steady number of entities doesn't allocate every tick.
+    void clear() {
+        guids.clear();
+        positions.clear();
+        facings.clear();
+        facings2.clear();
+        healths.clear();
+        orientations.clear();
+        velocities.clear();
+        dirty.clear();
+        properties.clear();
+    }
+
+    size_t size() const { return guids.size(); }
+    bool empty() const { return guids.empty(); }
 };
 
 class EntitySync {
@@ -56,8 +145,11 @@ public:
     std::shared_ptr<NetworkEntity> add_entity(sdk::Entity* entity, uint32_t guid);
     void remove_entity(uint32_t identifier);
 
-    void think();
+    // Applies received state every frame, on the master send_tick says whether a snapshot is due.
+    void think(bool send_tick);
     void process_entity_data(uint32_t guid, const nier::EntityData* data);
+    // position_precision is the one from the welcome, quantized snapshots are rejected without one.
+    bool process_entity_snapshot(const nier::EntitySnapshot* snapshot, float position_precision);
 
     std::shared_ptr<NetworkEntity> get_network_entity_from_handle(uint32_t handle) {
         auto it = m_handle_map.find(handle);
@@ -87,7 +179,28 @@ public:
 
 private:
     friend class NetworkEntity;
+
+    // Entities whose prediction still holds are left out of the snapshot, except on every Nth tick
+    // so a lost one can't leave a client stale.
+    static constexpr uint32_t SNAPSHOT_REFRESH_INTERVAL = 30;
+    // How far the real entity may get from what receivers predict before it is sent again.
+    static constexpr float POSITION_TOLERANCE = 0.1f;
+    static constexpr float FACING_TOLERANCE = 0.05f; // radians, about 3 degrees
+    static constexpr float ORIENTATION_TOLERANCE = 0.05f; // radians of rotation between the two
+
+    // True once receivers' prediction of network_entity is too far off data and orientation to leave it out.
+    static bool has_diverged(const NetworkEntity& network_entity, const nier::EntityData& data,
+        const nier::CompressedQuaternion& orientation, NetworkEntity::Clock::time_point now);
+
+    bool process_quantized_entity_snapshot(const nier::EntitySnapshot* snapshot, float position_precision);
+    void apply_entity_data(NetworkEntity& network_entity, const nier::EntityData& data, const Vector3f& velocity);
+    // orientations is optional, older masters leave it out.
+    void apply_entity_orientations(const flatbuffers::Vector<uint32_t>* guids,
+        const flatbuffers::Vector<const nier::CompressedQuaternion*>* orientations);
+
     uint32_t m_max_guid{0};
+    uint32_t m_snapshot_tick{0};
+    EntitySnapshotData m_snapshot{};
     std::unordered_map<uint32_t, std::shared_ptr<NetworkEntity>> m_network_entities;
     std::unordered_map<uint32_t, uint32_t> m_handle_map;
     std::recursive_mutex m_map_mutex;
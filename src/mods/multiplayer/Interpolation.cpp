@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Interpolation.hpp"
+
+namespace interpolation {
+// Weights of the running averages, 1/16 like RFC 3550 jitter.
+static constexpr double STATISTICS_GAIN = 1.0 / 16.0;
+// How hard the smoothed timeline is pulled toward the real arrival times.
+static constexpr double TIMELINE_GAIN = 1.0 / 8.0;
+// Nothing for this long restarts the timeline, the player stopped sending or the link stalled.
+static constexpr double TIMELINE_RESET_GAP = 1.0;
+static constexpr float TWO_PI = 6.28318530717958647692f;
+
+static float lerp_angle(float a, float b, float t) {
+    return a + std::remainder(b - a, TWO_PI) * t;
+}
+
+State lerp(const State& a, const State& b, float t) {
+    return State{
+        a.position + (b.position - a.position) * t,
+        lerp_angle(a.facing, b.facing, t),
+        lerp_angle(a.facing2, b.facing2, t),
+        a.speed + (b.speed - a.speed) * t,
+    };
+}
+
+void SnapshotBuffer::push(double arrival_time, const State& state) {
+    if (m_has_arrival) {
+        const auto gap = arrival_time - m_last_arrival;
+
+        if (gap < TIMELINE_RESET_GAP) {
+            m_interval += (gap - m_interval) * STATISTICS_GAIN;
+            m_jitter += (std::abs(gap - m_interval) - m_jitter) * STATISTICS_GAIN;
+        }
+    }
+
+    m_last_arrival = arrival_time;
+    m_has_arrival = true;
+
+    // An update every interval plus room for a late one, playback needs an update on either side of it.
+    const auto target_delay = std::clamp(m_interval + 2.0 * m_jitter, MIN_PLAYOUT_DELAY, MAX_PLAYOUT_DELAY);
+    m_playout_delay += (target_delay - m_playout_delay) * STATISTICS_GAIN;
+
+    auto time = arrival_time;
+
+    if (m_count > 0) {
+        const auto& newest = get(m_count - 1);
+
+        if (arrival_time - newest.time >= TIMELINE_RESET_GAP ||
+            glm::length(state.position - newest.state.position) > TELEPORT_DISTANCE)
+        {
+            clear();
+        } else {
+            // Evenly spaced while the sender is steady, never later than the update really arrived.
+            const auto expected = newest.time + m_interval;
+            time = std::clamp(expected + (arrival_time - expected) * TIMELINE_GAIN, newest.time, arrival_time);
+        }
+    }
+
+    m_entries[m_next] = Entry{time, state};
+    m_next = (m_next + 1) % CAPACITY;
+    m_count = std::min(m_count + 1, CAPACITY);
+}
+
+bool SnapshotBuffer::sample(double now, State& out) const {
+    if (m_count == 0) {
+        return false;
+    }
+
+    const auto render_time = now - m_playout_delay;
+    const auto& newest = get(m_count - 1);
+
+    if (render_time >= newest.time) {
+        out = newest.state;
+
+        // Late, keep going the way the last two updates went for a little while, then stop.
+        if (m_count >= 2) {
+            const auto& previous = get(m_count - 2);
+            const auto span = newest.time - previous.time;
+
+            if (span > 0.0) {
+                const auto ahead = std::min(render_time - newest.time, MAX_EXTRAPOLATION);
+                out.position += (newest.state.position - previous.state.position) * (float)(ahead / span);
+            }
+        }
+
+        return true;
+    }
+
+    if (render_time <= get(0).time) {
+        out = get(0).state;
+        return true;
+    }
+
+    for (size_t i = m_count - 1; i > 0; --i) {
+        const auto& a = get(i - 1);
+        const auto& b = get(i);
+
+        if (render_time >= a.time) {
+            const auto span = b.time - a.time;
+            out = span > 0.0 ? lerp(a.state, b.state, (float)((render_time - a.time) / span)) : b.state;
+            return true;
+        }
+    }
+
+    out = newest.state;
+    return true;
+}
+
+void SnapshotBuffer::clear() {
+    m_next = 0;
+    m_count = 0;
+}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+// Remote player movement played back a little in the past, between updates that have already arrived,
+// instead of snapping to each one as it comes in.
+// Updates are stamped on a smoothed copy of the arrival timeline so network jitter doesn't end up in
+// the motion, and the playout delay follows the measured jitter so it is only as long as it has to be.
+// Pure on purpose, times are seconds on any monotonic clock so recorded traces can be replayed.
+namespace interpolation {
+// The fields that are blended, everything else in nier::PlayerData is taken from the newest update.
+struct State {
+    glm::vec3 position{};
+    float facing{}; // radians
+    float facing2{};
+    float speed{};
+};
+
+class SnapshotBuffer {
+public:
+    static constexpr size_t CAPACITY = 32;
+    // Until two updates have arrived, the rate players are sent at by default.
+    static constexpr double DEFAULT_INTERVAL = 1.0 / 30.0;
+    static constexpr double MIN_PLAYOUT_DELAY = 0.03;
+    static constexpr double MAX_PLAYOUT_DELAY = 0.5;
+    // How far past the newest update movement is continued when the next one is late.
+    static constexpr double MAX_EXTRAPOLATION = 0.25;
+    // Farther than this between two updates is a teleport, it is snapped to instead of slid across.
+    static constexpr float TELEPORT_DISTANCE = 10.0f;
+
+    void push(double arrival_time, const State& state);
+    // The state to show at now, false if nothing has arrived yet.
+    bool sample(double now, State& out) const;
+    void clear();
+
+    double get_interval() const { return m_interval; }
+    double get_jitter() const { return m_jitter; }
+    double get_playout_delay() const { return m_playout_delay; }
+
+private:
+    struct Entry {
+        double time{}; // on the smoothed timeline
+        State state{};
+    };
+
+    // 0 is the oldest.
+    const Entry& get(size_t i) const { return m_entries[(m_next + CAPACITY - m_count + i) % CAPACITY]; }
+
+    std::array<Entry, CAPACITY> m_entries{};
+    size_t m_next{};
+    size_t m_count{};
+
+    double m_last_arrival{};
+    bool m_has_arrival{false};
+    double m_interval{DEFAULT_INTERVAL};
+    double m_jitter{};
+    double m_playout_delay{DEFAULT_INTERVAL};
+};
+
+// a to b by t, facings take the short way around.
+State lerp(const State& a, const State& b, float t);
+}
@@ -182,19 +182,20 @@ MidHooks::MidHooks() {
             return;
         }
 
-        const auto& players = client->get_players();
+        // Runs for every character each time it processes buttons, so players are found by handle instead of by walking them.
+        const auto owner = entity->get_entity();
 
-        auto it = std::find_if(players.begin(), players.end(), [&](auto& player) {
-            return player.second->get_entity() == entity;
-        });
-
-        if (it == players.end() || it->second == nullptr) {
+        if (owner == nullptr) {
             return;
         }
 
-        if (entity == it->second->get_entity()) {
-            entity->character_controller().held_flags = it->second->get_player_data().held_button_flags();
+        const auto player = client->get_players().find_by_handle(owner->handle);
+
+        if (player == nullptr) {
+            return;
         }
+
+        entity->character_controller().held_flags = player->get_player_data().held_button_flags();
     });
 
     spdlog::info("[MidHooks] Initialized.");
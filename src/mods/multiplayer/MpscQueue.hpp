@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// Unbounded lock free queue any number of threads push to and one thread pops from (Vyukov's MPSC node queue).
+// A push is one exchange and one store, producers never wait on each other or on the consumer.
+// The consumer owns a dummy node whose successor holds the next value, popping moves that value out and
+// makes its node the new dummy, so the queue is never empty of nodes and needs no lock on either end.
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() {
+        const auto stub = new Node{};
+        m_head.store(stub, std::memory_order_relaxed);
+        m_tail = stub;
+    }
+
+    ~MpscQueue() {
+        T value{};
+
+        while (try_pop(value)) {
+        }
+
+        delete m_tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread.
+    void push(T value) {
+        const auto node = new Node{std::move(value)};
+        const auto previous = m_head.exchange(node, std::memory_order_acq_rel);
+
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer only. False if the queue is empty, or if the oldest push hasn't linked its node yet,
+    // in which case it and everything pushed after it comes out of a later call.
+    bool try_pop(T& out) {
+        const auto tail = m_tail;
+        const auto next = tail->next.load(std::memory_order_acquire);
+
+        if (next == nullptr) {
+            return false;
+        }
+
+        out = std::move(next->value);
+        next->value = T{};
+        m_tail = next;
+        delete tail;
+        return true;
+    }
+
+private:
+    struct Node {
+        T value{};
+        std::atomic<Node*> next{nullptr};
+    };
+
+    std::atomic<Node*> m_head{}; // newest node, producers swap themselves in here
+    Node* m_tail{}; // the consumer's dummy node
+};
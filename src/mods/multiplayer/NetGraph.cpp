@@ -0,0 +1,49 @@
+#include <imgui.h>
+
+#include "NetGraph.hpp"
+
+void NetGraph::update(const enetpp::client_statistics& stats) {
+    const auto now = std::chrono::steady_clock::now();
+    const auto elapsed = now - m_last_sample_time;
+
+    if (elapsed < SAMPLE_INTERVAL) {
+        return;
+    }
+
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_received = 0;
+
+    for (const auto& channel : stats._channels) {
+        bytes_sent += channel._bytes_sent;
+        bytes_received += channel._bytes_received;
+    }
+
+    // First sample only establishes the baseline.
+    if (m_last_sample_time != std::chrono::steady_clock::time_point{}) {
+        const auto seconds = std::chrono::duration<float>(elapsed).count();
+
+        m_sent_kbps[m_offset] = (float)(bytes_sent - m_last_bytes_sent) * 8.0f / 1000.0f / seconds;
+        m_received_kbps[m_offset] = (float)(bytes_received - m_last_bytes_received) * 8.0f / 1000.0f / seconds;
+        m_rtt_ms[m_offset] = (float)stats._round_trip_time_in_ms;
+        m_offset = (m_offset + 1) % SAMPLE_COUNT;
+    }
+
+    m_last_sample_time = now;
+    m_last_bytes_sent = bytes_sent;
+    m_last_bytes_received = bytes_received;
+}
+
+void NetGraph::draw() const {
+    // m_offset is the oldest sample, the newest is just before it.
+    const auto newest = (m_offset + SAMPLE_COUNT - 1) % SAMPLE_COUNT;
+    char overlay[64]{};
+
+    snprintf(overlay, sizeof(overlay), "%.1f kbit/s", m_sent_kbps[newest]);
+    ImGui::PlotLines("Sent", m_sent_kbps.data(), (int)SAMPLE_COUNT, (int)m_offset, overlay, 0.0f, FLT_MAX, ImVec2{0, 60});
+
+    snprintf(overlay, sizeof(overlay), "%.1f kbit/s", m_received_kbps[newest]);
+    ImGui::PlotLines("Received", m_received_kbps.data(), (int)SAMPLE_COUNT, (int)m_offset, overlay, 0.0f, FLT_MAX, ImVec2{0, 60});
+
+    snprintf(overlay, sizeof(overlay), "%.0f ms", m_rtt_ms[newest]);
+    ImGui::PlotLines("RTT", m_rtt_ms.data(), (int)SAMPLE_COUNT, (int)m_offset, overlay, 0.0f, FLT_MAX, ImVec2{0, 60});
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include <enetpp/client_statistics.h>
+
+// Rolling bandwidth / round trip time graph fed from enetpp::client_statistics.
+// Only touched from the thread drawing the UI, the statistics themselves are atomics.
+class NetGraph {
+public:
+    static constexpr size_t SAMPLE_COUNT = 120;
+    static constexpr std::chrono::milliseconds SAMPLE_INTERVAL{250};
+
+    void update(const enetpp::client_statistics& stats);
+    void draw() const;
+
+private:
+    std::array<float, SAMPLE_COUNT> m_sent_kbps{};
+    std::array<float, SAMPLE_COUNT> m_received_kbps{};
+    std::array<float, SAMPLE_COUNT> m_rtt_ms{};
+    size_t m_offset{};
+
+    std::chrono::steady_clock::time_point m_last_sample_time{};
+    uint64_t m_last_bytes_sent{};
+    uint64_t m_last_bytes_received{};
+};
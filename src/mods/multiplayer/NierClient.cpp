@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <numeric>
 #include <thread>
+#include <tuple>
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -14,6 +17,39 @@
 
 using namespace std;
 
+// Only the newest state update per (type, guid) matters, older ones still queued on a congested link get dropped.
+// Player guids are 64 bit, so the whole guid is hashed with the type instead of packing them side by side.
+static uint64_t make_coalesce_key(nier::PacketType id, uint64_t guid) {
+    // splitmix64's finalizer.
+    auto key = guid ^ ((uint64_t)id * 0x9E3779B97F4A7C15ull);
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+    key ^= key >> 31;
+
+    return key != 0 ? key : 1; // 0 means not coalescable
+}
+
+// Guid, position, two facings, health, orientation and velocity.
+static constexpr size_t ENTITY_SNAPSHOT_BYTES_PER_ENTITY =
+    sizeof(uint32_t) + sizeof(nier::Vector3f) + sizeof(float) * 2 + sizeof(uint32_t) + sizeof(nier::CompressedQuaternion) +
+    sizeof(nier::QuantizedVelocity);
+// Leaves room for the vector headers and the PacketV2 around the snapshot.
+static constexpr size_t MAX_ENTITY_SNAPSHOT_SIZE =
+    (ENET_HOST_DEFAULT_MTU - PacketBatcher::ENET_OVERHEAD - PacketBatcher::ENVELOPE_SIZE - 64) / ENTITY_SNAPSHOT_BYTES_PER_ENTITY;
+// Guid, quantized position, two quantized facings, health, orientation and velocity.
+static constexpr size_t QUANTIZED_ENTITY_SNAPSHOT_BYTES_PER_ENTITY =
+    sizeof(uint32_t) + sizeof(nier::QuantizedVector3) + sizeof(uint16_t) * 2 + sizeof(uint32_t) + sizeof(nier::CompressedQuaternion) +
+    sizeof(nier::QuantizedVelocity);
+static constexpr size_t MAX_QUANTIZED_ENTITY_SNAPSHOT_SIZE =
+    (ENET_HOST_DEFAULT_MTU - PacketBatcher::ENET_OVERHEAD - PacketBatcher::ENVELOPE_SIZE - 64) / QUANTIZED_ENTITY_SNAPSHOT_BYTES_PER_ENTITY;
+
+// V2 wraps struct payloads in a table, returns nullptr if the packet carries a different message.
+template <typename T>
+static auto get_struct_message(const nier::PacketV2* packet) -> decltype(packet->message_as<T>()->data()) {
+    const auto message = packet->message_as<T>();
+    return message != nullptr ? message->data() : nullptr;
+}
+
 NierClient::NierClient(const std::string& host, const std::string& port, const std::string& name, const std::string& password)
     : m_hello_name{ name },
     m_password{ password }
@@ -24,9 +60,10 @@ NierClient::NierClient(const std::string& host, const std::string& port, const s
     enetpp::global_state::get().initialize();
 
     set_trace_handler([](const std::string& s) { spdlog::info("{}", s); });
+    set_receive_handler([this](ENetPacket* packet) { return on_packet_received_in_thread(packet); });
     
     enet_uint16 port_num = static_cast<enet_uint16>(std::stoi(port));
-    connect(enetpp::client_connect_params().set_channel_count(1).set_server_host_name_and_port(host.c_str(), port_num).set_timeout(chrono::seconds(1)));
+    connect(enetpp::client_connect_params().set_channel_count(packet_policy::CHANNEL_COUNT).set_server_host_name_and_port(host.c_str(), port_num).set_timeout(chrono::seconds(1)));
 
     while (get_connection_state() == enetpp::CONNECT_CONNECTING) {
         think();
@@ -42,24 +79,34 @@ NierClient::~NierClient() {
 void NierClient::think() {
     std::scoped_lock _{m_mtx};
 
+    const auto think_start = std::chrono::steady_clock::now();
+
+    // Applied before the events, so whatever arrived ahead of a disconnect is handled ahead of it.
+    apply_received_messages();
+
+    // Received data is decoded on the network thread and never shows up here.
     consume_events(
         [this]() { on_connect(); },
         [this]() { on_disconnect(); },
-        [this](const enet_uint8* a, size_t b) { 
-            on_data_received(a, b); 
-        }
+        [](const enet_uint8*, size_t) {}
     );
 
     if (m_hello_sent && m_welcome_received && m_players.contains(m_guid)) {
+        const auto now = TickScheduler::Clock::now();
+        const auto player_tick = m_player_tick.tick(now);
+
         update_local_player_data();
-        send_player_data();
+
+        if (player_tick) {
+            send_player_data();
+        }
 
         // Synchronize the players.
-        for (auto& it : m_players) {
-            const auto& networked_player = it.second;
+        for (auto& player : m_players) {
+            const auto networked_player = &player;
 
             // Do not update the local player here.
-            if (networked_player == nullptr || networked_player->get_guid() == m_guid) {
+            if (networked_player->get_guid() == m_guid) {
                 continue;
             }
 
@@ -75,37 +122,78 @@ void NierClient::think() {
             auto& data = networked_player->get_player_data();
             npc->run_speed_type() = regenny::ERunSpeedType::SPEED_PLAYER;
             npc->flashlight() = data.flashlight();
-            npc->speed() = data.speed();
-            npc->facing() = data.facing();
-            npc->facing2() = data.facing2();
+
+            // Movement is played back from the buffered updates, the rest is whatever arrived last.
+            if (interpolation::State state{}; networked_player->sample_snapshot(state)) {
+                npc->position() = state.position;
+                npc->speed() = state.speed;
+                npc->facing() = state.facing;
+                npc->facing2() = state.facing2;
+            }
+
             npc->weapon_index() = data.weapon_index();
             npc->pod_index() = data.pod_index();
             npc->character_controller().held_flags = data.held_button_flags();
             //*npc->getPosition() = *(Vector3f*)&data.position();
+
+            if (networked_player->has_orientation()) {
+                npc->set_rotation(networked_player->get_predicted_orientation());
+            }
         }
 
-        m_network_entities->think();
+        m_network_entities->think(m_entity_tick.tick(now));
+
+        if (player_tick) {
+            send_player_data_acks();
+        }
     }
+
+    flush_packet_batches();
+
+    m_think_cost.record(std::chrono::steady_clock::now() - think_start);
 }
 
 void NierClient::on_draw_ui() {
+    if (ImGui::TreeNode("ENet Allocator")) {
+        const auto& allocator = enetpp::global_state::get().get_allocator();
+
+        for (size_t i = 0; i < enetpp::pool_allocator::size_class_count; ++i) {
+            const auto& stats = allocator.get_size_class_statistics(i);
+
+            ImGui::Text("%4zu bytes: %llu hits, %llu misses, %llu free",
+                stats._block_size,
+                (unsigned long long)stats._hit_count,
+                (unsigned long long)stats._miss_count,
+                (unsigned long long)stats._free_block_count);
+        }
+
+        ImGui::Text("Large allocations: %llu", (unsigned long long)allocator.get_large_allocation_count());
+        ImGui::TreePop();
+    }
+
+    draw_network_stats();
+
     std::scoped_lock _{m_players_mutex};
 
-    for (auto& it : m_players) {
-        if (it.second->get_guid() == m_guid) {
+    for (auto& player : m_players) {
+        if (player.get_guid() == m_guid) {
             continue;
         }
 
-        if (ImGui::TreeNode(it.second->get_name().c_str())) {
+        if (ImGui::TreeNode(player.get_name().c_str())) {
+            const auto& snapshots = player.get_snapshots();
+            ImGui::Text("Playout delay: %.1f ms, jitter %.1f ms, interval %.1f ms", snapshots.get_playout_delay() * 1000.0,
+                snapshots.get_jitter() * 1000.0, snapshots.get_interval() * 1000.0);
+
             if (ImGui::Button("Teleport To")) {
                 auto ents = sdk::EntityList::get();
                 auto controlled = ents->get_possessed_entity();
 
                 if (controlled != nullptr && controlled->behavior != nullptr) {
                     if (controlled->behavior->is_pl0000()) {
-                        controlled->behavior->as<sdk::Pl0000>()->setPosRotResetHap(Vector4f{*(Vector3f*)&it.second->get_player_data().position(), 1.0f}, glm::identity<glm::quat>());
+                        controlled->behavior->as<sdk::Pl0000>()->setPosRotResetHap(Vector4f{*(Vector3f*)&player.get_player_data().position(), 1.0f}, glm::identity<glm::quat>());
                     } else {
-                        controlled->behavior->position() = *(Vector3f*)&it.second->get_player_data().position();
+                        controlled->behavior->position() = *(Vector3f*)&player.get_player_data().position();
                     }
                 }
             }
@@ -121,16 +209,16 @@ void NierClient::on_frame() {
     const auto size = g_framework->get_d3d11_rt_size();
     const auto camera = sdk::CameraGame::get();
 
-    for (auto& it : m_players) {
-        if (it.second->get_guid() == m_guid) {
+    for (auto& player : m_players) {
+        if (player.get_guid() == m_guid) {
             continue;
         }
 
-        if (it.second->get_entity() == nullptr) {
+        if (player.get_entity() == nullptr) {
             continue;
         }
 
-        const auto s = camera->world_to_screen(size, it.second->get_entity()->position());
+        const auto s = camera->world_to_screen(size, player.get_entity()->position());
 
         if (s) {
             ImGui::GetBackgroundDrawList()->AddText(
@@ -138,35 +226,35 @@ void NierClient::on_frame() {
                 ImGui::GetFontSize(),
                 ImVec2{s->x, s->y + 1},
                 0xFF000000,
-                it.second->get_name().c_str());
+                player.get_name().c_str());
 
             ImGui::GetBackgroundDrawList()->AddText(
                 ImGui::GetFont(),
                 ImGui::GetFontSize(),
                 ImVec2{s->x, s->y -1},
                 0xFF000000,
-                it.second->get_name().c_str());
+                player.get_name().c_str());
 
             ImGui::GetBackgroundDrawList()->AddText(
                 ImGui::GetFont(),
                 ImGui::GetFontSize(),
                 ImVec2{s->x - 1, s->y},
                 0xFF000000,
-                it.second->get_name().c_str());
+                player.get_name().c_str());
 
             ImGui::GetBackgroundDrawList()->AddText(
                 ImGui::GetFont(),
                 ImGui::GetFontSize(),
                 ImVec2{s->x + 1, s->y},
                 0xFF000000,
-                it.second->get_name().c_str());
+                player.get_name().c_str());
 
             ImGui::GetBackgroundDrawList()->AddText(
                 ImGui::GetFont(),
                 ImGui::GetFontSize(),
                 *(ImVec2*)&*s,
                 ImGui::GetColorU32(ImGuiCol_Text),
-                it.second->get_name().c_str());
+                player.get_name().c_str());
         }
     }
 }
@@ -190,30 +278,134 @@ void NierClient::on_disconnect() {
     spdlog::info("Disconnected");
 }
 
-void NierClient::on_data_received(const enet_uint8* data, size_t size) {
+bool NierClient::on_packet_received_in_thread(ENetPacket* enet_packet) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::shared_ptr<ENetPacket> buffer{enet_packet, enet_packet_destroy};
+    const auto data = buffer->data;
+    const auto size = buffer->dataLength;
+
+    // Every message decoded from this packet is stamped with it, the game thread may only get to them a frame later.
+    m_packet_received_time = start;
+
     try {
         auto verif = flatbuffers::Verifier(data, size);
-        const auto packet = flatbuffers::GetRoot<nier::Packet>(data);
 
-        if (!packet->Verify(verif)) {
-            spdlog::error("Invalid packet");
-            return;
-        }
+        // V2 buffers carry a file identifier, V1 ones never have anything that looks like one at that offset.
+        if (size >= sizeof(flatbuffers::uoffset_t) + flatbuffers::FlatBufferBuilder::kFileIdentifierLength &&
+            nier::PacketV2BufferHasIdentifier(data))
+        {
+            if (nier::VerifyPacketV2Buffer(verif)) {
+                const auto packet = nier::GetPacketV2(data);
+
+                record_packet_stats(packet->id(), size, false);
+                decode_packet(buffer, packet);
+            } else {
+                spdlog::error("Invalid packet");
+            }
+        } else {
+            const auto packet = flatbuffers::GetRoot<nier::Packet>(data);
 
-        on_packet_received(packet);
+            if (packet->Verify(verif)) {
+                record_packet_stats(packet->id(), size, false);
+                decode_packet(buffer, packet);
+            } else {
+                spdlog::error("Invalid packet");
+            }
+        }
     } catch(const std::exception& e) {
-        spdlog::error("Exception occurred during packet processing: {}", e.what());
+        spdlog::error("Exception occurred during packet decoding: {}", e.what());
     } catch(...) {
-        spdlog::error("Unknown exception occurred during packet processing");
+        spdlog::error("Unknown exception occurred during packet decoding");
     }
+
+    m_decode_cost.record(std::chrono::steady_clock::now() - start);
+
+    // Decoded messages hold on to the buffer, a malformed packet is freed here.
+    return true;
 }
 
-void NierClient::on_packet_received(const nier::Packet* packet) {
-    if (!m_welcome_received && packet->id() != nier::PacketType_ID_WELCOME) {
-        spdlog::error("Expected welcome packet, but got {} ({}), ignoring", packet->id(), nier::EnumNamePacketType(packet->id()));
-        return;
+void NierClient::push_received_message(const std::shared_ptr<ENetPacket>& buffer, nier::PacketType id, uint64_t guid,
+    ReceivedMessage::Payload payload)
+{
+    m_received_messages.push(ReceivedMessage{buffer, id, guid, payload, m_packet_received_time});
+}
+
+void NierClient::decode_packet(const std::shared_ptr<ENetPacket>& buffer, const nier::PacketV2* packet) {
+    const auto id = packet->id();
+
+    // The verifier already checked the whole buffer, every handler reads the message in place.
+    switch (id) {
+    case nier::PacketType_ID_PACKET_BATCH: {
+        const auto batch = packet->message_as_PacketBatch();
+
+        if (batch == nullptr || batch->packets() == nullptr) {
+            spdlog::error("Failed to handle packet {} ({})", id, nier::EnumNamePacketType(id));
+            break;
+        }
+
+        // Entries were verified as nested PacketV2 buffers along with the batch.
+        for (const auto entry : *batch->packets()) {
+            if (entry->packet() == nullptr) {
+                continue;
+            }
+
+            const auto entry_packet = entry->packet_nested_root();
+
+            if (entry_packet->id() == nier::PacketType_ID_PACKET_BATCH) {
+                spdlog::error("Nested packet batch, ignoring");
+                continue;
+            }
+
+            record_packet_stats(entry_packet->id(), entry->packet()->size(), false);
+            decode_packet(buffer, entry_packet);
+        }
+
+        break;
+    }
+    case nier::PacketType_ID_WELCOME:
+        push_received_message(buffer, id, packet->guid(), packet->message_as_Welcome());
+        break;
+    case nier::PacketType_ID_SET_MASTER_CLIENT:
+    case nier::PacketType_ID_DESTROY_PLAYER:
+    case nier::PacketType_ID_DESTROY_ENTITY:
+        push_received_message(buffer, id, packet->guid());
+        break;
+    case nier::PacketType_ID_CREATE_PLAYER:
+        push_received_message(buffer, id, packet->guid(), packet->message_as_CreatePlayer());
+        break;
+    case nier::PacketType_ID_SPAWN_ENTITY:
+        push_received_message(buffer, id, packet->guid(), packet->message_as_EntitySpawnParams());
+        break;
+    case nier::PacketType_ID_ENTITY_DATA:
+        push_received_message(buffer, id, packet->guid(), get_struct_message<nier::EntityDataMessage>(packet));
+        break;
+    case nier::PacketType_ID_ENTITY_SNAPSHOT:
+        push_received_message(buffer, id, packet->guid(), packet->message_as_EntitySnapshot());
+        break;
+    case nier::PacketType_ID_ENTITY_ANIMATION_START:
+    case nier::PacketType_ID_ANIMATION_START:
+        push_received_message(buffer, id, packet->guid(), get_struct_message<nier::AnimationStartMessage>(packet));
+        break;
+    case nier::PacketType_ID_PLAYER_DATA:
+        push_received_message(buffer, id, packet->guid(), packet->message_as_PlayerDataMessage());
+        break;
+    case nier::PacketType_ID_PLAYER_DATA_ACK:
+        push_received_message(buffer, id, packet->guid(), packet->message_as_PlayerDataAck());
+        break;
+    case nier::PacketType_ID_STRING_TABLE:
+        push_received_message(buffer, id, packet->guid(), packet->message_as_StringTable());
+        break;
+    case nier::PacketType_ID_BUTTONS:
+        push_received_message(buffer, id, packet->guid(), packet->message_as_Buttons());
+        break;
+    default:
+        spdlog::error("Unknown packet type {} ({})", id, nier::EnumNamePacketType(id));
+        break;
     }
+}
 
+// V1 peers nest every payload in its own buffer, so each level is verified before the typed handlers see it.
+void NierClient::decode_packet(const std::shared_ptr<ENetPacket>& buffer, const nier::Packet* packet) {
     const nier::PlayerPacket* player_packet = nullptr;
 
     // Bounced player packets.
@@ -226,41 +418,50 @@ void NierClient::on_packet_received(const nier::Packet* packet) {
             return;
         }
 
-        on_player_packet_received(packet->id(), player_packet);
+        decode_player_packet(buffer, packet->id(), player_packet);
         return;
     }
 
     // Standard packets.
     switch(packet->id()) {
         case nier::PacketType_ID_WELCOME: {
-            if (handle_welcome(packet)) {
-                m_welcome_received = true;
+            const auto welcome = flatbuffers::GetRoot<nier::Welcome>(packet->data()->data());
+            auto verif = flatbuffers::Verifier(packet->data()->data(), packet->data()->size());
+
+            if (!welcome->Verify(verif)) {
+                spdlog::error("Invalid welcome packet");
+                break;
             }
 
+            push_received_message(buffer, packet->id(), 0, welcome);
             break;
         }
 
         case nier::PacketType_ID_SET_MASTER_CLIENT: {
-            m_is_master_client = true;
+            push_received_message(buffer, packet->id(), 0);
             break;
         }
 
         case nier::PacketType_ID_CREATE_PLAYER: {
-            if (!handle_create_player(packet)) {
-                spdlog::error("Failed to create player");
+            const auto create_player = flatbuffers::GetRoot<nier::CreatePlayer>(packet->data()->data());
+            auto verif = flatbuffers::Verifier(packet->data()->data(), packet->data()->size());
+
+            if (!create_player->Verify(verif)) {
+                spdlog::error("Invalid create player packet");
+                break;
             }
 
+            push_received_message(buffer, packet->id(), 0, create_player);
             break;
         }
 
         case nier::PacketType_ID_DESTROY_PLAYER: {
-            if (!handle_destroy_player(packet)) {
-                spdlog::error("Failed to destroy player");
-            }
+            const auto destroy_player = flatbuffers::GetRoot<nier::DestroyPlayer>(packet->data()->data());
 
+            push_received_message(buffer, packet->id(), destroy_player->guid());
             break;
         }
-        
+
         case nier::PacketType_ID_SPAWN_ENTITY: [[fallthrough]];
         case nier::PacketType_ID_DESTROY_ENTITY: [[fallthrough]];
         case nier::PacketType_ID_ENTITY_DATA: [[fallthrough]];
@@ -273,7 +474,7 @@ void NierClient::on_packet_received(const nier::Packet* packet) {
                 return;
             }
 
-            on_entity_packet_received(packet->id(), entity_packet);
+            decode_entity_packet(buffer, packet->id(), entity_packet);
             break;
         }
 
@@ -290,29 +491,28 @@ void NierClient::on_packet_received(const nier::Packet* packet) {
     }*/
 }
 
-void NierClient::on_player_packet_received(nier::PacketType packet_type, const nier::PlayerPacket* packet) {
-    spdlog::info("Player packet {} received from {}", nier::EnumNamePacketType(packet_type), packet->guid());
+void NierClient::decode_player_packet(const std::shared_ptr<ENetPacket>& buffer, nier::PacketType packet_type, const nier::PlayerPacket* packet) {
+    spdlog::trace("Player packet {} received from {}", nier::EnumNamePacketType(packet_type), packet->guid());
 
     switch (packet_type) {
     case nier::PacketType_ID_PLAYER_DATA: {
-        if (!handle_player_data(packet)) {
-            spdlog::error("Failed to handle player data");
-        }
-
+        push_received_message(buffer, packet_type, packet->guid(), flatbuffers::GetRoot<nier::PlayerData>(packet->data()->data()));
         break;
     }
     case nier::PacketType_ID_ANIMATION_START: {
-        if (!handle_animation_start(packet)) {
-            spdlog::error("Failed to handle animation start");
-        }
-
+        push_received_message(buffer, packet_type, packet->guid(), flatbuffers::GetRoot<nier::AnimationStart>(packet->data()->data()));
         break;
     }
     case nier::PacketType_ID_BUTTONS: {
-        if (!handle_buttons(packet)) {
+        const auto buttons = flatbuffers::GetRoot<nier::Buttons>(packet->data()->data());
+        auto verif = flatbuffers::Verifier(packet->data()->data(), packet->data()->size());
+
+        if (!buttons->Verify(verif)) {
             spdlog::error("Failed to handle buttons");
+            break;
         }
 
+        push_received_message(buffer, packet_type, packet->guid(), buttons);
         break;
     }
     default:
@@ -321,36 +521,32 @@ void NierClient::on_player_packet_received(nier::PacketType packet_type, const n
     }
 }
 
-void NierClient::on_entity_packet_received(nier::PacketType packet_type, const nier::EntityPacket* packet) {
-    spdlog::info("Entity packet {} received from {}", nier::EnumNamePacketType(packet_type), packet->guid());
+void NierClient::decode_entity_packet(const std::shared_ptr<ENetPacket>& buffer, nier::PacketType packet_type, const nier::EntityPacket* packet) {
+    spdlog::trace("Entity packet {} received from {}", nier::EnumNamePacketType(packet_type), packet->guid());
 
     switch (packet_type) {
     case nier::PacketType_ID_SPAWN_ENTITY: {
-        if (!handle_create_entity(packet)) {
+        const auto spawn = flatbuffers::GetRoot<nier::EntitySpawnParams>(packet->data()->data());
+        auto verif = flatbuffers::Verifier(packet->data()->data(), packet->data()->size());
+
+        if (!spawn->Verify(verif)) {
             spdlog::error("Failed to handle spawn entity");
+            break;
         }
 
+        push_received_message(buffer, packet_type, packet->guid(), spawn);
         break;
     }
     case nier::PacketType_ID_DESTROY_ENTITY: {
-        if (!handle_destroy_entity(packet)) {
-            spdlog::error("Failed to handle destroy entity");
-        }
-
+        push_received_message(buffer, packet_type, packet->guid());
         break;
     }
     case nier::PacketType_ID_ENTITY_DATA: {
-        if (!handle_entity_data(packet)) {
-            spdlog::error("Failed to handle entity data");
-        }
-
+        push_received_message(buffer, packet_type, packet->guid(), flatbuffers::GetRoot<nier::EntityData>(packet->data()->data()));
         break;
     }
     case nier::PacketType_ID_ENTITY_ANIMATION_START: {
-        if (!handle_entity_animation_start(packet)) {
-            spdlog::error("Failed to handle entity animation start");
-        }
-
+        push_received_message(buffer, packet_type, packet->guid(), flatbuffers::GetRoot<nier::AnimationStart>(packet->data()->data()));
         break;
     }
     default:
@@ -359,20 +555,120 @@ void NierClient::on_entity_packet_received(nier::PacketType packet_type, const n
     }
 }
 
-void NierClient::send_packet(nier::PacketType id, const uint8_t* data, size_t size) {
-    auto builder = flatbuffers::FlatBufferBuilder{};
+void NierClient::apply_received_messages() {
+    const auto start = std::chrono::steady_clock::now();
+    ReceivedMessage message{};
+
+    while (m_received_messages.try_pop(message)) {
+        try {
+            apply_received_message(message);
+        } catch(const std::exception& e) {
+            spdlog::error("Exception occurred during packet processing: {}", e.what());
+        } catch(...) {
+            spdlog::error("Unknown exception occurred during packet processing");
+        }
+    }
 
-    uint32_t dataoffs = 0;
+    // Drops the last buffer here instead of whenever the next message comes in.
+    message = {};
 
-    if (data != nullptr && size > 0) {
-        builder.StartVector(size, 1); // byte vector
-        for (int64_t i = (int64_t)size - 1; i >= 0; i--) {
-            builder.PushElement(data[i]);
+    m_apply_cost.record(std::chrono::steady_clock::now() - start);
+}
+
+// A payload of another type than the handler takes means the packet didn't carry the message its id says.
+template <typename T>
+static const T* get_payload(const auto& payload) {
+    const auto message = std::get_if<const T*>(&payload);
+    return message != nullptr ? *message : nullptr;
+}
+
+void NierClient::apply_received_message(const ReceivedMessage& message) {
+    const auto id = message.id;
+    const auto guid = message.guid;
+    const auto& payload = message.payload;
+
+    if (!m_welcome_received && id != nier::PacketType_ID_WELCOME) {
+        spdlog::error("Expected welcome packet, but got {} ({}), ignoring", id, nier::EnumNamePacketType(id));
+        return;
+    }
+
+    bool handled = false;
+
+    switch (id) {
+    case nier::PacketType_ID_WELCOME:
+        handled = handle_welcome(get_payload<nier::Welcome>(payload));
+
+        if (handled) {
+            m_welcome_received = true;
+        }
+
+        break;
+    case nier::PacketType_ID_SET_MASTER_CLIENT:
+        m_is_master_client = true;
+        handled = true;
+        break;
+    case nier::PacketType_ID_CREATE_PLAYER:
+        handled = handle_create_player(get_payload<nier::CreatePlayer>(payload));
+        break;
+    case nier::PacketType_ID_DESTROY_PLAYER:
+        handled = handle_destroy_player(guid);
+        break;
+    case nier::PacketType_ID_SPAWN_ENTITY:
+        handled = handle_create_entity((uint32_t)guid, get_payload<nier::EntitySpawnParams>(payload));
+        break;
+    case nier::PacketType_ID_DESTROY_ENTITY:
+        handled = handle_destroy_entity((uint32_t)guid);
+        break;
+    case nier::PacketType_ID_ENTITY_DATA:
+        handled = handle_entity_data((uint32_t)guid, get_payload<nier::EntityData>(payload));
+        break;
+    case nier::PacketType_ID_ENTITY_SNAPSHOT:
+        handled = handle_entity_snapshot(get_payload<nier::EntitySnapshot>(payload));
+        break;
+    case nier::PacketType_ID_ENTITY_ANIMATION_START:
+        handled = handle_entity_animation_start((uint32_t)guid, get_payload<nier::AnimationStart>(payload));
+        break;
+    case nier::PacketType_ID_PLAYER_DATA:
+        // V2 peers send the message, V1 ones the bare player data.
+        if (const auto player_data_message = get_payload<nier::PlayerDataMessage>(payload); player_data_message != nullptr) {
+            handled = handle_player_data_message(guid, player_data_message, message.received_time);
+        } else {
+            handled = handle_player_data(guid, get_payload<nier::PlayerData>(payload), message.received_time);
         }
-        dataoffs = builder.EndVector(size);
+
+        break;
+    case nier::PacketType_ID_PLAYER_DATA_ACK:
+        handled = handle_player_data_ack(get_payload<nier::PlayerDataAck>(payload));
+        break;
+    case nier::PacketType_ID_STRING_TABLE:
+        handled = handle_string_table(get_payload<nier::StringTable>(payload));
+        break;
+    case nier::PacketType_ID_ANIMATION_START:
+        handled = handle_animation_start(guid, get_payload<nier::AnimationStart>(payload));
+        break;
+    case nier::PacketType_ID_BUTTONS:
+        handled = handle_buttons(guid, get_payload<nier::Buttons>(payload));
+        break;
+    default:
+        spdlog::error("Unknown packet type {} ({})", id, nier::EnumNamePacketType(id));
+        return;
+    }
+
+    if (!handled) {
+        spdlog::error("Failed to handle packet {} ({})", id, nier::EnumNamePacketType(id));
+    }
+}
+
+void NierClient::send_packet(nier::PacketType id, const uint8_t* data, size_t size, uint64_t coalesce_key) {
+    auto builder = m_builder_pool.acquire();
+
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> dataoffs{};
+
+    if (data != nullptr && size > 0) {
+        dataoffs = builder->CreateVector(data, size);
     }
 
-    auto packet_builder = nier::PacketBuilder(builder);
+    auto packet_builder = nier::PacketBuilder(*builder);
 
     packet_builder.add_magic(1347240270);
     packet_builder.add_id(id);
@@ -381,42 +677,228 @@ void NierClient::send_packet(nier::PacketType id, const uint8_t* data, size_t si
         packet_builder.add_data(dataoffs);
     }
 
-    builder.Finish(packet_builder.Finish());
+    builder->Finish(packet_builder.Finish());
+    send_finished_packet(builder, id, coalesce_key);
+}
+
+void NierClient::send_message(flatbuffers::FlatBufferBuilder* builder, nier::PacketType id, uint64_t guid,
+    nier::Message message_type, flatbuffers::Offset<void> message, uint64_t coalesce_key)
+{
+    nier::FinishPacketV2Buffer(*builder, nier::CreatePacketV2(*builder, id, guid, message_type, message));
+
+    // Goes out with everything else sent on its channel this tick, see flush_packet_batches.
+    std::scoped_lock _{m_send_mtx};
+    record_packet_stats(id, builder->GetSize(), true);
+    m_packet_batcher.add(builder, packet_policy::get(id), coalesce_key);
+}
+
+void NierClient::flush_packet_batches() {
+    std::scoped_lock _{m_send_mtx};
+
+    if (m_packet_batcher.empty() || !is_connected()) {
+        return;
+    }
+
+    const size_t mtu = get_statistics()._mtu;
+
+    m_packet_batcher.flush(mtu != 0 ? mtu : ENET_HOST_DEFAULT_MTU, [this](uint8_t channel, ENetPacket* packet, uint64_t coalesce_key, size_t message_count) {
+        if (packet == nullptr) {
+            spdlog::error("Failed to create packet batch on channel {}", channel);
+            return;
+        }
+
+        // The messages were counted when they were queued.
+        if (message_count > 1) {
+            record_packet_stats(nier::PacketType_ID_PACKET_BATCH, packet->dataLength, true);
+        }
+
+        this->enetpp::client::send_packet(channel, packet, coalesce_key);
+    });
+}
+
+void NierClient::send_finished_packet(flatbuffers::FlatBufferBuilder* builder, nier::PacketType id, uint64_t coalesce_key) {
+    std::scoped_lock _{m_send_mtx};
+
+    const auto policy = packet_policy::get(id);
+
+    // The finished buffer goes to ENet as-is, the builder comes back to the pool once ENet destroys the packet.
+    auto packet = m_builder_pool.create_packet(builder, policy.flags);
+
+    if (packet == nullptr) {
+        spdlog::error("Failed to create packet {} ({})", id, nier::EnumNamePacketType(id));
+        return;
+    }
+
+    record_packet_stats(id, packet->dataLength, true);
+    this->enetpp::client::send_packet(policy.channel, packet, coalesce_key);
+}
+
+void NierClient::record_packet_stats(nier::PacketType id, size_t size, bool sent) {
+    std::scoped_lock _{m_packet_stats_mtx};
+    auto& stats = m_packet_stats[id];
+
+    if (sent) {
+        ++stats.sent_count;
+        stats.sent_bytes += size;
+    } else {
+        ++stats.received_count;
+        stats.received_bytes += size;
+    }
+}
+
+void NierClient::draw_network_stats() {
+    const auto& stats = get_statistics();
+    m_net_graph.update(stats);
+
+    if (!ImGui::TreeNode("Network")) {
+        return;
+    }
+
+    m_net_graph.draw();
+    draw_send_rates();
+
+    ImGui::Text("RTT: %d ms (variance %d ms)", (int)stats._round_trip_time_in_ms, (int)stats._round_trip_time_variance_in_ms);
+    ImGui::Text("Packet loss: %.2f%% (variance %.2f%%)",
+        (float)stats._packet_loss * 100.0f / ENET_PEER_PACKET_LOSS_SCALE,
+        (float)stats._packet_loss_variance * 100.0f / ENET_PEER_PACKET_LOSS_SCALE);
+    ImGui::Text("Throttle: %u / %u", (unsigned)stats._packet_throttle, (unsigned)ENET_PEER_PACKET_THROTTLE_SCALE);
+    ImGui::Text("Reliable: %u sent, %u resent, %u bytes in transit",
+        (unsigned)stats._packets_sent, (unsigned)stats._packets_lost, (unsigned)stats._reliable_data_in_transit);
+    ImGui::Text("Queued: %zu packets (%zu bytes), %zu events",
+        (size_t)stats._queued_packet_count, (size_t)stats._queued_byte_count, (size_t)stats._event_queue_depth);
+    ImGui::Text("Dropped: %u, coalesced: %u", (unsigned)stats._dropped_packet_count, (unsigned)stats._coalesced_packet_count);
+    ImGui::Text("think: %.1f us (peak %.1f us), of which applying received messages %.1f us",
+        m_think_cost.mean_us.load(), m_think_cost.peak_us.load(), m_apply_cost.mean_us.load());
+    ImGui::Text("Decoding on the network thread: %.1f us per packet (peak %.1f us)",
+        m_decode_cost.mean_us.load(), m_decode_cost.peak_us.load());
+
+    {
+        std::scoped_lock _{m_packet_stats_mtx};
+
+        if (m_player_state_bytes > 0) {
+            ImGui::Text("Player data deltas: %llu bytes for %llu bytes of state (%.1f%%)",
+                (unsigned long long)m_player_delta_bytes, (unsigned long long)m_player_state_bytes,
+                (float)m_player_delta_bytes * 100.0f / m_player_state_bytes);
+        }
+    }
+
+    if (ImGui::TreeNode("Channels")) {
+        for (size_t i = 0; i < enetpp::channel_statistics::tracked_channel_count; ++i) {
+            const auto& channel = stats._channels[i];
+
+            if (channel._packets_sent == 0 && channel._packets_received == 0) {
+                continue;
+            }
+
+            ImGui::Text("%zu: sent %llu (%llu bytes), received %llu (%llu bytes)", i,
+                (unsigned long long)channel._packets_sent, (unsigned long long)channel._bytes_sent,
+                (unsigned long long)channel._packets_received, (unsigned long long)channel._bytes_received);
+        }
+
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Packet Types")) {
+        std::scoped_lock _{m_packet_stats_mtx};
+
+        for (const auto& [id, type_stats] : m_packet_stats) {
+            ImGui::Text("%s: sent %llu (%llu bytes), received %llu (%llu bytes)", nier::EnumNamePacketType(id),
+                (unsigned long long)type_stats.sent_count, (unsigned long long)type_stats.sent_bytes,
+                (unsigned long long)type_stats.received_count, (unsigned long long)type_stats.received_bytes);
+        }
+
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Queue Latency (log2 us)")) {
+        const auto draw_histogram = [](const char* label, const enetpp::latency_histogram& histogram) {
+            std::array<float, enetpp::latency_histogram::bucket_count> buckets{};
 
-    this->enetpp::client::send_packet(0, builder.GetBufferPointer(), builder.GetSize(), ENET_PACKET_FLAG_RELIABLE);
+            for (size_t i = 0; i < buckets.size(); ++i) {
+                buckets[i] = (float)histogram.get_bucket(i);
+            }
+
+            char overlay[64]{};
+            snprintf(overlay, sizeof(overlay), "mean %llu us", (unsigned long long)histogram.get_mean_in_us());
+            ImGui::PlotHistogram(label, buckets.data(), (int)buckets.size(), 0, overlay, 0.0f, FLT_MAX, ImVec2{0, 60});
+        };
+
+        draw_histogram("Outbound", stats._packet_queue_latency);
+        draw_histogram("Events", stats._event_queue_latency);
+        ImGui::TreePop();
+    }
+
+    ImGui::TreePop();
+}
+
+void NierClient::draw_send_rates() {
+    if (!ImGui::TreeNode("Send Rates")) {
+        return;
+    }
+
+    const auto draw_rate = [](const char* label, TickScheduler& scheduler) {
+        auto rate = scheduler.get_rate();
+
+        if (ImGui::SliderFloat(label, &rate, TickScheduler::MIN_RATE, TickScheduler::MAX_RATE, "%.0f Hz")) {
+            scheduler.set_rate(rate);
+        }
+
+        ImGui::Text("  %llu ticks, jitter %.2f ms, %llu skipped", (unsigned long long)scheduler.get_tick_count(),
+            scheduler.get_jitter_ms(), (unsigned long long)scheduler.get_skipped_ticks());
+    };
+
+    draw_rate("Players", m_player_tick);
+    draw_rate("Entities", m_entity_tick);
+    ImGui::TreePop();
 }
 
 void NierClient::send_animation_start(uint32_t anim, uint32_t variant, uint32_t a3, uint32_t a4) {
     nier::AnimationStart data{anim, variant, a3, a4};
 
-    flatbuffers::FlatBufferBuilder builder(0);
-    auto dataoffs = builder.CreateStruct(data);
-    builder.Finish(dataoffs);
+    if (uses_packet_v2()) {
+        auto builder = m_builder_pool.acquire();
+        const auto message = nier::CreateAnimationStartMessage(*builder, &data);
+        send_message(builder, nier::PacketType_ID_ANIMATION_START, m_guid, nier::Message_AnimationStartMessage, message.Union());
+        return;
+    }
+
+    BuilderPool::Scoped builder{m_builder_pool};
+    auto dataoffs = builder->CreateStruct(data);
+    builder->Finish(dataoffs);
 
-    send_packet(nier::PacketType_ID_ANIMATION_START, builder.GetBufferPointer(), builder.GetSize());
+    send_packet(nier::PacketType_ID_ANIMATION_START, builder->GetBufferPointer(), builder->GetSize());
 }
 
 void NierClient::send_buttons(const uint32_t* buttons) {
-    flatbuffers::FlatBufferBuilder builder(0);
-    const auto dataoffs = builder.CreateVector(buttons, sdk::Pl0000::EButtonIndex::INDEX_MAX);
+    if (uses_packet_v2()) {
+        auto builder = m_builder_pool.acquire();
+        const auto buttons_offs = builder->CreateVector(buttons, sdk::Pl0000::EButtonIndex::INDEX_MAX);
+        const auto message = nier::CreateButtons(*builder, buttons_offs);
+        send_message(builder, nier::PacketType_ID_BUTTONS, m_guid, nier::Message_Buttons, message.Union());
+        return;
+    }
+
+    BuilderPool::Scoped builder{m_builder_pool};
+    const auto dataoffs = builder->CreateVector(buttons, sdk::Pl0000::EButtonIndex::INDEX_MAX);
 
-    nier::Buttons::Builder data_builder(builder);
+    nier::Buttons::Builder data_builder(*builder);
     data_builder.add_buttons(dataoffs);
-    builder.Finish(data_builder.Finish());
+    builder->Finish(data_builder.Finish());
 
-    send_packet(nier::PacketType_ID_BUTTONS, builder.GetBufferPointer(), builder.GetSize());
+    send_packet(nier::PacketType_ID_BUTTONS, builder->GetBufferPointer(), builder->GetSize());
 }
 
 void NierClient::send_entity_packet(nier::PacketType id, uint32_t guid, const uint8_t* data, size_t size) {
-    flatbuffers::FlatBufferBuilder builder(0);
-    const auto dataoffs = builder.CreateVector(data, size);
+    BuilderPool::Scoped builder{m_builder_pool};
+    const auto dataoffs = builder->CreateVector(data, size);
 
-    nier::EntityPacket::Builder data_builder(builder);
+    nier::EntityPacket::Builder data_builder(*builder);
     data_builder.add_guid(guid);
     data_builder.add_data(dataoffs);
-    builder.Finish(data_builder.Finish());
+    builder->Finish(data_builder.Finish());
 
-    send_packet(id, builder.GetBufferPointer(), builder.GetSize());
+    const auto coalesce_key = id == nier::PacketType_ID_ENTITY_DATA ? make_coalesce_key(id, guid) : 0;
+    send_packet(id, builder->GetBufferPointer(), builder->GetSize(), coalesce_key);
 }
 
 void NierClient::send_entity_create(uint32_t guid, sdk::EntitySpawnParams* data) {
@@ -425,22 +907,33 @@ void NierClient::send_entity_create(uint32_t guid, sdk::EntitySpawnParams* data)
         return;
     }
 
+    const auto positional = (const nier::EntitySpawnPositionalData*)data->matrix;
+
+    if (uses_packet_v2()) {
+        auto builder = m_builder_pool.acquire();
+        const auto name_id = m_use_string_table ? m_string_table.find(data->name) : 0;
+        const auto name = name_id == 0 ? builder->CreateString(data->name) : flatbuffers::Offset<flatbuffers::String>{};
+        const auto message = nier::CreateEntitySpawnParams(*builder, name, data->model, data->model2, positional, name_id);
+        send_message(builder, nier::PacketType_ID_SPAWN_ENTITY, guid, nier::Message_EntitySpawnParams, message.Union());
+        return;
+    }
+
     // entity packet.
-    flatbuffers::FlatBufferBuilder builder(0);
-    const auto name = builder.CreateString(data->name);
+    BuilderPool::Scoped builder{m_builder_pool};
+    const auto name = builder->CreateString(data->name);
 
-    nier::EntitySpawnParams::Builder data_builder(builder);
+    nier::EntitySpawnParams::Builder data_builder(*builder);
     data_builder.add_name(name);
     data_builder.add_model(data->model);
     data_builder.add_model2(data->model2);
 
-    if (data->matrix != nullptr) {
-        data_builder.add_positional((nier::EntitySpawnPositionalData*)data->matrix);
+    if (positional != nullptr) {
+        data_builder.add_positional(positional);
     }
 
-    builder.Finish(data_builder.Finish());
+    builder->Finish(data_builder.Finish());
 
-    send_entity_packet(nier::PacketType_ID_SPAWN_ENTITY, guid, builder.GetBufferPointer(), builder.GetSize());
+    send_entity_packet(nier::PacketType_ID_SPAWN_ENTITY, guid, builder->GetBufferPointer(), builder->GetSize());
 }
 
 void NierClient::send_entity_destroy(uint32_t guid) {
@@ -449,24 +942,142 @@ void NierClient::send_entity_destroy(uint32_t guid) {
         return;
     }
 
+    if (uses_packet_v2()) {
+        send_message(m_builder_pool.acquire(), nier::PacketType_ID_DESTROY_ENTITY, guid);
+        return;
+    }
+
     send_entity_packet(nier::PacketType_ID_DESTROY_ENTITY, guid);
 }
 
-void NierClient::send_entity_data(uint32_t guid, sdk::BehaviorAppBase* entity) {
+void NierClient::send_entity_snapshot(const EntitySnapshotData& snapshot) {
     if (!m_is_master_client) {
-        spdlog::info("Not master client, not sending entity data");
+        spdlog::info("Not master client, not sending entity snapshot");
+        return;
+    }
+
+    if (m_position_precision > 0.0f) {
+        send_quantized_entity_snapshot(snapshot);
         return;
     }
 
-    flatbuffers::FlatBufferBuilder builder(0);
-    nier::EntityData new_data(entity->facing(),
-        0.0f, // entity is not a player.
-        entity->health(), *(nier::Vector3f*)&entity->position());
+    if (uses_packet_v2()) {
+        m_snapshot_order.resize(snapshot.size());
+        std::iota(m_snapshot_order.begin(), m_snapshot_order.end(), 0);
+
+        // Split so every snapshot fits in one datagram, ENet drops an unreliable packet if any of its fragments is lost.
+        for (size_t first = 0; first < snapshot.size(); first += MAX_ENTITY_SNAPSHOT_SIZE) {
+            const auto count = std::min(snapshot.size() - first, MAX_ENTITY_SNAPSHOT_SIZE);
 
-    builder.Finish(builder.CreateStruct(new_data));
+            auto builder = m_builder_pool.acquire();
+            const auto guids = builder->CreateVector(snapshot.guids.data() + first, count);
+            const auto positions = builder->CreateVectorOfStructs(snapshot.positions.data() + first, count);
+            const auto facings = builder->CreateVector(snapshot.facings.data() + first, count);
+            const auto facings2 = builder->CreateVector(snapshot.facings2.data() + first, count);
+            const auto orientations = builder->CreateVectorOfStructs(snapshot.orientations.data() + first, count);
+            const auto velocities = builder->CreateVectorOfStructs(snapshot.velocities.data() + first, count);
 
-    m_network_entities->process_entity_data(guid, &new_data);
-    send_entity_packet(nier::PacketType_ID_ENTITY_DATA, guid, builder.GetBufferPointer(), builder.GetSize());
+            flatbuffers::Offset<flatbuffers::Vector<uint32_t>> healths{};
+            flatbuffers::Offset<flatbuffers::Vector<uint8_t>> dirty{};
+            flatbuffers::Offset<flatbuffers::Vector<uint8_t>> properties{};
+            create_entity_snapshot_properties(*builder, snapshot, m_snapshot_order.data() + first, count, healths, dirty, properties);
+
+            const auto message = nier::CreateEntitySnapshot(*builder, guids, positions, facings, facings2, healths,
+                nullptr, 0, 0, 0, orientations, dirty, properties, velocities);
+
+            // Not coalesced, a snapshot only holds what changed since the previous one.
+            send_message(builder, nier::PacketType_ID_ENTITY_SNAPSHOT, 0, nier::Message_EntitySnapshot, message.Union());
+        }
+
+        return;
+    }
+
+    // V1 peers get the entity data packets the snapshot replaces.
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        const nier::EntityData data(snapshot.facings[i], snapshot.facings2[i], snapshot.healths[i], snapshot.positions[i]);
+
+        BuilderPool::Scoped builder{m_builder_pool};
+        builder->Finish(builder->CreateStruct(data));
+
+        send_entity_packet(nier::PacketType_ID_ENTITY_DATA, snapshot.guids[i], builder->GetBufferPointer(), builder->GetSize());
+    }
+}
+
+void NierClient::send_quantized_entity_snapshot(const EntitySnapshotData& snapshot) {
+    const auto precision = m_position_precision;
+
+    m_snapshot_sectors.clear();
+    m_snapshot_order.clear();
+
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        m_snapshot_sectors.push_back(quantization::get_sector(snapshot.positions[i], precision));
+        m_snapshot_order.push_back(i);
+    }
+
+    // Every message has one sector, entities close to each other end up in the same one.
+    std::sort(m_snapshot_order.begin(), m_snapshot_order.end(), [this](size_t a, size_t b) {
+        const auto& sa = m_snapshot_sectors[a];
+        const auto& sb = m_snapshot_sectors[b];
+        return std::make_tuple(sa.x(), sa.y(), sa.z()) < std::make_tuple(sb.x(), sb.y(), sb.z());
+    });
+
+    for (size_t first = 0; first < m_snapshot_order.size();) {
+        const auto sector = m_snapshot_sectors[m_snapshot_order[first]];
+        auto last = first + 1;
+
+        while (last < m_snapshot_order.size() && last - first < MAX_QUANTIZED_ENTITY_SNAPSHOT_SIZE &&
+            quantization::is_same_sector(m_snapshot_sectors[m_snapshot_order[last]], sector))
+        {
+            ++last;
+        }
+
+        const auto count = last - first;
+        const auto index = [&](size_t i) { return m_snapshot_order[first + i]; };
+
+        auto builder = m_builder_pool.acquire();
+        const auto guids = builder->CreateVector<uint32_t>(count, [&](size_t i) { return snapshot.guids[index(i)]; });
+        const auto positions = builder->CreateVectorOfStructs<nier::QuantizedVector3>(count, [&](size_t i, nier::QuantizedVector3* out) {
+            *out = quantization::quantize_position(snapshot.positions[index(i)], sector, precision);
+        });
+        const auto facings = builder->CreateVector<uint16_t>(count, [&](size_t i) { return quantization::quantize_yaw(snapshot.facings[index(i)]); });
+        const auto facings2 = builder->CreateVector<uint16_t>(count, [&](size_t i) { return quantization::quantize_yaw(snapshot.facings2[index(i)]); });
+        const auto orientations = builder->CreateVectorOfStructs<nier::CompressedQuaternion>(count, [&](size_t i, nier::CompressedQuaternion* out) {
+            *out = snapshot.orientations[index(i)];
+        });
+        const auto velocities = builder->CreateVectorOfStructs<nier::QuantizedVelocity>(count, [&](size_t i, nier::QuantizedVelocity* out) {
+            *out = snapshot.velocities[index(i)];
+        });
+
+        flatbuffers::Offset<flatbuffers::Vector<uint32_t>> healths{};
+        flatbuffers::Offset<flatbuffers::Vector<uint8_t>> dirty{};
+        flatbuffers::Offset<flatbuffers::Vector<uint8_t>> properties{};
+        create_entity_snapshot_properties(*builder, snapshot, m_snapshot_order.data() + first, count, healths, dirty, properties);
+
+        const auto message = nier::CreateEntitySnapshot(*builder, guids, 0, 0, 0, healths, &sector, positions, facings, facings2, orientations,
+            dirty, properties, velocities);
+
+        send_message(builder, nier::PacketType_ID_ENTITY_SNAPSHOT, 0, nier::Message_EntitySnapshot, message.Union());
+        first = last;
+    }
+}
+
+void NierClient::create_entity_snapshot_properties(flatbuffers::FlatBufferBuilder& builder, const EntitySnapshotData& snapshot,
+    const size_t* rows, size_t count, flatbuffers::Offset<flatbuffers::Vector<uint32_t>>& healths,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>>& dirty, flatbuffers::Offset<flatbuffers::Vector<uint8_t>>& properties)
+{
+    if (!m_replicated_properties) {
+        healths = builder.CreateVector<uint32_t>(count, [&](size_t i) { return snapshot.healths[rows[i]]; });
+        return;
+    }
+
+    m_snapshot_properties.clear();
+
+    for (size_t i = 0; i < count; ++i) {
+        replication::EntityProperties::write(snapshot.properties[rows[i]], snapshot.dirty[rows[i]], m_snapshot_properties);
+    }
+
+    dirty = builder.CreateVector<uint8_t>(count, [&](size_t i) { return snapshot.dirty[rows[i]]; });
+    properties = builder.CreateVector(m_snapshot_properties);
 }
 
 void NierClient::send_entity_animation_start(uint32_t guid, uint32_t anim, uint32_t variant, uint32_t a3, uint32_t a4) {
@@ -475,11 +1086,19 @@ void NierClient::send_entity_animation_start(uint32_t guid, uint32_t anim, uint3
         return;
     }
     
-    flatbuffers::FlatBufferBuilder builder(0);
     nier::AnimationStart data{anim, variant, a3, a4};
-    builder.Finish(builder.CreateStruct(data));
 
-    send_entity_packet(nier::PacketType_ID_ENTITY_ANIMATION_START, guid, builder.GetBufferPointer(), builder.GetSize());
+    if (uses_packet_v2()) {
+        auto builder = m_builder_pool.acquire();
+        const auto message = nier::CreateAnimationStartMessage(*builder, &data);
+        send_message(builder, nier::PacketType_ID_ENTITY_ANIMATION_START, guid, nier::Message_AnimationStartMessage, message.Union());
+        return;
+    }
+
+    BuilderPool::Scoped builder{m_builder_pool};
+    builder->Finish(builder->CreateStruct(data));
+
+    send_entity_packet(nier::PacketType_ID_ENTITY_ANIMATION_START, guid, builder->GetBufferPointer(), builder->GetSize());
 }
 
 void NierClient::on_entity_created(sdk::Entity* entity, sdk::EntitySpawnParams* data) {
@@ -505,21 +1124,26 @@ void NierClient::send_hello() {
     }
     
 
-    flatbuffers::FlatBufferBuilder builder{};
-    const auto name_pkt = builder.CreateString(m_hello_name);
-    const auto pwd_pkt = builder.CreateString(m_password);
+    BuilderPool::Scoped builder{m_builder_pool};
+    const auto name_pkt = builder->CreateString(m_hello_name);
+    const auto pwd_pkt = builder->CreateString(m_password);
 
-    nier::HelloBuilder hello_builder(builder);
+    nier::HelloBuilder hello_builder(*builder);
     hello_builder.add_major(nier::VersionMajor_Value);
     hello_builder.add_minor(nier::VersionMinor_Value);
     hello_builder.add_patch(nier::VersionPatch_Value);
     hello_builder.add_name(name_pkt);
     hello_builder.add_password(pwd_pkt);
     hello_builder.add_model(possessed->behavior->model_index());
+    hello_builder.add_protocol(nier::ProtocolVersion_V2);
+    hello_builder.add_quantized_positions(true);
+    hello_builder.add_delta_player_data(true);
+    hello_builder.add_replicated_properties(true);
+    hello_builder.add_string_table(true);
 
-    builder.Finish(hello_builder.Finish());
+    builder->Finish(hello_builder.Finish());
 
-    send_packet(nier::PacketType_ID_HELLO, builder.GetBufferPointer(), builder.GetSize());
+    send_packet(nier::PacketType_ID_HELLO, builder->GetBufferPointer(), builder->GetSize());
     m_hello_sent = true;
 }
 
@@ -528,9 +1152,9 @@ void NierClient::update_local_player_data() {
         return;
     }
 
-    auto it = m_players.find(m_guid);
+    const auto local_player = m_players.find(m_guid);
 
-    if (it == m_players.end() || it->second == nullptr) {
+    if (local_player == nullptr) {
         spdlog::error("Local player not set up");
         return;
     }
@@ -547,7 +1171,7 @@ void NierClient::update_local_player_data() {
         return;
     }
 
-    it->second->set_handle(player->handle);
+    m_players.set_handle(*local_player, player->handle);
 }
 
 void NierClient::send_player_data() {
@@ -556,14 +1180,12 @@ void NierClient::send_player_data() {
         return;
     }
 
-    auto it = m_players.find(m_guid);
+    const auto player = m_players.find(m_guid);
 
-    if (it == m_players.end() || it->second == nullptr) {
+    if (player == nullptr) {
         spdlog::error("Cannot send player data without player");
         return;
     }
-
-    auto& player = it->second;
     
     auto entity = player->get_entity();
 
@@ -572,32 +1194,192 @@ void NierClient::send_player_data() {
         return;
     }
 
-    nier::PlayerData player_data(entity->flashlight(), entity->speed(), entity->facing(), entity->facing2(), entity->weapon_index(),
-        entity->pod_index(), entity->character_controller().held_flags, *(nier::Vector3f*)&entity->position());
+    const std::vector<uint8_t>* properties = nullptr;
+
+    if (m_replicated_properties) {
+        m_player_properties.update(*entity);
 
-    flatbuffers::FlatBufferBuilder builder{};
-    const auto offs = builder.CreateStruct(player_data);
-    builder.Finish(offs);
+        if (m_player_properties_count++ % PROPERTY_REFRESH_INTERVAL == 0) {
+            m_player_properties.mark_all_dirty();
+        }
+
+        const auto dirty = m_player_properties.take_dirty();
+
+        if (dirty != 0) {
+            m_player_properties_bytes.clear();
+            replication::PlayerProperties::write_message(m_player_properties.get_values(), dirty, m_player_properties_bytes);
+            properties = &m_player_properties_bytes;
+        }
+    }
+
+    // Replicated properties are left zero here, so they never change the delta either.
+    const auto replicated = m_replicated_properties;
+    nier::PlayerData player_data(replicated ? false : entity->flashlight(), entity->speed(), entity->facing(), entity->facing2(),
+        replicated ? 0 : entity->weapon_index(), replicated ? 0 : entity->pod_index(), replicated ? 0 : entity->held_flags(),
+        *(nier::Vector3f*)&entity->position());
+
+    const auto coalesce_key = make_coalesce_key(nier::PacketType_ID_PLAYER_DATA, m_guid);
+
+    // V1 has nowhere to put these, facing and facing2 are all it gets.
+    const auto orientation = entity->rotation();
+    const auto compressed_orientation = quantization::compress_quaternion(orientation);
+    const auto angular_velocity = update_angular_velocity(orientation);
+    const auto quantized_angular_velocity = quantization::quantize_angular_velocity(angular_velocity);
+    const auto turning = glm::length(angular_velocity) > MIN_ANGULAR_VELOCITY;
+
+    // Indices that don't fit in a byte fall back to floats for this update.
+    if (m_position_precision > 0.0f && entity->weapon_index() <= 0xFF && entity->pod_index() <= 0xFF) {
+        const auto precision = m_position_precision;
+        const auto& position = player_data.position();
+
+        // Sticks to the current sector until the player leaves it, so walking along an edge doesn't resend it every update.
+        if (!m_has_sector || !quantization::is_in_sector(position, m_sector, precision)) {
+            m_sector = quantization::get_sector(position, precision);
+            ++m_sector_id;
+            m_has_sector = true;
+            m_sector_resends = SECTOR_RESEND_COUNT;
+        }
 
-    send_packet(nier::PacketType_ID_PLAYER_DATA, builder.GetBufferPointer(), builder.GetSize());
+        const auto refresh_sector = ++m_player_data_count % SECTOR_REFRESH_INTERVAL == 0;
+        const auto send_sector = m_sector_resends > 0 || refresh_sector;
+        m_sector_resends = m_sector_resends > 0 ? m_sector_resends - 1 : 0;
+
+        const nier::QuantizedPlayerData quantized(quantization::quantize_position(position, m_sector, precision),
+            quantization::quantize_yaw(player_data.facing()), quantization::quantize_yaw(player_data.facing2()), m_sector_id,
+            player_data.flashlight(), (uint8_t)player_data.weapon_index(), (uint8_t)player_data.pod_index(), player_data.speed(),
+            player_data.held_button_flags());
+
+        auto builder = m_builder_pool.acquire();
+        const auto sector = send_sector ? &m_sector : nullptr;
+        const auto angular_velocity = turning ? &quantized_angular_velocity : nullptr;
+
+        if (m_delta_player_data) {
+            // Not turning is all zeros, the same as leaving angular_velocity out.
+            const auto state = delta_compression::make_player_state(quantized, compressed_orientation,
+                turning ? quantized_angular_velocity : nier::QuantizedAngularVelocity{});
+
+            uint16_t sequence{};
+            uint16_t baseline{};
+            m_player_data_delta.clear();
+            m_player_data_sender.encode(state, m_player_data_delta, sequence, baseline);
+
+            {
+                std::scoped_lock _{m_packet_stats_mtx};
+                m_player_state_bytes += state.size();
+                m_player_delta_bytes += m_player_data_delta.size();
+            }
+
+            const auto message = nier::CreatePlayerDataMessageDirect(*builder, nullptr, nullptr, sector, nullptr, nullptr,
+                sequence, baseline, &m_player_data_delta, properties);
+            send_message(builder, nier::PacketType_ID_PLAYER_DATA, m_guid, nier::Message_PlayerDataMessage, message.Union(), coalesce_key);
+            return;
+        }
+
+        const auto message = nier::CreatePlayerDataMessageDirect(*builder, nullptr, &quantized, sector, &compressed_orientation, angular_velocity,
+            0, 0, nullptr, properties);
+        send_message(builder, nier::PacketType_ID_PLAYER_DATA, m_guid, nier::Message_PlayerDataMessage, message.Union(), coalesce_key);
+        return;
+    }
+
+    if (uses_packet_v2()) {
+        auto builder = m_builder_pool.acquire();
+        const auto message = nier::CreatePlayerDataMessageDirect(*builder, &player_data, nullptr, nullptr,
+            &compressed_orientation, turning ? &quantized_angular_velocity : nullptr, 0, 0, nullptr, properties);
+        send_message(builder, nier::PacketType_ID_PLAYER_DATA, m_guid, nier::Message_PlayerDataMessage, message.Union(), coalesce_key);
+        return;
+    }
+
+    BuilderPool::Scoped builder{m_builder_pool};
+    const auto offs = builder->CreateStruct(player_data);
+    builder->Finish(offs);
+
+    send_packet(nier::PacketType_ID_PLAYER_DATA, builder->GetBufferPointer(), builder->GetSize(), coalesce_key);
 }
 
-bool NierClient::handle_welcome(const nier::Packet* packet) {
-    spdlog::info("Welcome packet received");
+void NierClient::send_player_data_acks() {
+    if (!m_delta_player_data) {
+        return;
+    }
+
+    m_ack_guids.clear();
+    m_ack_sequences.clear();
+
+    for (auto& player : m_players) {
+        uint16_t sequence{};
+
+        if (player.get_player_data_receiver().take_ack(sequence)) {
+            m_ack_guids.push_back(player.get_guid());
+            m_ack_sequences.push_back(sequence);
+        }
+    }
+
+    if (m_ack_guids.empty()) {
+        return;
+    }
+
+    // One ack for every player heard from this tick.
+    auto builder = m_builder_pool.acquire();
+    const auto ack = nier::CreatePlayerDataAckDirect(*builder, &m_ack_guids, &m_ack_sequences);
+    send_message(builder, nier::PacketType_ID_PLAYER_DATA_ACK, 0, nier::Message_PlayerDataAck, ack.Union());
+}
+
+Vector3f NierClient::update_angular_velocity(const glm::quat& orientation) {
+    const auto now = chrono::steady_clock::now();
+    Vector3f velocity{};
+
+    if (m_has_last_orientation) {
+        const auto dt = chrono::duration<float>(now - m_last_orientation_time).count();
+        auto delta = orientation * glm::inverse(m_last_orientation);
 
-    const auto welcome = flatbuffers::GetRoot<nier::Welcome>(packet->data()->data());
-    auto verif = flatbuffers::Verifier(packet->data()->data(), packet->data()->size());
+        // q and -q are the same rotation, this picks the short way around.
+        if (delta.w < 0.0f) {
+            delta = -delta;
+        }
+
+        if (dt > 0.0f) {
+            velocity = glm::axis(delta) * (glm::angle(delta) / dt);
+        }
+    }
+
+    m_last_orientation = orientation;
+    m_last_orientation_time = now;
+    m_has_last_orientation = true;
+
+    return velocity;
+}
 
-    if (!welcome->Verify(verif)) {
+bool NierClient::handle_welcome(const nier::Welcome* welcome) {
+    spdlog::info("Welcome packet received");
+
+    if (welcome == nullptr) {
         spdlog::error("Invalid welcome packet");
         return false;
     }
 
     m_is_master_client = welcome->isMasterClient();
     m_guid = welcome->guid();
+    m_protocol = welcome->protocol(); // servers that predate V2 leave it out, which reads as V1.
+    m_position_precision = uses_packet_v2() ? quantization::validate_precision(welcome->position_precision()) : 0.0f;
+
+    if (m_position_precision != welcome->position_precision()) {
+        spdlog::warn("Unusable position precision {}, sending floats", welcome->position_precision());
+    }
+
+    m_has_sector = false;
+    m_delta_player_data = m_position_precision > 0.0f && welcome->delta_player_data();
+    m_player_data_sender.reset();
+    m_replicated_properties = uses_packet_v2() && welcome->replicated_properties();
+    m_player_properties = {};
+    m_player_properties_count = 0;
+    m_use_string_table = uses_packet_v2() && welcome->string_table();
+    m_string_table.clear();
+    m_player_tick.reset();
+    m_entity_tick.reset();
     const auto highest_guid = welcome->highestEntityGuid();
 
-    spdlog::info("Welcome packet received, isMasterClient: {}, guid: {}", m_is_master_client, m_guid);
+    spdlog::info("Welcome packet received, isMasterClient: {}, guid: {}, protocol: {}, position precision: {}, delta player data: {}, replicated properties: {}, string table: {}",
+        m_is_master_client, m_guid, nier::EnumNameProtocolVersion(m_protocol), m_position_precision, m_delta_player_data,
+        m_replicated_properties, m_use_string_table);
 
     m_network_entities = std::make_unique<EntitySync>(highest_guid);
     m_network_entities->on_enter_server(m_is_master_client);
@@ -605,9 +1387,16 @@ bool NierClient::handle_welcome(const nier::Packet* packet) {
     return true;
 }
 
-bool NierClient::handle_create_player(const nier::Packet* packet) {
+bool NierClient::handle_create_player(const nier::CreatePlayer* create_player) {
     spdlog::info("Create player packet received");
 
+    std::string name{};
+
+    if (create_player == nullptr || !resolve_name(create_player->name(), create_player->name_id(), name)) {
+        spdlog::error("Invalid create player packet");
+        return false;
+    }
+
     auto entity_list = sdk::EntityList::get();
 
     if (entity_list == nullptr) {
@@ -629,27 +1418,23 @@ bool NierClient::handle_create_player(const nier::Packet* packet) {
         return false;
     }
 
-    const auto create_player = flatbuffers::GetRoot<nier::CreatePlayer>(packet->data()->data());
-    auto verif = flatbuffers::Verifier(packet->data()->data(), packet->data()->size());
-
-    if (!create_player->Verify(verif)) {
-        spdlog::error("Invalid create player packet");
-        return false;
-    }
-
     {
         std::scoped_lock _{m_players_mutex};
 
-        auto new_player = std::make_unique<Player>();
-        new_player->set_guid(create_player->guid());
-        new_player->set_name(create_player->name()->c_str());
+        const auto new_player = m_players.add(create_player->guid(), create_player->slot());
+
+        if (new_player == nullptr) {
+            spdlog::error("No player slot for player {}, slot {}", create_player->guid(), create_player->slot());
+            return false;
+        }
 
-        m_players[create_player->guid()] = std::move(new_player);
+        new_player->set_guid(create_player->guid());
+        new_player->set_name(name);
     }
 
     // we don't want to spawn ourselves
     if (create_player->guid() != m_guid) {
-        spdlog::info("Spawning player {}, {}", create_player->guid(), create_player->name()->c_str());
+        spdlog::info("Spawning player {}, {}", create_player->guid(), name);
 
         MidHooks::s_ignore_spawn = true;
         auto ent = entity_list->spawn_entity("partner", create_player->model(), possessed->behavior->position());
@@ -676,8 +1461,10 @@ bool NierClient::handle_create_player(const nier::Packet* packet) {
             ent->behavior->as<sdk::Pl0000>()->setBuddyFromNpc();
             ent->behavior->obj_flags() = 0;
 
-            m_players[create_player->guid()]->set_start_tick(ent->behavior->tick_count());
-            m_players[create_player->guid()]->set_handle(ent->handle);
+            if (const auto player = m_players.find(create_player->guid()); player != nullptr) {
+                player->set_start_tick(ent->behavior->tick_count());
+                m_players.set_handle(*player, ent->handle);
+            }
 
             spdlog::info(" player assigned handle {:x}", ent->handle);
         } else {
@@ -690,14 +1477,12 @@ bool NierClient::handle_create_player(const nier::Packet* packet) {
     return true;
 }
 
-bool NierClient::handle_destroy_player(const nier::Packet* packet) {
+bool NierClient::handle_destroy_player(uint64_t guid) {
     spdlog::info("Destroy player packet received");
 
-    const auto destroy_player = flatbuffers::GetRoot<nier::DestroyPlayer>(packet->data()->data());
-
     std::scoped_lock _{m_players_mutex};
 
-    if (m_players.contains(destroy_player->guid()) && m_players[destroy_player->guid()] != nullptr) {
+    if (const auto player = m_players.find(guid); player != nullptr) {
         auto entity_list = sdk::EntityList::get();
 
         if (entity_list == nullptr) {
@@ -705,26 +1490,24 @@ bool NierClient::handle_destroy_player(const nier::Packet* packet) {
             spdlog::info("Entity list not found while handling destroy player packet");
         } else {
             auto localplayer = entity_list->get_by_name("Player");
-            auto ent = entity_list->get_by_handle(m_players[destroy_player->guid()]->get_handle());
+            auto ent = entity_list->get_by_handle(player->get_handle());
             if (ent != nullptr && ent != localplayer) {
                 ent->behavior->terminate();
             }
         }
     }
 
-    m_players[destroy_player->guid()].reset();
-    m_players.erase(destroy_player->guid());
+    m_players.remove(guid);
 
     return true;
 }
 
-bool NierClient::handle_create_entity(const nier::EntityPacket* packet) {
+bool NierClient::handle_create_entity(uint32_t guid, const nier::EntitySpawnParams* spawn) {
     spdlog::info("Create entity packet received");
 
-    const auto spawn = flatbuffers::GetRoot<nier::EntitySpawnParams>(packet->data()->data());
-    auto verif = flatbuffers::Verifier(packet->data()->data(), packet->data()->size());
+    std::string name{};
 
-    if (!spawn->Verify(verif)) {
+    if (spawn == nullptr || !resolve_name(spawn->name(), spawn->name_id(), name)) {
         spdlog::error("Invalid create entity packet");
         return false;
     }
@@ -737,9 +1520,9 @@ bool NierClient::handle_create_entity(const nier::EntityPacket* packet) {
         params.matrix = &matrix;
         params.model = spawn->model();
         params.model2 = spawn->model2();
-        params.name = spawn->name()->c_str();
+        params.name = name.c_str();
 
-        spdlog::info(" Spawning {}", spawn->name()->c_str());
+        spdlog::info(" Spawning {}", name);
 
         //const auto pos = spawn->positional() != nullptr ? *(Vector3f*)&spawn->positional()->position() : Vector3f{};
         //auto ent = entityList->spawnEntity(spawn->name()->c_str(), spawn->model(), pos);
@@ -753,7 +1536,7 @@ bool NierClient::handle_create_entity(const nier::EntityPacket* packet) {
             //ent->entity->setSuspend(false);
 
             spdlog::info(" Entity spawned @ {:x}", (uintptr_t)ent);
-            auto new_network_ent = m_network_entities->add_entity(ent, packet->guid());
+            auto new_network_ent = m_network_entities->add_entity(ent, guid);
 
             if (new_network_ent != nullptr) {
                 spdlog::info(" Network entity created");
@@ -766,27 +1549,41 @@ bool NierClient::handle_create_entity(const nier::EntityPacket* packet) {
     return true;
 }
 
-bool NierClient::handle_destroy_entity(const nier::EntityPacket* packet) {
+bool NierClient::handle_destroy_entity(uint32_t guid) {
     spdlog::info("Destroy entity packet received");
 
-    m_network_entities->remove_entity(packet->guid());
+    m_network_entities->remove_entity(guid);
 
     return true;
 }
 
-bool NierClient::handle_entity_data(const nier::EntityPacket* packet) {
-    spdlog::info("Entity data packet received");
+bool NierClient::handle_entity_data(uint32_t guid, const nier::EntityData* entity_data) {
+    spdlog::trace("Entity data packet received");
 
-    const auto entity_data = flatbuffers::GetRoot<nier::EntityData>(packet->data()->data());
-    m_network_entities->process_entity_data(packet->guid(), entity_data);
+    if (entity_data == nullptr) {
+        return false;
+    }
+
+    m_network_entities->process_entity_data(guid, entity_data);
 
     return true;
 }
 
-bool NierClient::handle_entity_animation_start(const nier::EntityPacket* packet) {
+bool NierClient::handle_entity_snapshot(const nier::EntitySnapshot* snapshot) {
+    if (snapshot == nullptr) {
+        return false;
+    }
+
+    return m_network_entities->process_entity_snapshot(snapshot, m_position_precision);
+}
+
+bool NierClient::handle_entity_animation_start(uint32_t guid, const nier::AnimationStart* animation_data) {
     spdlog::info("Entity animation start packet received");
 
-    const auto guid = packet->guid();
+    if (animation_data == nullptr) {
+        return false;
+    }
+
     auto entity_networked = m_network_entities->get_network_entity_from_guid(guid);
 
     if (entity_networked == nullptr) {
@@ -794,7 +1591,6 @@ bool NierClient::handle_entity_animation_start(const nier::EntityPacket* packet)
         return false;
     }
 
-    auto animation_data = flatbuffers::GetRoot<nier::AnimationStart>(packet->data()->data());
     auto npc = entity_networked->get_entity() != nullptr ? entity_networked->get_entity()->behavior : nullptr;
 
     if (npc != nullptr) {
@@ -816,59 +1612,237 @@ bool NierClient::handle_entity_animation_start(const nier::EntityPacket* packet)
     return true;
 }
 
-bool NierClient::handle_player_data(const nier::PlayerPacket* packet) {
-    const auto guid = packet->guid();
+bool NierClient::handle_player_data_message(uint64_t guid, const nier::PlayerDataMessage* message,
+    std::chrono::steady_clock::time_point received_time)
+{
+    if (message == nullptr) {
+        return false;
+    }
 
-    // do not update the local player. maybe change this later for forced updates/teleportation commands?
+    auto quantized = message->quantized();
+    auto orientation = message->orientation();
+    auto angular_velocity = message->angular_velocity();
+
+    nier::QuantizedPlayerData decoded_quantized{};
+    nier::CompressedQuaternion decoded_orientation{};
+    nier::QuantizedAngularVelocity decoded_angular_velocity{};
+
+    if (const auto delta = message->delta(); delta != nullptr) {
+        if (!m_delta_player_data) {
+            return false;
+        }
+
+        if (guid == m_guid) {
+            return true;
+        }
+
+        const auto player = m_players.find(guid);
+
+        if (player == nullptr) {
+            spdlog::error("Player data packet received for unknown player {}", guid);
+            return false;
+        }
+
+        delta_compression::PlayerState state{};
+
+        // Its baseline is gone or a newer update got here first, acks keep the next one decodable.
+        if (!player->get_player_data_receiver().decode(message->sequence(), message->baseline(), delta->data(), delta->size(), state)) {
+            return true;
+        }
+
+        delta_compression::read_player_state(state, decoded_quantized, decoded_orientation, decoded_angular_velocity);
+        quantized = &decoded_quantized;
+        orientation = &decoded_orientation;
+        angular_velocity = &decoded_angular_velocity; // all zeros while not turning
+    }
+
+    // Read after the delta so a stale update that gets dropped can't roll the properties back.
+    if (const auto properties = message->properties(); properties != nullptr && guid != m_guid) {
+        if (!m_replicated_properties) {
+            return false;
+        }
+
+        const auto player = m_players.find(guid);
+
+        if (player == nullptr) {
+            spdlog::error("Player properties received for unknown player {}", guid);
+            return false;
+        }
+
+        if (!replication::PlayerProperties::read_message(properties->data(), properties->size(), player->get_properties())) {
+            return false;
+        }
+    }
+
+    if (orientation != nullptr) {
+        if (!handle_player_orientation(guid, orientation, angular_velocity)) {
+            return false;
+        }
+    }
+
+    if (quantized == nullptr) {
+        return handle_player_data(guid, message->data(), received_time);
+    }
+
+    // Only clients that negotiated a precision get quantized updates.
+    if (m_position_precision <= 0.0f) {
+        return false;
+    }
+
+    // do not update the local player, same as handle_player_data.
     if (guid == m_guid) {
         return true;
     }
 
-    if (!m_players.contains(guid)) {
+    const auto player = m_players.find(guid);
+
+    if (player == nullptr) {
         spdlog::error("Player data packet received for unknown player {}", guid);
         return false;
     }
 
-    const auto& player_networked = m_players[guid];
+    if (const auto sector = message->sector(); sector != nullptr) {
+        player->set_sector(quantized->sector_id(), *sector);
+    }
+
+    const auto sector = player->get_sector(quantized->sector_id());
 
-    if (player_networked == nullptr) {
-        spdlog::error("(nullptr) Player data packet received for unknown player {}", guid);
+    // The update that carried the new sector was lost, skip updates until one of its resends arrives.
+    if (sector == nullptr) {
+        return true;
+    }
+
+    const auto precision = m_position_precision;
+    const nier::PlayerData player_data(quantized->flashlight(), quantized->speed(),
+        quantization::dequantize_yaw(quantized->facing()), quantization::dequantize_yaw(quantized->facing2()),
+        quantized->weapon_index(), quantized->pod_index(), quantized->held_button_flags(),
+        quantization::dequantize_position(quantized->position(), *sector, precision));
+
+    return handle_player_data(guid, &player_data, received_time);
+}
+
+bool NierClient::handle_player_data_ack(const nier::PlayerDataAck* ack) {
+    if (ack == nullptr || ack->guids() == nullptr || ack->sequences() == nullptr || ack->guids()->size() != ack->sequences()->size()) {
         return false;
     }
 
-    auto player_data = flatbuffers::GetRoot<nier::PlayerData>(packet->data()->data());
-    auto npc = player_networked->get_entity();
+    // The relay acks what it received from us under our own guid.
+    for (flatbuffers::uoffset_t i = 0; i < ack->guids()->size(); ++i) {
+        if (ack->guids()->Get(i) == m_guid) {
+            m_player_data_sender.on_ack(ack->sequences()->Get(i));
+        }
+    }
 
-    if (npc != nullptr) {
-        npc->position() = *(Vector3f*)&player_data->position();
+    return true;
+}
+
+bool NierClient::handle_string_table(const nier::StringTable* table) {
+    if (table == nullptr || table->ids() == nullptr || table->strings() == nullptr || table->ids()->size() != table->strings()->size()) {
+        return false;
     }
 
-    player_networked->set_player_data(*player_data);
+    for (flatbuffers::uoffset_t i = 0; i < table->ids()->size(); ++i) {
+        const auto name = table->strings()->Get(i);
+
+        if (name == nullptr || !m_string_table.add(table->ids()->Get(i), name->string_view())) {
+            spdlog::error("Invalid string table entry {}", table->ids()->Get(i));
+            return false;
+        }
+    }
 
     return true;
 }
 
-bool NierClient::handle_animation_start(const nier::PlayerPacket* packet) {
-    const auto guid = packet->guid();
+bool NierClient::resolve_name(const flatbuffers::String* name, uint32_t name_id, std::string& out) {
+    if (name_id == 0) {
+        if (name == nullptr) {
+            return false;
+        }
+
+        out = name->str();
+        return true;
+    }
+
+    // The relay always sends an id's entry first, an unknown one means the packet is broken.
+    return m_use_string_table && m_string_table.get(name_id, out);
+}
+
+bool NierClient::handle_player_data(uint64_t guid, const nier::PlayerData* player_data,
+    std::chrono::steady_clock::time_point received_time)
+{
+    if (player_data == nullptr) {
+        return false;
+    }
 
     // do not update the local player. maybe change this later for forced updates/teleportation commands?
     if (guid == m_guid) {
         return true;
     }
 
-    if (!m_players.contains(guid)) {
+    const auto player_networked = m_players.find(guid);
+
+    if (player_networked == nullptr) {
         spdlog::error("Player data packet received for unknown player {}", guid);
         return false;
     }
 
-    const auto& player_networked = m_players[guid];
+    // Shown once the playout delay has passed, see think.
+    player_networked->push_snapshot(*player_data, received_time);
+
+    auto& properties = player_networked->get_properties();
+
+    // The relay leaves the replicated fields zero, they come from the properties received so far.
+    if (m_replicated_properties) {
+        const auto& [flashlight, weapon_index, pod_index, held_flags] = properties;
+        player_networked->set_player_data(nier::PlayerData(flashlight, player_data->speed(), player_data->facing(),
+            player_data->facing2(), weapon_index, pod_index, held_flags, player_data->position()));
+    } else {
+        properties = {player_data->flashlight(), player_data->weapon_index(), player_data->pod_index(), player_data->held_button_flags()};
+        player_networked->set_player_data(*player_data);
+    }
+
+    return true;
+}
+
+bool NierClient::handle_player_orientation(uint64_t guid, const nier::CompressedQuaternion* orientation,
+    const nier::QuantizedAngularVelocity* angular_velocity)
+{
+    // do not update the local player, same as handle_player_data.
+    if (guid == m_guid) {
+        return true;
+    }
+
+    const auto player = m_players.find(guid);
+
+    if (player == nullptr) {
+        spdlog::error("Player orientation received for unknown player {}", guid);
+        return false;
+    }
+
+    // No angular velocity means the player stopped turning.
+    player->set_orientation(quantization::decompress_quaternion(*orientation),
+        angular_velocity != nullptr ? quantization::dequantize_angular_velocity(*angular_velocity) : Vector3f{});
+
+    return true;
+}
+
+bool NierClient::handle_animation_start(uint64_t guid, const nier::AnimationStart* animation_data) {
+    if (animation_data == nullptr) {
+        return false;
+    }
+
+    // do not update the local player. maybe change this later for forced updates/teleportation commands?
+    if (guid == m_guid) {
+        return true;
+    }
+
+    const auto player_networked = m_players.find(guid);
 
     if (player_networked == nullptr) {
-        spdlog::error("(nullptr) Player data packet received for unknown player {}", guid);
+        spdlog::error("Player data packet received for unknown player {}", guid);
         return false;
     }
 
-    auto animation_data = flatbuffers::GetRoot<nier::AnimationStart>(packet->data()->data());
     auto npc = player_networked->get_entity();
 
     if (npc != nullptr) {
@@ -891,30 +1865,26 @@ bool NierClient::handle_animation_start(const nier::PlayerPacket* packet) {
     return true;
 }
 
-bool NierClient::handle_buttons(const nier::PlayerPacket* packet) {
-    const auto guid = packet->guid();
-    
+bool NierClient::handle_buttons(uint64_t guid, const nier::Buttons* buttons) {
+    if (buttons == nullptr) {
+        return false;
+    }
+
     // do not update the local player. maybe change this later for forced updates/teleportation commands?
     if (guid == m_guid) {
         return true;
     }
 
-    if (!m_players.contains(guid)) {
-        spdlog::error("Player data packet received for unknown player {}", guid);
-        return false;
-    }
-
-    const auto& player_networked = m_players[guid];
+    const auto player_networked = m_players.find(guid);
 
     if (player_networked == nullptr) {
-        spdlog::error("(nullptr) Player data packet received for unknown player {}", guid);
+        spdlog::error("Player data packet received for unknown player {}", guid);
         return false;
     }
 
-    auto buttons = flatbuffers::GetRoot<nier::Buttons>(packet->data()->data());
     auto npc = player_networked->get_entity();
 
-    if (npc != nullptr) {
+    if (npc != nullptr && buttons->buttons() != nullptr) {
         const auto buttons_data = buttons->buttons()->data();
         const auto size_buttons = sizeof(regenny::CharacterController::buttons);
         memcpy(&npc->character_controller().buttons, buttons_data, size_buttons);
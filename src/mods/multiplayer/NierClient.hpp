@@ -1,11 +1,28 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
 #include <unordered_map>
+#include <variant>
 
 #include <enetpp/client.h>
 
 #include "Player.hpp"
 #include "EntitySync.hpp"
+#include "BuilderPool.hpp"
+#include "DeltaCompression.hpp"
+#include "MpscQueue.hpp"
+#include "NetGraph.hpp"
+#include "PacketBatcher.hpp"
+#include "PacketPolicy.hpp"
+#include "PlayerTable.hpp"
+#include "Quantization.hpp"
+#include "ReplicatedProperty.hpp"
+#include "StringTable.hpp"
+#include "TickScheduler.hpp"
 #include "schema/Packets_generated.h"
 
 struct Packet;
@@ -24,14 +41,15 @@ public:
     void on_frame();
     bool is_connected() { return get_connection_state() == enetpp::CONNECT_CONNECTED; }
 
-    void send_packet(nier::PacketType id, const uint8_t* data = nullptr, size_t size = 0);
+    // coalesce_key != 0 marks state updates where a newer packet with the same key may replace an unsent older one.
+    void send_packet(nier::PacketType id, const uint8_t* data = nullptr, size_t size = 0, uint64_t coalesce_key = 0);
     void send_animation_start(uint32_t anim, uint32_t variant, uint32_t a3, uint32_t a4);
     void send_buttons(const uint32_t* buttons);
 
     void send_entity_packet(nier::PacketType id, uint32_t guid, const uint8_t* data = nullptr, size_t size = 0);
     void send_entity_create(uint32_t guid, sdk::EntitySpawnParams* data);
     void send_entity_destroy(uint32_t guid);
-    void send_entity_data(uint32_t guid, sdk::BehaviorAppBase* entity);
+    void send_entity_snapshot(const EntitySnapshotData& snapshot);
     void send_entity_animation_start(uint32_t guid, uint32_t anim, uint32_t variant, uint32_t a3, uint32_t a4);
 
     void on_entity_created(sdk::Entity* entity, sdk::EntitySpawnParams* data);
@@ -45,40 +63,131 @@ public:
         return m_is_master_client;
     }
 
-    const auto& get_players() const {
+    // The held flags hook looks players up by entity handle in here.
+    auto& get_players() {
         return m_players;
     }
 
+    // Only snapshots carry velocities, V1 receivers snap to each entity data packet.
+    bool sends_entity_velocities() const {
+        return uses_packet_v2();
+    }
+
 private:
     void on_connect();
     void on_disconnect();
-    void on_data_received(const enet_uint8* data, size_t size);
-    void on_packet_received(const nier::Packet* packet);
-    void on_player_packet_received(nier::PacketType packet_type, const nier::PlayerPacket* packet);
-    void on_entity_packet_received(nier::PacketType packet_type, const nier::EntityPacket* packet);
+
+    // A verified packet decoded down to the message its handler takes, pointing into buffer which it keeps alive.
+    // A batch shares its buffer between the messages in it.
+    struct ReceivedMessage {
+        using Payload = std::variant<std::monostate, const nier::Welcome*, const nier::CreatePlayer*, const nier::EntitySpawnParams*,
+            const nier::EntityData*, const nier::EntitySnapshot*, const nier::AnimationStart*, const nier::PlayerDataMessage*,
+            const nier::PlayerDataAck*, const nier::StringTable*, const nier::PlayerData*, const nier::Buttons*>;
+
+        std::shared_ptr<ENetPacket> buffer{};
+        nier::PacketType id{};
+        uint64_t guid{};
+        Payload payload{};
+        std::chrono::steady_clock::time_point received_time{}; // when the network thread got the packet, not when it's applied
+    };
+
+    // Run on the network thread, they verify and decode into m_received_messages and never touch game state.
+    bool on_packet_received_in_thread(ENetPacket* packet);
+    void decode_packet(const std::shared_ptr<ENetPacket>& buffer, const nier::PacketV2* packet);
+    void decode_packet(const std::shared_ptr<ENetPacket>& buffer, const nier::Packet* packet);
+    void decode_player_packet(const std::shared_ptr<ENetPacket>& buffer, nier::PacketType packet_type, const nier::PlayerPacket* packet);
+    void decode_entity_packet(const std::shared_ptr<ENetPacket>& buffer, nier::PacketType packet_type, const nier::EntityPacket* packet);
+    void push_received_message(const std::shared_ptr<ENetPacket>& buffer, nier::PacketType id, uint64_t guid,
+        ReceivedMessage::Payload payload = {});
+
+    // Game thread, hands what the network thread decoded to the handlers.
+    void apply_received_messages();
+    void apply_received_message(const ReceivedMessage& message);
 
     void send_hello();
+    void send_message(flatbuffers::FlatBufferBuilder* builder, nier::PacketType id, uint64_t guid,
+        nier::Message message_type = nier::Message_NONE, flatbuffers::Offset<void> message = 0, uint64_t coalesce_key = 0);
+    void send_finished_packet(flatbuffers::FlatBufferBuilder* builder, nier::PacketType id, uint64_t coalesce_key);
+    void flush_packet_batches();
+    bool uses_packet_v2() const { return m_protocol >= nier::ProtocolVersion_V2; }
+    void draw_network_stats();
+    void draw_send_rates();
+    void record_packet_stats(nier::PacketType id, size_t size, bool sent);
 
     void update_local_player_data();
     void send_player_data();
+    Vector3f update_angular_velocity(const glm::quat& orientation);
+    void send_quantized_entity_snapshot(const EntitySnapshotData& snapshot);
+    // Healths, or dirty and properties with replicated properties, for the snapshot rows in rows.
+    void create_entity_snapshot_properties(flatbuffers::FlatBufferBuilder& builder, const EntitySnapshotData& snapshot,
+        const size_t* rows, size_t count, flatbuffers::Offset<flatbuffers::Vector<uint32_t>>& healths,
+        flatbuffers::Offset<flatbuffers::Vector<uint8_t>>& dirty, flatbuffers::Offset<flatbuffers::Vector<uint8_t>>& properties);
+    void send_player_data_acks();
+
+    // Handlers take the decoded message so V1 and V2 packets share them, nullptr means the packet was malformed.
+    // Only called from apply_received_message, on the game thread.
+    bool handle_welcome(const nier::Welcome* welcome);
+    bool handle_create_player(const nier::CreatePlayer* create_player);
+    bool handle_destroy_player(uint64_t guid);
+
+    bool handle_create_entity(uint32_t guid, const nier::EntitySpawnParams* spawn);
+    bool handle_destroy_entity(uint32_t guid);
+    bool handle_entity_data(uint32_t guid, const nier::EntityData* entity_data);
+    bool handle_entity_snapshot(const nier::EntitySnapshot* snapshot);
+    bool handle_entity_animation_start(uint32_t guid, const nier::AnimationStart* animation_data);
+
+    bool handle_player_data_message(uint64_t guid, const nier::PlayerDataMessage* message,
+        std::chrono::steady_clock::time_point received_time);
+    bool handle_player_data_ack(const nier::PlayerDataAck* ack);
+    bool handle_string_table(const nier::StringTable* table);
+    // A name that may have been sent as name_id, false if neither is usable.
+    bool resolve_name(const flatbuffers::String* name, uint32_t name_id, std::string& out);
+    bool handle_player_data(uint64_t guid, const nier::PlayerData* player_data, std::chrono::steady_clock::time_point received_time);
+    bool handle_player_orientation(uint64_t guid, const nier::CompressedQuaternion* orientation,
+        const nier::QuantizedAngularVelocity* angular_velocity);
+    bool handle_animation_start(uint64_t guid, const nier::AnimationStart* animation_data);
+    bool handle_buttons(uint64_t guid, const nier::Buttons* buttons);
+
+    std::unique_ptr<EntitySync> m_network_entities{};
 
-    bool handle_welcome(const nier::Packet* packet);
-    bool handle_create_player(const nier::Packet* packet);
-    bool handle_destroy_player(const nier::Packet* packet);
+    MpscQueue<ReceivedMessage> m_received_messages{};
+    std::chrono::steady_clock::time_point m_packet_received_time{}; // network thread only, the packet being decoded
 
-    bool handle_create_entity(const nier::EntityPacket* packet);
-    bool handle_destroy_entity(const nier::EntityPacket* packet);
-    bool handle_entity_data(const nier::EntityPacket* packet);
-    bool handle_entity_animation_start(const nier::EntityPacket* packet);
+    // Smoothed cost per call in microseconds, recorded on one thread and read by the UI.
+    struct CostMeter {
+        std::atomic<float> mean_us{};
+        std::atomic<float> peak_us{}; // decays, so a single hitch doesn't stick
 
-    bool handle_player_data(const nier::PlayerPacket* packet);
-    bool handle_animation_start(const nier::PlayerPacket* packet);
-    bool handle_buttons(const nier::PlayerPacket* packet);
+        void record(std::chrono::steady_clock::duration duration) {
+            const auto us = std::chrono::duration<float, std::micro>{duration}.count();
 
-    std::unique_ptr<EntitySync> m_network_entities{};
+            mean_us = mean_us + (us - mean_us) / 64.0f;
+            peak_us = std::max(us, peak_us * 0.99f);
+        }
+    };
+
+    CostMeter m_think_cost{};
+    CostMeter m_apply_cost{}; // the part of think() handing received messages to the handlers
+    CostMeter m_decode_cost{}; // per packet, on the network thread
 
     std::recursive_mutex m_mtx{};
     std::recursive_mutex m_players_mutex{};
+    std::mutex m_send_mtx{}; // enetpp's outbound queue is single producer, sends come from hooks on other threads too.
+    BuilderPool m_builder_pool{}; // declared as a member so it outlives the packets freed by disconnect()
+    PacketBatcher m_packet_batcher{m_builder_pool}; // V2 packets waiting for the end of the tick, guarded by m_send_mtx
+
+    struct PacketTypeStats {
+        uint64_t sent_count{};
+        uint64_t sent_bytes{};
+        uint64_t received_count{};
+        uint64_t received_bytes{};
+    };
+
+    std::mutex m_packet_stats_mtx{}; // sends happen on hook threads, receives on the network thread.
+    std::map<nier::PacketType, PacketTypeStats> m_packet_stats{};
+    uint64_t m_player_state_bytes{}; // what the delta encoded player data would have been without a baseline
+    uint64_t m_player_delta_bytes{};
+    NetGraph m_net_graph{};
     std::string m_hello_name{};
     std::string m_password{};
 
@@ -87,6 +196,56 @@ private:
 
     bool m_is_master_client{false};
     uint64_t m_guid{};
-
-    std::unordered_map<uint64_t, std::unique_ptr<Player>> m_players{};
+    nier::ProtocolVersion m_protocol{nier::ProtocolVersion_V1}; // until the welcome says otherwise.
+    float m_position_precision{}; // from the welcome, 0 sends positions and facings as floats.
+
+    // Player data and entity snapshots go out at these rates whatever the frame rate is, see TickScheduler.
+    // Buttons and animations are events and are still sent when they happen.
+    static constexpr float DEFAULT_PLAYER_SEND_RATE = 30.0f;
+    static constexpr float DEFAULT_ENTITY_SEND_RATE = 20.0f;
+    TickScheduler m_player_tick{DEFAULT_PLAYER_SEND_RATE};
+    TickScheduler m_entity_tick{DEFAULT_ENTITY_SEND_RATE};
+
+    // The sector the local player's quantized positions are relative to, it is resent with the
+    // next few updates after it changes and every so often after that for players that join later.
+    static constexpr uint32_t SECTOR_RESEND_COUNT = 8;
+    static constexpr uint32_t SECTOR_REFRESH_INTERVAL = 60;
+    nier::Sector m_sector{};
+    uint8_t m_sector_id{};
+    bool m_has_sector{false};
+    uint32_t m_sector_resends{};
+    uint32_t m_player_data_count{};
+
+    // The local player's orientation as of the previous update, to work out how fast it is turning.
+    // Slower than this (radians per second) counts as not turning and leaves angular_velocity out.
+    static constexpr float MIN_ANGULAR_VELOCITY = 0.01f;
+    glm::quat m_last_orientation{glm::identity<glm::quat>()};
+    std::chrono::steady_clock::time_point m_last_orientation_time{};
+    bool m_has_last_orientation{false};
+
+    // From the welcome, the local player's quantized updates go out as deltas against what the relay acked.
+    bool m_delta_player_data{false};
+    delta_compression::Sender m_player_data_sender{};
+    std::vector<uint8_t> m_player_data_delta{}; // reused by send_player_data
+    std::vector<uint64_t> m_ack_guids{}; // reused by send_player_data_acks
+    std::vector<uint16_t> m_ack_sequences{};
+
+    // From the welcome, the local player's rarely changing fields go out as properties when they change,
+    // and everything is marked dirty every PROPERTY_REFRESH_INTERVAL updates for players that join later.
+    static constexpr uint32_t PROPERTY_REFRESH_INTERVAL = 60;
+    bool m_replicated_properties{false};
+    replication::PlayerProperties m_player_properties{};
+    std::vector<uint8_t> m_player_properties_bytes{}; // reused by send_player_data
+    uint32_t m_player_properties_count{};
+
+    // From the welcome, entity and player names the relay has given ids go both ways as name_id.
+    bool m_use_string_table{false};
+    StringTable m_string_table{};
+
+    // Reused by send_entity_snapshot and send_quantized_entity_snapshot, only touched on the game thread.
+    std::vector<nier::Sector> m_snapshot_sectors{};
+    std::vector<size_t> m_snapshot_order{};
+    std::vector<uint8_t> m_snapshot_properties{};
+
+    PlayerTable m_players{};
 };
\ No newline at end of file
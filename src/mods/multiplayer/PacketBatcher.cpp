@@ -0,0 +1,98 @@
+#include <spdlog/spdlog.h>
+
+#include "PacketBatcher.hpp"
+
+PacketBatcher::PacketBatcher(BuilderPool& pool)
+    : m_pool{pool}
+{
+}
+
+PacketBatcher::~PacketBatcher() {
+    for (auto& queue : m_queues) {
+        for (const auto& packet : queue.packets) {
+            m_pool.release(packet.builder);
+        }
+    }
+}
+
+void PacketBatcher::add(flatbuffers::FlatBufferBuilder* builder, const packet_policy::Policy& policy, uint64_t coalesce_key) {
+    if (policy.channel >= m_queues.size()) {
+        spdlog::error("[PacketBatcher] Packet for unknown channel {}", policy.channel);
+        m_pool.release(builder);
+        return;
+    }
+
+    auto& queue = m_queues[policy.channel];
+    queue.flags = policy.flags;
+
+    if (coalesce_key != 0) {
+        for (auto& packet : queue.packets) {
+            if (packet.coalesce_key == coalesce_key) {
+                m_pool.release(packet.builder);
+                packet.builder = builder;
+                return;
+            }
+        }
+    }
+
+    queue.packets.push_back({builder, coalesce_key});
+}
+
+void PacketBatcher::flush(size_t mtu, const SendFunction& send) {
+    const auto max_size = mtu > ENET_OVERHEAD ? mtu - ENET_OVERHEAD : 0;
+
+    for (uint8_t channel = 0; channel < m_queues.size(); ++channel) {
+        auto& queue = m_queues[channel];
+        size_t first = 0;
+
+        while (first < queue.packets.size()) {
+            // Takes as many packets as fit in one datagram, a packet too big for one on its own still goes out alone.
+            size_t last = first + 1;
+            size_t size = ENVELOPE_SIZE + queue.packets[first].builder->GetSize() + ENTRY_SIZE;
+
+            while (last < queue.packets.size()) {
+                const auto next_size = queue.packets[last].builder->GetSize() + ENTRY_SIZE;
+
+                if (size + next_size > max_size) {
+                    break;
+                }
+
+                size += next_size;
+                ++last;
+            }
+
+            send_batch(channel, queue, first, last, send);
+            first = last;
+        }
+
+        queue.packets.clear();
+    }
+}
+
+void PacketBatcher::send_batch(uint8_t channel, const Queue& queue, size_t first, size_t last, const SendFunction& send) {
+    const auto& packets = queue.packets;
+
+    // Not worth an envelope, the packet's own buffer goes to ENet as-is.
+    if (last - first == 1) {
+        send(channel, m_pool.create_packet(packets[first].builder, queue.flags), packets[first].coalesce_key, 1);
+        return;
+    }
+
+    auto builder = m_pool.acquire();
+
+    m_entries.clear();
+
+    for (auto i = first; i < last; ++i) {
+        const auto packet_builder = packets[i].builder;
+        const auto packet = builder->CreateVector(packet_builder->GetBufferPointer(), packet_builder->GetSize());
+
+        m_entries.push_back(nier::CreatePacketBatchEntry(*builder, packet));
+        m_pool.release(packet_builder);
+    }
+
+    const auto batch = nier::CreatePacketBatch(*builder, builder->CreateVector(m_entries));
+    nier::FinishPacketV2Buffer(*builder, nier::CreatePacketV2(*builder, nier::PacketType_ID_PACKET_BATCH, 0, nier::Message_PacketBatch, batch.Union()));
+
+    // Never coalesced, which players and entities a batch holds changes from tick to tick.
+    send(channel, m_pool.create_packet(builder, queue.flags), 0, last - first);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <enet/enet.h>
+#include <flatbuffers/flatbuffers.h>
+
+#include "BuilderPool.hpp"
+#include "PacketPolicy.hpp"
+#include "schema/Packets_generated.h"
+
+// Holds the V2 packets sent during a tick and packs each channel's packets into PacketBatch
+// envelopes of at most one datagram when flushed, so the packet rate follows the tick rate
+// instead of the number of players and entities.
+// Not thread safe, NierClient only touches it under its send mutex.
+class PacketBatcher {
+public:
+    // Must match server/automatamp/core/PacketBatch.go.
+    // ENet's protocol header, the send command and a few acknowledgements sharing the datagram.
+    static constexpr size_t ENET_OVERHEAD = 48;
+    // The PacketV2 and PacketBatch tables around the entries, and each entry's table and vector header, rounded up.
+    static constexpr size_t ENVELOPE_SIZE = 48;
+    static constexpr size_t ENTRY_SIZE = 16;
+
+    // packet is nullptr if ENet couldn't create it, message_count is 1 for a packet sent without an envelope.
+    using SendFunction = std::function<void(uint8_t channel, ENetPacket* packet, uint64_t coalesce_key, size_t message_count)>;
+
+    PacketBatcher(BuilderPool& pool);
+    ~PacketBatcher();
+
+    PacketBatcher(const PacketBatcher&) = delete;
+    PacketBatcher& operator=(const PacketBatcher&) = delete;
+
+    // builder must hold a finished PacketV2, it belongs to the batcher from here on.
+    // A queued packet with the same non zero coalesce_key is replaced, only the newest state goes out.
+    void add(flatbuffers::FlatBufferBuilder* builder, const packet_policy::Policy& policy, uint64_t coalesce_key);
+    void flush(size_t mtu, const SendFunction& send);
+
+    bool empty() const {
+        for (const auto& queue : m_queues) {
+            if (!queue.packets.empty()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    struct QueuedPacket {
+        flatbuffers::FlatBufferBuilder* builder;
+        uint64_t coalesce_key;
+    };
+
+    struct Queue {
+        enet_uint32 flags{}; // the policy table gives every packet type on a channel the same flags
+        std::vector<QueuedPacket> packets{};
+    };
+
+    void send_batch(uint8_t channel, const Queue& queue, size_t first, size_t last, const SendFunction& send);
+
+    BuilderPool& m_pool;
+    std::array<Queue, packet_policy::CHANNEL_COUNT> m_queues{};
+    std::vector<flatbuffers::Offset<nier::PacketBatchEntry>> m_entries{}; // reused so building a batch doesn't allocate
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#include <enet/enet.h>
+
+#include "schema/Packets_generated.h"
+
+// Which channel and delivery mode each packet type uses.
+// Must match server/automatamp/core/PacketPolicy.go, the relay forwards with the same table.
+namespace packet_policy {
+enum Channel : uint8_t {
+    // Reliable, ordered. Spawns, destroys, handshakes, anything that must not be lost.
+    CHANNEL_LIFECYCLE = 0,
+    // Unreliable, sequenced. Continuous state where only the newest update matters.
+    CHANNEL_STATE = 1,
+    // Reliable, ordered, but separate from lifecycle so a resend doesn't stall spawns.
+    CHANNEL_EVENTS = 2,
+
+    CHANNEL_COUNT
+};
+
+struct Policy {
+    uint8_t channel;
+    enet_uint32 flags;
+};
+
+constexpr Policy get(nier::PacketType id) {
+    switch (id) {
+    case nier::PacketType_ID_PLAYER_DATA:
+    case nier::PacketType_ID_ENTITY_DATA:
+    case nier::PacketType_ID_ENTITY_SNAPSHOT:
+    case nier::PacketType_ID_PLAYER_DATA_ACK: // a lost ack is covered by the next one.
+        // No flags is unreliable sequenced in ENet, stale updates are dropped by the receiver.
+        return {CHANNEL_STATE, 0};
+    case nier::PacketType_ID_ANIMATION_START:
+    case nier::PacketType_ID_ENTITY_ANIMATION_START:
+    case nier::PacketType_ID_BUTTONS:
+        return {CHANNEL_EVENTS, ENET_PACKET_FLAG_RELIABLE};
+    default:
+        return {CHANNEL_LIFECYCLE, ENET_PACKET_FLAG_RELIABLE};
+    }
+}
+}
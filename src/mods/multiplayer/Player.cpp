@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <sdk/EntityList.hpp>
 #include <sdk/Entity.hpp>
 #include "Player.hpp"
@@ -15,3 +17,33 @@ sdk::Pl0000* Player::get_entity() {
 
     return ent->behavior->as<sdk::Pl0000>();
 }
+
+// Seconds on the steady clock, what the snapshot buffer is timed in.
+static double get_snapshot_time(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration<double>(time.time_since_epoch()).count();
+}
+
+void Player::push_snapshot(const nier::PlayerData& data, std::chrono::steady_clock::time_point received_time) {
+    m_snapshots.push(get_snapshot_time(received_time), interpolation::State{
+        *(const Vector3f*)&data.position(), data.facing(), data.facing2(), data.speed()});
+}
+
+bool Player::sample_snapshot(interpolation::State& out) const {
+    return m_snapshots.sample(get_snapshot_time(std::chrono::steady_clock::now()), out);
+}
+
+glm::quat Player::get_predicted_orientation() const {
+    // Past this the update is late or lost, keep turning any further and a stopped player would spin in place.
+    constexpr float MAX_EXTRAPOLATION = 0.25f;
+
+    const auto speed = glm::length(m_angular_velocity);
+
+    if (speed <= 0.0f) {
+        return m_orientation;
+    }
+
+    const auto elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - m_orientation_time).count();
+    const auto dt = std::clamp(elapsed, 0.0f, MAX_EXTRAPOLATION);
+
+    return glm::normalize(glm::angleAxis(speed * dt, m_angular_velocity / speed) * m_orientation);
+}
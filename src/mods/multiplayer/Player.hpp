@@ -1,5 +1,12 @@
 #pragma once
 
+#include <chrono>
+
+#include <sdk/Math.hpp>
+
+#include "DeltaCompression.hpp"
+#include "Interpolation.hpp"
+#include "ReplicatedProperty.hpp"
 #include "schema/Packets_generated.h"
 
 namespace sdk {
@@ -20,9 +27,44 @@ public:
 
     auto& get_player_data() { return m_player_data; }
 
-    uint32_t get_handle() { return m_entity_handle; }
+    // The last replicated properties received, see nier::PlayerDataMessage.properties.
+    auto& get_properties() { return m_properties; }
 
-    void set_handle(uint32_t handle) { m_entity_handle = handle; }
+    // The sector this player's quantized positions are relative to, see nier::PlayerDataMessage.
+    void set_sector(uint8_t id, const nier::Sector& sector) {
+        m_sector_id = id;
+        m_sector = sector;
+        m_has_sector = true;
+    }
+
+    // nullptr until the sector with this id has been received.
+    const nier::Sector* get_sector(uint8_t id) const { return m_has_sector && m_sector_id == id ? &m_sector : nullptr; }
+
+    // Full orientation from the last update that carried one, angular_velocity is in radians per second.
+    void set_orientation(const glm::quat& orientation, const Vector3f& angular_velocity) {
+        m_orientation = orientation;
+        m_angular_velocity = angular_velocity;
+        m_orientation_time = std::chrono::steady_clock::now();
+        m_has_orientation = true;
+    }
+
+    bool has_orientation() const { return m_has_orientation; }
+
+    // The last orientation turned on by its angular velocity until now.
+    glm::quat get_predicted_orientation() const;
+
+    // Buffers a received update for playback a little in the past, see interpolation::SnapshotBuffer.
+    // Timed by when the packet arrived, so time spent queued for the game thread isn't taken for network jitter.
+    void push_snapshot(const nier::PlayerData& data, std::chrono::steady_clock::time_point received_time);
+    // Where to show the player this frame, false until an update has arrived.
+    bool sample_snapshot(interpolation::State& out) const;
+
+    const auto& get_snapshots() const { return m_snapshots; }
+
+    // Decodes this player's delta encoded updates, see nier::PlayerDataMessage.delta.
+    auto& get_player_data_receiver() { return m_player_data_receiver; }
+
+    uint32_t get_handle() { return m_entity_handle; }
 
     float get_start_tick() { return m_start_tick; }
 
@@ -31,9 +73,26 @@ public:
     sdk::Pl0000* get_entity();
 
 private:
+    // Only through PlayerTable::set_handle, which keeps its handle lookup in step with the entity.
+    friend class PlayerTable;
+
+    void set_handle(uint32_t handle) { m_entity_handle = handle; }
+
     std::string m_name{};
     uint64_t m_guid{};
     uint32_t m_entity_handle{0};
     float m_start_tick{0.0f};
     nier::PlayerData m_player_data;
+    replication::PlayerProperties::Values m_properties{};
+    nier::Sector m_sector{};
+    uint8_t m_sector_id{};
+    bool m_has_sector{false};
+
+    glm::quat m_orientation{glm::identity<glm::quat>()};
+    Vector3f m_angular_velocity{};
+    std::chrono::steady_clock::time_point m_orientation_time{};
+    bool m_has_orientation{false};
+
+    delta_compression::Receiver m_player_data_receiver{};
+    interpolation::SnapshotBuffer m_snapshots{};
 };
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "PlayerTable.hpp"
+
+Player* PlayerTable::add(uint64_t guid, uint8_t slot) {
+    size_t index = MAX_PLAYERS;
+
+    for (size_t i = 0; i < MAX_PLAYERS; ++i) {
+        if (m_used[i] && m_guids[i] == guid) {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == MAX_PLAYERS) {
+        if (slot > 0 && slot <= MAX_PLAYERS) {
+            if (m_used[slot - 1]) {
+                return nullptr;
+            }
+
+            index = slot - 1;
+        } else {
+            for (size_t i = 0; i < MAX_PLAYERS; ++i) {
+                if (!m_used[i]) {
+                    index = i;
+                    break;
+                }
+            }
+
+            if (index == MAX_PLAYERS) {
+                return nullptr;
+            }
+        }
+    }
+
+    unlink_handle(index);
+
+    m_players[index] = Player{};
+    m_guids[index] = guid;
+    m_used[index] = true;
+    return &m_players[index];
+}
+
+void PlayerTable::remove(uint64_t guid) {
+    const auto player = find(guid);
+
+    if (player == nullptr) {
+        return;
+    }
+
+    const auto index = get_index(*player);
+
+    unlink_handle(index);
+
+    m_players[index] = Player{};
+    m_guids[index] = 0;
+    m_used[index] = false;
+}
+
+Player* PlayerTable::find(uint64_t guid) {
+    for (size_t i = 0; i < MAX_PLAYERS; ++i) {
+        if (m_used[i] && m_guids[i] == guid) {
+            return &m_players[i];
+        }
+    }
+
+    return nullptr;
+}
+
+Player* PlayerTable::find_by_handle(uint32_t handle) {
+    if (handle == 0) {
+        return nullptr;
+    }
+
+    const auto slot = m_slot_by_handle_index[get_handle_index(handle)];
+
+    if (slot == 0) {
+        return nullptr;
+    }
+
+    // The index is shared by every entity that ever lives in that entry, the rest of the handle tells them apart.
+    auto& player = m_players[slot - 1];
+    return player.get_handle() == handle ? &player : nullptr;
+}
+
+void PlayerTable::set_handle(Player& player, uint32_t handle) {
+    const auto index = get_index(player);
+
+    unlink_handle(index);
+    player.set_handle(handle);
+
+    if (handle != 0) {
+        m_slot_by_handle_index[get_handle_index(handle)] = (uint8_t)(index + 1);
+    }
+}
+
+void PlayerTable::clear() {
+    for (size_t i = 0; i < MAX_PLAYERS; ++i) {
+        unlink_handle(i);
+
+        m_players[i] = Player{};
+        m_guids[i] = 0;
+        m_used[i] = false;
+    }
+}
+
+void PlayerTable::unlink_handle(size_t index) {
+    const auto handle = m_players[index].get_handle();
+
+    if (handle == 0) {
+        return;
+    }
+
+    auto& slot = m_slot_by_handle_index[get_handle_index(handle)];
+
+    if (slot == index + 1) {
+        slot = 0;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Player.hpp"
+
+// The session's players in the slots the relay gave them, see nier::CreatePlayer.slot.
+// Finding a player by guid or by entity handle is an index or a short scan over one array,
+// and walking every player touches only that array. Guarded by NierClient's players mutex.
+// MAX_PLAYERS must match server/automatamp/structs/Server.go.
+class PlayerTable {
+public:
+    static constexpr size_t MAX_PLAYERS = 32;
+
+    // Visits the occupied slots in order.
+    class Iterator {
+    public:
+        Iterator(PlayerTable* table, size_t index)
+            : m_table{table},
+            m_index{index}
+        {
+            skip_free();
+        }
+
+        Player& operator*() const { return m_table->m_players[m_index]; }
+        Player* operator->() const { return &m_table->m_players[m_index]; }
+
+        Iterator& operator++() {
+            ++m_index;
+            skip_free();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+
+    private:
+        void skip_free() {
+            while (m_index < MAX_PLAYERS && !m_table->m_used[m_index]) {
+                ++m_index;
+            }
+        }
+
+        PlayerTable* m_table{};
+        size_t m_index{};
+    };
+
+    Iterator begin() { return Iterator{this, 0}; }
+    Iterator end() { return Iterator{this, MAX_PLAYERS}; }
+
+    // slot is 1 based as the relay sends it. 0 or out of range takes the lowest free slot instead,
+    // so relays that don't assign slots still work. A guid that is already in the table starts over in its slot.
+    // nullptr if the slot belongs to another player or every slot is taken.
+    Player* add(uint64_t guid, uint8_t slot);
+    void remove(uint64_t guid);
+    Player* find(uint64_t guid);
+    bool contains(uint64_t guid) { return find(guid) != nullptr; }
+
+    // The player whose entity has this handle, nullptr if none does. Called from the held flags hook for every character.
+    Player* find_by_handle(uint32_t handle);
+    // The only way to change a player's handle, so find_by_handle always sees the new entity.
+    void set_handle(Player& player, uint32_t handle);
+
+    void clear();
+
+private:
+    // What sdk::EntityList::get_by_handle indexes its entries with.
+    static uint16_t get_handle_index(uint32_t handle) { return (uint16_t)(handle >> 8); }
+
+    size_t get_index(const Player& player) const { return &player - m_players.data(); }
+    void unlink_handle(size_t index);
+
+    std::array<Player, MAX_PLAYERS> m_players{};
+    std::array<uint64_t, MAX_PLAYERS> m_guids{};
+    std::array<bool, MAX_PLAYERS> m_used{};
+    std::array<uint8_t, 1 << 16> m_slot_by_handle_index{}; // 1 based slot, 0 if no player's entity is there
+};
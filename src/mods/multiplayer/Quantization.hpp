@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <sdk/Math.hpp>
+
+#include "schema/Packets_generated.h"
+
+// Fixed point positions and facings, used instead of floats when the Welcome negotiated a position precision.
+// A position is a 16 bit offset per axis from the center of its sector, a cube of SECTOR_STEPS steps,
+// and the sector itself is only sent when it changes.
+// Must match server/automatamp/core/Quantization.go, the relay decodes these for clients that read floats.
+namespace quantization {
+// Three quarters of what a short reaches from the center, so a player can wander a bit past the edge
+// before their sector has to change and walking along it doesn't flip between two.
+constexpr float SECTOR_STEPS = 49152.0f;
+// Turns are split into 65536 steps, a decoded facing is off by at most 0.0027 degrees.
+constexpr float YAW_STEPS = 65536.0f;
+constexpr float PI = 3.14159265358979323846f;
+constexpr float TWO_PI = 2.0f * PI;
+
+// The server's default, see positionPrecision in server.json.
+// A decoded position is off by at most half a step (1mm) and a sector spans 98m.
+constexpr float DEFAULT_PRECISION = 0.002f;
+
+// Anything coarser than this would make a sector larger than a level.
+constexpr float MAX_PRECISION = 0.1f;
+
+// Returns 0 (floats) for a precision the encoding can't use.
+inline float validate_precision(float precision) {
+    if (!std::isfinite(precision) || precision <= 0.0f || precision > MAX_PRECISION) {
+        return 0.0f;
+    }
+
+    return precision;
+}
+
+inline int16_t to_short(float value) {
+    return (int16_t)std::clamp(std::round(value), -32768.0f, 32767.0f);
+}
+
+inline nier::Sector get_sector(const nier::Vector3f& position, float precision) {
+    const auto sector_size = precision * SECTOR_STEPS;
+
+    return nier::Sector{
+        to_short(position.x() / sector_size),
+        to_short(position.y() / sector_size),
+        to_short(position.z() / sector_size)
+    };
+}
+
+inline bool is_same_sector(const nier::Sector& a, const nier::Sector& b) {
+    return a.x() == b.x() && a.y() == b.y() && a.z() == b.z();
+}
+
+inline nier::Vector3f get_sector_center(const nier::Sector& sector, float precision) {
+    const auto sector_size = precision * SECTOR_STEPS;
+
+    return nier::Vector3f{sector.x() * sector_size, sector.y() * sector_size, sector.z() * sector_size};
+}
+
+// True if position can be encoded relative to sector without clamping.
+inline bool is_in_sector(const nier::Vector3f& position, const nier::Sector& sector, float precision) {
+    const auto center = get_sector_center(sector, precision);
+    const auto in_range = [precision](float offset) {
+        const auto steps = std::round(offset / precision);
+        return steps >= -32768.0f && steps <= 32767.0f;
+    };
+
+    return in_range(position.x() - center.x()) && in_range(position.y() - center.y()) && in_range(position.z() - center.z());
+}
+
+// position should lie in sector, a position outside of it is clamped to the sector's edge.
+inline nier::QuantizedVector3 quantize_position(const nier::Vector3f& position, const nier::Sector& sector, float precision) {
+    const auto center = get_sector_center(sector, precision);
+
+    return nier::QuantizedVector3{
+        to_short((position.x() - center.x()) / precision),
+        to_short((position.y() - center.y()) / precision),
+        to_short((position.z() - center.z()) / precision)
+    };
+}
+
+inline nier::Vector3f dequantize_position(const nier::QuantizedVector3& position, const nier::Sector& sector, float precision) {
+    const auto center = get_sector_center(sector, precision);
+
+    return nier::Vector3f{
+        center.x() + position.x() * precision,
+        center.y() + position.y() * precision,
+        center.z() + position.z() * precision
+    };
+}
+
+inline uint16_t quantize_yaw(float radians) {
+    auto turns = radians / TWO_PI;
+    turns -= std::floor(turns);
+
+    // A value just below a full turn rounds up to 65536, which wraps to 0 like it should.
+    return (uint16_t)((uint32_t)std::lround(turns * YAW_STEPS) & 0xFFFF);
+}
+
+// Returns a facing in [-pi, pi), the range the game keeps them in.
+inline float dequantize_yaw(uint16_t yaw) {
+    const auto radians = yaw * (TWO_PI / YAW_STEPS);
+
+    return radians >= PI ? radians - TWO_PI : radians;
+}
+
+// Smallest three: the largest component of a unit quaternion is left out and rebuilt from the other three,
+// which can then only lie in [-1/sqrt(2), 1/sqrt(2)] and get 10 bits each. A sent component is off by
+// at most 0.0007, half a step, and the rebuilt one by at most 0.0021 since it takes on the error of the
+// other three. The loops have a fixed trip count and no branches on the data so they vectorize.
+constexpr float QUATERNION_COMPONENT_RANGE = 0.70710678118654752440f;
+constexpr float QUATERNION_COMPONENT_STEPS = 1023.0f;
+
+// Angular velocity is in radians per second, steps of 1/2048 reach 16 radians per second.
+constexpr float ANGULAR_VELOCITY_STEPS = 2048.0f;
+
+// Velocity is in meters per second, steps of 1/256 reach 128 meters per second.
+constexpr float VELOCITY_STEPS = 256.0f;
+
+inline nier::CompressedQuaternion compress_quaternion(const glm::quat& rotation) {
+    const auto q = glm::normalize(rotation);
+    const float components[4]{q.x, q.y, q.z, q.w};
+
+    uint32_t largest = 0;
+
+    for (uint32_t i = 1; i < 4; ++i) {
+        largest = std::abs(components[i]) > std::abs(components[largest]) ? i : largest;
+    }
+
+    // q and -q are the same rotation, flipping makes the left out component positive.
+    const auto sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    uint32_t value = largest << 30;
+    uint32_t shift = 30;
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        const auto normalized = std::clamp(components[i] * sign / QUATERNION_COMPONENT_RANGE, -1.0f, 1.0f);
+        const auto bits = (uint32_t)std::lround((normalized + 1.0f) * 0.5f * QUATERNION_COMPONENT_STEPS);
+        const auto skip = i == largest;
+
+        shift -= skip ? 0 : 10;
+        value |= skip ? 0 : bits << shift;
+    }
+
+    return nier::CompressedQuaternion{value};
+}
+
+inline glm::quat decompress_quaternion(const nier::CompressedQuaternion& compressed) {
+    const auto value = compressed.value();
+    const auto largest = value >> 30;
+
+    float components[4]{};
+    float sum = 0.0f;
+    uint32_t shift = 30;
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        const auto skip = i == largest;
+        shift -= skip ? 0 : 10;
+        const auto bits = (value >> shift) & 0x3FF;
+        const auto component = ((float)bits / QUATERNION_COMPONENT_STEPS * 2.0f - 1.0f) * QUATERNION_COMPONENT_RANGE;
+
+        components[i] = skip ? 0.0f : component;
+        sum += components[i] * components[i];
+    }
+
+    components[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+
+    return glm::normalize(glm::quat{components[3], components[0], components[1], components[2]});
+}
+
+inline nier::QuantizedAngularVelocity quantize_angular_velocity(const Vector3f& velocity) {
+    return nier::QuantizedAngularVelocity{
+        to_short(velocity.x * ANGULAR_VELOCITY_STEPS),
+        to_short(velocity.y * ANGULAR_VELOCITY_STEPS),
+        to_short(velocity.z * ANGULAR_VELOCITY_STEPS)
+    };
+}
+
+inline Vector3f dequantize_angular_velocity(const nier::QuantizedAngularVelocity& velocity) {
+    return Vector3f{(float)velocity.x(), (float)velocity.y(), (float)velocity.z()} / ANGULAR_VELOCITY_STEPS;
+}
+
+inline nier::QuantizedVelocity quantize_velocity(const Vector3f& velocity) {
+    return nier::QuantizedVelocity{
+        to_short(velocity.x * VELOCITY_STEPS),
+        to_short(velocity.y * VELOCITY_STEPS),
+        to_short(velocity.z * VELOCITY_STEPS)
+    };
+}
+
+inline Vector3f dequantize_velocity(const nier::QuantizedVelocity& velocity) {
+    return Vector3f{(float)velocity.x(), (float)velocity.y(), (float)velocity.z()} / VELOCITY_STEPS;
+}
+}
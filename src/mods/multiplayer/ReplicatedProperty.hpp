@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sdk/Pl0000.hpp>
+
+// Fields that rarely change, sent as a bitmask followed by only the values that changed instead of in every update.
+// Updates are unreliable, so a changed value rides along with the next RESEND_COUNT of them, and the owner marks
+// everything dirty now and then so late joiners catch up.
+// Values are written as their little endian bytes, in the order the properties are declared.
+// Must match server/automatamp/core/ReplicatedProperty.go.
+namespace replication {
+constexpr uint8_t RESEND_COUNT = 3;
+
+// One field of Owner, Accessor returns a reference to it.
+template <typename Owner, auto Accessor>
+struct Property {
+    using Value = std::remove_cvref_t<std::invoke_result_t<decltype(Accessor), Owner&>>;
+    static_assert(std::is_trivially_copyable_v<Value>, "properties are sent as their bytes");
+
+    static Value& get(Owner& owner) { return std::invoke(Accessor, owner); }
+};
+
+// The properties of one Owner, bit i of a mask stands for the i-th one.
+template <typename Owner, typename... Properties>
+class PropertySet {
+public:
+    static_assert(sizeof...(Properties) <= 8, "the dirty mask is one byte");
+
+    using Values = std::tuple<typename Properties::Value...>;
+
+    static constexpr size_t COUNT = sizeof...(Properties);
+    static constexpr uint8_t ALL = (uint8_t)((1u << COUNT) - 1);
+
+    static Values gather(Owner& owner) { return Values{Properties::get(owner)...}; }
+
+    // Appends the values in mask.
+    static void write(const Values& values, uint8_t mask, std::vector<uint8_t>& out) {
+        write(values, mask, out, std::index_sequence_for<Properties...>{});
+    }
+
+    // Overwrites the values in mask from data at offset and moves offset past them. False if data is too short.
+    static bool read(const uint8_t* data, size_t size, uint8_t mask, Values& values, size_t& offset) {
+        return read(data, size, mask, values, offset, std::index_sequence_for<Properties...>{});
+    }
+
+    // The mask byte followed by the values in it, see nier::PlayerDataMessage.properties.
+    static void write_message(const Values& values, uint8_t mask, std::vector<uint8_t>& out) {
+        out.push_back(mask);
+        write(values, mask, out);
+    }
+
+    // False if data is malformed or longer than its mask says.
+    static bool read_message(const uint8_t* data, size_t size, Values& values) {
+        if (size == 0 || (data[0] & ~ALL) != 0) {
+            return false;
+        }
+
+        auto read_values = values;
+        size_t offset = 1;
+
+        if (!read(data, size, data[0], read_values, offset) || offset != size) {
+            return false;
+        }
+
+        values = read_values;
+        return true;
+    }
+
+    // Marks the properties that changed since the last call dirty.
+    void update(Owner& owner) {
+        const auto values = gather(owner);
+        update(values, std::index_sequence_for<Properties...>{});
+        m_values = values;
+    }
+
+    void mark_all_dirty() { m_resends.fill(RESEND_COUNT); }
+
+    // The properties to send with this update, each one counts down a resend.
+    uint8_t take_dirty() {
+        uint8_t mask = 0;
+
+        for (size_t i = 0; i < COUNT; ++i) {
+            if (m_resends[i] > 0) {
+                mask |= (uint8_t)(1 << i);
+                --m_resends[i];
+            }
+        }
+
+        return mask;
+    }
+
+    const Values& get_values() const { return m_values; }
+
+private:
+    template <size_t... I>
+    static void write(const Values& values, uint8_t mask, std::vector<uint8_t>& out, std::index_sequence<I...>) {
+        const auto write_one = [&](const auto& value, size_t index) {
+            if (mask & (1 << index)) {
+                const auto bytes = (const uint8_t*)&value;
+                out.insert(out.end(), bytes, bytes + sizeof(value));
+            }
+        };
+
+        (write_one(std::get<I>(values), I), ...);
+    }
+
+    template <size_t... I>
+    static bool read(const uint8_t* data, size_t size, uint8_t mask, Values& values, size_t& offset, std::index_sequence<I...>) {
+        const auto read_one = [&](auto& value, size_t index) {
+            if (!(mask & (1 << index))) {
+                return true;
+            }
+
+            if (offset + sizeof(value) > size) {
+                return false;
+            }
+
+            memcpy(&value, data + offset, sizeof(value));
+            offset += sizeof(value);
+            return true;
+        };
+
+        return (read_one(std::get<I>(values), I) && ...);
+    }
+
+    template <size_t... I>
+    void update(const Values& values, std::index_sequence<I...>) {
+        ((std::get<I>(values) != std::get<I>(m_values) ? (void)(m_resends[I] = RESEND_COUNT) : (void)0), ...);
+    }
+
+    Values m_values{};
+    std::array<uint8_t, COUNT> m_resends{};
+};
+
+// Speed and the facings change with every step, so they stay in every update.
+using PlayerProperties = PropertySet<sdk::Pl0000,
+    Property<sdk::Pl0000, &sdk::Pl0000::flashlight>,
+    Property<sdk::Pl0000, &sdk::Pl0000::weapon_index>,
+    Property<sdk::Pl0000, &sdk::Pl0000::pod_index>,
+    Property<sdk::Pl0000, &sdk::Pl0000::held_flags>>;
+
+using EntityProperties = PropertySet<sdk::BehaviorAppBase,
+    Property<sdk::BehaviorAppBase, &sdk::BehaviorAppBase::health>>;
+}
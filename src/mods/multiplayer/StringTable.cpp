@@ -0,0 +1,47 @@
+#include "StringTable.hpp"
+
+bool StringTable::add(uint32_t id, std::string_view name) {
+    if (id == 0 || id > MAX_STRINGS || name.empty()) {
+        return false;
+    }
+
+    std::scoped_lock _{m_mtx};
+
+    if (id > m_strings.size()) {
+        m_strings.resize(id);
+    }
+
+    auto& entry = m_strings[id - 1];
+
+    if (!entry.empty()) {
+        return entry == name;
+    }
+
+    entry = name;
+    m_ids.emplace(entry, id);
+    return true;
+}
+
+uint32_t StringTable::find(std::string_view name) {
+    std::scoped_lock _{m_mtx};
+
+    const auto it = m_ids.find(name);
+    return it != m_ids.end() ? it->second : 0;
+}
+
+bool StringTable::get(uint32_t id, std::string& out) {
+    std::scoped_lock _{m_mtx};
+
+    if (id == 0 || id > m_strings.size() || m_strings[id - 1].empty()) {
+        return false;
+    }
+
+    out = m_strings[id - 1];
+    return true;
+}
+
+void StringTable::clear() {
+    std::scoped_lock _{m_mtx};
+    m_ids.clear();
+    m_strings.clear();
+}
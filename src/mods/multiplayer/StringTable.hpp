@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// The relay's session table of entity and player names, see nier::StringTable.
+// Names it has are sent both ways as name_id instead of the string, 0 means the name is sent as is.
+// Must match server/automatamp/core/StringTable.go.
+class StringTable {
+public:
+    // Ids past this are never handed out by the relay.
+    static constexpr uint32_t MAX_STRINGS = 4096;
+
+    // False if id is out of range or already names something else.
+    bool add(uint32_t id, std::string_view name);
+    // 0 if the relay hasn't sent name yet. Called from hook threads too.
+    uint32_t find(std::string_view name);
+    // False if the relay never sent id.
+    bool get(uint32_t id, std::string& out);
+    // A new welcome starts a new session.
+    void clear();
+
+private:
+    // Lets find look up a string_view without building a std::string.
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    std::mutex m_mtx{}; // filled on the game thread, entity spawns are sent from hook threads
+    std::unordered_map<std::string, uint32_t, Hash, std::equal_to<>> m_ids{};
+    std::vector<std::string> m_strings{}; // indexed by id - 1, empty for ids not received yet
+};
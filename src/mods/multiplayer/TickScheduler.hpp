@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+// Decides on which game frames a stream of state updates goes out, so it is sent at a fixed rate
+// instead of once per frame whatever the frame rate is.
+// Time is accumulated from a monotonic clock and one tick is taken whenever a whole interval has built up.
+// A hitch would leave a backlog that fires on every following frame, so anything past MAX_CATCH_UP
+// intervals is dropped and counted instead.
+// Ticked on the game thread, the rate and statistics are atomics so the UI can change and read them.
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr float MIN_RATE = 1.0f;
+    static constexpr float MAX_RATE = 144.0f;
+    static constexpr uint32_t MAX_CATCH_UP = 3;
+
+    TickScheduler(float rate) { set_rate(rate); }
+
+    // In ticks per second, clamped to [MIN_RATE, MAX_RATE].
+    void set_rate(float rate) {
+        rate = std::clamp(rate, MIN_RATE, MAX_RATE);
+        m_rate = rate;
+        m_interval_ns = (int64_t)(1'000'000'000.0 / rate);
+    }
+
+    float get_rate() const { return m_rate; }
+
+    // True if the stream is due at now. The first call always is.
+    bool tick(Clock::time_point now) {
+        const auto interval = Clock::duration{std::chrono::nanoseconds{m_interval_ns.load()}};
+
+        if (!m_started) {
+            m_started = true;
+            m_last_update = now;
+            m_last_tick = now;
+            m_accumulator = interval;
+        }
+
+        m_accumulator += now - m_last_update;
+        m_last_update = now;
+
+        if (m_accumulator < interval) {
+            return false;
+        }
+
+        m_accumulator -= interval;
+
+        if (m_accumulator > interval * MAX_CATCH_UP) {
+            m_dropped += m_accumulator - interval * MAX_CATCH_UP;
+            m_accumulator = interval * MAX_CATCH_UP;
+
+            const auto skipped = m_dropped / interval;
+            m_skipped_ticks += (uint64_t)skipped;
+            m_dropped -= interval * skipped;
+        }
+
+        // Smoothed like RFC 3550 interarrival jitter, how far apart ticks actually went out from the interval.
+        if (m_last_tick != now) {
+            const auto deviation_us = std::abs(std::chrono::duration<float, std::micro>{(now - m_last_tick) - interval}.count());
+            m_jitter_us = m_jitter_us + (deviation_us - m_jitter_us) / 16.0f;
+        }
+
+        m_last_tick = now;
+        ++m_tick_count;
+        return true;
+    }
+
+    // A new session starts ticking right away.
+    void reset() {
+        m_started = false;
+        m_dropped = {};
+    }
+
+    float get_jitter_ms() const { return m_jitter_us / 1000.0f; }
+    uint64_t get_tick_count() const { return m_tick_count; }
+    uint64_t get_skipped_ticks() const { return m_skipped_ticks; }
+
+private:
+    std::atomic<float> m_rate{};
+    std::atomic<int64_t> m_interval_ns{};
+
+    Clock::time_point m_last_update{};
+    Clock::time_point m_last_tick{};
+    Clock::duration m_accumulator{};
+    Clock::duration m_dropped{}; // past the catch-up limit, counted as skipped ticks once it adds up to one
+    bool m_started{false};
+
+    std::atomic<float> m_jitter_us{};
+    std::atomic<uint64_t> m_tick_count{};
+    std::atomic<uint64_t> m_skipped_ticks{};
+};
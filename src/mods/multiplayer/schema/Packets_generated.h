@@ -12,6 +12,16 @@ struct Vector3f;
 
 struct Vector4f;
 
+struct QuantizedVector3;
+
+struct Sector;
+
+struct CompressedQuaternion;
+
+struct QuantizedAngularVelocity;
+
+struct QuantizedVelocity;
+
 struct Packet;
 struct PacketBuilder;
 
@@ -33,6 +43,8 @@ struct EntityData;
 
 struct PlayerData;
 
+struct QuantizedPlayerData;
+
 struct AnimationStart;
 
 struct Buttons;
@@ -48,13 +60,41 @@ struct SetMasterClient;
 struct CreatePlayer;
 struct CreatePlayerBuilder;
 
+struct PlayerDataMessage;
+struct PlayerDataMessageBuilder;
+
+struct PlayerDataAck;
+struct PlayerDataAckBuilder;
+
+struct StringTable;
+struct StringTableBuilder;
+
+struct AnimationStartMessage;
+struct AnimationStartMessageBuilder;
+
+struct EntityDataMessage;
+struct EntityDataMessageBuilder;
+
+struct EntitySnapshot;
+struct EntitySnapshotBuilder;
+
+struct PacketBatchEntry;
+struct PacketBatchEntryBuilder;
+
+struct PacketV2;
+struct PacketV2Builder;
+
+struct PacketBatch;
+struct PacketBatchBuilder;
+
 enum PacketType : uint32_t {
   PacketType_ID_MASTER_CLIENT_START = 0,
   PacketType_ID_SPAWN_ENTITY = 1,
   PacketType_ID_DESTROY_ENTITY = 2,
   PacketType_ID_ENTITY_DATA = 3,
   PacketType_ID_ENTITY_ANIMATION_START = 4,
-  PacketType_ID_MASTER_CLIENT_END = 5,
+  PacketType_ID_ENTITY_SNAPSHOT = 5,
+  PacketType_ID_MASTER_CLIENT_END = 6,
   PacketType_ID_SERVER_START = 2048,
   PacketType_ID_CREATE_PLAYER = 2049,
   PacketType_ID_DESTROY_PLAYER = 2050,
@@ -70,17 +110,21 @@ enum PacketType : uint32_t {
   PacketType_ID_PONG = 32769,
   PacketType_ID_HELLO = 32770,
   PacketType_ID_WELCOME = 32771,
+  PacketType_ID_PACKET_BATCH = 32772,
+  PacketType_ID_PLAYER_DATA_ACK = 32773,
+  PacketType_ID_STRING_TABLE = 32774,
   PacketType_MIN = PacketType_ID_MASTER_CLIENT_START,
-  PacketType_MAX = PacketType_ID_WELCOME
+  PacketType_MAX = PacketType_ID_STRING_TABLE
 };
 
-inline const PacketType (&EnumValuesPacketType())[21] {
+inline const PacketType (&EnumValuesPacketType())[25] {
   static const PacketType values[] = {
     PacketType_ID_MASTER_CLIENT_START,
     PacketType_ID_SPAWN_ENTITY,
     PacketType_ID_DESTROY_ENTITY,
     PacketType_ID_ENTITY_DATA,
     PacketType_ID_ENTITY_ANIMATION_START,
+    PacketType_ID_ENTITY_SNAPSHOT,
     PacketType_ID_MASTER_CLIENT_END,
     PacketType_ID_SERVER_START,
     PacketType_ID_CREATE_PLAYER,
@@ -96,7 +140,10 @@ inline const PacketType (&EnumValuesPacketType())[21] {
     PacketType_ID_PING,
     PacketType_ID_PONG,
     PacketType_ID_HELLO,
-    PacketType_ID_WELCOME
+    PacketType_ID_WELCOME,
+    PacketType_ID_PACKET_BATCH,
+    PacketType_ID_PLAYER_DATA_ACK,
+    PacketType_ID_STRING_TABLE
   };
   return values;
 }
@@ -108,6 +155,7 @@ inline const char *EnumNamePacketType(PacketType e) {
     case PacketType_ID_DESTROY_ENTITY: return "ID_DESTROY_ENTITY";
     case PacketType_ID_ENTITY_DATA: return "ID_ENTITY_DATA";
     case PacketType_ID_ENTITY_ANIMATION_START: return "ID_ENTITY_ANIMATION_START";
+    case PacketType_ID_ENTITY_SNAPSHOT: return "ID_ENTITY_SNAPSHOT";
     case PacketType_ID_MASTER_CLIENT_END: return "ID_MASTER_CLIENT_END";
     case PacketType_ID_SERVER_START: return "ID_SERVER_START";
     case PacketType_ID_CREATE_PLAYER: return "ID_CREATE_PLAYER";
@@ -124,6 +172,9 @@ inline const char *EnumNamePacketType(PacketType e) {
     case PacketType_ID_PONG: return "ID_PONG";
     case PacketType_ID_HELLO: return "ID_HELLO";
     case PacketType_ID_WELCOME: return "ID_WELCOME";
+    case PacketType_ID_PACKET_BATCH: return "ID_PACKET_BATCH";
+    case PacketType_ID_PLAYER_DATA_ACK: return "ID_PLAYER_DATA_ACK";
+    case PacketType_ID_STRING_TABLE: return "ID_STRING_TABLE";
     default: return "";
   }
 }
@@ -209,6 +260,36 @@ inline const char *EnumNameVersionPatch(VersionPatch e) {
   return EnumNamesVersionPatch()[index];
 }
 
+enum ProtocolVersion : uint32_t {
+  ProtocolVersion_V1 = 1,
+  ProtocolVersion_V2 = 2,
+  ProtocolVersion_MIN = ProtocolVersion_V1,
+  ProtocolVersion_MAX = ProtocolVersion_V2
+};
+
+inline const ProtocolVersion (&EnumValuesProtocolVersion())[2] {
+  static const ProtocolVersion values[] = {
+    ProtocolVersion_V1,
+    ProtocolVersion_V2
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesProtocolVersion() {
+  static const char * const names[3] = {
+    "V1",
+    "V2",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameProtocolVersion(ProtocolVersion e) {
+  if (flatbuffers::IsOutRange(e, ProtocolVersion_V1, ProtocolVersion_V2)) return "";
+  const size_t index = static_cast<size_t>(e) - static_cast<size_t>(ProtocolVersion_V1);
+  return EnumNamesProtocolVersion()[index];
+}
+
 enum ModelType : uint32_t {
   ModelType_MODEL_2B = 65536,
   ModelType_MODEL_A2 = 65792,
@@ -235,6 +316,124 @@ inline const char *EnumNameModelType(ModelType e) {
   }
 }
 
+enum Message : uint8_t {
+  Message_NONE = 0,
+  Message_Hello = 1,
+  Message_Welcome = 2,
+  Message_CreatePlayer = 3,
+  Message_EntitySpawnParams = 4,
+  Message_EntityDataMessage = 5,
+  Message_AnimationStartMessage = 6,
+  Message_PlayerDataMessage = 7,
+  Message_Buttons = 8,
+  Message_PacketBatch = 9,
+  Message_EntitySnapshot = 10,
+  Message_PlayerDataAck = 11,
+  Message_StringTable = 12,
+  Message_MIN = Message_NONE,
+  Message_MAX = Message_StringTable
+};
+
+inline const Message (&EnumValuesMessage())[13] {
+  static const Message values[] = {
+    Message_NONE,
+    Message_Hello,
+    Message_Welcome,
+    Message_CreatePlayer,
+    Message_EntitySpawnParams,
+    Message_EntityDataMessage,
+    Message_AnimationStartMessage,
+    Message_PlayerDataMessage,
+    Message_Buttons,
+    Message_PacketBatch,
+    Message_EntitySnapshot,
+    Message_PlayerDataAck,
+    Message_StringTable
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesMessage() {
+  static const char * const names[14] = {
+    "NONE",
+    "Hello",
+    "Welcome",
+    "CreatePlayer",
+    "EntitySpawnParams",
+    "EntityDataMessage",
+    "AnimationStartMessage",
+    "PlayerDataMessage",
+    "Buttons",
+    "PacketBatch",
+    "EntitySnapshot",
+    "PlayerDataAck",
+    "StringTable",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameMessage(Message e) {
+  if (flatbuffers::IsOutRange(e, Message_NONE, Message_StringTable)) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesMessage()[index];
+}
+
+template<typename T> struct MessageTraits {
+  static const Message enum_value = Message_NONE;
+};
+
+template<> struct MessageTraits<nier::Hello> {
+  static const Message enum_value = Message_Hello;
+};
+
+template<> struct MessageTraits<nier::Welcome> {
+  static const Message enum_value = Message_Welcome;
+};
+
+template<> struct MessageTraits<nier::CreatePlayer> {
+  static const Message enum_value = Message_CreatePlayer;
+};
+
+template<> struct MessageTraits<nier::EntitySpawnParams> {
+  static const Message enum_value = Message_EntitySpawnParams;
+};
+
+template<> struct MessageTraits<nier::EntityDataMessage> {
+  static const Message enum_value = Message_EntityDataMessage;
+};
+
+template<> struct MessageTraits<nier::AnimationStartMessage> {
+  static const Message enum_value = Message_AnimationStartMessage;
+};
+
+template<> struct MessageTraits<nier::PlayerDataMessage> {
+  static const Message enum_value = Message_PlayerDataMessage;
+};
+
+template<> struct MessageTraits<nier::Buttons> {
+  static const Message enum_value = Message_Buttons;
+};
+
+template<> struct MessageTraits<nier::PacketBatch> {
+  static const Message enum_value = Message_PacketBatch;
+};
+
+template<> struct MessageTraits<nier::EntitySnapshot> {
+  static const Message enum_value = Message_EntitySnapshot;
+};
+
+template<> struct MessageTraits<nier::PlayerDataAck> {
+  static const Message enum_value = Message_PlayerDataAck;
+};
+
+template<> struct MessageTraits<nier::StringTable> {
+  static const Message enum_value = Message_StringTable;
+};
+
+bool VerifyMessage(flatbuffers::Verifier &verifier, const void *obj, Message type);
+bool VerifyMessageVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types);
+
 FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) Vector3f FLATBUFFERS_FINAL_CLASS {
  private:
   float x_;
@@ -299,6 +498,139 @@ FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) Vector4f FLATBUFFERS_FINAL_CLASS {
 };
 FLATBUFFERS_STRUCT_END(Vector4f, 16);
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) QuantizedVector3 FLATBUFFERS_FINAL_CLASS {
+ private:
+  int16_t x_;
+  int16_t y_;
+  int16_t z_;
+
+ public:
+  QuantizedVector3()
+      : x_(0),
+        y_(0),
+        z_(0) {
+  }
+  QuantizedVector3(int16_t _x, int16_t _y, int16_t _z)
+      : x_(flatbuffers::EndianScalar(_x)),
+        y_(flatbuffers::EndianScalar(_y)),
+        z_(flatbuffers::EndianScalar(_z)) {
+  }
+  int16_t x() const {
+    return flatbuffers::EndianScalar(x_);
+  }
+  int16_t y() const {
+    return flatbuffers::EndianScalar(y_);
+  }
+  int16_t z() const {
+    return flatbuffers::EndianScalar(z_);
+  }
+};
+FLATBUFFERS_STRUCT_END(QuantizedVector3, 6);
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) Sector FLATBUFFERS_FINAL_CLASS {
+ private:
+  int16_t x_;
+  int16_t y_;
+  int16_t z_;
+
+ public:
+  Sector()
+      : x_(0),
+        y_(0),
+        z_(0) {
+  }
+  Sector(int16_t _x, int16_t _y, int16_t _z)
+      : x_(flatbuffers::EndianScalar(_x)),
+        y_(flatbuffers::EndianScalar(_y)),
+        z_(flatbuffers::EndianScalar(_z)) {
+  }
+  int16_t x() const {
+    return flatbuffers::EndianScalar(x_);
+  }
+  int16_t y() const {
+    return flatbuffers::EndianScalar(y_);
+  }
+  int16_t z() const {
+    return flatbuffers::EndianScalar(z_);
+  }
+};
+FLATBUFFERS_STRUCT_END(Sector, 6);
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) CompressedQuaternion FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint32_t value_;
+
+ public:
+  CompressedQuaternion()
+      : value_(0) {
+  }
+  CompressedQuaternion(uint32_t _value)
+      : value_(flatbuffers::EndianScalar(_value)) {
+  }
+  uint32_t value() const {
+    return flatbuffers::EndianScalar(value_);
+  }
+};
+FLATBUFFERS_STRUCT_END(CompressedQuaternion, 4);
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) QuantizedAngularVelocity FLATBUFFERS_FINAL_CLASS {
+ private:
+  int16_t x_;
+  int16_t y_;
+  int16_t z_;
+
+ public:
+  QuantizedAngularVelocity()
+      : x_(0),
+        y_(0),
+        z_(0) {
+  }
+  QuantizedAngularVelocity(int16_t _x, int16_t _y, int16_t _z)
+      : x_(flatbuffers::EndianScalar(_x)),
+        y_(flatbuffers::EndianScalar(_y)),
+        z_(flatbuffers::EndianScalar(_z)) {
+  }
+  int16_t x() const {
+    return flatbuffers::EndianScalar(x_);
+  }
+  int16_t y() const {
+    return flatbuffers::EndianScalar(y_);
+  }
+  int16_t z() const {
+    return flatbuffers::EndianScalar(z_);
+  }
+};
+FLATBUFFERS_STRUCT_END(QuantizedAngularVelocity, 6);
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) QuantizedVelocity FLATBUFFERS_FINAL_CLASS {
+ private:
+  int16_t x_;
+  int16_t y_;
+  int16_t z_;
+
+ public:
+  QuantizedVelocity()
+      : x_(0),
+        y_(0),
+        z_(0) {
+  }
+  QuantizedVelocity(int16_t _x, int16_t _y, int16_t _z)
+      : x_(flatbuffers::EndianScalar(_x)),
+        y_(flatbuffers::EndianScalar(_y)),
+        z_(flatbuffers::EndianScalar(_z)) {
+  }
+  int16_t x() const {
+    return flatbuffers::EndianScalar(x_);
+  }
+  int16_t y() const {
+    return flatbuffers::EndianScalar(y_);
+  }
+  int16_t z() const {
+    return flatbuffers::EndianScalar(z_);
+  }
+};
+FLATBUFFERS_STRUCT_END(QuantizedVelocity, 6);
+
 FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) EntitySpawnPositionalData FLATBUFFERS_FINAL_CLASS {
  private:
   nier::Vector4f forward_;
@@ -503,6 +835,76 @@ FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) PlayerData FLATBUFFERS_FINAL_CLASS {
 };
 FLATBUFFERS_STRUCT_END(PlayerData, 40);
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) QuantizedPlayerData FLATBUFFERS_FINAL_CLASS {
+ private:
+  nier::QuantizedVector3 position_;
+  uint16_t facing_;
+  uint16_t facing2_;
+  uint8_t sector_id_;
+  uint8_t flashlight_;
+  uint8_t weapon_index_;
+  uint8_t pod_index_;
+  int16_t padding0__;
+  float speed_;
+  uint32_t held_button_flags_;
+
+ public:
+  QuantizedPlayerData()
+      : position_(),
+        facing_(0),
+        facing2_(0),
+        sector_id_(0),
+        flashlight_(0),
+        weapon_index_(0),
+        pod_index_(0),
+        padding0__(0),
+        speed_(0),
+        held_button_flags_(0) {
+    (void)padding0__;
+  }
+  QuantizedPlayerData(const nier::QuantizedVector3 &_position, uint16_t _facing, uint16_t _facing2, uint8_t _sector_id, bool _flashlight, uint8_t _weapon_index, uint8_t _pod_index, float _speed, uint32_t _held_button_flags)
+      : position_(_position),
+        facing_(flatbuffers::EndianScalar(_facing)),
+        facing2_(flatbuffers::EndianScalar(_facing2)),
+        sector_id_(flatbuffers::EndianScalar(_sector_id)),
+        flashlight_(flatbuffers::EndianScalar(static_cast<uint8_t>(_flashlight))),
+        weapon_index_(flatbuffers::EndianScalar(_weapon_index)),
+        pod_index_(flatbuffers::EndianScalar(_pod_index)),
+        padding0__(0),
+        speed_(flatbuffers::EndianScalar(_speed)),
+        held_button_flags_(flatbuffers::EndianScalar(_held_button_flags)) {
+    (void)padding0__;
+  }
+  const nier::QuantizedVector3 &position() const {
+    return position_;
+  }
+  uint16_t facing() const {
+    return flatbuffers::EndianScalar(facing_);
+  }
+  uint16_t facing2() const {
+    return flatbuffers::EndianScalar(facing2_);
+  }
+  uint8_t sector_id() const {
+    return flatbuffers::EndianScalar(sector_id_);
+  }
+  bool flashlight() const {
+    return flatbuffers::EndianScalar(flashlight_) != 0;
+  }
+  uint8_t weapon_index() const {
+    return flatbuffers::EndianScalar(weapon_index_);
+  }
+  uint8_t pod_index() const {
+    return flatbuffers::EndianScalar(pod_index_);
+  }
+  float speed() const {
+    return flatbuffers::EndianScalar(speed_);
+  }
+  uint32_t held_button_flags() const {
+    return flatbuffers::EndianScalar(held_button_flags_);
+  }
+};
+FLATBUFFERS_STRUCT_END(QuantizedPlayerData, 24);
+
 FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) AnimationStart FLATBUFFERS_FINAL_CLASS {
  private:
   uint32_t anim_;
@@ -655,7 +1057,12 @@ struct Hello FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_PATCH = 8,
     VT_NAME = 10,
     VT_PASSWORD = 12,
-    VT_MODEL = 14
+    VT_MODEL = 14,
+    VT_PROTOCOL = 16,
+    VT_QUANTIZED_POSITIONS = 18,
+    VT_DELTA_PLAYER_DATA = 20,
+    VT_REPLICATED_PROPERTIES = 22,
+    VT_STRING_TABLE = 24
   };
   uint32_t major() const {
     return GetField<uint32_t>(VT_MAJOR, 0);
@@ -675,6 +1082,21 @@ struct Hello FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   uint32_t model() const {
     return GetField<uint32_t>(VT_MODEL, 0);
   }
+  nier::ProtocolVersion protocol() const {
+    return static_cast<nier::ProtocolVersion>(GetField<uint32_t>(VT_PROTOCOL, 1));
+  }
+  bool quantized_positions() const {
+    return GetField<uint8_t>(VT_QUANTIZED_POSITIONS, 0) != 0;
+  }
+  bool delta_player_data() const {
+    return GetField<uint8_t>(VT_DELTA_PLAYER_DATA, 0) != 0;
+  }
+  bool replicated_properties() const {
+    return GetField<uint8_t>(VT_REPLICATED_PROPERTIES, 0) != 0;
+  }
+  bool string_table() const {
+    return GetField<uint8_t>(VT_STRING_TABLE, 0) != 0;
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint32_t>(verifier, VT_MAJOR) &&
@@ -685,6 +1107,11 @@ struct Hello FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_PASSWORD) &&
            verifier.VerifyString(password()) &&
            VerifyField<uint32_t>(verifier, VT_MODEL) &&
+           VerifyField<uint32_t>(verifier, VT_PROTOCOL) &&
+           VerifyField<uint8_t>(verifier, VT_QUANTIZED_POSITIONS) &&
+           VerifyField<uint8_t>(verifier, VT_DELTA_PLAYER_DATA) &&
+           VerifyField<uint8_t>(verifier, VT_REPLICATED_PROPERTIES) &&
+           VerifyField<uint8_t>(verifier, VT_STRING_TABLE) &&
            verifier.EndTable();
   }
 };
@@ -711,6 +1138,21 @@ struct HelloBuilder {
   void add_model(uint32_t model) {
     fbb_.AddElement<uint32_t>(Hello::VT_MODEL, model, 0);
   }
+  void add_protocol(nier::ProtocolVersion protocol) {
+    fbb_.AddElement<uint32_t>(Hello::VT_PROTOCOL, static_cast<uint32_t>(protocol), 1);
+  }
+  void add_quantized_positions(bool quantized_positions) {
+    fbb_.AddElement<uint8_t>(Hello::VT_QUANTIZED_POSITIONS, static_cast<uint8_t>(quantized_positions), 0);
+  }
+  void add_delta_player_data(bool delta_player_data) {
+    fbb_.AddElement<uint8_t>(Hello::VT_DELTA_PLAYER_DATA, static_cast<uint8_t>(delta_player_data), 0);
+  }
+  void add_replicated_properties(bool replicated_properties) {
+    fbb_.AddElement<uint8_t>(Hello::VT_REPLICATED_PROPERTIES, static_cast<uint8_t>(replicated_properties), 0);
+  }
+  void add_string_table(bool string_table) {
+    fbb_.AddElement<uint8_t>(Hello::VT_STRING_TABLE, static_cast<uint8_t>(string_table), 0);
+  }
   explicit HelloBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -729,14 +1171,24 @@ inline flatbuffers::Offset<Hello> CreateHello(
     uint32_t patch = 0,
     flatbuffers::Offset<flatbuffers::String> name = 0,
     flatbuffers::Offset<flatbuffers::String> password = 0,
-    uint32_t model = 0) {
+    uint32_t model = 0,
+    nier::ProtocolVersion protocol = nier::ProtocolVersion_V1,
+    bool quantized_positions = false,
+    bool delta_player_data = false,
+    bool replicated_properties = false,
+    bool string_table = false) {
   HelloBuilder builder_(_fbb);
+  builder_.add_protocol(protocol);
   builder_.add_model(model);
   builder_.add_password(password);
   builder_.add_name(name);
   builder_.add_patch(patch);
   builder_.add_minor(minor);
   builder_.add_major(major);
+  builder_.add_string_table(string_table);
+  builder_.add_replicated_properties(replicated_properties);
+  builder_.add_delta_player_data(delta_player_data);
+  builder_.add_quantized_positions(quantized_positions);
   return builder_.Finish();
 }
 
@@ -747,7 +1199,12 @@ inline flatbuffers::Offset<Hello> CreateHelloDirect(
     uint32_t patch = 0,
     const char *name = nullptr,
     const char *password = nullptr,
-    uint32_t model = 0) {
+    uint32_t model = 0,
+    nier::ProtocolVersion protocol = nier::ProtocolVersion_V1,
+    bool quantized_positions = false,
+    bool delta_player_data = false,
+    bool replicated_properties = false,
+    bool string_table = false) {
   auto name__ = name ? _fbb.CreateString(name) : 0;
   auto password__ = password ? _fbb.CreateString(password) : 0;
   return nier::CreateHello(
@@ -757,7 +1214,12 @@ inline flatbuffers::Offset<Hello> CreateHelloDirect(
       patch,
       name__,
       password__,
-      model);
+      model,
+      protocol,
+      quantized_positions,
+      delta_player_data,
+      replicated_properties,
+      string_table);
 }
 
 struct Welcome FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -765,7 +1227,12 @@ struct Welcome FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_GUID = 4,
     VT_ISMASTERCLIENT = 6,
-    VT_HIGHESTENTITYGUID = 8
+    VT_HIGHESTENTITYGUID = 8,
+    VT_PROTOCOL = 10,
+    VT_POSITION_PRECISION = 12,
+    VT_DELTA_PLAYER_DATA = 14,
+    VT_REPLICATED_PROPERTIES = 16,
+    VT_STRING_TABLE = 18
   };
   uint64_t guid() const {
     return GetField<uint64_t>(VT_GUID, 0);
@@ -776,11 +1243,31 @@ struct Welcome FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   uint32_t highestEntityGuid() const {
     return GetField<uint32_t>(VT_HIGHESTENTITYGUID, 0);
   }
+  nier::ProtocolVersion protocol() const {
+    return static_cast<nier::ProtocolVersion>(GetField<uint32_t>(VT_PROTOCOL, 1));
+  }
+  float position_precision() const {
+    return GetField<float>(VT_POSITION_PRECISION, 0.0f);
+  }
+  bool delta_player_data() const {
+    return GetField<uint8_t>(VT_DELTA_PLAYER_DATA, 0) != 0;
+  }
+  bool replicated_properties() const {
+    return GetField<uint8_t>(VT_REPLICATED_PROPERTIES, 0) != 0;
+  }
+  bool string_table() const {
+    return GetField<uint8_t>(VT_STRING_TABLE, 0) != 0;
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint64_t>(verifier, VT_GUID) &&
            VerifyField<uint8_t>(verifier, VT_ISMASTERCLIENT) &&
            VerifyField<uint32_t>(verifier, VT_HIGHESTENTITYGUID) &&
+           VerifyField<uint32_t>(verifier, VT_PROTOCOL) &&
+           VerifyField<float>(verifier, VT_POSITION_PRECISION) &&
+           VerifyField<uint8_t>(verifier, VT_DELTA_PLAYER_DATA) &&
+           VerifyField<uint8_t>(verifier, VT_REPLICATED_PROPERTIES) &&
+           VerifyField<uint8_t>(verifier, VT_STRING_TABLE) &&
            verifier.EndTable();
   }
 };
@@ -798,6 +1285,21 @@ struct WelcomeBuilder {
   void add_highestEntityGuid(uint32_t highestEntityGuid) {
     fbb_.AddElement<uint32_t>(Welcome::VT_HIGHESTENTITYGUID, highestEntityGuid, 0);
   }
+  void add_protocol(nier::ProtocolVersion protocol) {
+    fbb_.AddElement<uint32_t>(Welcome::VT_PROTOCOL, static_cast<uint32_t>(protocol), 1);
+  }
+  void add_position_precision(float position_precision) {
+    fbb_.AddElement<float>(Welcome::VT_POSITION_PRECISION, position_precision, 0.0f);
+  }
+  void add_delta_player_data(bool delta_player_data) {
+    fbb_.AddElement<uint8_t>(Welcome::VT_DELTA_PLAYER_DATA, static_cast<uint8_t>(delta_player_data), 0);
+  }
+  void add_replicated_properties(bool replicated_properties) {
+    fbb_.AddElement<uint8_t>(Welcome::VT_REPLICATED_PROPERTIES, static_cast<uint8_t>(replicated_properties), 0);
+  }
+  void add_string_table(bool string_table) {
+    fbb_.AddElement<uint8_t>(Welcome::VT_STRING_TABLE, static_cast<uint8_t>(string_table), 0);
+  }
   explicit WelcomeBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -813,10 +1315,20 @@ inline flatbuffers::Offset<Welcome> CreateWelcome(
     flatbuffers::FlatBufferBuilder &_fbb,
     uint64_t guid = 0,
     bool isMasterClient = false,
-    uint32_t highestEntityGuid = 0) {
+    uint32_t highestEntityGuid = 0,
+    nier::ProtocolVersion protocol = nier::ProtocolVersion_V1,
+    float position_precision = 0.0f,
+    bool delta_player_data = false,
+    bool replicated_properties = false,
+    bool string_table = false) {
   WelcomeBuilder builder_(_fbb);
   builder_.add_guid(guid);
+  builder_.add_position_precision(position_precision);
+  builder_.add_protocol(protocol);
   builder_.add_highestEntityGuid(highestEntityGuid);
+  builder_.add_string_table(string_table);
+  builder_.add_replicated_properties(replicated_properties);
+  builder_.add_delta_player_data(delta_player_data);
   builder_.add_isMasterClient(isMasterClient);
   return builder_.Finish();
 }
@@ -890,7 +1402,8 @@ struct EntitySpawnParams FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_NAME = 4,
     VT_MODEL = 6,
     VT_MODEL2 = 8,
-    VT_POSITIONAL = 10
+    VT_POSITIONAL = 10,
+    VT_NAME_ID = 12
   };
   const flatbuffers::String *name() const {
     return GetPointer<const flatbuffers::String *>(VT_NAME);
@@ -904,6 +1417,9 @@ struct EntitySpawnParams FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const nier::EntitySpawnPositionalData *positional() const {
     return GetStruct<const nier::EntitySpawnPositionalData *>(VT_POSITIONAL);
   }
+  uint32_t name_id() const {
+    return GetField<uint32_t>(VT_NAME_ID, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_NAME) &&
@@ -911,6 +1427,7 @@ struct EntitySpawnParams FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<uint32_t>(verifier, VT_MODEL) &&
            VerifyField<uint32_t>(verifier, VT_MODEL2) &&
            VerifyField<nier::EntitySpawnPositionalData>(verifier, VT_POSITIONAL) &&
+           VerifyField<uint32_t>(verifier, VT_NAME_ID) &&
            verifier.EndTable();
   }
 };
@@ -931,6 +1448,9 @@ struct EntitySpawnParamsBuilder {
   void add_positional(const nier::EntitySpawnPositionalData *positional) {
     fbb_.AddStruct(EntitySpawnParams::VT_POSITIONAL, positional);
   }
+  void add_name_id(uint32_t name_id) {
+    fbb_.AddElement<uint32_t>(EntitySpawnParams::VT_NAME_ID, name_id, 0);
+  }
   explicit EntitySpawnParamsBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -947,8 +1467,10 @@ inline flatbuffers::Offset<EntitySpawnParams> CreateEntitySpawnParams(
     flatbuffers::Offset<flatbuffers::String> name = 0,
     uint32_t model = 0,
     uint32_t model2 = 0,
-    const nier::EntitySpawnPositionalData *positional = 0) {
+    const nier::EntitySpawnPositionalData *positional = 0,
+    uint32_t name_id = 0) {
   EntitySpawnParamsBuilder builder_(_fbb);
+  builder_.add_name_id(name_id);
   builder_.add_positional(positional);
   builder_.add_model2(model2);
   builder_.add_model(model);
@@ -961,14 +1483,16 @@ inline flatbuffers::Offset<EntitySpawnParams> CreateEntitySpawnParamsDirect(
     const char *name = nullptr,
     uint32_t model = 0,
     uint32_t model2 = 0,
-    const nier::EntitySpawnPositionalData *positional = 0) {
+    const nier::EntitySpawnPositionalData *positional = 0,
+    uint32_t name_id = 0) {
   auto name__ = name ? _fbb.CreateString(name) : 0;
   return nier::CreateEntitySpawnParams(
       _fbb,
       name__,
       model,
       model2,
-      positional);
+      positional,
+      name_id);
 }
 
 struct Buttons FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -1090,7 +1614,9 @@ struct CreatePlayer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_GUID = 4,
     VT_NAME = 6,
-    VT_MODEL = 8
+    VT_MODEL = 8,
+    VT_NAME_ID = 10,
+    VT_SLOT = 12
   };
   uint64_t guid() const {
     return GetField<uint64_t>(VT_GUID, 0);
@@ -1101,12 +1627,20 @@ struct CreatePlayer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   uint32_t model() const {
     return GetField<uint32_t>(VT_MODEL, 0);
   }
+  uint32_t name_id() const {
+    return GetField<uint32_t>(VT_NAME_ID, 0);
+  }
+  uint8_t slot() const {
+    return GetField<uint8_t>(VT_SLOT, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint64_t>(verifier, VT_GUID) &&
            VerifyOffset(verifier, VT_NAME) &&
            verifier.VerifyString(name()) &&
            VerifyField<uint32_t>(verifier, VT_MODEL) &&
+           VerifyField<uint32_t>(verifier, VT_NAME_ID) &&
+           VerifyField<uint8_t>(verifier, VT_SLOT) &&
            verifier.EndTable();
   }
 };
@@ -1124,6 +1658,12 @@ struct CreatePlayerBuilder {
   void add_model(uint32_t model) {
     fbb_.AddElement<uint32_t>(CreatePlayer::VT_MODEL, model, 0);
   }
+  void add_name_id(uint32_t name_id) {
+    fbb_.AddElement<uint32_t>(CreatePlayer::VT_NAME_ID, name_id, 0);
+  }
+  void add_slot(uint8_t slot) {
+    fbb_.AddElement<uint8_t>(CreatePlayer::VT_SLOT, slot, 0);
+  }
   explicit CreatePlayerBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1139,11 +1679,15 @@ inline flatbuffers::Offset<CreatePlayer> CreateCreatePlayer(
     flatbuffers::FlatBufferBuilder &_fbb,
     uint64_t guid = 0,
     flatbuffers::Offset<flatbuffers::String> name = 0,
-    uint32_t model = 0) {
+    uint32_t model = 0,
+    uint32_t name_id = 0,
+    uint8_t slot = 0) {
   CreatePlayerBuilder builder_(_fbb);
   builder_.add_guid(guid);
+  builder_.add_name_id(name_id);
   builder_.add_model(model);
   builder_.add_name(name);
+  builder_.add_slot(slot);
   return builder_.Finish();
 }
 
@@ -1151,13 +1695,968 @@ inline flatbuffers::Offset<CreatePlayer> CreateCreatePlayerDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     uint64_t guid = 0,
     const char *name = nullptr,
-    uint32_t model = 0) {
+    uint32_t model = 0,
+    uint32_t name_id = 0,
+    uint8_t slot = 0) {
   auto name__ = name ? _fbb.CreateString(name) : 0;
   return nier::CreateCreatePlayer(
       _fbb,
       guid,
       name__,
-      model);
+      model,
+      name_id,
+      slot);
+}
+
+struct PlayerDataMessage FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PlayerDataMessageBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_DATA = 4,
+    VT_QUANTIZED = 6,
+    VT_SECTOR = 8,
+    VT_ORIENTATION = 10,
+    VT_ANGULAR_VELOCITY = 12,
+    VT_SEQUENCE = 14,
+    VT_BASELINE = 16,
+    VT_DELTA = 18,
+    VT_PROPERTIES = 20
+  };
+  const nier::PlayerData *data() const {
+    return GetStruct<const nier::PlayerData *>(VT_DATA);
+  }
+  const nier::QuantizedPlayerData *quantized() const {
+    return GetStruct<const nier::QuantizedPlayerData *>(VT_QUANTIZED);
+  }
+  const nier::Sector *sector() const {
+    return GetStruct<const nier::Sector *>(VT_SECTOR);
+  }
+  const nier::CompressedQuaternion *orientation() const {
+    return GetStruct<const nier::CompressedQuaternion *>(VT_ORIENTATION);
+  }
+  const nier::QuantizedAngularVelocity *angular_velocity() const {
+    return GetStruct<const nier::QuantizedAngularVelocity *>(VT_ANGULAR_VELOCITY);
+  }
+  uint16_t sequence() const {
+    return GetField<uint16_t>(VT_SEQUENCE, 0);
+  }
+  uint16_t baseline() const {
+    return GetField<uint16_t>(VT_BASELINE, 0);
+  }
+  const flatbuffers::Vector<uint8_t> *delta() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_DELTA);
+  }
+  const flatbuffers::Vector<uint8_t> *properties() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PROPERTIES);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<nier::PlayerData>(verifier, VT_DATA) &&
+           VerifyField<nier::QuantizedPlayerData>(verifier, VT_QUANTIZED) &&
+           VerifyField<nier::Sector>(verifier, VT_SECTOR) &&
+           VerifyField<nier::CompressedQuaternion>(verifier, VT_ORIENTATION) &&
+           VerifyField<nier::QuantizedAngularVelocity>(verifier, VT_ANGULAR_VELOCITY) &&
+           VerifyField<uint16_t>(verifier, VT_SEQUENCE) &&
+           VerifyField<uint16_t>(verifier, VT_BASELINE) &&
+           VerifyOffset(verifier, VT_DELTA) &&
+           verifier.VerifyVector(delta()) &&
+           VerifyOffset(verifier, VT_PROPERTIES) &&
+           verifier.VerifyVector(properties()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PlayerDataMessageBuilder {
+  typedef PlayerDataMessage Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_data(const nier::PlayerData *data) {
+    fbb_.AddStruct(PlayerDataMessage::VT_DATA, data);
+  }
+  void add_quantized(const nier::QuantizedPlayerData *quantized) {
+    fbb_.AddStruct(PlayerDataMessage::VT_QUANTIZED, quantized);
+  }
+  void add_sector(const nier::Sector *sector) {
+    fbb_.AddStruct(PlayerDataMessage::VT_SECTOR, sector);
+  }
+  void add_orientation(const nier::CompressedQuaternion *orientation) {
+    fbb_.AddStruct(PlayerDataMessage::VT_ORIENTATION, orientation);
+  }
+  void add_angular_velocity(const nier::QuantizedAngularVelocity *angular_velocity) {
+    fbb_.AddStruct(PlayerDataMessage::VT_ANGULAR_VELOCITY, angular_velocity);
+  }
+  void add_sequence(uint16_t sequence) {
+    fbb_.AddElement<uint16_t>(PlayerDataMessage::VT_SEQUENCE, sequence, 0);
+  }
+  void add_baseline(uint16_t baseline) {
+    fbb_.AddElement<uint16_t>(PlayerDataMessage::VT_BASELINE, baseline, 0);
+  }
+  void add_delta(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> delta) {
+    fbb_.AddOffset(PlayerDataMessage::VT_DELTA, delta);
+  }
+  void add_properties(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> properties) {
+    fbb_.AddOffset(PlayerDataMessage::VT_PROPERTIES, properties);
+  }
+  explicit PlayerDataMessageBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<PlayerDataMessage> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PlayerDataMessage>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PlayerDataMessage> CreatePlayerDataMessage(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const nier::PlayerData *data = 0,
+    const nier::QuantizedPlayerData *quantized = 0,
+    const nier::Sector *sector = 0,
+    const nier::CompressedQuaternion *orientation = 0,
+    const nier::QuantizedAngularVelocity *angular_velocity = 0,
+    uint16_t sequence = 0,
+    uint16_t baseline = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> delta = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> properties = 0) {
+  PlayerDataMessageBuilder builder_(_fbb);
+  builder_.add_properties(properties);
+  builder_.add_delta(delta);
+  builder_.add_angular_velocity(angular_velocity);
+  builder_.add_orientation(orientation);
+  builder_.add_sector(sector);
+  builder_.add_quantized(quantized);
+  builder_.add_data(data);
+  builder_.add_baseline(baseline);
+  builder_.add_sequence(sequence);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PlayerDataMessage> CreatePlayerDataMessageDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const nier::PlayerData *data = 0,
+    const nier::QuantizedPlayerData *quantized = 0,
+    const nier::Sector *sector = 0,
+    const nier::CompressedQuaternion *orientation = 0,
+    const nier::QuantizedAngularVelocity *angular_velocity = 0,
+    uint16_t sequence = 0,
+    uint16_t baseline = 0,
+    const std::vector<uint8_t> *delta = nullptr,
+    const std::vector<uint8_t> *properties = nullptr) {
+  auto delta__ = delta ? _fbb.CreateVector<uint8_t>(*delta) : 0;
+  auto properties__ = properties ? _fbb.CreateVector<uint8_t>(*properties) : 0;
+  return nier::CreatePlayerDataMessage(
+      _fbb,
+      data,
+      quantized,
+      sector,
+      orientation,
+      angular_velocity,
+      sequence,
+      baseline,
+      delta__,
+      properties__);
+}
+
+struct PlayerDataAck FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PlayerDataAckBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_GUIDS = 4,
+    VT_SEQUENCES = 6
+  };
+  const flatbuffers::Vector<uint64_t> *guids() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_GUIDS);
+  }
+  const flatbuffers::Vector<uint16_t> *sequences() const {
+    return GetPointer<const flatbuffers::Vector<uint16_t> *>(VT_SEQUENCES);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_GUIDS) &&
+           verifier.VerifyVector(guids()) &&
+           VerifyOffset(verifier, VT_SEQUENCES) &&
+           verifier.VerifyVector(sequences()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PlayerDataAckBuilder {
+  typedef PlayerDataAck Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_guids(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> guids) {
+    fbb_.AddOffset(PlayerDataAck::VT_GUIDS, guids);
+  }
+  void add_sequences(flatbuffers::Offset<flatbuffers::Vector<uint16_t>> sequences) {
+    fbb_.AddOffset(PlayerDataAck::VT_SEQUENCES, sequences);
+  }
+  explicit PlayerDataAckBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<PlayerDataAck> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PlayerDataAck>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PlayerDataAck> CreatePlayerDataAck(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> guids = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint16_t>> sequences = 0) {
+  PlayerDataAckBuilder builder_(_fbb);
+  builder_.add_sequences(sequences);
+  builder_.add_guids(guids);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PlayerDataAck> CreatePlayerDataAckDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<uint64_t> *guids = nullptr,
+    const std::vector<uint16_t> *sequences = nullptr) {
+  auto guids__ = guids ? _fbb.CreateVector<uint64_t>(*guids) : 0;
+  auto sequences__ = sequences ? _fbb.CreateVector<uint16_t>(*sequences) : 0;
+  return nier::CreatePlayerDataAck(
+      _fbb,
+      guids__,
+      sequences__);
+}
+
+struct StringTable FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef StringTableBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_IDS = 4,
+    VT_STRINGS = 6
+  };
+  const flatbuffers::Vector<uint32_t> *ids() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_IDS);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *strings() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_STRINGS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_IDS) &&
+           verifier.VerifyVector(ids()) &&
+           VerifyOffset(verifier, VT_STRINGS) &&
+           verifier.VerifyVector(strings()) &&
+           verifier.VerifyVectorOfStrings(strings()) &&
+           verifier.EndTable();
+  }
+};
+
+struct StringTableBuilder {
+  typedef StringTable Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_ids(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> ids) {
+    fbb_.AddOffset(StringTable::VT_IDS, ids);
+  }
+  void add_strings(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> strings) {
+    fbb_.AddOffset(StringTable::VT_STRINGS, strings);
+  }
+  explicit StringTableBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<StringTable> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<StringTable>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<StringTable> CreateStringTable(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> ids = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> strings = 0) {
+  StringTableBuilder builder_(_fbb);
+  builder_.add_strings(strings);
+  builder_.add_ids(ids);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<StringTable> CreateStringTableDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<uint32_t> *ids = nullptr,
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *strings = nullptr) {
+  auto ids__ = ids ? _fbb.CreateVector<uint32_t>(*ids) : 0;
+  auto strings__ = strings ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*strings) : 0;
+  return nier::CreateStringTable(
+      _fbb,
+      ids__,
+      strings__);
+}
+
+struct AnimationStartMessage FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef AnimationStartMessageBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_DATA = 4
+  };
+  const nier::AnimationStart *data() const {
+    return GetStruct<const nier::AnimationStart *>(VT_DATA);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<nier::AnimationStart>(verifier, VT_DATA) &&
+           verifier.EndTable();
+  }
+};
+
+struct AnimationStartMessageBuilder {
+  typedef AnimationStartMessage Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_data(const nier::AnimationStart *data) {
+    fbb_.AddStruct(AnimationStartMessage::VT_DATA, data);
+  }
+  explicit AnimationStartMessageBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<AnimationStartMessage> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<AnimationStartMessage>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<AnimationStartMessage> CreateAnimationStartMessage(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const nier::AnimationStart *data = 0) {
+  AnimationStartMessageBuilder builder_(_fbb);
+  builder_.add_data(data);
+  return builder_.Finish();
+}
+
+struct EntityDataMessage FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef EntityDataMessageBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_DATA = 4
+  };
+  const nier::EntityData *data() const {
+    return GetStruct<const nier::EntityData *>(VT_DATA);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<nier::EntityData>(verifier, VT_DATA) &&
+           verifier.EndTable();
+  }
+};
+
+struct EntityDataMessageBuilder {
+  typedef EntityDataMessage Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_data(const nier::EntityData *data) {
+    fbb_.AddStruct(EntityDataMessage::VT_DATA, data);
+  }
+  explicit EntityDataMessageBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<EntityDataMessage> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<EntityDataMessage>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<EntityDataMessage> CreateEntityDataMessage(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const nier::EntityData *data = 0) {
+  EntityDataMessageBuilder builder_(_fbb);
+  builder_.add_data(data);
+  return builder_.Finish();
+}
+
+struct EntitySnapshot FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef EntitySnapshotBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_GUIDS = 4,
+    VT_POSITIONS = 6,
+    VT_FACINGS = 8,
+    VT_FACINGS2 = 10,
+    VT_HEALTHS = 12,
+    VT_SECTOR = 14,
+    VT_QUANTIZED_POSITIONS = 16,
+    VT_QUANTIZED_FACINGS = 18,
+    VT_QUANTIZED_FACINGS2 = 20,
+    VT_ORIENTATIONS = 22,
+    VT_DIRTY = 24,
+    VT_PROPERTIES = 26,
+    VT_VELOCITIES = 28
+  };
+  const flatbuffers::Vector<uint32_t> *guids() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_GUIDS);
+  }
+  const flatbuffers::Vector<const nier::Vector3f *> *positions() const {
+    return GetPointer<const flatbuffers::Vector<const nier::Vector3f *> *>(VT_POSITIONS);
+  }
+  const flatbuffers::Vector<float> *facings() const {
+    return GetPointer<const flatbuffers::Vector<float> *>(VT_FACINGS);
+  }
+  const flatbuffers::Vector<float> *facings2() const {
+    return GetPointer<const flatbuffers::Vector<float> *>(VT_FACINGS2);
+  }
+  const flatbuffers::Vector<uint32_t> *healths() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_HEALTHS);
+  }
+  const nier::Sector *sector() const {
+    return GetStruct<const nier::Sector *>(VT_SECTOR);
+  }
+  const flatbuffers::Vector<const nier::QuantizedVector3 *> *quantized_positions() const {
+    return GetPointer<const flatbuffers::Vector<const nier::QuantizedVector3 *> *>(VT_QUANTIZED_POSITIONS);
+  }
+  const flatbuffers::Vector<uint16_t> *quantized_facings() const {
+    return GetPointer<const flatbuffers::Vector<uint16_t> *>(VT_QUANTIZED_FACINGS);
+  }
+  const flatbuffers::Vector<uint16_t> *quantized_facings2() const {
+    return GetPointer<const flatbuffers::Vector<uint16_t> *>(VT_QUANTIZED_FACINGS2);
+  }
+  const flatbuffers::Vector<const nier::CompressedQuaternion *> *orientations() const {
+    return GetPointer<const flatbuffers::Vector<const nier::CompressedQuaternion *> *>(VT_ORIENTATIONS);
+  }
+  const flatbuffers::Vector<uint8_t> *dirty() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_DIRTY);
+  }
+  const flatbuffers::Vector<uint8_t> *properties() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PROPERTIES);
+  }
+  const flatbuffers::Vector<const nier::QuantizedVelocity *> *velocities() const {
+    return GetPointer<const flatbuffers::Vector<const nier::QuantizedVelocity *> *>(VT_VELOCITIES);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_GUIDS) &&
+           verifier.VerifyVector(guids()) &&
+           VerifyOffset(verifier, VT_POSITIONS) &&
+           verifier.VerifyVector(positions()) &&
+           VerifyOffset(verifier, VT_FACINGS) &&
+           verifier.VerifyVector(facings()) &&
+           VerifyOffset(verifier, VT_FACINGS2) &&
+           verifier.VerifyVector(facings2()) &&
+           VerifyOffset(verifier, VT_HEALTHS) &&
+           verifier.VerifyVector(healths()) &&
+           VerifyField<nier::Sector>(verifier, VT_SECTOR) &&
+           VerifyOffset(verifier, VT_QUANTIZED_POSITIONS) &&
+           verifier.VerifyVector(quantized_positions()) &&
+           VerifyOffset(verifier, VT_QUANTIZED_FACINGS) &&
+           verifier.VerifyVector(quantized_facings()) &&
+           VerifyOffset(verifier, VT_QUANTIZED_FACINGS2) &&
+           verifier.VerifyVector(quantized_facings2()) &&
+           VerifyOffset(verifier, VT_ORIENTATIONS) &&
+           verifier.VerifyVector(orientations()) &&
+           VerifyOffset(verifier, VT_DIRTY) &&
+           verifier.VerifyVector(dirty()) &&
+           VerifyOffset(verifier, VT_PROPERTIES) &&
+           verifier.VerifyVector(properties()) &&
+           VerifyOffset(verifier, VT_VELOCITIES) &&
+           verifier.VerifyVector(velocities()) &&
+           verifier.EndTable();
+  }
+};
+
+struct EntitySnapshotBuilder {
+  typedef EntitySnapshot Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_guids(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> guids) {
+    fbb_.AddOffset(EntitySnapshot::VT_GUIDS, guids);
+  }
+  void add_positions(flatbuffers::Offset<flatbuffers::Vector<const nier::Vector3f *>> positions) {
+    fbb_.AddOffset(EntitySnapshot::VT_POSITIONS, positions);
+  }
+  void add_facings(flatbuffers::Offset<flatbuffers::Vector<float>> facings) {
+    fbb_.AddOffset(EntitySnapshot::VT_FACINGS, facings);
+  }
+  void add_facings2(flatbuffers::Offset<flatbuffers::Vector<float>> facings2) {
+    fbb_.AddOffset(EntitySnapshot::VT_FACINGS2, facings2);
+  }
+  void add_healths(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> healths) {
+    fbb_.AddOffset(EntitySnapshot::VT_HEALTHS, healths);
+  }
+  void add_sector(const nier::Sector *sector) {
+    fbb_.AddStruct(EntitySnapshot::VT_SECTOR, sector);
+  }
+  void add_quantized_positions(flatbuffers::Offset<flatbuffers::Vector<const nier::QuantizedVector3 *>> quantized_positions) {
+    fbb_.AddOffset(EntitySnapshot::VT_QUANTIZED_POSITIONS, quantized_positions);
+  }
+  void add_quantized_facings(flatbuffers::Offset<flatbuffers::Vector<uint16_t>> quantized_facings) {
+    fbb_.AddOffset(EntitySnapshot::VT_QUANTIZED_FACINGS, quantized_facings);
+  }
+  void add_quantized_facings2(flatbuffers::Offset<flatbuffers::Vector<uint16_t>> quantized_facings2) {
+    fbb_.AddOffset(EntitySnapshot::VT_QUANTIZED_FACINGS2, quantized_facings2);
+  }
+  void add_orientations(flatbuffers::Offset<flatbuffers::Vector<const nier::CompressedQuaternion *>> orientations) {
+    fbb_.AddOffset(EntitySnapshot::VT_ORIENTATIONS, orientations);
+  }
+  void add_dirty(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> dirty) {
+    fbb_.AddOffset(EntitySnapshot::VT_DIRTY, dirty);
+  }
+  void add_properties(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> properties) {
+    fbb_.AddOffset(EntitySnapshot::VT_PROPERTIES, properties);
+  }
+  void add_velocities(flatbuffers::Offset<flatbuffers::Vector<const nier::QuantizedVelocity *>> velocities) {
+    fbb_.AddOffset(EntitySnapshot::VT_VELOCITIES, velocities);
+  }
+  explicit EntitySnapshotBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<EntitySnapshot> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<EntitySnapshot>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<EntitySnapshot> CreateEntitySnapshot(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> guids = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const nier::Vector3f *>> positions = 0,
+    flatbuffers::Offset<flatbuffers::Vector<float>> facings = 0,
+    flatbuffers::Offset<flatbuffers::Vector<float>> facings2 = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> healths = 0,
+    const nier::Sector *sector = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const nier::QuantizedVector3 *>> quantized_positions = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint16_t>> quantized_facings = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint16_t>> quantized_facings2 = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const nier::CompressedQuaternion *>> orientations = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> dirty = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> properties = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const nier::QuantizedVelocity *>> velocities = 0) {
+  EntitySnapshotBuilder builder_(_fbb);
+  builder_.add_velocities(velocities);
+  builder_.add_properties(properties);
+  builder_.add_dirty(dirty);
+  builder_.add_orientations(orientations);
+  builder_.add_quantized_facings2(quantized_facings2);
+  builder_.add_quantized_facings(quantized_facings);
+  builder_.add_quantized_positions(quantized_positions);
+  builder_.add_sector(sector);
+  builder_.add_healths(healths);
+  builder_.add_facings2(facings2);
+  builder_.add_facings(facings);
+  builder_.add_positions(positions);
+  builder_.add_guids(guids);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<EntitySnapshot> CreateEntitySnapshotDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<uint32_t> *guids = nullptr,
+    const std::vector<nier::Vector3f> *positions = nullptr,
+    const std::vector<float> *facings = nullptr,
+    const std::vector<float> *facings2 = nullptr,
+    const std::vector<uint32_t> *healths = nullptr,
+    const nier::Sector *sector = 0,
+    const std::vector<nier::QuantizedVector3> *quantized_positions = nullptr,
+    const std::vector<uint16_t> *quantized_facings = nullptr,
+    const std::vector<uint16_t> *quantized_facings2 = nullptr,
+    const std::vector<nier::CompressedQuaternion> *orientations = nullptr,
+    const std::vector<uint8_t> *dirty = nullptr,
+    const std::vector<uint8_t> *properties = nullptr,
+    const std::vector<nier::QuantizedVelocity> *velocities = nullptr) {
+  auto guids__ = guids ? _fbb.CreateVector<uint32_t>(*guids) : 0;
+  auto positions__ = positions ? _fbb.CreateVectorOfStructs<nier::Vector3f>(*positions) : 0;
+  auto facings__ = facings ? _fbb.CreateVector<float>(*facings) : 0;
+  auto facings2__ = facings2 ? _fbb.CreateVector<float>(*facings2) : 0;
+  auto healths__ = healths ? _fbb.CreateVector<uint32_t>(*healths) : 0;
+  auto quantized_positions__ = quantized_positions ? _fbb.CreateVectorOfStructs<nier::QuantizedVector3>(*quantized_positions) : 0;
+  auto quantized_facings__ = quantized_facings ? _fbb.CreateVector<uint16_t>(*quantized_facings) : 0;
+  auto quantized_facings2__ = quantized_facings2 ? _fbb.CreateVector<uint16_t>(*quantized_facings2) : 0;
+  auto orientations__ = orientations ? _fbb.CreateVectorOfStructs<nier::CompressedQuaternion>(*orientations) : 0;
+  auto dirty__ = dirty ? _fbb.CreateVector<uint8_t>(*dirty) : 0;
+  auto properties__ = properties ? _fbb.CreateVector<uint8_t>(*properties) : 0;
+  auto velocities__ = velocities ? _fbb.CreateVectorOfStructs<nier::QuantizedVelocity>(*velocities) : 0;
+  return nier::CreateEntitySnapshot(
+      _fbb,
+      guids__,
+      positions__,
+      facings__,
+      facings2__,
+      healths__,
+      sector,
+      quantized_positions__,
+      quantized_facings__,
+      quantized_facings2__,
+      orientations__,
+      dirty__,
+      properties__,
+      velocities__);
+}
+
+struct PacketBatchEntry FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PacketBatchEntryBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_PACKET = 4
+  };
+  const flatbuffers::Vector<uint8_t> *packet() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PACKET);
+  }
+  const nier::PacketV2 *packet_nested_root() const {
+    return flatbuffers::GetRoot<nier::PacketV2>(packet()->Data());
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_PACKET) &&
+           verifier.VerifyVector(packet()) &&
+           verifier.VerifyNestedFlatBuffer<nier::PacketV2>(packet(), nullptr) &&
+           verifier.EndTable();
+  }
+};
+
+struct PacketBatchEntryBuilder {
+  typedef PacketBatchEntry Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_packet(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> packet) {
+    fbb_.AddOffset(PacketBatchEntry::VT_PACKET, packet);
+  }
+  explicit PacketBatchEntryBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<PacketBatchEntry> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PacketBatchEntry>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PacketBatchEntry> CreatePacketBatchEntry(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> packet = 0) {
+  PacketBatchEntryBuilder builder_(_fbb);
+  builder_.add_packet(packet);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PacketBatchEntry> CreatePacketBatchEntryDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<uint8_t> *packet = nullptr) {
+  auto packet__ = packet ? _fbb.CreateVector<uint8_t>(*packet) : 0;
+  return nier::CreatePacketBatchEntry(
+      _fbb,
+      packet__);
+}
+
+struct PacketV2 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PacketV2Builder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ID = 4,
+    VT_GUID = 6,
+    VT_MESSAGE_TYPE = 8,
+    VT_MESSAGE = 10
+  };
+  nier::PacketType id() const {
+    return static_cast<nier::PacketType>(GetField<uint32_t>(VT_ID, 0));
+  }
+  uint64_t guid() const {
+    return GetField<uint64_t>(VT_GUID, 0);
+  }
+  nier::Message message_type() const {
+    return static_cast<nier::Message>(GetField<uint8_t>(VT_MESSAGE_TYPE, 0));
+  }
+  const void *message() const {
+    return GetPointer<const void *>(VT_MESSAGE);
+  }
+  template<typename T> const T *message_as() const;
+  const nier::Hello *message_as_Hello() const {
+    return message_type() == nier::Message_Hello ? static_cast<const nier::Hello *>(message()) : nullptr;
+  }
+  const nier::Welcome *message_as_Welcome() const {
+    return message_type() == nier::Message_Welcome ? static_cast<const nier::Welcome *>(message()) : nullptr;
+  }
+  const nier::CreatePlayer *message_as_CreatePlayer() const {
+    return message_type() == nier::Message_CreatePlayer ? static_cast<const nier::CreatePlayer *>(message()) : nullptr;
+  }
+  const nier::EntitySpawnParams *message_as_EntitySpawnParams() const {
+    return message_type() == nier::Message_EntitySpawnParams ? static_cast<const nier::EntitySpawnParams *>(message()) : nullptr;
+  }
+  const nier::EntityDataMessage *message_as_EntityDataMessage() const {
+    return message_type() == nier::Message_EntityDataMessage ? static_cast<const nier::EntityDataMessage *>(message()) : nullptr;
+  }
+  const nier::AnimationStartMessage *message_as_AnimationStartMessage() const {
+    return message_type() == nier::Message_AnimationStartMessage ? static_cast<const nier::AnimationStartMessage *>(message()) : nullptr;
+  }
+  const nier::PlayerDataMessage *message_as_PlayerDataMessage() const {
+    return message_type() == nier::Message_PlayerDataMessage ? static_cast<const nier::PlayerDataMessage *>(message()) : nullptr;
+  }
+  const nier::Buttons *message_as_Buttons() const {
+    return message_type() == nier::Message_Buttons ? static_cast<const nier::Buttons *>(message()) : nullptr;
+  }
+  const nier::PacketBatch *message_as_PacketBatch() const {
+    return message_type() == nier::Message_PacketBatch ? static_cast<const nier::PacketBatch *>(message()) : nullptr;
+  }
+  const nier::EntitySnapshot *message_as_EntitySnapshot() const {
+    return message_type() == nier::Message_EntitySnapshot ? static_cast<const nier::EntitySnapshot *>(message()) : nullptr;
+  }
+  const nier::PlayerDataAck *message_as_PlayerDataAck() const {
+    return message_type() == nier::Message_PlayerDataAck ? static_cast<const nier::PlayerDataAck *>(message()) : nullptr;
+  }
+  const nier::StringTable *message_as_StringTable() const {
+    return message_type() == nier::Message_StringTable ? static_cast<const nier::StringTable *>(message()) : nullptr;
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_ID) &&
+           VerifyField<uint64_t>(verifier, VT_GUID) &&
+           VerifyField<uint8_t>(verifier, VT_MESSAGE_TYPE) &&
+           VerifyOffset(verifier, VT_MESSAGE) &&
+           VerifyMessage(verifier, message(), message_type()) &&
+           verifier.EndTable();
+  }
+};
+
+template<> inline const nier::Hello *PacketV2::message_as<nier::Hello>() const {
+  return message_as_Hello();
+}
+
+template<> inline const nier::Welcome *PacketV2::message_as<nier::Welcome>() const {
+  return message_as_Welcome();
+}
+
+template<> inline const nier::CreatePlayer *PacketV2::message_as<nier::CreatePlayer>() const {
+  return message_as_CreatePlayer();
+}
+
+template<> inline const nier::EntitySpawnParams *PacketV2::message_as<nier::EntitySpawnParams>() const {
+  return message_as_EntitySpawnParams();
+}
+
+template<> inline const nier::EntityDataMessage *PacketV2::message_as<nier::EntityDataMessage>() const {
+  return message_as_EntityDataMessage();
+}
+
+template<> inline const nier::AnimationStartMessage *PacketV2::message_as<nier::AnimationStartMessage>() const {
+  return message_as_AnimationStartMessage();
+}
+
+template<> inline const nier::PlayerDataMessage *PacketV2::message_as<nier::PlayerDataMessage>() const {
+  return message_as_PlayerDataMessage();
+}
+
+template<> inline const nier::Buttons *PacketV2::message_as<nier::Buttons>() const {
+  return message_as_Buttons();
+}
+
+template<> inline const nier::PacketBatch *PacketV2::message_as<nier::PacketBatch>() const {
+  return message_as_PacketBatch();
+}
+
+template<> inline const nier::EntitySnapshot *PacketV2::message_as<nier::EntitySnapshot>() const {
+  return message_as_EntitySnapshot();
+}
+
+template<> inline const nier::PlayerDataAck *PacketV2::message_as<nier::PlayerDataAck>() const {
+  return message_as_PlayerDataAck();
+}
+
+template<> inline const nier::StringTable *PacketV2::message_as<nier::StringTable>() const {
+  return message_as_StringTable();
+}
+
+struct PacketV2Builder {
+  typedef PacketV2 Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_id(nier::PacketType id) {
+    fbb_.AddElement<uint32_t>(PacketV2::VT_ID, static_cast<uint32_t>(id), 0);
+  }
+  void add_guid(uint64_t guid) {
+    fbb_.AddElement<uint64_t>(PacketV2::VT_GUID, guid, 0);
+  }
+  void add_message_type(nier::Message message_type) {
+    fbb_.AddElement<uint8_t>(PacketV2::VT_MESSAGE_TYPE, static_cast<uint8_t>(message_type), 0);
+  }
+  void add_message(flatbuffers::Offset<void> message) {
+    fbb_.AddOffset(PacketV2::VT_MESSAGE, message);
+  }
+  explicit PacketV2Builder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<PacketV2> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PacketV2>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PacketV2> CreatePacketV2(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    nier::PacketType id = nier::PacketType_ID_MASTER_CLIENT_START,
+    uint64_t guid = 0,
+    nier::Message message_type = nier::Message_NONE,
+    flatbuffers::Offset<void> message = 0) {
+  PacketV2Builder builder_(_fbb);
+  builder_.add_guid(guid);
+  builder_.add_message(message);
+  builder_.add_id(id);
+  builder_.add_message_type(message_type);
+  return builder_.Finish();
+}
+
+struct PacketBatch FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef PacketBatchBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_PACKETS = 4
+  };
+  const flatbuffers::Vector<flatbuffers::Offset<nier::PacketBatchEntry>> *packets() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<nier::PacketBatchEntry>> *>(VT_PACKETS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_PACKETS) &&
+           verifier.VerifyVector(packets()) &&
+           verifier.VerifyVectorOfTables(packets()) &&
+           verifier.EndTable();
+  }
+};
+
+struct PacketBatchBuilder {
+  typedef PacketBatch Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_packets(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<nier::PacketBatchEntry>>> packets) {
+    fbb_.AddOffset(PacketBatch::VT_PACKETS, packets);
+  }
+  explicit PacketBatchBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<PacketBatch> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<PacketBatch>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<PacketBatch> CreatePacketBatch(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<nier::PacketBatchEntry>>> packets = 0) {
+  PacketBatchBuilder builder_(_fbb);
+  builder_.add_packets(packets);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<PacketBatch> CreatePacketBatchDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<flatbuffers::Offset<nier::PacketBatchEntry>> *packets = nullptr) {
+  auto packets__ = packets ? _fbb.CreateVector<flatbuffers::Offset<nier::PacketBatchEntry>>(*packets) : 0;
+  return nier::CreatePacketBatch(
+      _fbb,
+      packets__);
+}
+
+inline bool VerifyMessage(flatbuffers::Verifier &verifier, const void *obj, Message type) {
+  switch (type) {
+    case Message_NONE: {
+      return true;
+    }
+    case Message_Hello: {
+      auto ptr = reinterpret_cast<const nier::Hello *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_Welcome: {
+      auto ptr = reinterpret_cast<const nier::Welcome *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_CreatePlayer: {
+      auto ptr = reinterpret_cast<const nier::CreatePlayer *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_EntitySpawnParams: {
+      auto ptr = reinterpret_cast<const nier::EntitySpawnParams *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_EntityDataMessage: {
+      auto ptr = reinterpret_cast<const nier::EntityDataMessage *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_AnimationStartMessage: {
+      auto ptr = reinterpret_cast<const nier::AnimationStartMessage *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_PlayerDataMessage: {
+      auto ptr = reinterpret_cast<const nier::PlayerDataMessage *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_Buttons: {
+      auto ptr = reinterpret_cast<const nier::Buttons *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_PacketBatch: {
+      auto ptr = reinterpret_cast<const nier::PacketBatch *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_EntitySnapshot: {
+      auto ptr = reinterpret_cast<const nier::EntitySnapshot *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_PlayerDataAck: {
+      auto ptr = reinterpret_cast<const nier::PlayerDataAck *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Message_StringTable: {
+      auto ptr = reinterpret_cast<const nier::StringTable *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    default: return true;
+  }
+}
+
+inline bool VerifyMessageVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types) {
+  if (!values || !types) return !values && !types;
+  if (values->size() != types->size()) return false;
+  for (flatbuffers::uoffset_t i = 0; i < values->size(); ++i) {
+    if (!VerifyMessage(
+        verifier,  values->Get(i), types->GetEnum<Message>(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline const nier::PacketV2 *GetPacketV2(const void *buf) {
+  return flatbuffers::GetRoot<nier::PacketV2>(buf);
+}
+
+inline const nier::PacketV2 *GetSizePrefixedPacketV2(const void *buf) {
+  return flatbuffers::GetSizePrefixedRoot<nier::PacketV2>(buf);
+}
+
+inline const char *PacketV2Identifier() {
+  return "NMP2";
+}
+
+inline bool PacketV2BufferHasIdentifier(const void *buf) {
+  return flatbuffers::BufferHasIdentifier(
+      buf, PacketV2Identifier());
+}
+
+inline bool VerifyPacketV2Buffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifyBuffer<nier::PacketV2>(PacketV2Identifier());
+}
+
+inline bool VerifySizePrefixedPacketV2Buffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifySizePrefixedBuffer<nier::PacketV2>(PacketV2Identifier());
+}
+
+inline void FinishPacketV2Buffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<nier::PacketV2> root) {
+  fbb.Finish(root, PacketV2Identifier());
+}
+
+inline void FinishSizePrefixedPacketV2Buffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<nier::PacketV2> root) {
+  fbb.FinishSizePrefixed(root, PacketV2Identifier());
 }
 
 }  // namespace nier
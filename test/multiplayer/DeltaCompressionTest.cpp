@@ -0,0 +1,319 @@
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "DeltaCompression.hpp"
+#include "Test.hpp"
+
+using delta_compression::BASELINE_COUNT;
+using delta_compression::PlayerState;
+
+namespace {
+// Sequential bytes against one changed field here and there. server/automatamp/core/DeltaCompression_test.go
+// encodes the same pair to the same bytes.
+PlayerState make_shared_baseline() {
+    PlayerState baseline{};
+
+    for (size_t i = 0; i < baseline.size(); ++i) {
+        baseline[i] = (uint8_t)i;
+    }
+
+    return baseline;
+}
+
+PlayerState make_shared_state() {
+    auto state = make_shared_baseline();
+    state[0] = 0x10;
+    state[6] = 0x44;
+    state[7] = 0x13;
+    state[28] = 0xA1;
+    state[29] = 0xB2;
+    state[30] = 0xC3;
+    state[31] = 0xD4;
+    state[33] = 0x00;
+
+    return state;
+}
+
+const std::vector<uint8_t> SHARED_DELTA{
+    0x00, 0x10,
+    0x84,
+    0x01, 0x42, 0x14,
+    0x93,
+    0x03, 0xBD, 0xAF, 0xDD, 0xCB,
+    0x80,
+    0x00, 0x21,
+};
+
+// A player walking and turning, only a few bytes change from one tick to the next.
+PlayerState make_walking_state(uint32_t tick) {
+    const nier::QuantizedPlayerData quantized{
+        nier::QuantizedVector3{(int16_t)(tick * 3), 120, (int16_t)(-(int32_t)tick)},
+        (uint16_t)(tick * 40), (uint16_t)(tick * 40), 2, false, 1, 0, 4.5f, tick % 20 < 10 ? 0x1u : 0x0u};
+
+    return delta_compression::make_player_state(quantized, nier::CompressedQuaternion{0x40000000u + tick * 17u},
+        nier::QuantizedAngularVelocity{0, (int16_t)(tick % 7), 0});
+}
+
+PlayerState make_random_state(test::Random& random) {
+    PlayerState state{};
+
+    for (auto& b : state) {
+        // Mostly zeros so both run kinds show up.
+        b = random.next_unit() < 0.5 ? 0 : (uint8_t)(random.next() >> 24);
+    }
+
+    return state;
+}
+
+bool decodes_to(const std::vector<uint8_t>& delta, const PlayerState& baseline, const PlayerState& expected) {
+    PlayerState state{};
+
+    return delta_compression::decode(delta.data(), delta.size(), baseline, state) && state == expected;
+}
+
+bool rejects(const std::vector<uint8_t>& delta) {
+    PlayerState state{};
+
+    return !delta_compression::decode(delta.data(), delta.size(), make_shared_baseline(), state);
+}
+}
+
+TEST(delta_compression_shared_vector) {
+    const auto baseline = make_shared_baseline();
+    const auto state = make_shared_state();
+
+    std::vector<uint8_t> out{};
+    delta_compression::encode(state, baseline, out);
+
+    CHECK(out == SHARED_DELTA);
+    CHECK(decodes_to(SHARED_DELTA, baseline, state));
+}
+
+TEST(delta_compression_round_trip) {
+    nier::QuantizedPlayerData quantized{nier::QuantizedVector3{-1200, 35, 30000}, 0x1234, 0xFEDC, 9, true, 3, 5, -2.5f, 0x80000001u};
+    nier::CompressedQuaternion orientation{0xDEADBEEFu};
+    nier::QuantizedAngularVelocity angular_velocity{-7, 0, 512};
+
+    const auto state = delta_compression::make_player_state(quantized, orientation, angular_velocity);
+
+    nier::QuantizedPlayerData read_quantized{};
+    nier::CompressedQuaternion read_orientation{};
+    nier::QuantizedAngularVelocity read_angular_velocity{};
+    delta_compression::read_player_state(state, read_quantized, read_orientation, read_angular_velocity);
+
+    CHECK(read_quantized.position().x() == -1200 && read_quantized.position().y() == 35 && read_quantized.position().z() == 30000);
+    CHECK(read_quantized.facing() == 0x1234 && read_quantized.facing2() == 0xFEDC && read_quantized.sector_id() == 9);
+    CHECK(read_quantized.flashlight() && read_quantized.weapon_index() == 3 && read_quantized.pod_index() == 5);
+    CHECK(read_quantized.speed() == -2.5f && read_quantized.held_button_flags() == 0x80000001u);
+    CHECK(read_orientation.value() == 0xDEADBEEFu);
+    CHECK(read_angular_velocity.x() == -7 && read_angular_velocity.y() == 0 && read_angular_velocity.z() == 512);
+
+    // An unchanged state is a single zero run.
+    std::vector<uint8_t> out{};
+    delta_compression::encode(state, state, out);
+
+    CHECK((out == std::vector<uint8_t>{0x80 | (uint8_t)(delta_compression::PLAYER_STATE_SIZE - 1)}));
+    CHECK(decodes_to(out, state, state));
+
+    test::Random random{};
+
+    for (auto i = 0; i < 1000; ++i) {
+        const auto a = make_random_state(random);
+        const auto b = make_random_state(random);
+
+        out.clear();
+        delta_compression::encode(a, b, out);
+
+        CHECK(decodes_to(out, b, a));
+    }
+}
+
+TEST(delta_compression_malformed) {
+    CHECK(rejects({}));
+    // Covers less than a state.
+    CHECK(rejects({0x80 | 32}));
+    // Covers more than a state.
+    CHECK(rejects({0x80 | 33, 0x80}));
+    CHECK(rejects({0xFF}));
+    // Literal run past the end of the delta.
+    CHECK(rejects({0x80 | 31, 0x01, 0xAA}));
+    // Literal run past the end of the state.
+    CHECK(rejects({0x80 | 31, 0x02, 0xAA, 0xBB, 0xCC}));
+
+    // No prefix of a valid delta decodes.
+    for (size_t size = 0; size < SHARED_DELTA.size(); ++size) {
+        CHECK(rejects({SHARED_DELTA.begin(), SHARED_DELTA.begin() + size}));
+    }
+}
+
+TEST(delta_compression_baseline_ring) {
+    delta_compression::BaselineRing ring{};
+    PlayerState state{};
+
+    CHECK(ring.find(0) == nullptr);
+
+    // Across the sequence wrap.
+    for (uint32_t i = 0; i < 100; ++i) {
+        const auto sequence = (uint16_t)(65500 + i);
+        state[0] = (uint8_t)i;
+        ring.store(sequence, state);
+    }
+
+    const auto newest = (uint16_t)(65500 + 99);
+
+    for (uint16_t age = 0; age < BASELINE_COUNT; ++age) {
+        const auto found = ring.find((uint16_t)(newest - age));
+
+        CHECK(found != nullptr && (*found)[0] == (uint8_t)(99 - age));
+    }
+
+    // Same slot, overwritten.
+    CHECK(ring.find((uint16_t)(newest - BASELINE_COUNT)) == nullptr);
+    // Same slot, never stored.
+    CHECK(ring.find((uint16_t)(newest + BASELINE_COUNT)) == nullptr);
+
+    ring.clear();
+
+    CHECK(ring.find(newest) == nullptr);
+}
+
+TEST(delta_compression_sequence_order) {
+    CHECK(delta_compression::is_newer(1, 0));
+    CHECK(!delta_compression::is_newer(0, 1));
+    CHECK(!delta_compression::is_newer(5, 5));
+    CHECK(delta_compression::is_newer(0, 65535));
+    CHECK(delta_compression::is_newer(10, 65530));
+    CHECK(!delta_compression::is_newer(65530, 10));
+}
+
+TEST(delta_compression_acks) {
+    delta_compression::Sender sender{};
+    delta_compression::Receiver receiver{};
+    std::vector<uint8_t> out{};
+    uint16_t sequence{}, baseline{}, ack{};
+    PlayerState state{};
+
+    // Nothing acked yet, so against zeros.
+    sender.encode(make_walking_state(0), out, sequence, baseline);
+
+    CHECK(sequence == 1 && baseline == sequence);
+    CHECK(!receiver.take_ack(ack));
+    CHECK(receiver.decode(sequence, baseline, out.data(), out.size(), state) && state == make_walking_state(0));
+    CHECK(receiver.take_ack(ack) && ack == 1);
+    CHECK(!receiver.take_ack(ack));
+
+    // Acks for unsent updates are ignored.
+    sender.on_ack(2);
+    out.clear();
+    sender.encode(make_walking_state(1), out, sequence, baseline);
+
+    CHECK(sequence == 2 && baseline == sequence);
+
+    sender.on_ack(2);
+    sender.on_ack(1);
+    out.clear();
+    sender.encode(make_walking_state(2), out, sequence, baseline);
+
+    // Older acks are ignored once a newer one arrived.
+    CHECK(sequence == 3 && baseline == 2);
+
+    // 2 was never decoded, so the receiver has no baseline for 3.
+    CHECK(!receiver.decode(sequence, baseline, out.data(), out.size(), state));
+    CHECK(!receiver.take_ack(ack));
+
+    // Stops using an ack once it fell out of the ring.
+    for (auto i = 3; i < 1 + BASELINE_COUNT; ++i) {
+        out.clear();
+        sender.encode(make_walking_state(i), out, sequence, baseline);
+
+        CHECK(baseline == 2);
+    }
+
+    out.clear();
+    sender.encode(make_walking_state(1 + BASELINE_COUNT), out, sequence, baseline);
+
+    CHECK(sequence == 2 + BASELINE_COUNT && baseline == sequence);
+    CHECK(receiver.decode(sequence, baseline, out.data(), out.size(), state) && state == make_walking_state(1 + BASELINE_COUNT));
+
+    // Not newer than what was decoded.
+    CHECK(!receiver.decode(sequence, baseline, out.data(), out.size(), state));
+
+    sender.reset();
+    receiver.reset();
+    out.clear();
+    sender.encode(make_walking_state(0), out, sequence, baseline);
+
+    CHECK(sequence == 1 && baseline == sequence);
+    CHECK(receiver.decode(sequence, baseline, out.data(), out.size(), state));
+}
+
+// Updates and acks are lost, reordered and wrap around, every decoded state must still be the one that was sent.
+TEST(delta_compression_lossy_channel) {
+    struct Update {
+        uint16_t sequence;
+        uint16_t baseline;
+        std::vector<uint8_t> delta;
+        PlayerState state;
+    };
+
+    delta_compression::Sender sender{};
+    delta_compression::Receiver receiver{};
+    test::Random random{7};
+    std::deque<Update> in_flight{};
+    std::deque<uint16_t> acks_in_flight{};
+
+    size_t decoded = 0;
+    size_t delta_bytes = 0;
+    uint16_t newest = 0;
+    bool has_newest = false;
+
+    // Enough ticks to wrap the 16 bit sequence.
+    for (uint32_t tick = 0; tick < 70000; ++tick) {
+        Update update{};
+        update.state = make_walking_state(tick);
+        sender.encode(update.state, update.delta, update.sequence, update.baseline);
+        delta_bytes += update.delta.size();
+
+        // 10% loss, the rest may swap with the update before it.
+        if (random.next_unit() >= 0.1) {
+            if (!in_flight.empty() && random.next_unit() < 0.2) {
+                in_flight.insert(in_flight.end() - 1, std::move(update));
+            } else {
+                in_flight.push_back(std::move(update));
+            }
+        }
+
+        // A couple of ticks of latency.
+        while (in_flight.size() > 2) {
+            const auto& received = in_flight.front();
+            PlayerState state{};
+
+            if (receiver.decode(received.sequence, received.baseline, received.delta.data(), received.delta.size(), state)) {
+                CHECK(state == received.state);
+                CHECK(!has_newest || delta_compression::is_newer(received.sequence, newest));
+
+                newest = received.sequence;
+                has_newest = true;
+                ++decoded;
+            }
+
+            in_flight.pop_front();
+        }
+
+        uint16_t ack{};
+
+        if (receiver.take_ack(ack) && random.next_unit() >= 0.1) {
+            acks_in_flight.push_back(ack);
+        }
+
+        while (acks_in_flight.size() > 2) {
+            sender.on_ack(acks_in_flight.front());
+            acks_in_flight.pop_front();
+        }
+    }
+
+    // Most updates get through, and encoding against acked ones still saves bytes with a few ticks of stale baselines.
+    CHECK(decoded > 70000 * 7 / 10);
+    CHECK(delta_bytes < 70000 * delta_compression::PLAYER_STATE_SIZE * 2 / 3);
+}
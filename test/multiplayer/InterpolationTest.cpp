@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <vector>
+
+#include "Interpolation.hpp"
+#include "Test.hpp"
+
+using interpolation::SnapshotBuffer;
+using interpolation::State;
+
+namespace {
+constexpr double SEND_INTERVAL = 1.0 / 30.0;
+constexpr double LATENCY = 0.05;
+constexpr double FRAME_TIME = 1.0 / 144.0;
+constexpr float SPEED = 5.0f; // metres per second along x
+
+struct Arrival {
+    double time;
+    State state;
+};
+
+State make_state(float x) {
+    State state{};
+    state.position.x = x;
+    return state;
+}
+
+// Updates sent every SEND_INTERVAL while moving at SPEED, each delayed by LATENCY plus up to max_jitter.
+std::vector<Arrival> make_trace(size_t count, double max_jitter) {
+    std::vector<Arrival> trace{};
+    test::Random random{};
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto sent = i * SEND_INTERVAL;
+        const auto jitter = max_jitter * random.next_unit();
+
+        trace.push_back({sent + LATENCY + jitter, make_state((float)sent * SPEED)});
+    }
+
+    std::stable_sort(trace.begin(), trace.end(), [](const auto& a, const auto& b) { return a.time < b.time; });
+    return trace;
+}
+
+void push_steady(SnapshotBuffer& buffer, double start, size_t count, float start_x) {
+    for (size_t i = 0; i < count; ++i) {
+        buffer.push(start + i * SEND_INTERVAL, make_state(start_x + (float)(i * SEND_INTERVAL) * SPEED));
+    }
+}
+}
+
+TEST(interpolation_smooths_jittered_30hz) {
+    const auto trace = make_trace(300, 0.03);
+
+    SnapshotBuffer buffer{};
+    State sample{};
+    size_t next = 0;
+    float newest_x = 0.0f;
+    float previous_x = 0.0f;
+    bool has_previous = false;
+
+    for (auto now = trace.front().time; now < trace.back().time; now += FRAME_TIME) {
+        while (next < trace.size() && trace[next].time <= now) {
+            buffer.push(trace[next].time, trace[next].state);
+            newest_x = std::max(newest_x, trace[next].state.position.x);
+            ++next;
+        }
+
+        CHECK(buffer.sample(now, sample));
+
+        // Once the statistics have settled playback never runs backwards, never jumps more than
+        // two frames' worth and only runs past what has arrived when an update is late.
+        if (now > trace.front().time + 2.0) {
+            const auto step = sample.position.x - previous_x;
+
+            CHECK(has_previous);
+            CHECK(step >= 0.0f);
+            CHECK(step <= 2.0f * SPEED * (float)FRAME_TIME);
+            CHECK(sample.position.x <= newest_x + (float)SnapshotBuffer::MAX_EXTRAPOLATION * SPEED);
+        }
+
+        previous_x = sample.position.x;
+        has_previous = true;
+    }
+
+    CHECK_NEAR(buffer.get_interval(), SEND_INTERVAL, 0.005);
+    CHECK(buffer.get_jitter() > 0.0);
+    CHECK(buffer.get_playout_delay() > buffer.get_interval());
+    CHECK(buffer.get_playout_delay() <= SnapshotBuffer::MAX_PLAYOUT_DELAY);
+}
+
+TEST(interpolation_extrapolation_is_capped) {
+    SnapshotBuffer buffer{};
+    push_steady(buffer, 0.0, 60, 0.0f);
+
+    const auto newest_x = (float)(59 * SEND_INTERVAL) * SPEED;
+    const auto newest_time = 59 * SEND_INTERVAL;
+    State sample{};
+
+    // The next update is late, movement carries on past the newest one...
+    CHECK(buffer.sample(newest_time + buffer.get_playout_delay() + 0.1, sample));
+    CHECK_NEAR(sample.position.x, newest_x + 0.1f * SPEED, 0.01);
+
+    // ...but only for MAX_EXTRAPOLATION, however late it gets.
+    for (const auto late : {0.3, 1.0, 10.0}) {
+        CHECK(buffer.sample(newest_time + buffer.get_playout_delay() + late, sample));
+        CHECK_NEAR(sample.position.x, newest_x + (float)SnapshotBuffer::MAX_EXTRAPOLATION * SPEED, 0.01);
+    }
+}
+
+TEST(interpolation_teleport_clears_buffer) {
+    SnapshotBuffer buffer{};
+    push_steady(buffer, 0.0, 30, 0.0f);
+
+    const auto now = 30 * SEND_INTERVAL;
+    const auto newest_x = (float)(29 * SEND_INTERVAL) * SPEED;
+    State sample{};
+
+    // Just under the limit still slides...
+    SnapshotBuffer slide = buffer;
+    slide.push(now, make_state(newest_x + SnapshotBuffer::TELEPORT_DISTANCE - 0.5f));
+    CHECK(slide.sample(now, sample));
+    CHECK(sample.position.x < newest_x + SnapshotBuffer::TELEPORT_DISTANCE - 0.5f);
+
+    // ...past it the old updates are gone and the new position is shown right away, both now and later.
+    const auto teleport_x = newest_x + SnapshotBuffer::TELEPORT_DISTANCE + 0.5f;
+    buffer.push(now, make_state(teleport_x));
+
+    for (const auto later : {0.0, 0.1, 1.0}) {
+        CHECK(buffer.sample(now + later, sample));
+        CHECK(sample.position.x == teleport_x);
+    }
+}
+
+TEST(interpolation_gap_resets_timeline) {
+    SnapshotBuffer buffer{};
+    push_steady(buffer, 0.0, 30, 0.0f);
+
+    const auto interval = buffer.get_interval();
+    const auto jitter = buffer.get_jitter();
+    const auto resumed = 29 * SEND_INTERVAL + 1.5;
+    State sample{};
+
+    // Same place, so only the gap can reset it.
+    const auto newest_x = (float)(29 * SEND_INTERVAL) * SPEED;
+    buffer.push(resumed, make_state(newest_x));
+
+    // The gap isn't an interval and isn't jitter.
+    CHECK(buffer.get_interval() == interval);
+    CHECK(buffer.get_jitter() == jitter);
+
+    // Nothing is played back or extrapolated from before the gap.
+    CHECK(buffer.sample(resumed + 1.0, sample));
+    CHECK(sample.position.x == newest_x);
+
+    // The timeline starts over from the first update after the gap.
+    buffer.push(resumed + SEND_INTERVAL, make_state(newest_x + 1.0f));
+    CHECK(buffer.sample(resumed + SEND_INTERVAL + buffer.get_playout_delay() - SEND_INTERVAL / 2, sample));
+    CHECK(sample.position.x > newest_x);
+    CHECK(sample.position.x < newest_x + 1.0f);
+}
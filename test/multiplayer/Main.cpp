@@ -0,0 +1,21 @@
+#include <cstdio>
+
+#include "Test.hpp"
+
+int main() {
+    int failed_cases = 0;
+
+    for (const auto& c : test::get_cases()) {
+        const auto failures_before = test::get_failure_count();
+
+        c.function();
+
+        if (test::get_failure_count() != failures_before) {
+            printf("FAIL: %s\n", c.name);
+            ++failed_cases;
+        }
+    }
+
+    printf("%zu tests, %d failed\n", test::get_cases().size(), failed_cases);
+    return failed_cases != 0 ? 1 : 0;
+}
@@ -0,0 +1,106 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "MpscQueue.hpp"
+#include "Test.hpp"
+
+TEST(mpsc_queue_single_thread) {
+    MpscQueue<int> queue{};
+    int value{};
+
+    CHECK(!queue.try_pop(value));
+
+    for (auto i = 0; i < 100; ++i) {
+        queue.push(i);
+    }
+
+    for (auto i = 0; i < 100; ++i) {
+        CHECK(queue.try_pop(value) && value == i);
+    }
+
+    CHECK(!queue.try_pop(value));
+}
+
+TEST(mpsc_queue_releases_values) {
+    const auto value = std::make_shared<int>(1);
+
+    {
+        MpscQueue<std::shared_ptr<int>> queue{};
+        std::shared_ptr<int> out{};
+
+        queue.push(value);
+        queue.push(value);
+
+        CHECK(queue.try_pop(out) && out == value);
+
+        // Popping doesn't keep a copy in the queue's dummy node.
+        out.reset();
+
+        CHECK(value.use_count() == 2);
+    }
+
+    // The destructor drops what was never popped.
+    CHECK(value.use_count() == 1);
+}
+
+// Like the network thread and the game thread, except with several producers pushing while the consumer pops.
+TEST(mpsc_queue_multiple_producers) {
+    constexpr uint32_t PRODUCER_COUNT = 4;
+    constexpr uint32_t PUSH_COUNT = 50000;
+
+    MpscQueue<uint64_t> queue{};
+    std::atomic<uint32_t> ready{};
+    std::vector<std::thread> producers{};
+
+    for (uint32_t producer = 0; producer < PRODUCER_COUNT; ++producer) {
+        producers.emplace_back([&queue, &ready, producer]() {
+            ++ready;
+
+            while (ready.load() != PRODUCER_COUNT) {
+                std::this_thread::yield();
+            }
+
+            for (uint32_t i = 0; i < PUSH_COUNT; ++i) {
+                queue.push((uint64_t)producer << 32 | i);
+            }
+        });
+    }
+
+    // Each producer's values come out in the order it pushed them, none lost or repeated.
+    std::array<uint32_t, PRODUCER_COUNT> next{};
+    uint64_t popped = 0;
+    bool in_order = true;
+    uint64_t value{};
+
+    while (popped < (uint64_t)PRODUCER_COUNT * PUSH_COUNT) {
+        if (!queue.try_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const auto producer = (uint32_t)(value >> 32);
+
+        if (producer >= PRODUCER_COUNT || (uint32_t)value != next[producer]) {
+            in_order = false;
+            break;
+        }
+
+        ++next[producer];
+        ++popped;
+    }
+
+    for (auto& thread : producers) {
+        thread.join();
+    }
+
+    CHECK(in_order);
+    CHECK(!queue.try_pop(value));
+
+    for (const auto count : next) {
+        CHECK(count == PUSH_COUNT);
+    }
+}
@@ -0,0 +1,137 @@
+#include <cstdint>
+#include <memory>
+
+#include "PlayerTable.hpp"
+#include "Test.hpp"
+
+namespace {
+// The entity list index is everything above the low byte, see PlayerTable::get_handle_index.
+constexpr uint32_t make_handle(uint32_t index, uint32_t low) {
+    return index << 8 | low;
+}
+
+size_t count_players(PlayerTable& table) {
+    size_t count = 0;
+
+    for (auto& player : table) {
+        (void)player;
+        ++count;
+    }
+
+    return count;
+}
+}
+
+TEST(player_table_add) {
+    const auto table = std::make_unique<PlayerTable>();
+
+    // The relay's slot, or the lowest free one without it.
+    const auto a = table->add(5, 3);
+    const auto b = table->add(7, 0);
+    const auto c = table->add(9, PlayerTable::MAX_PLAYERS + 1);
+
+    CHECK(a != nullptr && b != nullptr && c != nullptr);
+    CHECK(a == &*table->begin() + 2);
+    CHECK(b == &*table->begin());
+    CHECK(c == b + 1);
+    CHECK(count_players(*table) == 3);
+
+    // Someone else's slot.
+    CHECK(table->add(11, 3) == nullptr);
+
+    // Adding a guid again starts it over in the slot it has.
+    table->set_handle(*a, make_handle(0x123, 1));
+    CHECK(table->add(5, 10) == a);
+    CHECK(a->get_handle() == 0);
+    CHECK(table->find_by_handle(make_handle(0x123, 1)) == nullptr);
+    CHECK(count_players(*table) == 3);
+
+    for (uint64_t guid = 100; count_players(*table) < PlayerTable::MAX_PLAYERS; ++guid) {
+        CHECK(table->add(guid, 0) != nullptr);
+    }
+
+    CHECK(table->add(1000, 0) == nullptr);
+}
+
+TEST(player_table_remove) {
+    const auto table = std::make_unique<PlayerTable>();
+    const auto a = table->add(5, 1);
+    const auto b = table->add(7, 2);
+
+    table->set_handle(*a, make_handle(0x123, 1));
+    table->set_handle(*b, make_handle(0x124, 1));
+
+    table->remove(5);
+
+    CHECK(!table->contains(5));
+    CHECK(table->find(7) == b);
+    CHECK(table->find_by_handle(make_handle(0x123, 1)) == nullptr);
+    CHECK(table->find_by_handle(make_handle(0x124, 1)) == b);
+    CHECK(count_players(*table) == 1);
+
+    // Unknown guids are ignored, and the slot is free again.
+    table->remove(5);
+    table->remove(1000);
+    CHECK(count_players(*table) == 1);
+    CHECK(table->add(9, 1) == a);
+    CHECK(a->get_handle() == 0);
+
+    table->clear();
+    CHECK(count_players(*table) == 0);
+    CHECK(table->find_by_handle(make_handle(0x124, 1)) == nullptr);
+}
+
+TEST(player_table_find_by_handle) {
+    const auto table = std::make_unique<PlayerTable>();
+    const auto a = table->add(5, 1);
+
+    CHECK(table->find_by_handle(0) == nullptr);
+    CHECK(table->find_by_handle(make_handle(0x123, 1)) == nullptr);
+
+    table->set_handle(*a, make_handle(0x123, 1));
+
+    CHECK(table->find_by_handle(make_handle(0x123, 1)) == a);
+
+    // A different entity in the same entry isn't the player's.
+    CHECK(table->find_by_handle(make_handle(0x123, 2)) == nullptr);
+
+    // A new entity leaves the old handle behind.
+    table->set_handle(*a, make_handle(0x200, 1));
+
+    CHECK(table->find_by_handle(make_handle(0x123, 1)) == nullptr);
+    CHECK(table->find_by_handle(make_handle(0x200, 1)) == a);
+
+    table->set_handle(*a, 0);
+
+    CHECK(a->get_handle() == 0);
+    CHECK(table->find_by_handle(make_handle(0x200, 1)) == nullptr);
+    CHECK(table->find_by_handle(0) == nullptr);
+}
+
+TEST(player_table_reused_handle_index) {
+    const auto table = std::make_unique<PlayerTable>();
+    const auto a = table->add(5, 1);
+    const auto b = table->add(7, 2);
+
+    table->set_handle(*a, make_handle(0x123, 1));
+
+    // A's entity is gone and the game gives its entry to B's new one before A's is replaced.
+    table->set_handle(*b, make_handle(0x123, 2));
+
+    CHECK(table->find_by_handle(make_handle(0x123, 2)) == b);
+    CHECK(table->find_by_handle(make_handle(0x123, 1)) == nullptr);
+
+    // A moving on must not take the entry from B.
+    table->set_handle(*a, make_handle(0x300, 1));
+
+    CHECK(table->find_by_handle(make_handle(0x123, 2)) == b);
+    CHECK(table->find_by_handle(make_handle(0x300, 1)) == a);
+
+    // Nor A leaving.
+    table->set_handle(*a, make_handle(0x123, 3));
+    table->set_handle(*b, make_handle(0x124, 1));
+    table->set_handle(*b, make_handle(0x123, 4));
+    table->remove(5);
+
+    CHECK(table->find_by_handle(make_handle(0x123, 4)) == b);
+}
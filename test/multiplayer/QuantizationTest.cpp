@@ -0,0 +1,91 @@
+#include <cfloat>
+
+#include "Quantization.hpp"
+#include "Test.hpp"
+
+using namespace quantization;
+
+namespace {
+// A decoded value can't be closer than the floats around it allow.
+float get_tolerance(float bound, float value) {
+    return bound + 4.0f * FLT_EPSILON * std::max(1.0f, std::abs(value));
+}
+
+float get_angle_error(float a, float b) {
+    return std::abs(std::remainder(a - b, TWO_PI));
+}
+}
+
+TEST(quantization_position_within_1mm) {
+    test::Random random{};
+
+    for (auto i = 0; i < 100000; ++i) {
+        const nier::Vector3f position{random.next_signed(5000.0f), random.next_signed(500.0f), random.next_signed(5000.0f)};
+        const auto sector = get_sector(position, DEFAULT_PRECISION);
+
+        CHECK(is_in_sector(position, sector, DEFAULT_PRECISION));
+
+        const auto decoded = dequantize_position(quantize_position(position, sector, DEFAULT_PRECISION), sector, DEFAULT_PRECISION);
+
+        CHECK_NEAR(decoded.x(), position.x(), get_tolerance(0.001f, position.x()));
+        CHECK_NEAR(decoded.y(), position.y(), get_tolerance(0.001f, position.y()));
+        CHECK_NEAR(decoded.z(), position.z(), get_tolerance(0.001f, position.z()));
+    }
+}
+
+TEST(quantization_sector_edge) {
+    const auto precision = DEFAULT_PRECISION;
+    const nier::Sector sector{1, 0, 0};
+    const auto center = get_sector_center(sector, precision).x();
+    const auto at = [&](float steps) { return nier::Vector3f{center + steps * precision, 0.0f, 0.0f}; };
+
+    // The last offsets a short holds on either side, and just past them.
+    CHECK(is_in_sector(at(32767.0f), sector, precision));
+    CHECK(is_in_sector(at(32767.4f), sector, precision));
+    CHECK(!is_in_sector(at(32767.6f), sector, precision));
+    CHECK(is_in_sector(at(-32768.0f), sector, precision));
+    CHECK(!is_in_sector(at(-32768.6f), sector, precision));
+
+    CHECK(quantize_position(at(32767.0f), sector, precision).x() == 32767);
+    CHECK(quantize_position(at(-32768.0f), sector, precision).x() == -32768);
+
+    // Past the edge it is clamped to it.
+    CHECK(quantize_position(at(40000.0f), sector, precision).x() == 32767);
+    CHECK(quantize_position(at(-40000.0f), sector, precision).x() == -32768);
+
+    // Sectors overlap, a player just across the boundary to the next one still fits in the one they're in.
+    const auto boundary = at(SECTOR_STEPS / 2.0f + 1000.0f);
+    const auto next_sector = get_sector(boundary, precision);
+
+    CHECK(next_sector.x() == 2);
+    CHECK(!is_same_sector(next_sector, sector));
+    CHECK(is_in_sector(boundary, sector, precision));
+    CHECK(is_in_sector(boundary, next_sector, precision));
+}
+
+TEST(quantization_yaw_wraps_at_two_pi) {
+    CHECK(quantize_yaw(0.0f) == 0);
+    CHECK(quantize_yaw(TWO_PI) == 0);
+    CHECK(quantize_yaw(-TWO_PI) == 0);
+
+    // Just below a full turn rounds up to 65536 and has to come out as 0, not 65535 or garbage.
+    CHECK(quantize_yaw(std::nextafter(TWO_PI, 0.0f)) == 0);
+    CHECK(quantize_yaw(-0.00001f) == 0);
+    CHECK(quantize_yaw(TWO_PI / YAW_STEPS * 65535.0f) == 65535);
+
+    // pi and -pi are the same facing, decoded into the game's [-pi, pi).
+    CHECK(quantize_yaw(PI) == 32768);
+    CHECK(quantize_yaw(-PI) == 32768);
+    CHECK(dequantize_yaw(32768) == -PI);
+    CHECK(dequantize_yaw(32767) < PI);
+    CHECK(dequantize_yaw(65535) < 0.0f);
+    CHECK(dequantize_yaw(65535) > -TWO_PI / YAW_STEPS * 1.5f);
+
+    // Anything, including angles past a full turn, comes back within half a step.
+    for (auto radians = -3.0f * TWO_PI; radians <= 3.0f * TWO_PI; radians += 0.001f) {
+        const auto decoded = dequantize_yaw(quantize_yaw(radians));
+
+        CHECK(decoded >= -PI && decoded < PI);
+        CHECK(get_angle_error(decoded, radians) <= get_tolerance(PI / YAW_STEPS, radians));
+    }
+}
@@ -0,0 +1,121 @@
+#include <cstdint>
+
+#include "Quantization.hpp"
+#include "Test.hpp"
+
+using namespace quantization;
+
+namespace {
+// Half a step for the three components that are sent, the rebuilt one takes on their error.
+constexpr float SENT_COMPONENT_BOUND = 0.0007f;
+constexpr float REBUILT_COMPONENT_BOUND = 0.0021f;
+
+struct Golden {
+    glm::quat rotation;
+    uint32_t largest;
+    uint32_t value;
+};
+
+// Pins the wire layout, server/automatamp/core/Quaternion_test.go decodes the same values.
+// One per largest component, x y z w in that order, the last two with it negative.
+const Golden GOLDEN[]{
+    {glm::quat{0.1f, 0.9f, -0.3f, 0.2f}, 0, 0x121A524A},
+    {glm::quat{0.2f, -0.3f, 0.9f, 0.1f}, 1, 0x52192A94},
+    {glm::quat{-0.1f, 0.2f, 0.3f, -0.9f}, 2, 0x96B4864A},
+    {glm::quat{-0.9f, 0.1f, -0.2f, 0.3f}, 3, 0xDB5A5121},
+};
+
+float get_component(const glm::quat& q, uint32_t i) {
+    const float components[4]{q.x, q.y, q.z, q.w};
+    return components[i];
+}
+
+// Round trips rotation and checks every component against the bounds. The decoded quaternion always has
+// the left out component positive, so it is compared against -rotation when that one was negative.
+void check_round_trip(const glm::quat& rotation, float* max_sent_error = nullptr, float* max_rebuilt_error = nullptr) {
+    const auto q = glm::normalize(rotation);
+    const auto compressed = compress_quaternion(rotation);
+    const auto decoded = decompress_quaternion(compressed);
+    const auto largest = compressed.value() >> 30;
+    const auto sign = get_component(q, largest) < 0.0f ? -1.0f : 1.0f;
+
+    CHECK(get_component(decoded, largest) >= 0.0f);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        const auto error = std::abs(get_component(q, i) * sign - get_component(decoded, i));
+        auto& max_error = i == largest ? max_rebuilt_error : max_sent_error;
+
+        CHECK(error <= (i == largest ? REBUILT_COMPONENT_BOUND : SENT_COMPONENT_BOUND));
+
+        if (max_error != nullptr) {
+            *max_error = std::max(*max_error, error);
+        }
+    }
+}
+}
+
+TEST(quaternion_golden_values) {
+    for (const auto& golden : GOLDEN) {
+        const auto compressed = compress_quaternion(golden.rotation);
+
+        CHECK(compressed.value() == golden.value);
+        CHECK(compressed.value() >> 30 == golden.largest);
+        check_round_trip(golden.rotation);
+    }
+}
+
+TEST(quaternion_each_largest_component) {
+    for (uint32_t largest = 0; largest < 4; ++largest) {
+        for (const auto sign : {1.0f, -1.0f}) {
+            float components[4]{0.1f, -0.2f, 0.3f, -0.15f};
+            components[largest] = 0.85f * sign;
+
+            const glm::quat rotation{components[3], components[0], components[1], components[2]};
+
+            CHECK(compress_quaternion(rotation).value() >> 30 == largest);
+            check_round_trip(rotation);
+        }
+    }
+}
+
+TEST(quaternion_negative_largest_flips) {
+    const auto q = glm::normalize(glm::quat{-0.9f, 0.1f, -0.2f, 0.3f});
+    const glm::quat negated{-q.w, -q.x, -q.y, -q.z};
+    const auto compressed = compress_quaternion(q);
+
+    // Both signs are the same rotation and the same bits.
+    CHECK(compressed.value() == compress_quaternion(negated).value());
+
+    // The left out component comes back positive, so it decodes as -q.
+    const auto decoded = decompress_quaternion(compressed);
+
+    CHECK_NEAR(decoded.w, negated.w, REBUILT_COMPONENT_BOUND);
+    CHECK_NEAR(decoded.x, negated.x, SENT_COMPONENT_BOUND);
+    CHECK_NEAR(decoded.y, negated.y, SENT_COMPONENT_BOUND);
+    CHECK_NEAR(decoded.z, negated.z, SENT_COMPONENT_BOUND);
+
+    // Identity and its negation, the largest component exactly 1 and the others at the middle step.
+    check_round_trip(glm::quat{1.0f, 0.0f, 0.0f, 0.0f});
+    check_round_trip(glm::quat{-1.0f, 0.0f, 0.0f, 0.0f});
+}
+
+TEST(quaternion_component_bound) {
+    test::Random random{};
+
+    auto max_sent_error = 0.0f;
+    auto max_rebuilt_error = 0.0f;
+
+    for (auto i = 0; i < 200000; ++i) {
+        const glm::quat rotation{random.next_signed(), random.next_signed(), random.next_signed(), random.next_signed()};
+
+        if (rotation.w * rotation.w + rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z < 0.01f) {
+            continue;
+        }
+
+        check_round_trip(rotation, &max_sent_error, &max_rebuilt_error);
+    }
+
+    // Not a loose bound, the sweep gets close to both.
+    CHECK(max_sent_error > SENT_COMPONENT_BOUND * 0.9f);
+    CHECK(max_rebuilt_error > REBUILT_COMPONENT_BOUND * 0.5f);
+}
@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <vector>
+
+#include "ReplicatedProperty.hpp"
+#include "Test.hpp"
+
+using replication::EntityProperties;
+using replication::PlayerProperties;
+
+namespace {
+// flashlight, weapon_index, pod_index, held_flags. server/automatamp/core/ReplicatedProperty_test.go reads the same bytes.
+const PlayerProperties::Values PLAYER_VALUES{true, 7u, 0x01020304u, 0xAABBCCDDu};
+const std::vector<uint8_t> PLAYER_MESSAGE{
+    0x0F,
+    0x01,
+    0x07, 0x00, 0x00, 0x00,
+    0x04, 0x03, 0x02, 0x01,
+    0xDD, 0xCC, 0xBB, 0xAA,
+};
+
+const PlayerProperties::Values OLD_VALUES{false, 1u, 2u, 3u};
+}
+
+TEST(replicated_property_wire_format) {
+    std::vector<uint8_t> out{};
+    PlayerProperties::write_message(PLAYER_VALUES, PlayerProperties::ALL, out);
+
+    CHECK(out == PLAYER_MESSAGE);
+
+    auto values = OLD_VALUES;
+
+    CHECK(PlayerProperties::read_message(PLAYER_MESSAGE.data(), PLAYER_MESSAGE.size(), values));
+    CHECK(values == PLAYER_VALUES);
+
+    // Only what's in the mask, in declaration order.
+    out.clear();
+    PlayerProperties::write_message(PLAYER_VALUES, 0x0A, out);
+
+    CHECK((out == std::vector<uint8_t>{0x0A, 0x07, 0x00, 0x00, 0x00, 0xDD, 0xCC, 0xBB, 0xAA}));
+
+    values = OLD_VALUES;
+
+    CHECK(PlayerProperties::read_message(out.data(), out.size(), values));
+    CHECK((values == PlayerProperties::Values{false, 7u, 2u, 0xAABBCCDDu}));
+}
+
+TEST(replicated_property_mask_only) {
+    const uint8_t message[]{0x00};
+    auto values = OLD_VALUES;
+
+    // Nothing changed, nothing is overwritten.
+    CHECK(PlayerProperties::read_message(message, sizeof(message), values));
+    CHECK(values == OLD_VALUES);
+
+    // A mask that says there are values but none of them.
+    const uint8_t flashlight_only[]{0x01};
+
+    CHECK(!PlayerProperties::read_message(flashlight_only, sizeof(flashlight_only), values));
+    CHECK(!PlayerProperties::read_message(message, 0, values));
+    CHECK(values == OLD_VALUES);
+}
+
+TEST(replicated_property_short_buffer) {
+    for (size_t size = 1; size < PLAYER_MESSAGE.size(); ++size) {
+        auto values = OLD_VALUES;
+
+        // A value cut in half doesn't leave the ones before it half applied either.
+        CHECK(!PlayerProperties::read_message(PLAYER_MESSAGE.data(), size, values));
+        CHECK(values == OLD_VALUES);
+    }
+}
+
+TEST(replicated_property_trailing_bytes) {
+    auto message = PLAYER_MESSAGE;
+    message.push_back(0x00);
+
+    auto values = OLD_VALUES;
+
+    CHECK(!PlayerProperties::read_message(message.data(), message.size(), values));
+    CHECK(values == OLD_VALUES);
+
+    const uint8_t mask_only[]{0x00, 0x00};
+
+    CHECK(!PlayerProperties::read_message(mask_only, sizeof(mask_only), values));
+    CHECK(values == OLD_VALUES);
+}
+
+TEST(replicated_property_out_of_range_mask) {
+    for (const uint8_t mask : {0x10, 0x20, 0x80, 0xFF}) {
+        auto message = PLAYER_MESSAGE;
+        message[0] = mask;
+
+        auto values = OLD_VALUES;
+
+        CHECK(!PlayerProperties::read_message(message.data(), message.size(), values));
+        CHECK(values == OLD_VALUES);
+    }
+
+    // Entities only have health.
+    const uint8_t entity_message[]{0x02, 0x05, 0x00, 0x00, 0x00};
+    EntityProperties::Values entity_values{9u};
+
+    CHECK(!EntityProperties::read_message(entity_message, sizeof(entity_message), entity_values));
+    CHECK(std::get<0>(entity_values) == 9u);
+}
+
+// read takes the mask from elsewhere and reads from the middle of a buffer, like entity snapshots are.
+TEST(replicated_property_read_at_offset) {
+    const uint8_t data[]{0xEE, 0xEE, 0x05, 0x01, 0x00, 0x00, 0x06, 0x01, 0x00, 0x00};
+    EntityProperties::Values values{9u};
+    size_t offset = 2;
+
+    CHECK(EntityProperties::read(data, sizeof(data), 0x01, values, offset));
+    CHECK(std::get<0>(values) == 0x105u);
+    CHECK(offset == 6);
+
+    // Not dirty, nothing is read and offset stays.
+    CHECK(EntityProperties::read(data, sizeof(data), 0x00, values, offset));
+    CHECK(std::get<0>(values) == 0x105u);
+    CHECK(offset == 6);
+
+    CHECK(EntityProperties::read(data, sizeof(data), 0x01, values, offset));
+    CHECK(std::get<0>(values) == 0x106u);
+    CHECK(offset == sizeof(data));
+
+    CHECK(!EntityProperties::read(data, sizeof(data), 0x01, values, offset));
+    CHECK(offset == sizeof(data));
+}
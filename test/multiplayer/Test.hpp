@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Just enough of a test harness for the multiplayer code that doesn't need the game, every TEST in the
+// target is run by Main.cpp and a failed CHECK fails the test it's in without stopping the others.
+namespace test {
+using Function = void (*)();
+
+struct Case {
+    const char* name;
+    Function function;
+};
+
+inline std::vector<Case>& get_cases() {
+    static std::vector<Case> cases{};
+    return cases;
+}
+
+inline int& get_failure_count() {
+    static int count{};
+    return count;
+}
+
+struct Registrar {
+    Registrar(const char* name, Function function) {
+        get_cases().push_back({name, function});
+    }
+};
+
+inline void fail(const char* file, int line, const char* expression) {
+    printf("%s(%d): CHECK(%s) failed\n", file, line, expression);
+    ++get_failure_count();
+}
+
+// A fixed LCG instead of <random> so a test sees the same values with every standard library.
+class Random {
+public:
+    explicit Random(uint32_t seed = 1)
+        : m_seed{seed}
+    {
+    }
+
+    uint32_t next() {
+        m_seed = m_seed * 1664525u + 1013904223u;
+        return m_seed;
+    }
+
+    // [0, 1) from the top 24 bits, the low bits of an LCG repeat with a short period.
+    double next_unit() {
+        return (next() >> 8) / (double)(1u << 24);
+    }
+
+    // [-range, range)
+    float next_signed(float range = 1.0f) {
+        return ((float)(next() >> 8) / (float)(1u << 24) * 2.0f - 1.0f) * range;
+    }
+
+private:
+    uint32_t m_seed;
+};
+}
+
+#define TEST(name) \
+    static void name(); \
+    static test::Registrar name##_registrar{#name, name}; \
+    static void name()
+
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) { \
+            test::fail(__FILE__, __LINE__, #expression); \
+        } \
+    } while (false)
+
+#define CHECK_NEAR(a, b, tolerance) CHECK(std::abs((double)(a) - (double)(b)) <= (double)(tolerance))
@@ -0,0 +1,132 @@
+#include <chrono>
+#include <cstdint>
+
+#include "TickScheduler.hpp"
+#include "Test.hpp"
+
+namespace {
+using Clock = TickScheduler::Clock;
+
+// Both send rates NierClient starts with and one the slider can reach.
+constexpr float SEND_RATES[]{20.0f, 30.0f, 60.0f};
+constexpr uint32_t FRAME_RATES[]{20, 60, 144, 300};
+
+Clock::duration frame_time(uint32_t fps) {
+    return std::chrono::nanoseconds{1'000'000'000 / fps};
+}
+
+// Calls tick once per frame like NierClient::on_frame does, returns how many frames ticked.
+uint64_t run_frames(TickScheduler& scheduler, Clock::time_point& now, uint32_t fps, uint64_t frames) {
+    uint64_t ticks = 0;
+
+    for (uint64_t i = 0; i < frames; ++i) {
+        now += frame_time(fps);
+        ticks += scheduler.tick(now) ? 1 : 0;
+    }
+
+    return ticks;
+}
+}
+
+TEST(tick_scheduler_fixed_frame_rates) {
+    constexpr uint64_t SECONDS = 10;
+
+    for (const auto rate : SEND_RATES) {
+        for (const auto fps : FRAME_RATES) {
+            TickScheduler scheduler{rate};
+            Clock::time_point now{};
+
+            CHECK(scheduler.tick(now));
+
+            run_frames(scheduler, now, fps, fps * SECONDS);
+
+            const auto ticks = scheduler.get_tick_count();
+            const auto skipped = scheduler.get_skipped_ticks();
+            const auto frame_ms = 1000.0 / fps;
+            const auto interval_ms = 1000.0 / rate;
+
+            // Ticks sent and dropped add up to the rate, short of the catch-up backlog still held.
+            CHECK_NEAR((double)(ticks + skipped), rate * SECONDS, TickScheduler::MAX_CATCH_UP + 1);
+
+            if (fps >= rate) {
+                CHECK(skipped == 0);
+                // Ticks land on frames, so they are off by less than a frame.
+                CHECK(scheduler.get_jitter_ms() < frame_ms);
+            } else {
+                // Once per frame and the rest is dropped.
+                CHECK(ticks == fps * SECONDS + 1);
+                CHECK(skipped > 0);
+                // Every tick is a frame apart instead of an interval.
+                CHECK_NEAR(scheduler.get_jitter_ms(), frame_ms - interval_ms, 0.01);
+            }
+
+            if (fps == (uint32_t)rate) {
+                CHECK(scheduler.get_jitter_ms() < 0.001f);
+            }
+        }
+    }
+}
+
+TEST(tick_scheduler_hitch) {
+    for (const auto rate : SEND_RATES) {
+        for (const auto fps : FRAME_RATES) {
+            if (fps < rate) {
+                continue;
+            }
+
+            TickScheduler scheduler{rate};
+            Clock::time_point now{};
+
+            scheduler.tick(now);
+            run_frames(scheduler, now, fps, fps * 2);
+
+            const auto jitter_before = scheduler.get_jitter_ms();
+            const auto interval_ms = 1000.0 / rate;
+
+            CHECK(scheduler.get_skipped_ticks() == 0);
+
+            // One frame that took a second.
+            now += std::chrono::seconds{1};
+
+            CHECK(scheduler.tick(now));
+
+            // Between 1000 ms and one interval less off from the last tick, smoothed by 1/16.
+            const auto jitter_hitch = scheduler.get_jitter_ms();
+
+            CHECK(jitter_hitch >= jitter_before * 15.0 / 16.0 + (1000.0 - interval_ms) / 16.0 - 0.01);
+            CHECK(jitter_hitch <= jitter_before * 15.0 / 16.0 + 1000.0 / 16.0 + 0.01);
+
+            // The second held up to MAX_CATCH_UP ticks back, they go out on top of the rate and the rest was dropped.
+            const auto ticks_after = run_frames(scheduler, now, fps, fps * 2);
+
+            CHECK(ticks_after >= rate * 2 - 1);
+            CHECK(ticks_after <= rate * 2 + TickScheduler::MAX_CATCH_UP + 1);
+            CHECK_NEAR((double)scheduler.get_skipped_ticks(), rate - 1 - TickScheduler::MAX_CATCH_UP, 1.0);
+            CHECK_NEAR((double)(scheduler.get_tick_count() + scheduler.get_skipped_ticks()), rate * 5, TickScheduler::MAX_CATCH_UP + 1);
+
+            // And the jitter settles again.
+            CHECK(scheduler.get_jitter_ms() < jitter_hitch / 4.0f);
+        }
+    }
+}
+
+TEST(tick_scheduler_rate) {
+    TickScheduler scheduler{300.0f};
+
+    CHECK(scheduler.get_rate() == TickScheduler::MAX_RATE);
+
+    scheduler.set_rate(0.0f);
+
+    CHECK(scheduler.get_rate() == TickScheduler::MIN_RATE);
+
+    // A new session ticks right away, even right after the last tick.
+    Clock::time_point now{};
+
+    scheduler.set_rate(20.0f);
+    CHECK(scheduler.tick(now));
+    CHECK(!scheduler.tick(now + std::chrono::milliseconds{10}));
+
+    scheduler.reset();
+
+    CHECK(scheduler.tick(now + std::chrono::milliseconds{20}));
+}